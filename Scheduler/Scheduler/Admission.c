@@ -0,0 +1,607 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Admission.c                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Admission.h                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Admission.h"
+#include "Synthesizer.h"
+#include "Network.h"
+#include "CompactSchedule.h"
+#include "Validator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Busy time of a link folded into one period of the new frame, as sorted intervals that do not overlap
+ */
+typedef struct LinkOccupancy {
+    long long int *starts;              // Time where every busy interval starts
+    long long int *ends;                // Time where every busy interval ends (not included)
+    int num_intervals;                  // Number of busy intervals
+}LinkOccupancy;
+
+                                                    /* VARIABLES */
+
+int admission_repair_limit = ADMISSION_REPAIR_FRAMES;  // Frames that can be unpinned in the repair stage
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the time to transmit a frame in a link, as the network computes it when it is initialized
+
+ @param size size of the frame in bytes
+ @param link_id identifier of the link
+ @return transmission time in ns
+ */
+long long int get_transmission_time(int size, int link_id) {
+    
+    return (size * 1000) / get_link_speed(get_link(link_id));
+}
+
+/**
+ Get the time budget left of the admission
+
+ @param options pointer to the options of the scheduler with the time budget
+ @param start_time time when the admission started
+ @return remaining time in ms, 0 if there is no budget, -1 if it has ended
+ */
+long long int get_remaining_budget(SchedulerOptions *options, struct timeval start_time) {
+    
+    struct timeval now;
+    long long int remaining;
+    
+    if (options->time_budget <= 0) {
+        return 0;
+    }
+    gettimeofday(&now, NULL);
+    remaining = options->time_budget - (long long int) time_diff(start_time, now);
+    return remaining > 0 ? remaining : -1;
+}
+
+/**
+ Checks that the new frame can be admitted in the network: its information is valid, its period divides the
+ hyperperiod, the links of its paths exist, have not failed and are connected, and every link has enough free time left
+ for all its instances. The links of the frame are saved in the result
+
+ @param period period of the frame in ns
+ @param deadline deadline of the frame in ns
+ @param size size of the frame in bytes
+ @param end_to_end maximum end to end delay of the frame in ns
+ @param starting starting time of the frame in ns
+ @param num_paths number of paths of the frame
+ @param paths array with the links of every path
+ @param len_paths array with the number of links of every path
+ @param result pointer to the result where the links or the reason of the rejection are saved
+ @return 0 if the frame can be admitted, -1 otherwise
+ */
+int check_admission_request(long long int period, long long int deadline, int size, long long int end_to_end,
+                            long long int starting, int num_paths, int **paths, int *len_paths,
+                            AdmissionResult *result) {
+    
+    long long int busy, time_between_frames = get_time_between_frames();
+    Offset *offset_pt;
+    int link, found;
+    
+    if (period <= 0 || size <= 0 || starting < 0 || deadline <= starting || deadline > period || end_to_end <= 0 ||
+        num_paths <= 0) {
+        snprintf(result->reason, ADMISSION_REASON_SIZE, "the information of the frame is not valid");
+        return -1;
+    }
+    if (get_hyper_period() % period != 0) {
+        snprintf(result->reason, ADMISSION_REASON_SIZE, "the period does not divide the hyperperiod");
+        return -1;
+    }
+    
+    // Links of the paths, the links shared by several paths are only saved once
+    result->links = malloc(sizeof(int) * (get_number_links() + 1));
+    result->offsets = malloc(sizeof(long long int) * (get_number_links() + 1));
+    for (int i = 0; i < num_paths; i++) {
+        if (len_paths[i] <= 0) {
+            snprintf(result->reason, ADMISSION_REASON_SIZE, "the path %d is empty", i);
+            return -1;
+        }
+        for (int j = 0; j < len_paths[i]; j++) {
+            link = paths[i][j];
+            if (link < 0 || link >= get_number_links() || is_link_failed(get_link(link))) {
+                snprintf(result->reason, ADMISSION_REASON_SIZE, "the link %d does not exist or has failed", link);
+                return -1;
+            }
+            if (j > 0 && get_link_destination(get_link(paths[i][j - 1])) >= 0 &&
+                get_link_source(get_link(link)) >= 0 &&
+                get_link_destination(get_link(paths[i][j - 1])) != get_link_source(get_link(link))) {
+                snprintf(result->reason, ADMISSION_REASON_SIZE, "the path %d is not connected", i);
+                return -1;
+            }
+            found = 0;
+            for (int k = 0; k < result->num_links && !found; k++) {
+                found = result->links[k] == link;
+            }
+            if (!found) {
+                result->links[result->num_links++] = link;
+            }
+        }
+    }
+    
+    // All the transmissions in the hyperperiod, with the time between frames, have to fit in every link
+    for (int i = 0; i < result->num_links; i++) {
+        link = result->links[i];
+        busy = (get_hyper_period() / period) * (get_transmission_time(size, link) + time_between_frames);
+        for (int j = 0; j < get_link_number_offsets(link); j++) {
+            offset_pt = get_link_offset(link, j);
+            busy += get_number_instances(offset_pt) * (get_number_replicas(offset_pt) + 1) *
+                    (get_timeslot_size(offset_pt) + time_between_frames);
+        }
+        if (busy > get_hyper_period()) {
+            snprintf(result->reason, ADMISSION_REASON_SIZE, "the link %d has not enough free time", link);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Compares two busy intervals by their start, to sort them
+
+ @param a pointer to the first interval (two long long int, start and end)
+ @param b pointer to the second interval
+ @return negative if a starts first, positive if b starts first, 0 if they start at the same time
+ */
+int compare_intervals(const void *a, const void *b) {
+    
+    const long long int *interval_a = a, *interval_b = b;
+    
+    return (interval_a[0] > interval_b[0]) - (interval_a[0] < interval_b[0]);
+}
+
+/**
+ Builds the occupancy of a link folded into one period of the new frame. As the period divides the hyperperiod, all
+ the instances of the new frame are free if the first one is free in the folded occupancy. Every transmission is busy
+ until the time between frames after it ends, and it is also copied one period before and after, so the transmissions
+ of the new frame that cross the end of the period are also checked
+
+ @param link_id identifier of the link
+ @param period period of the new frame in ns
+ @param occupancy pointer to the occupancy to build, its arrays have to be freed
+ */
+void build_link_occupancy(int link_id, long long int period, LinkOccupancy *occupancy) {
+    
+    Offset *offset_pt;
+    long long int *intervals, start, length, time_between_frames = get_time_between_frames();
+    int num_intervals = 0, size = 0;
+    
+    for (int i = 0; i < get_link_number_offsets(link_id); i++) {
+        offset_pt = get_link_offset(link_id, i);
+        size += get_number_instances(offset_pt) * (get_number_replicas(offset_pt) + 1) * 3;
+    }
+    intervals = malloc(sizeof(long long int) * 2 * (size + 1));
+    for (int i = 0; i < get_link_number_offsets(link_id); i++) {
+        offset_pt = get_link_offset(link_id, i);
+        length = get_timeslot_size(offset_pt) + time_between_frames;
+        for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+            for (int replica = 0; replica <= get_number_replicas(offset_pt); replica++) {
+                start = ((get_offset(offset_pt, instance, replica) % period) + period) % period;
+                for (int copy = -1; copy <= 1; copy++) {
+                    intervals[num_intervals * 2] = start + copy * period;
+                    intervals[num_intervals * 2 + 1] = start + copy * period + length;
+                    num_intervals++;
+                }
+            }
+        }
+    }
+    qsort(intervals, num_intervals, sizeof(long long int) * 2, compare_intervals);
+    
+    // Merge the intervals that overlap, so the search of free time only moves forward
+    occupancy->starts = malloc(sizeof(long long int) * (num_intervals + 1));
+    occupancy->ends = malloc(sizeof(long long int) * (num_intervals + 1));
+    occupancy->num_intervals = 0;
+    for (int i = 0; i < num_intervals; i++) {
+        if (occupancy->num_intervals > 0 && intervals[i * 2] <= occupancy->ends[occupancy->num_intervals - 1]) {
+            if (intervals[i * 2 + 1] > occupancy->ends[occupancy->num_intervals - 1]) {
+                occupancy->ends[occupancy->num_intervals - 1] = intervals[i * 2 + 1];
+            }
+        } else {
+            occupancy->starts[occupancy->num_intervals] = intervals[i * 2];
+            occupancy->ends[occupancy->num_intervals] = intervals[i * 2 + 1];
+            occupancy->num_intervals++;
+        }
+    }
+    free(intervals);
+}
+
+/**
+ Get the first time, from the given one, where a transmission of the given length does not touch any busy interval
+
+ @param occupancy pointer to the folded occupancy of the link
+ @param time earliest time to start the transmission
+ @param length time that the transmission keeps the link busy, including the time between frames
+ @return first free time to start the transmission
+ */
+long long int get_next_free_time(LinkOccupancy *occupancy, long long int time, long long int length) {
+    
+    int low = 0, high = occupancy->num_intervals, middle;
+    
+    // First interval that ends after the time, with a binary search as the intervals are sorted and do not overlap
+    while (low < high) {
+        middle = (low + high) / 2;
+        if (occupancy->ends[middle] <= time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (int i = low; i < occupancy->num_intervals && occupancy->starts[i] < time + length; i++) {
+        if (occupancy->ends[i] > time) {
+            time = occupancy->ends[i];
+        }
+    }
+    return time;
+}
+
+/**
+ Searches the first transmission times of the new frame in its links that are free in the current schedule and satisfy
+ its range, path dependency and end to end delay (with the same margins that the solver uses). Every path is placed as
+ soon as possible from a starting time, which is delayed while the end to end delay of any path is not satisfied
+
+ @param period period of the frame in ns
+ @param deadline deadline of the frame in ns
+ @param size size of the frame in bytes
+ @param end_to_end maximum end to end delay of the frame in ns
+ @param starting starting time of the frame in ns
+ @param num_paths number of paths of the frame
+ @param paths array with the links of every path
+ @param len_paths array with the number of links of every path
+ @param result pointer to the result with the links of the frame, where the transmission times found are saved
+ @return 0 if found, -1 otherwise
+ */
+int search_first_fit(long long int period, long long int deadline, int size, long long int end_to_end,
+                     long long int starting, int num_paths, int **paths, int *len_paths, AdmissionResult *result) {
+    
+    LinkOccupancy *occupancies;
+    long long int *transmission_times, first_time, retry_time, lower_bound, first, last;
+    long long int time_between_frames = get_time_between_frames();
+    int *link_positions, *assigned, position, previous, status = -1, placed;
+    
+    occupancies = malloc(sizeof(LinkOccupancy) * result->num_links);
+    transmission_times = malloc(sizeof(long long int) * result->num_links);
+    assigned = malloc(sizeof(int) * result->num_links);
+    link_positions = malloc(sizeof(int) * get_number_links());
+    for (int i = 0; i < result->num_links; i++) {
+        link_positions[result->links[i]] = i;
+        transmission_times[i] = get_transmission_time(size, result->links[i]);
+        build_link_occupancy(result->links[i], period, &occupancies[i]);
+    }
+    
+    first_time = starting + 1;
+    for (int attempt = 0; attempt < ADMISSION_FIRST_FIT_ATTEMPTS && status == -1; attempt++) {
+        memset(assigned, 0, sizeof(int) * result->num_links);
+        placed = 1;
+        retry_time = first_time + 1;
+        for (int i = 0; i < num_paths && placed == 1; i++) {
+            previous = -1;
+            for (int j = 0; j < len_paths[i] && placed == 1; j++) {
+                position = link_positions[paths[i][j]];
+                if (previous == -1) {
+                    lower_bound = first_time;
+                } else {
+                    lower_bound = result->offsets[previous] + transmission_times[previous] + get_hop_delay() + 1;
+                }
+                if (!assigned[position]) {
+                    result->offsets[position] = get_next_free_time(&occupancies[position], lower_bound,
+                                                                   transmission_times[position] + time_between_frames);
+                    assigned[position] = 1;
+                } else if (result->offsets[position] < lower_bound) {
+                    placed = 0;         // A link shared by paths that reach it at different times, try later
+                }
+                // Later starting times cannot move any transmission earlier, so there is no room for the frame
+                if (result->offsets[position] > deadline - transmission_times[position]) {
+                    placed = -1;
+                }
+                previous = position;
+            }
+            if (placed == 1) {
+                first = result->offsets[link_positions[paths[i][0]]];
+                last = result->offsets[previous];
+                if (last >= first + end_to_end - transmission_times[previous]) {
+                    placed = 0;         // The first link has to wait until the end to end delay can be satisfied
+                    if (last + transmission_times[previous] - end_to_end + 1 > retry_time) {
+                        retry_time = last + transmission_times[previous] - end_to_end + 1;
+                    }
+                }
+            }
+        }
+        if (placed == 1) {
+            status = 0;
+        } else if (placed == -1) {
+            break;
+        }
+        first_time = retry_time;
+    }
+    
+    for (int i = 0; i < result->num_links; i++) {
+        free(occupancies[i].starts);
+        free(occupancies[i].ends);
+    }
+    free(occupancies);
+    free(transmission_times);
+    free(assigned);
+    free(link_positions);
+    return status;
+}
+
+/**
+ Adds the new frame after the last frame of the network, that has to be not initialized
+
+ @param period period of the frame in ns
+ @param deadline deadline of the frame in ns
+ @param size size of the frame in bytes
+ @param end_to_end maximum end to end delay of the frame in ns
+ @param starting starting time of the frame in ns
+ @param num_paths number of paths of the frame
+ @param paths array with the links of every path
+ @param len_paths array with the number of links of every path
+ @return identifier of the new frame
+ */
+int append_admitted_frame(long long int period, long long int deadline, int size, long long int end_to_end,
+                          long long int starting, int num_paths, int **paths, int *len_paths) {
+    
+    int frame_id = append_frame();
+    
+    add_frame_information(frame_id, period, deadline, size, end_to_end, starting);
+    add_num_paths(frame_id, num_paths);
+    for (int i = 0; i < num_paths; i++) {
+        add_frame_path(frame_id, i, paths[i], len_paths[i]);
+    }
+    add_num_splits(frame_id, 0);
+    return frame_id;
+}
+
+/**
+ Initializes the network and sets the transmission times of all frames from a compact schedule, without the solver.
+ The offsets that are not in the schedule get -1 as transmission time, and the frame of the protocol is fixed at the
+ start of every protocol period, as the solver does
+
+ @param schedule pointer to the compact schedule
+ */
+void restore_schedule(CompactSchedule *schedule) {
+    
+    Frame *frame_pt;
+    Offset *offset_it;
+    ScheduleRecord *record;
+    long long int transmission;
+    
+    initialize_network();
+    for (int i = 0; i < get_number_frames(); i++) {
+        frame_pt = get_frame(i);
+        offset_it = get_offset_root(frame_pt);
+        while (!is_last_offset(offset_it)) {
+            // The frame of the protocol is not in the schedule, it is always at the start of its period
+            record = NULL;
+            if (i < get_number_network_frames()) {
+                record = get_schedule_record(schedule, i, get_offset_link(offset_it));
+            }
+            for (int instance = 0; instance < get_number_instances(offset_it); instance++) {
+                for (int replica = 0; replica <= get_number_replicas(offset_it); replica++) {
+                    if (i >= get_number_network_frames()) {
+                        transmission = get_period(frame_pt) * instance + 1;
+                    } else if (record != NULL) {
+                        transmission = get_record_transmission(schedule, record, instance, replica);
+                        if (transmission == -1) {
+                            transmission = get_record_transmission(schedule, record, instance, 0);
+                        }
+                    } else {
+                        transmission = -1;
+                    }
+                    set_offset(offset_it, instance, replica, transmission);
+                }
+            }
+            offset_it = get_next_offset(offset_it);
+        }
+    }
+}
+
+/**
+ Sets the transmission times found by the first fit in all the instances and replicas of the new frame
+
+ @param frame_id identifier of the new frame
+ @param result pointer to the result with the links of the frame and the transmission times of the first instance
+ */
+void set_first_fit_offsets(int frame_id, AdmissionResult *result) {
+    
+    Frame *frame_pt = get_frame(frame_id);
+    Offset *offset_pt;
+    
+    for (int i = 0; i < result->num_links; i++) {
+        offset_pt = get_frame_offset_by_link(frame_pt, result->links[i]);
+        for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+            for (int replica = 0; replica <= get_number_replicas(offset_pt); replica++) {
+                set_offset(offset_pt, instance, replica, result->offsets[i] + get_period(frame_pt) * instance);
+            }
+        }
+    }
+}
+
+/**
+ Saves in the result the frames transmitted in the links of the new frame in the previous schedule, up to the limit
+ of the repair stage, together with the new frame
+
+ @param previous pointer to the schedule before the admission
+ @param frame_id identifier of the new frame
+ @param result pointer to the result with the links of the frame
+ */
+void collect_repair_frames(CompactSchedule *previous, int frame_id, AdmissionResult *result) {
+    
+    char *unpinned = calloc(frame_id + 1, sizeof(char));
+    
+    result->unpinned_frames = malloc(sizeof(int) * (admission_repair_limit + 1));
+    for (int i = 0; i < result->num_links; i++) {
+        for (int j = 0; j < previous->num_records && result->num_unpinned < admission_repair_limit; j++) {
+            if (previous->records[j].link == result->links[i] && previous->records[j].frame < frame_id &&
+                !unpinned[previous->records[j].frame]) {
+                unpinned[previous->records[j].frame] = 1;
+                result->unpinned_frames[result->num_unpinned++] = previous->records[j].frame;
+            }
+        }
+    }
+    result->unpinned_frames[result->num_unpinned] = frame_id;
+    free(unpinned);
+}
+
+/**
+ Schedules the network with the new frame, and the given frames, free and the rest pinned to the previous schedule
+
+ @param previous pointer to the schedule before the admission
+ @param movable_frames frames that can change their offsets
+ @param num_movable_frames number of movable frames
+ @param options pointer to the options of the scheduler
+ @param budget time budget of the solver in ms, 0 for no limit
+ @return 0 if the schedule was found, -1 otherwise
+ */
+int schedule_admission(CompactSchedule *previous, int *movable_frames, int num_movable_frames,
+                       SchedulerOptions *options, long long int budget) {
+    
+    SchedulerOptions admission_options = *options;
+    
+    reset_network();
+    admission_options.previous_schedule = NULL;
+    admission_options.previous_compact = previous;
+    admission_options.movable_frames = movable_frames;
+    admission_options.num_movable_frames = num_movable_frames;
+    admission_options.movable_links = NULL;
+    admission_options.num_movable_links = 0;
+    admission_options.time_budget = budget;
+    return schedule_network(&admission_options);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Sets the maximum number of frames that can change their offsets in the repair stage
+ */
+void set_admission_repair_limit(int max_frames) {
+    
+    admission_repair_limit = max_frames > 0 ? max_frames : 0;
+}
+
+/**
+ Admits a new frame into the scheduled network in memory, keeping the offsets of the rest of frames if possible
+ */
+int admit_frame(long long int period, long long int deadline, int size, long long int end_to_end,
+                long long int starting, int num_paths, int **paths, int *len_paths, struct SchedulerOptions *options,
+                AdmissionResult *result) {
+    
+    SchedulerOptions admission_options;
+    CompactSchedule *previous;
+    struct timeval start_time, end_time;
+    long long int remaining;
+    int frame_id, found;
+    
+    gettimeofday(&start_time, NULL);
+    memset(result, 0, sizeof(AdmissionResult));
+    result->frame_id = -1;
+    if (options == NULL) {
+        init_scheduler_options(&admission_options);
+    } else {
+        admission_options = *options;
+    }
+    if (check_admission_request(period, deadline, size, end_to_end, starting, num_paths, paths, len_paths,
+                                result) == -1) {
+        gettimeofday(&end_time, NULL);
+        result->admission_time = time_diff(start_time, end_time);
+        return -1;
+    }
+    
+    // Stage 1, first fit in the free time of the links of the current schedule
+    found = search_first_fit(period, deadline, size, end_to_end, starting, num_paths, paths, len_paths, result);
+    previous = build_compact_schedule();
+    reset_network();
+    frame_id = append_admitted_frame(period, deadline, size, end_to_end, starting, num_paths, paths, len_paths);
+    if (found == 0) {
+        restore_schedule(previous);
+        set_first_fit_offsets(frame_id, result);
+        if (!admission_options.check_schedule || validate_schedule(admission_options.num_threads) == 0) {
+            result->stage = admission_first_fit;
+        }
+    }
+    
+    // Stage 2, only the new frame is searched by the solver
+    remaining = get_remaining_budget(&admission_options, start_time);
+    if (result->stage == admission_rejected && remaining != -1 &&
+        schedule_admission(previous, &frame_id, 1, &admission_options, remaining) == 0) {
+        result->stage = admission_solver;
+    }
+    
+    // Stage 3, the frames that share links with the new frame are also searched
+    remaining = get_remaining_budget(&admission_options, start_time);
+    if (result->stage == admission_rejected && remaining != -1 && admission_repair_limit > 0) {
+        collect_repair_frames(previous, frame_id, result);
+        if (schedule_admission(previous, result->unpinned_frames, result->num_unpinned + 1, &admission_options,
+                               remaining) == 0) {
+            result->stage = admission_repair;
+        }
+    }
+    
+    if (result->stage == admission_rejected) {
+        // The network goes back to the schedule before the request
+        reset_network();
+        remove_last_frame();
+        restore_schedule(previous);
+        if (get_remaining_budget(&admission_options, start_time) == -1) {
+            snprintf(result->reason, ADMISSION_REASON_SIZE, "the time budget ended before the frame was placed");
+        } else {
+            snprintf(result->reason, ADMISSION_REASON_SIZE, "no schedule found unpinning %d frames",
+                     result->num_unpinned);
+        }
+    } else {
+        result->frame_id = frame_id;
+        for (int i = 0; i < result->num_links; i++) {
+            result->offsets[i] = get_offset(get_frame_offset_by_link(get_frame(frame_id), result->links[i]), 0, 0);
+        }
+    }
+    free_compact_schedule(previous);
+    
+    gettimeofday(&end_time, NULL);
+    result->admission_time = time_diff(start_time, end_time);
+    return result->stage == admission_rejected ? -1 : 0;
+}
+
+/**
+ Get the name of an admission stage
+ */
+const char * get_admission_stage_name(AdmissionStage stage) {
+    
+    switch (stage) {
+        case admission_first_fit:
+            return "first_fit";
+        case admission_solver:
+            return "solver";
+        case admission_repair:
+            return "repair";
+        default:
+            return "rejected";
+    }
+}
+
+/**
+ Frees the arrays of an admission result
+ */
+void free_admission_result(AdmissionResult *result) {
+    
+    free(result->links);
+    free(result->offsets);
+    free(result->unpinned_frames);
+    result->links = NULL;
+    result->offsets = NULL;
+    result->unpinned_frames = NULL;
+    result->num_links = 0;
+    result->num_unpinned = 0;
+}
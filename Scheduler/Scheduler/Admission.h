@@ -0,0 +1,106 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Admission.h                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that admits a new frame into the scheduled network in memory without scheduling it again from scratch.     *
+ *  The request is rejected at once if its parameters are not valid, its period does not divide the hyperperiod, a     *
+ *  link of its paths does not exist or has failed, or a link has not enough free time left for it. Otherwise the      *
+ *  frame is placed in three stages, each one tried only if the previous one fails and there is time budget left:      *
+ *      1. First fit: the busy time of every link of the frame is folded into one period of the frame, and the first   *
+ *         free transmission times that satisfy its path dependency and end to end delay are taken, without solver.    *
+ *      2. Solver: only the offsets of the new frame are searched, the rest of frames are pinned to their offsets.     *
+ *      3. Repair: the frames transmitted in the links of the new frame (up to a limit) are also unpinned.             *
+ *  If the frame is not admitted, the network is left with the schedule it had before the request.                     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Admission_h
+#define Admission_h
+
+#include <stdio.h>
+
+#endif /* Admission_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define ADMISSION_REASON_SIZE 128
+#define ADMISSION_REPAIR_FRAMES 32      // Frames unpinned by default in the repair stage
+#define ADMISSION_FIRST_FIT_ATTEMPTS 1024   // Maximum starting times tried by the first fit
+
+struct SchedulerOptions;                // Options of the scheduler, defined in Synthesizer.h
+
+/**
+ Stage that admitted the frame
+ */
+typedef enum AdmissionStage {
+    admission_rejected,                 // The frame was not admitted
+    admission_first_fit,                // Placed in the free time of its links, without the solver
+    admission_solver,                   // Placed by the solver with the rest of frames pinned
+    admission_repair                    // Placed by the solver with the frames that share its links unpinned
+}AdmissionStage;
+
+/**
+ Result of a request to admit a new frame
+ */
+typedef struct AdmissionResult {
+    int frame_id;                       // Identifier of the new frame, -1 if it was not admitted
+    AdmissionStage stage;               // Stage that admitted the frame
+    char reason[ADMISSION_REASON_SIZE]; // Reason why the frame was rejected, empty if admitted
+    int num_links;                      // Number of links where the new frame is transmitted
+    int *links;                         // Identifiers of the links of the new frame
+    long long int *offsets;             // Transmission time of the first instance of the new frame in every link
+    int num_unpinned;                   // Number of frames that could change their offsets in the repair stage
+    int *unpinned_frames;               // Identifiers of the frames unpinned in the repair stage
+    double admission_time;              // Time in ms from the request until the frame is admitted or rejected
+}AdmissionResult;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Sets the maximum number of frames that share links with the new frame that can change their offsets in the repair
+ stage, ADMISSION_REPAIR_FRAMES if not set. 0 disables the repair stage
+
+ @param max_frames maximum number of frames unpinned
+ */
+void set_admission_repair_limit(int max_frames);
+
+/**
+ Admits a new frame into the scheduled network in memory (initialized and with the offsets of all frames), keeping the
+ offsets of the rest of frames unless they have to be repaired. The new frame is added after the last frame
+
+ @param period period of the frame in ns, it has to divide the hyperperiod
+ @param deadline deadline of the frame in ns
+ @param size size of the frame in bytes
+ @param end_to_end maximum end to end delay of the frame in ns
+ @param starting starting time of the frame in ns
+ @param num_paths number of paths of the frame
+ @param paths array with the links of every path, from the sender to the receiver
+ @param len_paths array with the number of links of every path
+ @param options pointer to the options of the scheduler, NULL to use the default ones. The time budget is the latency
+ budget of the whole admission, and the previous schedule and movable frames are replaced
+ @param result pointer where the new frame, its offsets or the reason of the rejection are saved. It has to be freed
+ with free_admission_result
+ @return 0 if the frame was admitted, -1 otherwise
+ */
+int admit_frame(long long int period, long long int deadline, int size, long long int end_to_end,
+                long long int starting, int num_paths, int **paths, int *len_paths, struct SchedulerOptions *options,
+                AdmissionResult *result);
+
+/**
+ Get the name of an admission stage
+
+ @param stage stage of the admission
+ @return name of the stage
+ */
+const char * get_admission_stage_name(AdmissionStage stage);
+
+/**
+ Frees the arrays of an admission result
+
+ @param result pointer to the result
+ */
+void free_admission_result(AdmissionResult *result);
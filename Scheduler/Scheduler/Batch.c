@@ -0,0 +1,424 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Batch.c                                                                                                            *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Batch.h                                                                                             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Batch.h"
+#include "Network.h"
+#include "Metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Work shared by the worker processes, it is mapped in shared memory followed by the entries
+ */
+typedef struct BatchWork {
+    int next_entry;                     // Next network to schedule, taken atomically by the workers
+    int num_entries;                    // Number of networks
+    BatchEntry entries[];               // Networks of the batch
+}BatchWork;
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Appends a network to the list of networks of the batch, with the given schedule path or the default one
+
+ @param entries pointer to the array of entries, it is reallocated when full
+ @param num_entries pointer to the number of entries
+ @param max_entries pointer to the number of entries that fit in the array
+ @param network path of the network file
+ @param schedule path of the schedule file, NULL to use the default one
+ @param output_directory directory of the default schedule, NULL to use the directory of the network
+ @return 0 if added, -1 if the paths are too long
+ */
+int add_batch_entry(BatchEntry **entries, int *num_entries, int *max_entries, const char *network,
+                    const char *schedule, const char *output_directory) {
+    
+    BatchEntry *entry;
+    const char *name, *extension;
+    int length;
+    
+    if (*num_entries == *max_entries) {
+        *max_entries = *max_entries * 2 + 16;
+        *entries = realloc(*entries, sizeof(BatchEntry) * (*max_entries));
+    }
+    entry = &(*entries)[*num_entries];
+    memset(entry, 0, sizeof(BatchEntry));
+    if (strlen(network) >= BATCH_PATH_SIZE) {
+        printf("The path of the network %s is too long\n", network);
+        return -1;
+    }
+    strcpy(entry->network, network);
+    
+    if (schedule != NULL) {
+        length = snprintf(entry->schedule, BATCH_PATH_SIZE, "%s", schedule);
+    } else {
+        // Name of the network without directory nor extension, in the output directory
+        name = strrchr(network, '/') != NULL ? strrchr(network, '/') + 1 : network;
+        extension = strrchr(name, '.');
+        if (extension == NULL) {
+            extension = name + strlen(name);
+        }
+        if (output_directory != NULL) {
+            length = snprintf(entry->schedule, BATCH_PATH_SIZE, "%s/%.*s%s", output_directory,
+                              (int) (extension - name), name, BATCH_SCHEDULE_SUFFIX);
+        } else {
+            length = snprintf(entry->schedule, BATCH_PATH_SIZE, "%.*s%s", (int) (extension - network), network,
+                              BATCH_SCHEDULE_SUFFIX);
+        }
+    }
+    if (length >= BATCH_PATH_SIZE) {
+        printf("The path of the schedule of the network %s is too long\n", network);
+        return -1;
+    }
+    *num_entries += 1;
+    return 0;
+}
+
+/**
+ Reads the networks of a manifest file, one per line optionally followed by the path of the schedule
+
+ @param namefile path of the manifest file
+ @param entries pointer to the array of entries
+ @param num_entries pointer to the number of entries
+ @param output_directory directory of the default schedules, NULL to use the directory of the networks
+ @return 0 if correct, -1 otherwise
+ */
+int read_batch_manifest(char *namefile, BatchEntry **entries, int *num_entries, const char *output_directory) {
+    
+    FILE *file;
+    char line[2 * BATCH_PATH_SIZE + 16];
+    char network[BATCH_PATH_SIZE], schedule[BATCH_PATH_SIZE];
+    int max_entries = 0, fields, status = 0;
+    
+    file = fopen(namefile, "r");
+    if (file == NULL) {
+        printf("The batch manifest does not exist\n");
+        return -1;
+    }
+    while (status == 0 && fgets(line, sizeof(line), file) != NULL) {
+        fields = sscanf(line, "%1023s %1023s", network, schedule);
+        if (fields <= 0 || network[0] == '#') {
+            continue;
+        }
+        status = add_batch_entry(entries, num_entries, &max_entries, network, fields == 2 ? schedule : NULL,
+                                 output_directory);
+    }
+    fclose(file);
+    return status;
+}
+
+/**
+ Compares two entries of the batch by the path of their network
+
+ @param a pointer to the first entry
+ @param b pointer to the second entry
+ @return negative, 0 or positive if the first path is smaller, equal or bigger
+ */
+int compare_batch_entries(const void *a, const void *b) {
+    
+    return strcmp(((const BatchEntry*) a)->network, ((const BatchEntry*) b)->network);
+}
+
+/**
+ Reads the network files of a directory, the .xml and .srsn files that are not schedules of a previous batch
+
+ @param directory path of the directory
+ @param entries pointer to the array of entries
+ @param num_entries pointer to the number of entries
+ @param output_directory directory of the schedules, NULL to write them in the same directory
+ @return 0 if correct, -1 otherwise
+ */
+int read_batch_directory(char *directory, BatchEntry **entries, int *num_entries, const char *output_directory) {
+    
+    DIR *dir;
+    struct dirent *file;
+    char network[BATCH_PATH_SIZE];
+    const char *extension;
+    size_t length;
+    int max_entries = 0, status = 0;
+    
+    dir = opendir(directory);
+    if (dir == NULL) {
+        printf("The batch directory could not be opened\n");
+        return -1;
+    }
+    while (status == 0 && (file = readdir(dir)) != NULL) {
+        extension = strrchr(file->d_name, '.');
+        length = strlen(file->d_name);
+        if (extension == NULL || (strcmp(extension, ".xml") != 0 && strcmp(extension, ".srsn") != 0)) {
+            continue;
+        }
+        if (length >= strlen(BATCH_SCHEDULE_SUFFIX) &&
+            strcmp(file->d_name + length - strlen(BATCH_SCHEDULE_SUFFIX), BATCH_SCHEDULE_SUFFIX) == 0) {
+            continue;
+        }
+        if (snprintf(network, BATCH_PATH_SIZE, "%s/%s", directory, file->d_name) >= BATCH_PATH_SIZE) {
+            printf("The path of the network %s is too long\n", file->d_name);
+            status = -1;
+            continue;
+        }
+        status = add_batch_entry(entries, num_entries, &max_entries, network, NULL, output_directory);
+    }
+    closedir(dir);
+    
+    // Always schedule the networks in the same order
+    qsort(*entries, *num_entries, sizeof(BatchEntry), compare_batch_entries);
+    return status;
+}
+
+/**
+ Schedules one network of the batch in the worker process, the output of the library is written in the log file of
+ the network. The network is running until its outcome is written at the end, so if the worker dies it is crashed
+
+ @param entry pointer to the entry in shared memory
+ @param options pointer to the options of the scheduler
+ */
+void schedule_batch_entry(BatchEntry *entry, SchedulerOptions *options) {
+    
+    struct timeval start_time, end_time;
+    char log[BATCH_PATH_SIZE + 8];
+    FILE *log_file;
+    BatchState state = batch_failed;    // Outcome of the network
+    
+    gettimeofday(&start_time, NULL);
+    fflush(stdout);
+    snprintf(log, sizeof(log), "%s.log", entry->schedule);
+    log_file = freopen(log, "w", stdout);
+    
+    if (srs_load_network(entry->network) != -1) {
+        entry->frames = get_number_frames();        // The frame of the protocol is added when scheduling
+        entry->links = get_number_links();
+        entry->parse_time = get_phase_time(phase_parse);
+        if (srs_schedule(options) != -1 && srs_write_schedule(entry->schedule) != -1) {
+            state = batch_scheduled;
+        }
+        entry->solve_time = get_phase_time(phase_solve);
+    }
+    srs_free_network();
+    
+    gettimeofday(&end_time, NULL);
+    entry->total_time = time_diff(start_time, end_time);
+    if (log_file != NULL) {
+        printf("Total time in ms => %f\n", entry->total_time);
+        fflush(stdout);
+    }
+    entry->state = state;
+}
+
+/**
+ Worker process, takes networks from the shared work until there are no more networks and exits
+
+ @param work pointer to the shared work
+ @param options pointer to the options of the scheduler
+ */
+void batch_worker(BatchWork *work, SchedulerOptions *options) {
+    
+    int entry;
+    
+    entry = __sync_fetch_and_add(&work->next_entry, 1);
+    while (entry < work->num_entries) {
+        work->entries[entry].worker = getpid();
+        work->entries[entry].state = batch_running;
+        schedule_batch_entry(&work->entries[entry], options);
+        entry = __sync_fetch_and_add(&work->next_entry, 1);
+    }
+    _exit(0);
+}
+
+/**
+ Starts a new worker process
+
+ @param work pointer to the shared work
+ @param options pointer to the options of the scheduler
+ @return process identifier of the worker, -1 if it could not be started
+ */
+pid_t start_batch_worker(BatchWork *work, SchedulerOptions *options) {
+    
+    pid_t worker;
+    
+    fflush(stdout);
+    worker = fork();
+    if (worker == 0) {
+        batch_worker(work, options);
+    }
+    return worker;
+}
+
+/**
+ Get the name of the state of a network of the batch
+
+ @param state state of the network
+ @return name of the state
+ */
+const char * get_batch_state_name(BatchState state) {
+    
+    switch (state) {
+        case batch_scheduled:
+            return "scheduled";
+        case batch_failed:
+            return "failed";
+        case batch_crashed:
+            return "crashed";
+        case batch_running:
+            return "running";
+        default:
+            return "pending";
+    }
+}
+
+/**
+ Writes the summary table of the batch
+
+ @param file file where to write the table
+ @param work pointer to the shared work
+ @param total_time time of the whole batch in ms
+ @param num_workers number of workers used
+ */
+void write_batch_summary(FILE *file, BatchWork *work, double total_time, int num_workers) {
+    
+    BatchEntry *entry;
+    int scheduled = 0;
+    
+    fprintf(file, "%-48s %-10s %8s %6s %12s %12s %12s\n", "Network", "Outcome", "Frames", "Links", "Parse ms",
+            "Solve ms", "Total ms");
+    for (int i = 0; i < work->num_entries; i++) {
+        entry = &work->entries[i];
+        fprintf(file, "%-48s %-10s %8d %6d %12.3f %12.3f %12.3f\n", entry->network, get_batch_state_name(entry->state),
+                entry->frames, entry->links, entry->parse_time, entry->solve_time, entry->total_time);
+        if (entry->state == batch_scheduled) {
+            scheduled++;
+        }
+    }
+    fprintf(file, "Scheduled %d of %d networks with %d workers in ms => %f\n", scheduled, work->num_entries,
+            num_workers, total_time);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Schedules all the networks of a manifest file or a directory in worker processes, and prints the summary table
+ */
+int schedule_batch(char *input, char *output_directory, int num_workers, SchedulerOptions *options,
+                   char *summary_file) {
+    
+    SchedulerOptions batch_options;     // Options used by the workers
+    BatchEntry *entries = NULL;
+    BatchWork *work;
+    struct stat input_stat;
+    struct timeval start_time, end_time;
+    size_t work_size;
+    pid_t *workers, worker;
+    int num_entries = 0, status, failed = 0, running = 0;
+    FILE *summary;
+    
+    if (options == NULL) {
+        init_scheduler_options(&batch_options);
+    } else {
+        batch_options = *options;
+    }
+    if (batch_options.num_threads == 0) {
+        batch_options.num_threads = 1;
+    }
+    
+    // Read the networks of the batch
+    if (stat(input, &input_stat) == -1) {
+        printf("The batch input does not exist\n");
+        return -1;
+    }
+    if (S_ISDIR(input_stat.st_mode)) {
+        status = read_batch_directory(input, &entries, &num_entries, output_directory);
+    } else {
+        status = read_batch_manifest(input, &entries, &num_entries, output_directory);
+    }
+    if (status == -1 || num_entries == 0) {
+        printf("There are no networks to schedule in the batch\n");
+        free(entries);
+        return -1;
+    }
+    
+    // The entries are shared with the workers, that save there the outcome of every network
+    work_size = sizeof(BatchWork) + sizeof(BatchEntry) * num_entries;
+    work = mmap(NULL, work_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (work == MAP_FAILED) {
+        printf("The shared memory of the batch could not be created\n");
+        free(entries);
+        return -1;
+    }
+    work->next_entry = 0;
+    work->num_entries = num_entries;
+    memcpy(work->entries, entries, sizeof(BatchEntry) * num_entries);
+    free(entries);
+    
+    if (num_workers <= 0) {
+        num_workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_workers > num_entries) {
+        num_workers = num_entries;
+    }
+    if (num_workers <= 0) {
+        num_workers = 1;
+    }
+    
+    // Start the workers, and replace the ones that crash while there are networks left
+    gettimeofday(&start_time, NULL);
+    workers = malloc(sizeof(pid_t) * num_workers);
+    for (int i = 0; i < num_workers; i++) {
+        workers[i] = start_batch_worker(work, &batch_options);
+        if (workers[i] != -1) {
+            running++;
+        }
+    }
+    while (running > 0 && (worker = wait(&status)) != -1) {
+        running--;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            continue;
+        }
+        // Only the network of the worker that died crashed, the rest of workers are still scheduling theirs
+        for (int i = 0; i < num_entries; i++) {
+            if (work->entries[i].state == batch_running && work->entries[i].worker == worker) {
+                work->entries[i].state = batch_crashed;
+            }
+        }
+        if (work->next_entry < num_entries && start_batch_worker(work, &batch_options) != -1) {
+            running++;
+        }
+    }
+    gettimeofday(&end_time, NULL);
+    
+    // Networks not scheduled, including the ones that no worker could take
+    for (int i = 0; i < num_entries; i++) {
+        if (work->entries[i].state != batch_scheduled) {
+            failed++;
+        }
+    }
+    write_batch_summary(stdout, work, time_diff(start_time, end_time), num_workers);
+    if (summary_file != NULL) {
+        summary = fopen(summary_file, "w");
+        if (summary != NULL) {
+            write_batch_summary(summary, work, time_diff(start_time, end_time), num_workers);
+            fclose(summary);
+        } else {
+            printf("The summary file could not be created\n");
+        }
+    }
+    
+    free(workers);
+    munmap(work, work_size);
+    return failed;
+}
@@ -0,0 +1,80 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Batch.h                                                                                                            *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that schedules many networks in one call, given as a manifest file or as a directory of network files. The *
+ *  library keeps one network, one solver context and one validation in global memory, shared with the threads that    *
+ *  validate and write the schedule, and the terms of yices2 are global too. For that reason the networks are          *
+ *  scheduled by worker processes forked from the calling process once the solver and xml libraries are initialized,   *
+ *  so there is no program startup nor initialization per network. Every worker takes the next network from a counter  *
+ *  in shared memory (as the threads of the validator do) until there are no networks left, and saves its outcome and  *
+ *  timings in shared memory. If a worker crashes, its network is reported as crashed and a new worker is started. The *
+ *  output of every network is written in a log file next to its schedule, and a summary table is printed.             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Batch_h
+#define Batch_h
+
+#include <stdio.h>
+#include <sys/types.h>
+#include "SelfRegeneratingScheduler.h"
+
+#endif /* Batch_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define BATCH_PATH_SIZE 1024
+#define BATCH_SCHEDULE_SUFFIX "-schedule.xml"
+
+/**
+ State of a network of the batch
+ */
+typedef enum BatchState {
+    batch_pending,                      // Not taken by any worker yet
+    batch_running,                      // Being scheduled by a worker
+    batch_scheduled,                    // Schedule found and written
+    batch_failed,                       // No schedule found or it could not be read or written
+    batch_crashed                       // The worker crashed while scheduling it
+}BatchState;
+
+/**
+ Network of the batch with its outcome and timings
+ */
+typedef struct BatchEntry {
+    char network[BATCH_PATH_SIZE];      // Path of the network file
+    char schedule[BATCH_PATH_SIZE];     // Path of the schedule file to write
+    BatchState state;
+    pid_t worker;                       // Worker process that takes the network, it is running until it ends
+    int frames;                         // Number of frames of the network
+    int links;                          // Number of links of the network
+    double parse_time;                  // Time to read the network in ms
+    double solve_time;                  // Time of the solver in ms
+    double total_time;                  // Time to read, schedule and write the network in ms
+}BatchEntry;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Schedules all the networks of a manifest file or a directory.
+ A manifest has one network per line, optionally followed by the path of its schedule, empty lines and lines that
+ start with '#' are skipped. In a directory, all the .xml and .srsn files are scheduled (except the schedules written
+ by a previous batch). When no schedule path is given, the schedule is written in the output directory (or next to
+ the network) with the name of the network and the suffix -schedule.xml. The format of the schedule is given by its
+ extension (see srs_write_schedule). srs_init has to be called before, and there cannot be a network in memory
+
+ @param input path of the manifest file or the directory
+ @param output_directory directory where the schedules are written if not given in the manifest, NULL to write them
+ next to the networks
+ @param num_workers number of networks scheduled at the same time, 0 to use one per available processor
+ @param options pointer to the options of the scheduler for all networks, NULL to use the default ones. If the number
+ of threads is 0, every network uses one thread, as the networks are already scheduled in parallel
+ @param summary_file path of a file where the summary table is also written, NULL to only print it
+ @return number of networks that were not scheduled, -1 if the batch could not be started
+ */
+int schedule_batch(char *input, char *output_directory, int num_workers, SchedulerOptions *options,
+                   char *summary_file);
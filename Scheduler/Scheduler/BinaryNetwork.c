@@ -0,0 +1,476 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  BinaryNetwork.c                                                                                                    *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in BinaryNetwork.h                                                                                     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "BinaryNetwork.h"
+#include "Topology.h"
+#include <string.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+                                                    /* VARIABLES */
+
+uint32_t crc32_table[8][256];           // Tables to compute the CRC32 checksum eight bytes at a time
+int crc32_table_ready = 0;              // 1 if the CRC32 tables have been computed
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Computes the size that a binary network file with the number of elements of the given header must have
+
+ @param header pointer to the header of the file
+ @return size of the file in bytes
+ */
+uint64_t get_binary_network_size(const BinaryNetworkHeader *header) {
+    
+    return sizeof(BinaryNetworkHeader) + sizeof(BinaryLink) * (uint64_t) header->number_links +
+           sizeof(BinaryFrame) * (uint64_t) header->number_frames + sizeof(uint32_t) * (header->number_paths + 1) +
+           sizeof(int32_t) * header->number_path_links + sizeof(uint32_t) * (header->number_splits + 1) +
+           sizeof(int32_t) * header->number_split_links + sizeof(int32_t) * (uint64_t) header->number_nodes +
+           sizeof(uint32_t) * ((uint64_t) header->number_nodes + 1) + sizeof(int32_t) * header->number_connections;
+}
+
+/**
+ Checks that the compressed rows of the paths (or splits) are consistent with the records of the file
+
+ @param starts array with the index where every path starts
+ @param num_lists number of paths
+ @param links array with the links of all paths
+ @param num_links number of links in all paths
+ @param number_links number of links in the network
+ @return 0 if correct, -1 otherwise
+ */
+int check_binary_lists(const uint32_t *starts, uint64_t num_lists, const int32_t *links, uint64_t num_links,
+                       uint32_t number_links) {
+    
+    if (starts[0] != 0 || starts[num_lists] != num_links) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < num_lists; i++) {
+        if (starts[i] > starts[i + 1]) {
+            return -1;
+        }
+    }
+    for (uint64_t i = 0; i < num_links; i++) {
+        if (links[i] < 0 || (uint32_t) links[i] >= number_links) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Writes a block of data into the file and adds it to the checksum
+
+ @param file pointer to the file
+ @param data pointer to the data
+ @param size size of the data in bytes
+ @param crc pointer to the checksum to update
+ @return 0 if correctly written, -1 otherwise
+ */
+int write_binary_block(FILE *file, const void *data, size_t size, uint32_t *crc) {
+    
+    if (size > 0 && fwrite(data, size, 1, file) != 1) {
+        return -1;
+    }
+    *crc = update_crc32(*crc, data, size);
+    return 0;
+}
+
+/**
+ Get the number of links of a path of a frame
+
+ @param frame_pt pointer to the frame
+ @param path_id identifier of the path
+ @return number of links in the path
+ */
+int get_path_length(Frame *frame_pt, int path_id) {
+    
+    int length = 0;
+    
+    for (Path *path_pt = get_path_root(frame_pt, path_id); !is_last_path(path_pt); path_pt = get_next_path(path_pt)) {
+        length++;
+    }
+    return length;
+}
+
+/**
+ Get the number of links of a split of a frame
+
+ @param frame_pt pointer to the frame
+ @param split_id identifier of the split
+ @return number of links in the split
+ */
+int get_split_length(Frame *frame_pt, int split_id) {
+    
+    int length = 0;
+    
+    for (Split *split_pt = &frame_pt->split_array_ls[split_id]; split_pt->next_split_pt != NULL;
+         split_pt = split_pt->next_split_pt) {
+        length++;
+    }
+    return length;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Updates the given CRC32 checksum with a block of data
+ */
+uint32_t update_crc32(uint32_t crc, const void *data, size_t size) {
+    
+    const unsigned char *byte = data;
+    uint32_t value;
+    
+    // Compute the table of the reflected polynomial the first time, and from it the tables of the next seven bytes
+    if (!crc32_table_ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            value = i;
+            for (int j = 0; j < 8; j++) {
+                value = (value & 1) ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+            }
+            crc32_table[0][i] = value;
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int i = 0; i < 256; i++) {
+                crc32_table[k][i] = (crc32_table[k - 1][i] >> 8) ^ crc32_table[0][crc32_table[k - 1][i] & 0xFF];
+            }
+        }
+        crc32_table_ready = 1;
+    }
+    
+    crc = ~crc;
+    for (; size >= 8; size -= 8, byte += 8) {
+        crc ^= (uint32_t) byte[0] | (uint32_t) byte[1] << 8 | (uint32_t) byte[2] << 16 | (uint32_t) byte[3] << 24;
+        crc = crc32_table[7][crc & 0xFF] ^ crc32_table[6][(crc >> 8) & 0xFF] ^ crc32_table[5][(crc >> 16) & 0xFF] ^
+              crc32_table[4][crc >> 24] ^ crc32_table[3][byte[4]] ^ crc32_table[2][byte[5]] ^
+              crc32_table[1][byte[6]] ^ crc32_table[0][byte[7]];
+    }
+    for (size_t i = 0; i < size; i++) {
+        crc = crc32_table[0][(crc ^ byte[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ Tells if the given file is a binary network file by reading its magic
+ */
+int is_network_binary(char *namefile) {
+    
+    FILE *file;
+    char magic[4];
+    int found = 0;
+    
+    file = fopen(namefile, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    if (fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, BINARY_NETWORK_MAGIC, sizeof(magic)) == 0) {
+        found = 1;
+    }
+    fclose(file);
+    return found;
+}
+
+/**
+ Maps the given binary network file into memory and builds the network from its records.
+ The version and checksum of the file are verified before building anything
+ */
+int read_network_binary(char *namefile) {
+    
+    int fd;
+    struct stat file_stat;
+    struct timeval start_time, end_time;
+    unsigned char *data;                // File mapped in memory
+    const BinaryNetworkHeader *header;
+    const BinaryLink *link_records;
+    const BinaryFrame *frame_records;
+    const uint32_t *path_starts, *split_starts, *connection_starts;
+    const int32_t *path_links, *split_links, *node_categories, *connection_links;
+    uint32_t crc;
+    int status = -1;
+    
+    // Map the file into memory
+    gettimeofday(&start_time, NULL);
+    fd = open(namefile, O_RDONLY);
+    if (fd == -1 || fstat(fd, &file_stat) == -1 || file_stat.st_size < (off_t) sizeof(BinaryNetworkHeader)) {
+        fprintf(stderr, "The binary network file does not exist or it is too small\n");
+        if (fd != -1) {
+            close(fd);
+        }
+        return -1;
+    }
+    data = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "The binary network file could not be mapped into memory\n");
+        return -1;
+    }
+    
+    // Check the header and the checksum before using any record
+    header = (const BinaryNetworkHeader*) data;
+    if (memcmp(header->magic, BINARY_NETWORK_MAGIC, sizeof(header->magic)) != 0) {
+        printf("The file is not a binary network file\n");
+    } else if (header->version != BINARY_NETWORK_VERSION) {
+        printf("The version %u of the binary network file is not supported\n", header->version);
+    } else if (get_binary_network_size(header) != (uint64_t) file_stat.st_size) {
+        printf("The binary network file is truncated or wrongly constructed\n");
+    } else if (header->number_frames == 0 || header->number_links == 0 || header->hyper_period <= 0) {
+        printf("The binary network file needs at least one frame, one link and a hyperperiod\n");
+    } else {
+        crc = update_crc32(0, &header->number_frames,
+                           file_stat.st_size - offsetof(BinaryNetworkHeader, number_frames));
+        if (crc != header->checksum) {
+            printf("The checksum of the binary network file is not correct\n");
+        } else {
+            status = 0;
+        }
+    }
+    
+    // Locate the sections of the file
+    link_records = (const BinaryLink*) (data + sizeof(BinaryNetworkHeader));
+    frame_records = (const BinaryFrame*) (link_records + header->number_links);
+    path_starts = (const uint32_t*) (frame_records + header->number_frames);
+    path_links = (const int32_t*) (path_starts + header->number_paths + 1);
+    split_starts = (const uint32_t*) (path_links + header->number_path_links);
+    split_links = (const int32_t*) (split_starts + header->number_splits + 1);
+    node_categories = split_links + header->number_split_links;
+    connection_starts = (const uint32_t*) (node_categories + header->number_nodes);
+    connection_links = (const int32_t*) (connection_starts + header->number_nodes + 1);
+    
+    if (status == 0 && (check_binary_lists(path_starts, header->number_paths, path_links, header->number_path_links,
+                                           header->number_links) == -1 ||
+                        check_binary_lists(split_starts, header->number_splits, split_links,
+                                           header->number_split_links, header->number_links) == -1 ||
+                        check_binary_lists(connection_starts, header->number_nodes, connection_links,
+                                           header->number_connections, header->number_links) == -1)) {
+        printf("The paths, splits or nodes of the binary network file are wrongly constructed\n");
+        status = -1;
+    }
+    for (uint32_t i = 0; status == 0 && i < header->number_frames; i++) {
+        if ((uint64_t) frame_records[i].first_path + frame_records[i].num_paths > header->number_paths ||
+            (uint64_t) frame_records[i].first_split + frame_records[i].num_splits > header->number_splits) {
+            printf("The frame %u of the binary network file is wrongly constructed\n", i);
+            status = -1;
+        }
+    }
+    for (uint32_t i = 0; status == 0 && i < header->number_nodes; i++) {
+        if (node_categories[i] < unknown_node || node_categories[i] > end_system_node) {
+            printf("The node %u of the binary network file has an unknown category\n", i);
+            status = -1;
+        }
+    }
+    if (status == -1) {
+        munmap(data, file_stat.st_size);
+        return -1;
+    }
+    
+    // Build the network directly from the records, the links of the paths are given in place to the network
+    set_number_frames(header->number_frames);
+    set_number_links(header->number_links);
+    set_hop_delay(header->hop_delay);
+    set_hyper_period(header->hyper_period);
+    set_protocol_parameters(header->protocol_period, header->protocol_time);
+    set_time_between_frames(header->time_between_frames);
+    for (uint32_t i = 0; i < header->number_links; i++) {
+        add_link(i, link_records[i].speed, (LinkType) link_records[i].type);
+        add_link_nodes(i, link_records[i].source, link_records[i].destination);
+    }
+    for (uint32_t i = 0; i < header->number_frames; i++) {
+        const BinaryFrame *record = &frame_records[i];
+        add_frame_information(i, record->period, record->deadline, record->size, record->end_to_end_delay,
+                              record->starting);
+        add_num_paths(i, record->num_paths);
+        for (uint32_t j = 0; j < record->num_paths; j++) {
+            uint32_t path = record->first_path + j;
+            add_frame_path(i, j, (int*) &path_links[path_starts[path]], path_starts[path + 1] - path_starts[path]);
+        }
+        add_num_splits(i, record->num_splits);
+        for (uint32_t j = 0; j < record->num_splits; j++) {
+            uint32_t split = record->first_split + j;
+            add_frame_split(i, j, (int*) &split_links[split_starts[split]],
+                            split_starts[split + 1] - split_starts[split]);
+        }
+    }
+    for (uint32_t i = 0; i < header->number_nodes; i++) {
+        add_node((NodeCategory) node_categories[i], connection_starts[i + 1] - connection_starts[i],
+                 (int*) &connection_links[connection_starts[i]]);
+    }
+    munmap(data, file_stat.st_size);
+    
+    gettimeofday(&end_time, NULL);
+    printf("Time to read the binary network in ms => %f\n",
+           (double) (end_time.tv_sec - start_time.tv_sec) * 1000 +
+           (double) (end_time.tv_usec - start_time.tv_usec) / 1000);
+    
+    return 0;
+}
+
+/**
+ Writes the network in memory into a binary network file. It has to be called before the network is initialized for
+ the scheduling, as the frame of the protocol is not part of the network description
+ */
+int write_network_binary(char *namefile) {
+    
+    FILE *file;
+    BinaryNetworkHeader header;
+    BinaryLink link_record;
+    BinaryFrame frame_record;
+    Frame *frame_pt;
+    uint32_t crc, start, first_path, first_split;
+    int32_t link, category;
+    int status = 0;
+    
+    // Count the paths and splits of all the frames to fill the header
+    memset(&header, 0, sizeof(BinaryNetworkHeader));
+    memcpy(header.magic, BINARY_NETWORK_MAGIC, sizeof(header.magic));
+    header.version = BINARY_NETWORK_VERSION;
+    header.number_frames = get_number_network_frames();
+    header.number_links = get_number_links();
+    header.number_nodes = get_number_described_nodes();
+    header.hop_delay = get_hop_delay();
+    header.hyper_period = get_hyper_period();
+    header.protocol_period = get_protocol_period();
+    header.protocol_time = get_protocol_time();
+    header.time_between_frames = get_time_between_frames();
+    for (int i = 0; i < get_number_network_frames(); i++) {
+        frame_pt = get_frame(i);
+        header.number_paths += get_num_paths(frame_pt);
+        header.number_splits += frame_pt->num_splits;
+        for (int j = 0; j < get_num_paths(frame_pt); j++) {
+            header.number_path_links += get_path_length(frame_pt, j);
+        }
+        for (int j = 0; j < frame_pt->num_splits; j++) {
+            header.number_split_links += get_split_length(frame_pt, j);
+        }
+    }
+    
+    for (int i = 0; i < get_number_described_nodes(); i++) {
+        header.number_connections += get_node_number_connections(i);
+    }
+    
+    file = fopen(namefile, "wb");
+    if (file == NULL) {
+        printf("The binary network file could not be created\n");
+        return -1;
+    }
+    
+    // Write the header without checksum, it is written again at the end when the checksum is known
+    if (fwrite(&header, sizeof(BinaryNetworkHeader), 1, file) != 1) {
+        status = -1;
+    }
+    crc = update_crc32(0, &header.number_frames, sizeof(BinaryNetworkHeader) -
+                       offsetof(BinaryNetworkHeader, number_frames));
+    
+    // Link records
+    for (int i = 0; i < get_number_links(); i++) {
+        memset(&link_record, 0, sizeof(BinaryLink));
+        link_record.speed = get_link_speed(get_link(i));
+        link_record.type = get_link_type(get_link(i));
+        link_record.source = get_link_source(get_link(i));
+        link_record.destination = get_link_destination(get_link(i));
+        status |= write_binary_block(file, &link_record, sizeof(BinaryLink), &crc);
+    }
+    
+    // Frame records
+    first_path = 0;
+    first_split = 0;
+    for (int i = 0; i < get_number_network_frames(); i++) {
+        frame_pt = get_frame(i);
+        memset(&frame_record, 0, sizeof(BinaryFrame));
+        frame_record.period = get_period(frame_pt);
+        frame_record.deadline = get_deadline(frame_pt);
+        frame_record.end_to_end_delay = get_end_to_end_delay(frame_pt);
+        frame_record.starting = get_starting(frame_pt);
+        frame_record.size = get_size(frame_pt);
+        frame_record.first_path = first_path;
+        frame_record.num_paths = get_num_paths(frame_pt);
+        frame_record.first_split = first_split;
+        frame_record.num_splits = frame_pt->num_splits;
+        first_path += frame_record.num_paths;
+        first_split += frame_record.num_splits;
+        status |= write_binary_block(file, &frame_record, sizeof(BinaryFrame), &crc);
+    }
+    
+    // Compressed rows of the paths, first where every path starts and then all their links
+    start = 0;
+    status |= write_binary_block(file, &start, sizeof(uint32_t), &crc);
+    for (int i = 0; i < get_number_network_frames(); i++) {
+        for (int j = 0; j < get_num_paths(get_frame(i)); j++) {
+            start += get_path_length(get_frame(i), j);
+            status |= write_binary_block(file, &start, sizeof(uint32_t), &crc);
+        }
+    }
+    for (int i = 0; i < get_number_network_frames(); i++) {
+        frame_pt = get_frame(i);
+        for (int j = 0; j < get_num_paths(frame_pt); j++) {
+            for (Path *path_pt = get_path_root(frame_pt, j); !is_last_path(path_pt);
+                 path_pt = get_next_path(path_pt)) {
+                link = path_pt->link;
+                status |= write_binary_block(file, &link, sizeof(int32_t), &crc);
+            }
+        }
+    }
+    
+    // Compressed rows of the splits
+    start = 0;
+    status |= write_binary_block(file, &start, sizeof(uint32_t), &crc);
+    for (int i = 0; i < get_number_network_frames(); i++) {
+        for (int j = 0; j < get_frame(i)->num_splits; j++) {
+            start += get_split_length(get_frame(i), j);
+            status |= write_binary_block(file, &start, sizeof(uint32_t), &crc);
+        }
+    }
+    for (int i = 0; i < get_number_network_frames(); i++) {
+        frame_pt = get_frame(i);
+        for (int j = 0; j < frame_pt->num_splits; j++) {
+            for (Split *split_pt = &frame_pt->split_array_ls[j]; split_pt->next_split_pt != NULL;
+                 split_pt = split_pt->next_split_pt) {
+                link = split_pt->link;
+                status |= write_binary_block(file, &link, sizeof(int32_t), &crc);
+            }
+        }
+    }
+    
+    // Category of the nodes and compressed rows of their connections
+    for (int i = 0; i < get_number_described_nodes(); i++) {
+        category = get_node_category(i);
+        status |= write_binary_block(file, &category, sizeof(int32_t), &crc);
+    }
+    start = 0;
+    status |= write_binary_block(file, &start, sizeof(uint32_t), &crc);
+    for (int i = 0; i < get_number_described_nodes(); i++) {
+        start += get_node_number_connections(i);
+        status |= write_binary_block(file, &start, sizeof(uint32_t), &crc);
+    }
+    for (int i = 0; i < get_number_described_nodes(); i++) {
+        for (int j = 0; j < get_node_number_connections(i); j++) {
+            link = get_node_connection(i, j);
+            status |= write_binary_block(file, &link, sizeof(int32_t), &crc);
+        }
+    }
+    
+    // Write again the header with the checksum
+    header.checksum = crc;
+    if (fseek(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(BinaryNetworkHeader), 1, file) != 1) {
+        status = -1;
+    }
+    if (fclose(file) != 0 || status != 0) {
+        printf("The binary network file could not be written\n");
+        return -1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,117 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  BinaryNetwork.h                                                                                                    *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that reads and writes the network in a binary format that can be mapped into memory.                      *
+ *  The file starts with a header (magic, version and checksum of the rest of the file), followed by fixed size        *
+ *  records for every link and frame, and the paths and splits of all frames stored as compressed rows (an array with  *
+ *  the index where the links of every path start, and an array with all the links one after another). The file ends   *
+ *  with the category of every node and the links connected to every node, also as compressed rows.                    *
+ *  The file is mapped into memory and the network is built directly from the records, without any text parsing.      *
+ *  Numbers are stored in the byte order of the machine that wrote the file.                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef BinaryNetwork_h
+#define BinaryNetwork_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include "Network.h"
+
+#endif /* BinaryNetwork_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define BINARY_NETWORK_MAGIC "SRSN"
+#define BINARY_NETWORK_VERSION 2
+
+/**
+ Header of the binary network file, the checksum is the CRC32 of all the bytes that come after it
+ */
+typedef struct BinaryNetworkHeader {
+    char magic[4];                      // Identifier of the file format (SRSN)
+    uint32_t version;                   // Version of the file format
+    uint32_t checksum;                  // CRC32 of the rest of the file, starting from number_frames
+    uint32_t number_frames;             // Number of frame records
+    uint32_t number_links;              // Number of link records
+    uint32_t number_nodes;              // Number of nodes with their category and connections, 0 if not described
+    uint32_t number_connections;        // Number of links connected to all nodes
+    uint32_t hop_delay;                 // Minimum time in ns that a switch needs to relay a frame
+    int64_t hyper_period;               // Hyperperiod of the network in ns
+    int64_t protocol_period;            // Period of the protocol in ns, 0 if there is no protocol
+    int64_t protocol_time;              // Time reserved for the protocol every period in ns
+    int64_t time_between_frames;        // Minimum time between two transmissions in the same link in ns
+    uint64_t number_paths;              // Number of paths of all frames
+    uint64_t number_path_links;         // Number of links of all paths
+    uint64_t number_splits;             // Number of splits of all frames
+    uint64_t number_split_links;        // Number of links of all splits
+}BinaryNetworkHeader;
+
+/**
+ Record of a link in the binary network file
+ */
+typedef struct BinaryLink {
+    int32_t speed;                      // Speed in MB/s of the link
+    int32_t type;                       // Type of the link (wired or wireless)
+    int32_t source;                     // Node that transmits in the link, -1 if unknown
+    int32_t destination;                // Node that receives from the link, -1 if unknown
+}BinaryLink;
+
+/**
+ Record of a frame in the binary network file, its paths and splits are stored in the path and split arrays
+ */
+typedef struct BinaryFrame {
+    int64_t period;                     // Period of the frame in ns
+    int64_t deadline;                   // Deadline of the frame in ns
+    int64_t end_to_end_delay;           // Maximum end to end delay of the frame in ns
+    int64_t starting;                   // Starting time of the frame in ns
+    int32_t size;                       // Size of the frame in bytes
+    uint32_t first_path;                // Index of the first path of the frame in the path arrays
+    uint32_t num_paths;                 // Number of paths of the frame
+    uint32_t first_split;               // Index of the first split of the frame in the split arrays
+    uint32_t num_splits;                // Number of splits of the frame
+    uint32_t reserved;                  // Padding to keep the records aligned
+}BinaryFrame;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Updates the given CRC32 checksum with a block of data, it is used to verify the binary files of the scheduler
+
+ @param crc checksum of the previous data, 0 for the first block
+ @param data pointer to the data
+ @param size size of the data in bytes
+ @return checksum including the given data
+ */
+uint32_t update_crc32(uint32_t crc, const void *data, size_t size);
+
+/**
+ Tells if the given file is a binary network file by reading its magic
+
+ @param namefile path and name of the file
+ @return 1 if it is a binary network file, 0 otherwise
+ */
+int is_network_binary(char *namefile);
+
+/**
+ Maps the given binary network file into memory and builds the network from its records.
+ The version and checksum of the file are verified before building anything
+
+ @param namefile path and name of the binary network file
+ @return 0 if correctly read, -1 otherwise
+ */
+int read_network_binary(char *namefile);
+
+/**
+ Writes the network in memory into a binary network file. The frame of the protocol, added when the network is
+ initialized for the scheduling, is not written as it is not part of the network description
+
+ @param namefile path and name of the binary network file to create
+ @return 0 if correctly written, -1 otherwise
+ */
+int write_network_binary(char *namefile);
@@ -0,0 +1,395 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  CompactSchedule.c                                                                                                  *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in CompactSchedule.h                                                                                   *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "CompactSchedule.h"
+#include "BinaryNetwork.h"
+#include "IOInterface.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+                                                    /* VARIABLES */
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Compares two offsets by their link, to sort the offsets of a frame
+
+ @param a pointer to the pointer of the first offset
+ @param b pointer to the pointer of the second offset
+ @return negative, 0 or positive if the first link is smaller, equal or bigger
+ */
+int compare_offsets_link(const void *a, const void *b) {
+    
+    return get_offset_link(*(Offset**) a) - get_offset_link(*(Offset**) b);
+}
+
+/**
+ Compares two records by their frame and link, to search records
+
+ @param a pointer to the first record
+ @param b pointer to the second record
+ @return negative, 0 or positive if the first record is smaller, equal or bigger
+ */
+int compare_records(const void *a, const void *b) {
+    
+    const ScheduleRecord *record_a = a, *record_b = b;
+    
+    if (record_a->frame != record_b->frame) {
+        return record_a->frame < record_b->frame ? -1 : 1;
+    }
+    if (record_a->link != record_b->link) {
+        return record_a->link < record_b->link ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Reads a binary compact schedule file that has already been opened
+
+ @param file pointer to the file, at the beginning
+ @return pointer to the compact schedule, NULL if it could not be read
+ */
+CompactSchedule * read_compact_schedule_binary(FILE *file) {
+    
+    CompactSchedule *schedule;
+    CompactScheduleHeader header;
+    uint32_t crc;
+    
+    if (fread(&header, sizeof(CompactScheduleHeader), 1, file) != 1 || header.version != COMPACT_SCHEDULE_VERSION) {
+        printf("The version of the compact schedule file is not supported\n");
+        return NULL;
+    }
+    
+    // Read the records and the base offsets and check the checksum
+    schedule = calloc(1, sizeof(CompactSchedule));
+    schedule->hyper_period = header.hyper_period;
+    schedule->num_records = header.number_records;
+    schedule->num_offsets = header.number_offsets;
+    schedule->records = malloc(sizeof(ScheduleRecord) * (header.number_records + 1));
+    schedule->base_offsets = malloc(sizeof(int64_t) * (header.number_offsets + 1));
+    if ((header.number_records > 0 &&
+         fread(schedule->records, sizeof(ScheduleRecord) * header.number_records, 1, file) != 1) ||
+        (header.number_offsets > 0 &&
+         fread(schedule->base_offsets, sizeof(int64_t) * header.number_offsets, 1, file) != 1)) {
+        printf("The compact schedule file is truncated\n");
+        free_compact_schedule(schedule);
+        return NULL;
+    }
+    crc = update_crc32(0, &header.number_records,
+                       sizeof(CompactScheduleHeader) - offsetof(CompactScheduleHeader, number_records));
+    crc = update_crc32(crc, schedule->records, sizeof(ScheduleRecord) * header.number_records);
+    crc = update_crc32(crc, schedule->base_offsets, sizeof(int64_t) * header.number_offsets);
+    if (crc != header.checksum) {
+        printf("The checksum of the compact schedule file is not correct\n");
+        free_compact_schedule(schedule);
+        return NULL;
+    }
+    
+    return schedule;
+}
+
+/**
+ Reads a text compact schedule file that has already been opened
+
+ @param file pointer to the file, at the beginning
+ @return pointer to the compact schedule, NULL if it could not be read
+ */
+CompactSchedule * read_compact_schedule_text(FILE *file) {
+    
+    CompactSchedule *schedule;
+    ScheduleRecord *record;
+    char magic[16];
+    int version, num_records, read_records = 0;
+    long long int hyper_period, num_offsets;
+    char *line = NULL, *it, *end;
+    size_t line_size = 0;
+    
+    if (fscanf(file, "%15s %d %lld %d %lld", magic, &version, &hyper_period, &num_records, &num_offsets) != 5 ||
+        version != COMPACT_SCHEDULE_VERSION || num_records < 0 || num_offsets < 0) {
+        printf("The version of the compact schedule file is not supported\n");
+        return NULL;
+    }
+    schedule = calloc(1, sizeof(CompactSchedule));
+    schedule->hyper_period = hyper_period;
+    schedule->records = malloc(sizeof(ScheduleRecord) * (num_records + 1));
+    schedule->base_offsets = malloc(sizeof(int64_t) * (num_offsets + 1));
+    
+    // Every line is a record: frame link period timeslot instances replicas and one base offset per replica
+    while (getline(&line, &line_size, file) != -1) {
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') {
+            continue;
+        }
+        if (read_records == num_records) {
+            break;
+        }
+        record = &schedule->records[read_records];
+        memset(record, 0, sizeof(ScheduleRecord));
+        it = line;
+        record->frame = (int32_t) strtol(it, &it, 10);
+        record->link = (int32_t) strtol(it, &it, 10);
+        record->period = strtoll(it, &it, 10);
+        record->timeslot_size = strtoll(it, &it, 10);
+        record->instances = (int32_t) strtol(it, &it, 10);
+        record->replicas = (int32_t) strtol(it, &it, 10);
+        record->first_offset = (uint32_t) schedule->num_offsets;
+        if (record->replicas < 0 || schedule->num_offsets + record->replicas + 1 > num_offsets) {
+            break;
+        }
+        for (int r = 0; r <= record->replicas; r++) {
+            schedule->base_offsets[schedule->num_offsets++] = strtoll(it, &end, 10);
+            if (end == it) {
+                break;
+            }
+            it = end;
+        }
+        read_records++;
+    }
+    free(line);
+    schedule->num_records = read_records;
+    
+    if (read_records != num_records || schedule->num_offsets != num_offsets) {
+        printf("The compact schedule file is truncated or wrongly constructed\n");
+        free_compact_schedule(schedule);
+        return NULL;
+    }
+    
+    return schedule;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Builds the compact schedule from the offsets of the network in memory, the frame of the protocol is not included
+ */
+CompactSchedule * build_compact_schedule(void) {
+    
+    CompactSchedule *schedule;
+    ScheduleRecord *record;
+    Offset *offset_it;
+    Offset **frame_offsets = NULL;      // Offsets of a frame, sorted by link
+    int num_frames, num_frame_offsets, max_frame_offsets = 0;
+    int max_records = 0;
+    long long int max_offsets = 0;
+    
+    if (is_protocol_active()) {
+        num_frames = get_number_frames() - 1;
+    } else {
+        num_frames = get_number_frames();
+    }
+    
+    schedule = calloc(1, sizeof(CompactSchedule));
+    schedule->hyper_period = get_hyper_period();
+    for (int i = 0; i < num_frames; i++) {
+        
+        // Collect the offsets of the frame and sort them by link
+        num_frame_offsets = 0;
+        offset_it = get_offset_root(get_frame(i));
+        while (!is_last_offset(offset_it)) {
+            if (num_frame_offsets == max_frame_offsets) {
+                max_frame_offsets = max_frame_offsets * 2 + 8;
+                frame_offsets = realloc(frame_offsets, sizeof(Offset*) * max_frame_offsets);
+            }
+            frame_offsets[num_frame_offsets++] = offset_it;
+            offset_it = get_next_offset(offset_it);
+        }
+        qsort(frame_offsets, num_frame_offsets, sizeof(Offset*), compare_offsets_link);
+        
+        // One record for every offset, with the transmission time of the first instance of every replica
+        for (int j = 0; j < num_frame_offsets; j++) {
+            offset_it = frame_offsets[j];
+            if (schedule->num_records == max_records) {
+                max_records = max_records * 2 + 64;
+                schedule->records = realloc(schedule->records, sizeof(ScheduleRecord) * max_records);
+            }
+            record = &schedule->records[schedule->num_records++];
+            memset(record, 0, sizeof(ScheduleRecord));
+            record->frame = i;
+            record->link = get_offset_link(offset_it);
+            record->period = get_period(get_frame(i));
+            record->timeslot_size = get_timeslot_size(offset_it);
+            record->instances = get_number_instances(offset_it);
+            record->replicas = get_number_replicas(offset_it);
+            record->first_offset = (uint32_t) schedule->num_offsets;
+            for (int r = 0; r <= record->replicas; r++) {
+                if (schedule->num_offsets == max_offsets) {
+                    max_offsets = max_offsets * 2 + 64;
+                    schedule->base_offsets = realloc(schedule->base_offsets, sizeof(int64_t) * max_offsets);
+                }
+                schedule->base_offsets[schedule->num_offsets++] = get_offset(offset_it, 0, r);
+            }
+        }
+    }
+    free(frame_offsets);
+    
+    return schedule;
+}
+
+/**
+ Writes the schedule of the network in memory into a binary compact schedule file
+ */
+int write_schedule_binary(char *namefile) {
+    
+    FILE *file;
+    CompactSchedule *schedule;
+    CompactScheduleHeader header;
+    int status = 0;
+    
+    schedule = build_compact_schedule();
+    memset(&header, 0, sizeof(CompactScheduleHeader));
+    memcpy(header.magic, COMPACT_SCHEDULE_MAGIC, sizeof(header.magic));
+    header.version = COMPACT_SCHEDULE_VERSION;
+    header.number_records = schedule->num_records;
+    header.number_offsets = schedule->num_offsets;
+    header.hyper_period = schedule->hyper_period;
+    header.checksum = update_crc32(0, &header.number_records,
+                                   sizeof(CompactScheduleHeader) - offsetof(CompactScheduleHeader, number_records));
+    header.checksum = update_crc32(header.checksum, schedule->records, sizeof(ScheduleRecord) * schedule->num_records);
+    header.checksum = update_crc32(header.checksum, schedule->base_offsets, sizeof(int64_t) * schedule->num_offsets);
+    
+    file = fopen(namefile, "wb");
+    if (file == NULL) {
+        printf("The compact schedule file could not be created\n");
+        free_compact_schedule(schedule);
+        return -1;
+    }
+    if (fwrite(&header, sizeof(CompactScheduleHeader), 1, file) != 1 ||
+        (schedule->num_records > 0 &&
+         fwrite(schedule->records, sizeof(ScheduleRecord) * schedule->num_records, 1, file) != 1) ||
+        (schedule->num_offsets > 0 &&
+         fwrite(schedule->base_offsets, sizeof(int64_t) * schedule->num_offsets, 1, file) != 1)) {
+        status = -1;
+    }
+    if (fclose(file) != 0 || status != 0) {
+        printf("The compact schedule file could not be written\n");
+        status = -1;
+    }
+    free_compact_schedule(schedule);
+    
+    return status;
+}
+
+/**
+ Writes the schedule of the network in memory into a text compact schedule file
+ */
+int write_schedule_text(char *namefile) {
+    
+    FILE *file;
+    CompactSchedule *schedule;
+    ScheduleRecord *record;
+    int status = 0;
+    
+    file = fopen(namefile, "w");
+    if (file == NULL) {
+        printf("The compact schedule file could not be created\n");
+        return -1;
+    }
+    
+    schedule = build_compact_schedule();
+    fprintf(file, "%s %d %lld %d %lld\n", COMPACT_SCHEDULE_TEXT_MAGIC, COMPACT_SCHEDULE_VERSION,
+            schedule->hyper_period, schedule->num_records, schedule->num_offsets);
+    fprintf(file, "# frame link period timeslot instances replicas base_offsets\n");
+    for (int i = 0; i < schedule->num_records; i++) {
+        record = &schedule->records[i];
+        fprintf(file, "%d %d %lld %lld %d %d", record->frame, record->link, (long long int) record->period,
+                (long long int) record->timeslot_size, record->instances, record->replicas);
+        for (int r = 0; r <= record->replicas; r++) {
+            fprintf(file, " %lld", (long long int) schedule->base_offsets[record->first_offset + r]);
+        }
+        fprintf(file, "\n");
+    }
+    if (fclose(file) != 0) {
+        printf("The compact schedule file could not be written\n");
+        status = -1;
+    }
+    free_compact_schedule(schedule);
+    
+    return status;
+}
+
+/**
+ Reads a compact schedule file, binary or text (the variant is detected by the content of the file). A schedule xml
+ file is also accepted and converted into a compact schedule
+ */
+CompactSchedule * read_compact_schedule(char *namefile) {
+    
+    FILE *file;
+    CompactSchedule *schedule;
+    char magic[sizeof(COMPACT_SCHEDULE_TEXT_MAGIC)];
+    
+    file = fopen(namefile, "rb");
+    if (file == NULL) {
+        printf("The compact schedule file does not exist\n");
+        return NULL;
+    }
+    
+    // Detect the variant by the magic, and start reading again from the beginning
+    memset(magic, 0, sizeof(magic));
+    if (fread(magic, 1, sizeof(magic) - 1, file) < 4) {
+        printf("The compact schedule file is too small\n");
+        fclose(file);
+        return NULL;
+    }
+    rewind(file);
+    if (magic[0] == '<') {
+        fclose(file);
+        return read_schedule_xml(namefile);
+    }
+    if (strcmp(magic, COMPACT_SCHEDULE_TEXT_MAGIC) == 0) {
+        schedule = read_compact_schedule_text(file);
+    } else if (memcmp(magic, COMPACT_SCHEDULE_MAGIC, 4) == 0) {
+        schedule = read_compact_schedule_binary(file);
+    } else {
+        printf("The file is not a compact schedule file\n");
+        schedule = NULL;
+    }
+    fclose(file);
+    
+    return schedule;
+}
+
+/**
+ Get the record of the given frame and link in a compact schedule
+ */
+ScheduleRecord * get_schedule_record(CompactSchedule *schedule, int frame_id, int link_id) {
+    
+    ScheduleRecord key;
+    
+    key.frame = frame_id;
+    key.link = link_id;
+    return bsearch(&key, schedule->records, schedule->num_records, sizeof(ScheduleRecord), compare_records);
+}
+
+/**
+ Get the transmission time of an instance and replica of a record of a compact schedule
+ */
+long long int get_record_transmission(CompactSchedule *schedule, ScheduleRecord *record, int instance, int replica) {
+    
+    if (instance < 0 || instance >= record->instances || replica < 0 || replica > record->replicas ||
+        record->first_offset + replica >= schedule->num_offsets) {
+        return -1;
+    }
+    return schedule->base_offsets[record->first_offset + replica] + record->period * instance;
+}
+
+/**
+ Frees a compact schedule read from a file
+ */
+void free_compact_schedule(CompactSchedule *schedule) {
+    
+    if (schedule == NULL) {
+        return;
+    }
+    free(schedule->records);
+    free(schedule->base_offsets);
+    free(schedule);
+}
@@ -0,0 +1,132 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  CompactSchedule.h                                                                                                  *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that writes and reads the schedule in a compact format.                                                    *
+ *  As all instances of a frame in a link are transmitted one period after the previous one, only the transmission     *
+ *  time of the first instance of every replica (base offset) is stored, once for every frame and link, together with  *
+ *  the period, the size of the timeslot and the number of instances and replicas. The transmission time of any        *
+ *  instance is then base offset + period * instance.                                                                  *
+ *  There is a binary variant (header with magic, version and checksum, fixed size records and an array with all the   *
+ *  base offsets) and a text variant with one line per record. The reader functions do not need the network, so they   *
+ *  can be used in the nodes that receive the schedule.                                                                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef CompactSchedule_h
+#define CompactSchedule_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include "Network.h"
+
+#endif /* CompactSchedule_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define COMPACT_SCHEDULE_MAGIC "SRSS"
+#define COMPACT_SCHEDULE_TEXT_MAGIC "SRSS-TEXT"
+#define COMPACT_SCHEDULE_VERSION 1
+
+/**
+ Header of the binary compact schedule file, the checksum is the CRC32 of all the bytes that come after it
+ */
+typedef struct CompactScheduleHeader {
+    char magic[4];                      // Identifier of the file format (SRSS)
+    uint32_t version;                   // Version of the file format
+    uint32_t checksum;                  // CRC32 of the rest of the file, starting from number_records
+    uint32_t number_records;            // Number of records
+    uint64_t number_offsets;            // Number of base offsets of all records
+    int64_t hyper_period;               // Hyperperiod of the schedule in ns
+}CompactScheduleHeader;
+
+/**
+ Transmissions of a frame in a link, records are sorted by frame and then by link
+ */
+typedef struct ScheduleRecord {
+    int32_t frame;                      // Identifier of the frame
+    int32_t link;                       // Identifier of the link
+    int64_t period;                     // Period of the frame in ns
+    int64_t timeslot_size;              // Time in ns that a transmission takes in the link
+    int32_t instances;                  // Number of instances in the hyperperiod
+    int32_t replicas;                   // Number of replicas (replica 0 is not counted)
+    uint32_t first_offset;              // Index of the base offset of replica 0 in the base offsets array
+    uint32_t reserved;                  // Padding to keep the records aligned
+}ScheduleRecord;
+
+/**
+ Compact schedule read from a file
+ */
+typedef struct CompactSchedule {
+    long long int hyper_period;         // Hyperperiod of the schedule in ns
+    int num_records;                    // Number of records
+    ScheduleRecord *records;            // Array with all the records
+    long long int num_offsets;          // Number of base offsets
+    int64_t *base_offsets;              // Base offsets of all records, one per replica
+}CompactSchedule;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Builds the compact schedule from the offsets of the network in memory, the frame of the protocol is not included
+
+ @return pointer to the compact schedule. It has to be freed with free_compact_schedule
+ */
+CompactSchedule * build_compact_schedule(void);
+
+/**
+ Writes the schedule of the network in memory into a binary compact schedule file
+
+ @param namefile path and name of the file to create
+ @return 0 if correctly written, -1 otherwise
+ */
+int write_schedule_binary(char *namefile);
+
+/**
+ Writes the schedule of the network in memory into a text compact schedule file
+
+ @param namefile path and name of the file to create
+ @return 0 if correctly written, -1 otherwise
+ */
+int write_schedule_text(char *namefile);
+
+/**
+ Reads a compact schedule file, binary or text (the variant is detected by the content of the file). A schedule xml
+ file is also accepted, read with read_schedule_xml of IOInterface.h
+
+ @param namefile path and name of the file
+ @return pointer to the compact schedule, NULL if it could not be read. It has to be freed with free_compact_schedule
+ */
+CompactSchedule * read_compact_schedule(char *namefile);
+
+/**
+ Get the record of the given frame and link in a compact schedule
+
+ @param schedule pointer to the compact schedule
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @return pointer to the record, NULL if the frame is not transmitted in the link
+ */
+ScheduleRecord * get_schedule_record(CompactSchedule *schedule, int frame_id, int link_id);
+
+/**
+ Get the transmission time of an instance and replica of a record of a compact schedule
+
+ @param schedule pointer to the compact schedule
+ @param record pointer to the record
+ @param instance number of the instance
+ @param replica number of the replica
+ @return transmission time in ns, -1 if the instance or the replica do not exist
+ */
+long long int get_record_transmission(CompactSchedule *schedule, ScheduleRecord *record, int instance, int replica);
+
+/**
+ Frees a compact schedule read from a file
+
+ @param schedule pointer to the compact schedule
+ */
+void free_compact_schedule(CompactSchedule *schedule);
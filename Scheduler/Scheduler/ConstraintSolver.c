@@ -11,37 +11,69 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "ConstraintSolver.h"
+#include "Memory.h"
+#include <stdlib.h>
 
                                                     /* VARIABLES */
 
 context_t *logical_context;             // Yices context where the constraints are saved to be solved
 model_t *schedule_model;                // Model where to save the solution that yices find when the context is SAT
 ctx_config_t *context_configuration;    // Configuration of the context to synthesize schedules faster
+int yices_initialized = 0;              // Yices global tables are initialized once and shared by all the contexts
+term_t *frame_guards = NULL;            // Boolean guard of every frame, its constraints only hold if it is assumed
+int num_frame_guards = 0;               // Number of frames with guard, 0 if the constraints are not guarded
+term_t active_guard = NULL_TERM;        // Guard of the constraints being added, NULL_TERM if they always hold
+FILE *smtlib2_file = NULL;              // File where the SMT-LIB2 solver writes the constraints
+int smtlib2_variables = 0;              // Number of variables declared in the SMT-LIB2 file
+int unchecked_formulas = 0;             // Formulas asserted since the memory of the process was checked
+long long int time_granularity = 1;     // Time unit in ns of the yices offsets, see get_grid_origin
 
 int create_offset_counter = 0;
 int path_dependent_counter = 0;
 int end_to_end_counter = 0;
 int contention_free_counter = 0;
 int fixed_distance_counter = 0;
+int variable_counter = 0;
 
                                                 /* AUXILIAR FUNCTIONS */
 
 /**
- Prints the needed constraint formulas and the amount of bytes to send all the schedule constraints
+ Divides a time by the time granularity, rounding down also for the negative times
+
+ @param time time in ns
+ @return time in the time unit of the solver rounded down
  */
-void bytes_needed() {
+long long int floor_time(long long int time) {
     
-    int bytes = 0;
+    if (time < 0) {
+        return -((-time + time_granularity - 1) / time_granularity);
+    }
+    return time / time_granularity;
+}
+
+/**
+ Get the first time of the grid where the solver searches the transmission times, the rest are every time granularity
+ after it. With granularity it is TIME_GRID_ORIGIN, so the protocol (transmitted 1 ns after its period) is in the grid.
+ Without granularity every time is in the grid, so it starts at 0 and the times are kept as they are
+
+ @return time in ns of the first point of the grid
+ */
+long long int get_grid_origin(void) {
     
-    printf("Number Create Constraints Formulas: %d\n", create_offset_counter);
-    printf("Number Path Dependent Formulas: %d\n", path_dependent_counter);
-    printf("Number End to End Formulas: %d\n", end_to_end_counter);
-    printf("Number Contention Free Formulas: %d\n", contention_free_counter);
-    printf("Number Set Fixed Formulas: %d\n", fixed_distance_counter);
+    return time_granularity > 1 ? TIME_GRID_ORIGIN : 0;
+}
+
+/**
+ Converts a transmission time, or a limit of it, to the time unit of the solver. The transmission times in the grid
+ are converted exactly, and so are the limits, as "after min" and "until max" hold for the same times of the grid
+ before and after rounding down
+
+ @param time transmission time in ns
+ @return transmission time in the time unit of the solver
+ */
+long long int scale_time(long long int time) {
     
-    bytes = (create_offset_counter * 12) + (path_dependent_counter * 11) + (end_to_end_counter * 11) +
-        (contention_free_counter * 15) + (fixed_distance_counter * 8);
-    printf("Bytes needed to send the Schedule: %d\n", bytes);
+    return floor_time(time - get_grid_origin());
 }
 
 /**
@@ -104,12 +136,133 @@ int offsets_share_interval(Frame *frame1_pt, Offset *offset1_pt, int instance1,
     return 0;
 }
 
+/**
+ Sets the guard of the next constraints added into the solver, the guard of the frame or the conjunction of the guards
+ of both frames. The frames without guard (the protocol, or all if the constraints are not guarded) are ignored
+
+ @param frame1_id identifier of the first frame, -1 for none
+ @param frame2_id identifier of the second frame, -1 for none
+ */
+void set_active_guard(int frame1_id, int frame2_id) {
+    
+    term_t guard1 = NULL_TERM, guard2 = NULL_TERM;
+    
+    if (frame1_id >= 0 && frame1_id < num_frame_guards) {
+        guard1 = frame_guards[frame1_id];
+    }
+    if (frame2_id >= 0 && frame2_id < num_frame_guards) {
+        guard2 = frame_guards[frame2_id];
+    }
+    if (guard1 != NULL_TERM && guard2 != NULL_TERM) {
+        active_guard = yices_and2(guard1, guard2);
+    } else if (guard1 != NULL_TERM) {
+        active_guard = guard1;
+    } else {
+        active_guard = guard2;
+    }
+}
+
+/**
+ Asserts a formula into the yices context, implied by the active guard if there is one
+
+ @param y_formula formula to assert
+ @return 0 if everything went ok, -1 if something failed
+ */
+int assert_yices2_formula(term_t y_formula) {
+    
+    if (active_guard != NULL_TERM) {
+        y_formula = yices_implies(active_guard, y_formula);
+    }
+    if (++unchecked_formulas == MEMORY_CHECK_INTERVAL) {
+        unchecked_formulas = 0;
+        check_memory_limit("while adding the constraints");
+    }
+    return yices_assert_formula(logical_context, y_formula);
+}
+
+/**
+ Resets the counters of the variables and formulas added into the solver
+ */
+void reset_constraint_counters(void) {
+    
+    create_offset_counter = 0;
+    path_dependent_counter = 0;
+    end_to_end_counter = 0;
+    contention_free_counter = 0;
+    fixed_distance_counter = 0;
+    variable_counter = 0;
+}
+
+/**
+ Writes an integer in the SMT-LIB2 file, the negative numbers are written as the negation of the positive one
+
+ @param value integer to write
+ */
+void write_smtlib2_integer(long long int value) {
+    
+    if (value < 0) {
+        fprintf(smtlib2_file, "(- %lld)", -value);
+    } else {
+        fprintf(smtlib2_file, "%lld", value);
+    }
+}
+
+/**
+ Writes in the SMT-LIB2 file the sum of the variable of an offset and a distance, (+ variable distance)
+
+ @param offset_pt pointer to the offset
+ @param instance of the offset
+ @param replica of the offset
+ @param distance distance added in ns
+ */
+void write_smtlib2_sum(Offset *offset_pt, int instance, int replica, long long int distance) {
+    
+    fprintf(smtlib2_file, "(+ v%d ", get_offset_variable(offset_pt, instance, replica));
+    write_smtlib2_integer(distance);
+    fprintf(smtlib2_file, ")");
+}
+
+/**
+ Starts the SMT-LIB2 file where the constraints are written, the file has to be opened with set_smtlib2_file
+ */
+void initialize_smtlib2_solver(void) {
+    
+    reset_constraint_counters();
+    smtlib2_variables = 0;
+    if (smtlib2_file != NULL) {
+        fprintf(smtlib2_file, "; Schedule constraints of the network, every variable is a transmission time in ns\n");
+        fprintf(smtlib2_file, "(set-info :smt-lib-version 2.6)\n");
+        fprintf(smtlib2_file, "(set-info :status unknown)\n");
+        fprintf(smtlib2_file, "(set-logic QF_LIA)\n");
+    }
+}
+
+/**
+ Ends the SMT-LIB2 file with the check of the constraints and closes it
+ */
+void close_smtlib2_solver(void) {
+    
+    if (smtlib2_file != NULL) {
+        fprintf(smtlib2_file, "(check-sat)\n(exit)\n");
+        fclose(smtlib2_file);
+        smtlib2_file = NULL;
+    }
+}
+
 /**
  Initialize the solver yices to be able to synthesize schedules
  */
 void initialize_yices2_solver(void) {
     
-    yices_init();
+    if (!yices_initialized) {
+        yices_init();
+        yices_initialized = 1;
+    }
+    schedule_model = NULL;
+    reset_constraint_counters();
+    time_granularity = 1;
+    num_frame_guards = 0;
+    active_guard = NULL_TERM;
     context_configuration = yices_new_config();
     yices_default_config_for_logic(context_configuration, "QF_LIA");    // Faster for integer schedule synthesis
     logical_context = yices_new_context(context_configuration);     // Create the context where to add the constraints
@@ -131,6 +284,47 @@ void init_variable(Offset *offset_pt, int instance, int replica, char *name, Sol
     switch (csolver) {
         case yices2:
             set_yices_offset(offset_pt, instance, replica, yices_new_uninterpreted_term(yices_int_type()), name);
+            variable_counter += 1;
+            break;
+            
+        case smtlib2:
+            set_offset_variable(offset_pt, instance, replica, smtlib2_variables);
+            fprintf(smtlib2_file, "(declare-fun v%d () Int) ; %s\n", smtlib2_variables, name);
+            smtlib2_variables += 1;
+            variable_counter += 1;
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/**
+ Init the offset with a constant instead of a variable, used for the offsets that are pinned to a previous schedule
+
+ @param offset_pt pointer of the offset
+ @param instance of the offset
+ @param replica of the offset
+ @param value long long int transmission time of the offset
+ @param name given to the constant
+ @param csolver constraint solver used
+ */
+void init_constant(Offset *offset_pt, int instance, int replica, long long int value, char *name, Solver csolver) {
+    
+    switch (csolver) {
+        case yices2:
+            // Negative because yices schedule is inverted
+            set_yices_offset(offset_pt, instance, replica, yices_int64(-scale_time(value)), name);
+            break;
+            
+        case smtlib2:
+            // A variable equal to the value, as the offsets are variables in the file
+            set_offset_variable(offset_pt, instance, replica, smtlib2_variables);
+            fprintf(smtlib2_file, "(declare-fun v%d () Int) ; %s\n(assert (= v%d ", smtlib2_variables, name,
+                    smtlib2_variables);
+            write_smtlib2_integer(value);
+            fprintf(smtlib2_file, "))\n");
+            smtlib2_variables += 1;
             break;
             
         default:
@@ -156,15 +350,21 @@ int set_fixed_value(Offset *offset_pt, int instance, int replica, long long int
     
     switch (cssolver) {
         case yices2:
-            y_integer = yices_int64(-value);    // Negative because yices schedule is inverted
+            y_integer = yices_int64(-scale_time(value));    // Negative because yices schedule is inverted
             y_formula = yices_eq(get_yices_offset(offset_pt, instance, replica), y_integer);
             // yices_pp_term(stdout, y_formula, 80, 1, 0);     // Remove when not debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error setting a fixed value\n");
                 return -1;
             }
             break;
             
+        case smtlib2:
+            fprintf(smtlib2_file, "(assert (= v%d ", get_offset_variable(offset_pt, instance, replica));
+            write_smtlib2_integer(value);
+            fprintf(smtlib2_file, "))\n");
+            break;
+            
         default:
             break;
     }
@@ -237,24 +437,34 @@ int set_offset_range(Offset *offset_pt, int instance, int replica, long long int
         case yices2:
             
             // Set the minimum transmission time. Note that in Yices, we invert the schedule due to yices2 being weird
-            y_integer = yices_int64(-min);
+            y_integer = yices_int64(-scale_time(min));
             y_formula = yices_arith_lt_atom(get_yices_offset(offset_pt, 0, 0), y_integer);
             //yices_pp_term(stdout, y_formula, 80, 1, 0);     // Printing of the formula, remove after debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error asserting minimum transmission time in yices2\n");
                 return -1;
             }
             
             // Set the maximum transmission time. Also inverted because is yices2 is weird
-            y_integer = yices_int64(-max);
+            y_integer = yices_int64(-scale_time(max));
             y_formula = yices_arith_geq_atom(get_yices_offset(offset_pt, 0, 0), y_integer);
             //yices_pp_term(stdout, y_formula, 80, 1, 0);     // Printing of the formula, remove after debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error asserting maximum transmission time in yices2\n");
                 return -1;
             }
             break;
             
+        case smtlib2:
+            // The schedule is not inverted, min < offset <= max
+            fprintf(smtlib2_file, "(assert (< ");
+            write_smtlib2_integer(min);
+            fprintf(smtlib2_file, " v%d))\n(assert (<= v%d ", get_offset_variable(offset_pt, 0, 0),
+                    get_offset_variable(offset_pt, 0, 0));
+            write_smtlib2_integer(max);
+            fprintf(smtlib2_file, "))\n");
+            break;
+            
         default:
             break;
     }
@@ -286,19 +496,25 @@ int set_fixed_distance(Offset *offset1_pt, int instance1, int replica1, Offset *
     
     switch (csolver) {
         case yices2:
-            // Set the distance between both offsets
-            y_integer = yices_int64(distance);
+            // Set the distance between both offsets, the periods are multiple of the granularity
+            y_integer = yices_int64(distance / time_granularity);
             // Set the distance to the offset 1, yices_sub because schedule is inverted
             y_add = yices_sub(get_yices_offset(offset1_pt, instance1, replica1), y_integer);
             // Equal the distance with offset 2
             y_formula = yices_arith_eq_atom(get_yices_offset(offset2_pt, instance2, replica2), y_add);
             // yices_pp_term(stdout, y_formula, 80, 1, 0);     // Printing of the formula, remove after debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error asserting distance between two offsets in yices2\n");
                 return -1;
             }
             break;
             
+        case smtlib2:
+            fprintf(smtlib2_file, "(assert (= v%d ", get_offset_variable(offset2_pt, instance2, replica2));
+            write_smtlib2_sum(offset1_pt, instance1, replica1, distance);
+            fprintf(smtlib2_file, "))\n");
+            break;
+            
         default:
             break;
     }
@@ -330,19 +546,25 @@ int set_minimum_distance(Offset *offset1_pt, int instance1, int replica1, Offset
     
     switch (csolver) {
         case yices2:
-            // Set the minimum distance between both offset
-            y_integer = yices_int64(distance);
+            // Set the minimum distance between both offset, rounded up it holds for the same times of the grid
+            y_integer = yices_int64(-floor_time(-distance));
             // Set the distance to the offset 1, yices_sub because schedule is inverted
             y_add = yices_sub(get_yices_offset(offset1_pt, instance1, replica1), y_integer);
             // Less than with the offset2 (greather or equal because schedule is inverted)
             y_formula = yices_arith_geq_atom(y_add, get_yices_offset(offset2_pt, instance2, replica2));
             // yices_pp_term(stdout, y_formula, 80, 1, 0);     // Printing of the formula, remove after debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error asserting minimum distance between two offsets in yices2\n");
                 return -1;
             }
             break;
             
+        case smtlib2:
+            fprintf(smtlib2_file, "(assert (>= v%d ", get_offset_variable(offset2_pt, instance2, replica2));
+            write_smtlib2_sum(offset1_pt, instance1, replica1, distance);
+            fprintf(smtlib2_file, "))\n");
+            break;
+            
         default:
             break;
     }
@@ -373,19 +595,25 @@ int set_maximum_distance(Offset *offset1_pt, int instance1, int replica1, Offset
     
     switch (csolver) {
         case yices2:
-            // Set the maximum distance between both offset
-            y_integer = yices_int64(distance);
+            // Set the maximum distance between both offset, as it is strict, rounded up it holds for the same times
+            y_integer = yices_int64(-floor_time(-distance));
             // Set the distance to the offset 1, yices_sub because schedule is inverted
             y_add = yices_sub(get_yices_offset(offset1_pt, instance1, replica1), y_integer);
             // Greater or equal with the offset2 (less than because schedule is inverted)
             y_formula = yices_arith_lt_atom(y_add, get_yices_offset(offset2_pt, instance2, replica2));
             // yices_pp_term(stdout, y_formula, 180, 1, 0);     // Printing of the formula, remove after debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error asserting maximum distance between two offsets in yices2\n");
                 return -1;
             }
             break;
             
+        case smtlib2:
+            fprintf(smtlib2_file, "(assert (< v%d ", get_offset_variable(offset2_pt, instance2, replica2));
+            write_smtlib2_sum(offset1_pt, instance1, replica1, distance);
+            fprintf(smtlib2_file, "))\n");
+            break;
+            
         default:
             break;
     }
@@ -421,20 +649,29 @@ int avoid_intersection(Offset *offset1_pt, int instance1, int replica1, Offset *
     
     switch (csolver) {
         case yices2:
-            y_integer = yices_int64(distance1);
+            // Both are strict distances, rounded down they hold for the same times of the grid
+            y_integer = yices_int64(floor_time(distance1));
             y_add = yices_sub(get_yices_offset(offset1_pt, instance1, replica1), y_integer);
             y_less = yices_arith_gt_atom(y_add, get_yices_offset(offset2_pt, instance2, replica2));
-            y_integer = yices_int64(distance2);
+            y_integer = yices_int64(floor_time(distance2));
             y_add = yices_sub(get_yices_offset(offset2_pt, instance2, replica2), y_integer);
             y_greater = yices_arith_lt_atom(get_yices_offset(offset1_pt, instance1, replica1), y_add);
             y_formula = yices_or2(y_less, y_greater);
             //yices_pp_term(stdout, y_formula, 12000, 10000, 0);     // Printing of the formula, remove after debugging
-            if (yices_assert_formula(logical_context, y_formula) == -1) {
+            if (assert_yices2_formula(y_formula) == -1) {
                 printf("Error avoiding intersection between two offsets in yices2\n");
                 return -1;
             }
             break;
             
+        case smtlib2:
+            fprintf(smtlib2_file, "(assert (or (> v%d ", get_offset_variable(offset2_pt, instance2, replica2));
+            write_smtlib2_sum(offset1_pt, instance1, replica1, distance1);
+            fprintf(smtlib2_file, ") (> v%d ", get_offset_variable(offset1_pt, instance1, replica1));
+            write_smtlib2_sum(offset2_pt, instance2, replica2, distance2);
+            fprintf(smtlib2_file, ")))\n");
+            break;
+            
         default:
             break;
     }
@@ -452,12 +689,13 @@ int avoid_intersection(Offset *offset1_pt, int instance1, int replica1, Offset *
  */
 long long int get_solver_offset(Offset *offset_pt, int instance, int replica, Solver csolver) {
     
-    long long int value;
+    int64_t value;
     
     switch (csolver) {
         case yices2:
             yices_get_int64_value(schedule_model, get_yices_offset(offset_pt, instance, replica), &value);
-            return -value;      // The schedule is inverted in yices, so we invert the value
+            // The schedule is inverted in yices, so we invert the value, then it is converted back to ns
+            return -value * time_granularity + get_grid_origin();
             break;
             
         default:
@@ -465,8 +703,105 @@ long long int get_solver_offset(Offset *offset_pt, int instance, int replica, So
     }
 }
 
+/**
+ Frees the model and the context of yices, the global tables are kept until the program finishes
+ */
+void close_yices2_solver(void) {
+    
+    tracked_free(memory_solver, frame_guards);
+    frame_guards = NULL;
+    num_frame_guards = 0;
+    active_guard = NULL_TERM;
+    if (schedule_model != NULL) {
+        yices_free_model(schedule_model);
+        schedule_model = NULL;
+    }
+    if (logical_context != NULL) {
+        yices_free_context(logical_context);
+        logical_context = NULL;
+    }
+}
+
                                                     /* FUNCTIONS */
 
+/**
+ Prints the needed constraint formulas and the amount of bytes to send all the schedule constraints
+ */
+int bytes_needed(void) {
+    
+    int bytes = 0;
+    
+    printf("Number Create Constraints Formulas: %d\n", create_offset_counter);
+    printf("Number Path Dependent Formulas: %d\n", path_dependent_counter);
+    printf("Number End to End Formulas: %d\n", end_to_end_counter);
+    printf("Number Contention Free Formulas: %d\n", contention_free_counter);
+    printf("Number Set Fixed Formulas: %d\n", fixed_distance_counter);
+    
+    bytes = (create_offset_counter * 12) + (path_dependent_counter * 11) + (end_to_end_counter * 11) +
+        (contention_free_counter * 15) + (fixed_distance_counter * 8);
+    printf("Bytes needed to send the Schedule: %d\n", bytes);
+    return bytes;
+}
+
+/**
+ Get the number of offset variables created in the solver
+ */
+int get_number_variables(void) {
+    
+    return variable_counter;
+}
+
+/**
+ Get the number of constraint formulas added into the solver
+ */
+int get_number_formulas(void) {
+    
+    return create_offset_counter + path_dependent_counter + end_to_end_counter + contention_free_counter +
+        fixed_distance_counter;
+}
+
+/**
+ Get the number of disjunctions added into the solver, the contention free formulas
+ */
+int get_number_disjunctions(void) {
+    
+    return contention_free_counter;
+}
+
+/**
+ Get the number of terms in the global tables of yices, they are kept until the solver finishes
+ */
+int get_number_terms(void) {
+    
+    return yices_initialized ? (int) yices_num_terms() : 0;
+}
+
+/**
+ Get the number of types in the global tables of yices
+ */
+int get_number_types(void) {
+    
+    return yices_initialized ? (int) yices_num_types() : 0;
+}
+
+/**
+ Initializes the global memory of the given solver, it is done once and shared by all the schedules
+ */
+void init_solver(Solver s) {
+    
+    switch (s) {
+        case yices2:
+            if (!yices_initialized) {
+                yices_init();
+                yices_initialized = 1;
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
 /**
  Initialize the given solver to start the scheduling process
  */
@@ -477,9 +812,120 @@ void initialize_solver(Solver s) {
             initialize_yices2_solver();
             break;
             
+        case smtlib2:
+            initialize_smtlib2_solver();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/**
+ Sets the time unit of the transmission times in the solver
+ */
+void set_solver_granularity(long long int granularity, Solver s) {
+    
+    switch (s) {
+        case yices2:
+            time_granularity = granularity > 0 ? granularity : 1;
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/**
+ Get the time unit of the transmission times in the solver
+ */
+long long int get_solver_granularity(void) {
+    
+    return time_granularity;
+}
+
+/**
+ Frees the memory used by the given solver after the scheduling process
+ */
+void close_solver(Solver s) {
+    
+    switch (s) {
+        case yices2:
+            close_yices2_solver();
+            break;
+            
+        case smtlib2:
+            close_smtlib2_solver();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/**
+ Finishes the given solver and frees all its global memory, no more schedules can be synthesized afterwards
+ */
+void exit_solver(Solver s) {
+    
+    switch (s) {
+        case yices2:
+            close_yices2_solver();
+            if (yices_initialized) {
+                yices_exit();
+                yices_initialized = 0;
+            }
+            break;
+            
+        case smtlib2:
+            close_smtlib2_solver();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/**
+ Opens the file where the SMT-LIB2 solver writes the constraints, it has to be called before the solver is initialized
+ */
+int set_smtlib2_file(char *namefile) {
+    
+    if (smtlib2_file != NULL) {
+        fclose(smtlib2_file);
+    }
+    smtlib2_file = fopen(namefile, "w");
+    if (smtlib2_file == NULL) {
+        printf("The SMT-LIB2 file could not be created\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Creates a boolean guard for every frame of the network (but the protocol), so the constraints added afterwards for
+ a frame only hold while its guard is assumed when the solver is checked
+ */
+int create_frame_guards(Solver csolver) {
+    
+    char name[50];                      // String to store the name of a guard
+    
+    switch (csolver) {
+        case yices2:
+            tracked_free(memory_solver, frame_guards);
+            num_frame_guards = is_protocol_active() == 1 ? get_number_frames() - 1 : get_number_frames();
+            frame_guards = tracked_malloc(memory_solver, sizeof(term_t) * (num_frame_guards + 1));
+            for (int i = 0; i < num_frame_guards; i++) {
+                frame_guards[i] = yices_new_uninterpreted_term(yices_bool_type());
+                sprintf(name, "G_%d", i);
+                yices_set_term_name(frame_guards[i], name);
+            }
+            break;
+            
         default:
             break;
     }
+    return num_frame_guards;
 }
 
 /**
@@ -509,6 +955,23 @@ int create_offset_variables(Solver csolver) {
         frame_pt = get_frame(i);
         period = get_period(frame_pt);
         offset_it = get_offset_root(frame_pt);      // Get the offset root of the frame to iterate over all offsets
+        
+        // The offsets of a pinned frame already have their transmission times, they are constants for the solver
+        if (is_frame_pinned(frame_pt)) {
+            while (!is_last_offset(offset_it)) {
+                for (int instance = 0; instance < get_number_instances(offset_it); instance++) {
+                    for (int replica = 0; replica <= get_number_replicas(offset_it); replica++) {
+                        sprintf(name, "P_%d_%d_%d_%d", i, instance, replica, get_offset_link(offset_it));
+                        init_constant(offset_it, instance, replica, get_offset(offset_it, instance, replica), name,
+                                      csolver);
+                    }
+                }
+                offset_it = get_next_offset(offset_it);
+            }
+            continue;
+        }
+        
+        set_active_guard(i, -1);
         while (!is_last_offset(offset_it)) {
             
             // Get the number of replicas and instances of the offsets, as there is a variable for each one
@@ -549,7 +1012,8 @@ int create_offset_variables(Solver csolver) {
         }
     }
     
-    // Also create the offset variables for the protocol to save the space
+    // Also create the offset variables for the protocol to save the space, they are never guarded
+    active_guard = NULL_TERM;
     create_variables_protocol(csolver);
     
     return 0;
@@ -580,6 +1044,10 @@ int contention_free(Solver csolver) {
                     // For all frames that were previously iterated (so we save ourselves from duplicities)
                     for (int j = 0; j < i; j++) {
                         previous_frame_pt = get_frame(j);
+                        // Two frames pinned to the previous schedule are already known to not collide
+                        if (is_frame_pinned(frame_pt) && is_frame_pinned(previous_frame_pt)) {
+                            continue;
+                        }
                         previous_offset_it = get_frame_offset_by_link(previous_frame_pt, link);
                         // If the previous frame has an offset with the same link, continue
                         if (previous_offset_it != NULL) {
@@ -594,6 +1062,7 @@ int contention_free(Solver csolver) {
                                                                previous_replica)) {
                                         // Add the constraint to avoid the offsets to collide
                                         contention_free_counter += 1;
+                                        set_active_guard(i, j);
                                         if (avoid_intersection(offset_it, instance, replica, previous_offset_it,
                                                                previous_instance, previous_replica,
                                                                get_timeslot_size(offset_it) + time_between_frames - 1,
@@ -612,6 +1081,7 @@ int contention_free(Solver csolver) {
             offset_it = get_next_offset(offset_it);
         }
     }
+    active_guard = NULL_TERM;
     return 0;
 }
 
@@ -627,9 +1097,13 @@ int frame_path_dependent(Solver csolver) {
     int hop_delay = get_hop_delay();    // Minimum time that a frame has to wait in a switch to be relayed
     int distance;                       // Minimum distance between both consecutive links in a path
     
-    // For all the given frames
+    // For all the given frames, the pinned frames were already checked against their previous schedule
     for (int i = 0; i < get_number_frames(); i++) {
         frame_pt = get_frame(i);
+        if (is_frame_pinned(frame_pt)) {
+            continue;
+        }
+        set_active_guard(i, -1);
         // For all the paths of the frame, go path by path
         for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
             path_it = get_path_root(frame_pt, path_id);
@@ -648,6 +1122,7 @@ int frame_path_dependent(Solver csolver) {
             }
         }
     }
+    active_guard = NULL_TERM;
     return 0;
 }
 
@@ -664,9 +1139,13 @@ int frame_end_to_end_delay(Solver cssolver) {
     long long int distance;             // Maximum end to end delay distance
     long long int delay;                // End to end delay of the frame
     
-    // For all the given frames
+    // For all the given frames, the pinned frames were already checked against their previous schedule
     for (int i = 0; i < get_number_frames(); i++) {
         frame_pt = get_frame(i);
+        if (is_frame_pinned(frame_pt)) {
+            continue;
+        }
+        set_active_guard(i, -1);
         delay = get_end_to_end_delay(frame_pt);
         // For all the paths of the frame, go path by path
         for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
@@ -689,6 +1168,7 @@ int frame_end_to_end_delay(Solver cssolver) {
             }
         }
     }
+    active_guard = NULL_TERM;
     return 0;
 }
 
@@ -709,6 +1189,97 @@ int check_solver(Solver csolver) {
             return -1;
             break;
             
+        case smtlib2:
+            return -1;                  // The constraints are only written, there is no model
+            
+        default:
+            break;
+    }
+    return -1;
+}
+
+/**
+ Check the constraint solver assuming only the guards of the given frames, the constraints of the rest of frames are
+ ignored. If the constraints are satisfiable, it creates the schedule model
+ */
+int check_solver_subset(Solver csolver, int *active_frames) {
+    
+    term_t *assumptions;                // Guards of the active frames
+    int num_assumptions = 0;
+    smt_status_t status;
+    
+    switch (csolver) {
+        case yices2:
+            if (schedule_model != NULL) {
+                yices_free_model(schedule_model);
+                schedule_model = NULL;
+            }
+            assumptions = tracked_malloc(memory_solver, sizeof(term_t) * (num_frame_guards + 1));
+            for (int i = 0; i < num_frame_guards; i++) {
+                if (active_frames[i]) {
+                    assumptions[num_assumptions++] = frame_guards[i];
+                }
+            }
+            status = yices_check_context_with_assumptions(logical_context, NULL, num_assumptions, assumptions);
+            tracked_free(memory_solver, assumptions);
+            if (status == STATUS_SAT) {
+                schedule_model = yices_get_model(logical_context, 1);       // Get the model with the schedule
+                return 1;
+            }
+            if (status == STATUS_UNSAT) {
+                return 0;
+            }
+            return -1;
+            break;
+            
+        default:
+            break;
+    }
+    return -1;
+}
+
+/**
+ Get the frames whose guards are in the unsatisfiable core of the last check of a subset of frames
+ */
+int get_conflicting_frames(Solver csolver, int *frames) {
+    
+    term_vector_t core;                 // Guards that cannot be assumed together
+    int num_frames = 0;
+    
+    switch (csolver) {
+        case yices2:
+            yices_init_term_vector(&core);
+            if (yices_get_unsat_core(logical_context, &core) == 0) {
+                for (int i = 0; i < (int) core.size; i++) {
+                    for (int frame_id = 0; frame_id < num_frame_guards; frame_id++) {
+                        if (frame_guards[frame_id] == core.data[i]) {
+                            frames[num_frames++] = frame_id;
+                            break;
+                        }
+                    }
+                }
+            }
+            yices_delete_term_vector(&core);
+            break;
+            
+        default:
+            break;
+    }
+    return num_frames;
+}
+
+/**
+ Stops the search of the given solver if it is checking the constraints
+ */
+void stop_solver(Solver csolver) {
+    
+    switch (csolver) {
+        case yices2:
+            if (logical_context != NULL) {
+                yices_stop_search(logical_context);
+            }
+            break;
+            
         default:
             break;
     }
@@ -723,9 +1294,12 @@ void save_offsets(Solver csolver) {
     Frame *frame_pt;                    // Pointer to a frame of the network
     long long int transmission_time;    // Transmission time of a offset
     
-    // For all the given frames, look for all its offsets
+    // For all the given frames, look for all its offsets (pinned frames already have their transmission times)
     for (int i = 0; i < get_number_frames(); i++) {
         frame_pt = get_frame(i);
+        if (is_frame_pinned(frame_pt)) {
+            continue;
+        }
         offset_it = get_offset_root(frame_pt);      // Get the offset root of the frame to iterate over all offsets
         while (!is_last_offset(offset_it)) {
             // Iterate over all replicas and instances
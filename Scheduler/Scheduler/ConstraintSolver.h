@@ -8,6 +8,7 @@
  *                                                                                                                     *
  *  Package that contains the constraints that are solved by the solver                                                *
  *  We plan to implement many different solvers, such as Z3, ILP, Gurobi, etc. But for now we only implement Yices 2   *
+ *  The smtlib2 solver does not solve them, it writes them in a SMT-LIB2 file to benchmark other solvers offline       *
  *                                                                                                                     *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -26,11 +27,56 @@
  Avaliable solvers
  */
 typedef enum Solver{
-    yices2
+    yices2,
+    smtlib2                             // Writes the constraints in a SMT-LIB2 file instead of solving them
 }Solver;
 
                                                 /* CODE DEFINITIONS */
 
+/**
+ Get the number of offset variables created in the solver (the offsets of the pinned frames are constants)
+
+ @return number of variables
+ */
+int get_number_variables(void);
+
+/**
+ Get the number of constraint formulas added into the solver
+
+ @return number of formulas
+ */
+int get_number_formulas(void);
+
+/**
+ Get the number of disjunctions added into the solver, the contention free formulas
+
+ @return number of disjunctions
+ */
+int get_number_disjunctions(void);
+
+/**
+ Get the number of terms in the global tables of yices, the memory of the tables is not exposed by yices so the terms
+ are the measure of its size. They are kept until the solver finishes, so they grow with every schedule
+
+ @return number of terms, 0 if yices is not initialized
+ */
+int get_number_terms(void);
+
+/**
+ Get the number of types in the global tables of yices
+
+ @return number of types, 0 if yices is not initialized
+ */
+int get_number_types(void);
+
+/**
+ Initializes the global memory of the given solver, it is done once and shared by all the schedules. If it is not
+ called, it is done when the first schedule starts
+
+ @param s solver to initialize
+ */
+void init_solver(Solver s);
+
 /**
  Initialize the given solver to start the scheduling process
 
@@ -39,7 +85,63 @@ typedef enum Solver{
 void initialize_solver(Solver s);
 
 /**
- Creates the offset variables for all frames in the network, then adds them into the logical context
+ Sets the time unit of the transmission times in the solver, to shrink the values of the offsets and constraints. It
+ has to be set once the solver is initialized and before the offset variables are created, as every time is converted
+ when it is added into the solver, and the transmission times found are converted back to ns when they are saved.
+ The transmission times are only searched in the grid, TIME_GRID_ORIGIN ns after a multiple of the granularity, so
+ every schedule found is also a schedule in ns. The limits are rounded so they hold for the same times of the grid,
+ and a strict limit multiple of the granularity takes a whole unit. Only yices2 is scaled, the SMT-LIB2 file is always
+ in ns
+
+ @param granularity time unit in ns, see get_time_granularity in Network.h
+ @param s solver used in the scheduling process
+ */
+void set_solver_granularity(long long int granularity, Solver s);
+
+/**
+ Get the time unit of the transmission times in the solver
+
+ @return time unit in ns, 1 if the times are not scaled
+ */
+long long int get_solver_granularity(void);
+
+/**
+ Frees the memory used by the given solver after the scheduling process
+
+ @param s solver used in the scheduling process
+ */
+void close_solver(Solver s);
+
+/**
+ Finishes the given solver and frees all its global memory, no more schedules can be synthesized afterwards
+
+ @param s solver to finish
+ */
+void exit_solver(Solver s);
+
+/**
+ Opens the file where the SMT-LIB2 solver writes the constraints, one declaration or assertion per line as they are
+ added, so the problem is not kept in memory. The file is closed when the solver is closed.
+ It has to be called before the solver is initialized
+
+ @param namefile path and name of the file to create
+ @return 0 if the file was opened, -1 otherwise
+ */
+int set_smtlib2_file(char *namefile);
+
+/**
+ Creates a boolean guard for every frame of the network (but the protocol), so the constraints added afterwards for
+ a frame only hold while its guard is assumed when the solver is checked with check_solver_subset.
+ It has to be called after the solver is initialized and before any constraint is added
+
+ @param csolver indicates which solver are we using
+ @return number of guards created
+ */
+int create_frame_guards(Solver csolver);
+
+/**
+ Creates the offset variables for all frames in the network, then adds them into the logical context.
+ The offsets of the frames pinned to a previous schedule are added as constants with their transmission times
 
  @param csolver indicates which solver are we using
  @return 0 if everything was ok, -1 if there was a problem creating the offset variables
@@ -47,7 +149,8 @@ void initialize_solver(Solver s);
 int create_offset_variables(Solver csolver);
 
 /**
- Assures that no frames are allowed to be transmitted at the same time in the same link
+ Assures that no frames are allowed to be transmitted at the same time in the same link.
+ Constraints between two pinned frames are skipped, as they do not share transmission time in the previous schedule
 
  @param csolver indicates which solver are we using
  @return 0 if everything was ok, -1 if there was a problem creating the contention free constraints
@@ -70,6 +173,14 @@ int frame_path_dependent(Solver csolver);
  */
 int frame_end_to_end_delay(Solver cssolver);
 
+/**
+ Prints the needed constraint formulas of the last scheduling and the amount of bytes to send all the schedule
+ constraints
+
+ @return amount of bytes needed to send the schedule constraints
+ */
+int bytes_needed(void);
+
 /**
  Check the constraint solver and returns the status of it, if everything went well, it creates the schedule model
 
@@ -78,6 +189,34 @@ int frame_end_to_end_delay(Solver cssolver);
  */
 int check_solver(Solver csolver);
 
+/**
+ Check the constraint solver assuming only the guards of the given frames, so the constraints of the rest of frames
+ are ignored. If the constraints are satisfiable, it creates the schedule model. The guards have to be created before
+
+ @param csolver indicates which solver are we using
+ @param active_frames array with 1 for every frame whose constraints hold and 0 for the rest (without the protocol)
+ @return 1 if the schedule was found, 0 if the constraints are unsatisfiable, -1 if the solver was stopped or failed
+ */
+int check_solver_subset(Solver csolver, int *active_frames);
+
+/**
+ Get the frames whose guards are in the unsatisfiable core of the last check_solver_subset, at least one of them has
+ to be left out to find a schedule
+
+ @param csolver indicates which solver are we using
+ @param frames array where the identifiers of the frames are saved, as long as the number of guards
+ @return number of frames in the core, 0 if there is no core
+ */
+int get_conflicting_frames(Solver csolver, int *frames);
+
+/**
+ Stops the search of the given solver if it is checking the constraints, then check_solver returns as not found.
+ It can be called from another thread while the solver is checking
+
+ @param csolver indicates which solver are we using
+ */
+void stop_solver(Solver csolver);
+
 /**
  Get the values obtained in the constraint solver and saves them into the offset variables as long long integers
 
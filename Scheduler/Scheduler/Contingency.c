@@ -0,0 +1,301 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Contingency.c                                                                                                      *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Contingency.h                                                                                       *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Contingency.h"
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the name of a scenario, used as prefix of its files
+
+ @param scenario pointer to the scenario
+ @param name string where the name is written
+ @param size size of the string
+ */
+void get_scenario_name(ContingencyScenario *scenario, char *name, int size) {
+    
+    snprintf(name, size, "%s_%d", scenario->kind == contingency_link ? "link" : "node", scenario->element);
+}
+
+/**
+ Get the links that fail in a scenario
+
+ @param scenario pointer to the scenario
+ @param link_ids array where the identifiers of the links are saved, its size has to be the number of links
+ @return number of failed links
+ */
+int get_scenario_links(ContingencyScenario *scenario, int *link_ids) {
+    
+    int num_links = 0;
+    
+    if (scenario->kind == contingency_link) {
+        link_ids[0] = scenario->element;
+        return 1;
+    }
+    for (int i = 0; i < get_number_links(); i++) {
+        if (get_link_source(get_link(i)) == scenario->element ||
+            get_link_destination(get_link(i)) == scenario->element) {
+            link_ids[num_links++] = i;
+        }
+    }
+    return num_links;
+}
+
+/**
+ Repairs a scenario in the process forked for it, from the base schedule in memory, and exits. The output of the
+ library is written in the log file of the scenario. The scenario is running until its outcome is written at the end,
+ so if the process dies it is crashed
+
+ @param scenario pointer to the scenario in shared memory
+ @param output_directory directory of the base schedule and the files of the scenario
+ @param options pointer to the options of the scheduler
+ */
+void repair_scenario(ContingencyScenario *scenario, char *output_directory, SchedulerOptions *options) {
+    
+    RegenerationResult result;
+    char name[64], path[CONTINGENCY_PATH_SIZE], base[CONTINGENCY_PATH_SIZE];
+    int *link_ids, num_links;
+    ContingencyState state = contingency_unrepairable;     // Outcome of the scenario
+    
+    get_scenario_name(scenario, name, sizeof(name));
+    snprintf(path, sizeof(path), "%s/%s.log", output_directory, name);
+    fflush(stdout);
+    freopen(path, "w", stdout);
+    
+    link_ids = malloc(sizeof(int) * get_number_links());
+    num_links = get_scenario_links(scenario, link_ids);
+    if (srs_regenerate_links_failure(num_links, link_ids, options, &result) != -1) {
+        snprintf(path, sizeof(path), "%s/%s-", output_directory, name);
+        snprintf(base, sizeof(base), "%s/%s", output_directory, CONTINGENCY_BASE_SCHEDULE);
+        scenario->delta_bytes = srs_write_schedule_delta(base, path);
+        if (scenario->delta_bytes != -1) {
+            state = result.num_lost > 0 ? contingency_degraded : contingency_repaired;
+        }
+    }
+    scenario->num_affected = result.num_affected;
+    scenario->num_lost = result.num_lost;
+    scenario->repair_time = result.recovery_time;
+    printf("Scenario %s repaired in ms => %f\n", name, scenario->repair_time);
+    fflush(stdout);
+    scenario->state = state;
+    _exit(0);
+}
+
+/**
+ Get the name of the outcome of a scenario
+
+ @param state outcome of the scenario
+ @return name of the outcome
+ */
+const char * get_contingency_state_name(ContingencyState state) {
+    
+    switch (state) {
+        case contingency_repaired:
+            return "repaired";
+        case contingency_degraded:
+            return "degraded";
+        case contingency_unrepairable:
+            return "unrepairable";
+        case contingency_crashed:
+            return "crashed";
+        case contingency_running:
+            return "running";
+        default:
+            return "pending";
+    }
+}
+
+/**
+ Writes the index with the outcome of every scenario and the storage needed
+
+ @param file file where to write the index
+ @param scenarios array of scenarios
+ @param num_scenarios number of scenarios
+ @param base_bytes bytes of the base schedule
+ @param total_time time to precompute all the scenarios in ms
+ */
+void write_contingency_index(FILE *file, ContingencyScenario *scenarios, int num_scenarios, long long int base_bytes,
+                             double total_time) {
+    
+    char name[64];
+    long long int delta_bytes = 0;
+    int without_repair = 0;
+    
+    fprintf(file, "%-16s %-14s %10s %8s %14s %12s\n", "Scenario", "Outcome", "Affected", "Lost", "Delta bytes",
+            "Repair ms");
+    for (int i = 0; i < num_scenarios; i++) {
+        get_scenario_name(&scenarios[i], name, sizeof(name));
+        fprintf(file, "%-16s %-14s %10d %8d %14lld %12.3f\n", name, get_contingency_state_name(scenarios[i].state),
+                scenarios[i].num_affected, scenarios[i].num_lost, scenarios[i].delta_bytes, scenarios[i].repair_time);
+        if (scenarios[i].state == contingency_repaired || scenarios[i].state == contingency_degraded) {
+            delta_bytes += scenarios[i].delta_bytes;
+        } else {
+            without_repair++;
+        }
+    }
+    fprintf(file, "Scenarios without repair: %d of %d\n", without_repair, num_scenarios);
+    fprintf(file, "Bytes of the base schedule: %lld\n", base_bytes);
+    fprintf(file, "Bytes of all the deltas: %lld\n", delta_bytes);
+    fprintf(file, "Time to precompute all scenarios in ms => %f\n", total_time);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Precomputes the repaired schedules of all the single failures of a network as deltas with its base schedule
+ */
+int precompute_contingencies(char *network_file, char *output_directory, int include_nodes, int num_workers,
+                             struct SchedulerOptions *options) {
+    
+    SchedulerOptions contingency_options;       // Options used to repair every scenario
+    ContingencyScenario *scenarios;
+    struct timeval start_time, end_time;
+    struct stat base_stat;
+    char path[CONTINGENCY_PATH_SIZE];
+    size_t scenarios_size;
+    pid_t *workers, worker;
+    int num_scenarios = 0, num_nodes, *node_links, next = 0, running = 0, status, without_repair = 0;
+    FILE *index;
+    
+    if (options == NULL) {
+        init_scheduler_options(&contingency_options);
+    } else {
+        contingency_options = *options;
+    }
+    if (contingency_options.num_threads == 0) {
+        contingency_options.num_threads = 1;
+    }
+    
+    // The output directory is created if it does not exist yet
+    if (mkdir(output_directory, S_IRWXU | S_IRWXG | S_IRWXO) == -1 && errno != EEXIST) {
+        printf("The output directory %s could not be created: %s\n", output_directory, strerror(errno));
+        return -1;
+    }
+    if (stat(output_directory, &base_stat) == -1 || !S_ISDIR(base_stat.st_mode)) {
+        printf("The output %s is not a directory\n", output_directory);
+        return -1;
+    }
+    
+    // Base schedule, kept in memory to be inherited by the processes of the scenarios
+    gettimeofday(&start_time, NULL);
+    snprintf(path, sizeof(path), "%s/%s", output_directory, CONTINGENCY_BASE_SCHEDULE);
+    if (srs_load_network(network_file) == -1 || srs_schedule(&contingency_options) == -1) {
+        printf("The base schedule of the network could not be found\n");
+        srs_free_network();
+        return -1;
+    }
+    if (srs_write_schedule_compact(path, 1) == -1 || stat(path, &base_stat) == -1) {
+        printf("The base schedule could not be written in %s\n", path);
+        srs_free_network();
+        return -1;
+    }
+    
+    // One scenario per link, and per node connected to any link
+    num_nodes = include_nodes ? get_number_nodes() : 0;
+    node_links = calloc(get_number_nodes() + 1, sizeof(int));
+    for (int i = 0; i < get_number_links(); i++) {
+        if (get_link_source(get_link(i)) >= 0) {
+            node_links[get_link_source(get_link(i))]++;
+        }
+        if (get_link_destination(get_link(i)) >= 0) {
+            node_links[get_link_destination(get_link(i))]++;
+        }
+    }
+    scenarios_size = sizeof(ContingencyScenario) * (get_number_links() + num_nodes);
+    scenarios = mmap(NULL, scenarios_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (scenarios == MAP_FAILED) {
+        printf("The shared memory of the scenarios could not be created\n");
+        free(node_links);
+        srs_free_network();
+        return -1;
+    }
+    memset(scenarios, 0, scenarios_size);
+    for (int i = 0; i < get_number_links(); i++) {
+        scenarios[num_scenarios].kind = contingency_link;
+        scenarios[num_scenarios++].element = i;
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        if (node_links[i] > 0) {
+            scenarios[num_scenarios].kind = contingency_node;
+            scenarios[num_scenarios++].element = i;
+        }
+    }
+    free(node_links);
+    
+    if (num_workers <= 0) {
+        num_workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_workers <= 0) {
+        num_workers = 1;
+    }
+    
+    // Every scenario is repaired in its own process, so all start from the base schedule in memory
+    workers = malloc(sizeof(pid_t) * num_scenarios);
+    while (next < num_scenarios || running > 0) {
+        if (next < num_scenarios && running < num_workers) {
+            scenarios[next].state = contingency_running;
+            fflush(stdout);
+            workers[next] = fork();
+            if (workers[next] == 0) {
+                repair_scenario(&scenarios[next], output_directory, &contingency_options);
+            }
+            if (workers[next] == -1) {
+                scenarios[next].state = contingency_crashed;
+            } else {
+                running++;
+            }
+            next++;
+            continue;
+        }
+        worker = wait(&status);
+        if (worker == -1) {
+            break;
+        }
+        running--;
+        for (int i = 0; i < next; i++) {
+            if (workers[i] == worker && scenarios[i].state == contingency_running) {
+                scenarios[i].state = contingency_crashed;
+            }
+        }
+    }
+    gettimeofday(&end_time, NULL);
+    
+    for (int i = 0; i < num_scenarios; i++) {
+        if (scenarios[i].state != contingency_repaired && scenarios[i].state != contingency_degraded) {
+            without_repair++;
+        }
+    }
+    write_contingency_index(stdout, scenarios, num_scenarios, base_stat.st_size, time_diff(start_time, end_time));
+    snprintf(path, sizeof(path), "%s/%s", output_directory, CONTINGENCY_INDEX);
+    index = fopen(path, "w");
+    if (index != NULL) {
+        write_contingency_index(index, scenarios, num_scenarios, base_stat.st_size, time_diff(start_time, end_time));
+        fclose(index);
+    } else {
+        printf("The index of the scenarios could not be created\n");
+    }
+    
+    free(workers);
+    munmap(scenarios, scenarios_size);
+    srs_free_network();
+    return without_repair;
+}
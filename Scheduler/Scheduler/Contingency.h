@@ -0,0 +1,86 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Contingency.h                                                                                                      *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that precomputes offline the repaired schedules of all the single failures of a network (N-1), so at       *
+ *  runtime the failover only applies a delta that is already computed instead of regenerating the schedule.           *
+ *  The base schedule of the network is synthesized once. Every scenario (the failure of one link, or of all the links *
+ *  of one node) is then regenerated in a process forked from the one with the base schedule in memory, so it reroutes *
+ *  and schedules only the affected frames while the rest keep their base offsets (see Regeneration.h). Several        *
+ *  scenarios are repaired at the same time, and a scenario whose process crashes is reported as crashed.              *
+ *  The output directory keeps the base compact schedule, the delta files of every scenario with the base schedule     *
+ *  (one per node, see ScheduleDelta.h) named after the scenario, a log per scenario, and an index with the outcome of *
+ *  every scenario. The scenarios without repair and the total storage of the deltas are reported.                     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Contingency_h
+#define Contingency_h
+
+#include <stdio.h>
+
+#endif /* Contingency_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define CONTINGENCY_PATH_SIZE 1024
+#define CONTINGENCY_BASE_SCHEDULE "base.srss"
+#define CONTINGENCY_INDEX "contingencies.txt"
+
+struct SchedulerOptions;                // Options of the scheduler, defined in Synthesizer.h
+
+/**
+ Element that fails in a scenario
+ */
+typedef enum ContingencyKind {
+    contingency_link,                   // One link fails
+    contingency_node                    // All the links that start or end in one node fail
+}ContingencyKind;
+
+/**
+ Outcome of a scenario
+ */
+typedef enum ContingencyState {
+    contingency_pending,                // Not repaired yet
+    contingency_running,                // Being repaired by a process
+    contingency_repaired,               // Schedule found for all the frames
+    contingency_degraded,               // Schedule found, but some frames have no path that avoids the failure
+    contingency_unrepairable,           // No schedule found
+    contingency_crashed                 // The process crashed while repairing it
+}ContingencyState;
+
+/**
+ Failure scenario with its outcome
+ */
+typedef struct ContingencyScenario {
+    ContingencyKind kind;
+    int element;                        // Identifier of the failed link or node
+    ContingencyState state;
+    int num_affected;                   // Number of frames rerouted and scheduled again
+    int num_lost;                       // Number of frames without path, removed in the repaired schedule
+    long long int delta_bytes;          // Bytes of all the delta files of the scenario
+    double repair_time;                 // Time to repair the schedule in ms
+}ContingencyScenario;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Precomputes the repaired schedules of all the single link failures of a network, and optionally of all the single
+ node failures, as deltas with the base schedule written in the output directory.
+ srs_init has to be called before, and there cannot be a network in memory
+
+ @param network_file path of the network file (xml or binary)
+ @param output_directory directory where the base schedule, the deltas, the logs and the index are written, it is
+ created if it does not exist
+ @param include_nodes 1 to also precompute the failure of every node, 0 for only the links
+ @param num_workers number of scenarios repaired at the same time, 0 to use one per available processor
+ @param options pointer to the options of the scheduler, NULL to use the default ones. The time budget applies to
+ the base schedule and to every scenario
+ @return number of scenarios without repair (unrepairable or crashed), -1 if the base schedule was not found
+ */
+int precompute_contingencies(char *network_file, char *output_directory, int include_nodes, int num_workers,
+                             struct SchedulerOptions *options);
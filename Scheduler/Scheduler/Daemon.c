@@ -0,0 +1,924 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Daemon.c                                                                                                           *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Daemon.h                                                                                            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Daemon.h"
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+
+                                                    /* VARIABLES */
+
+volatile sig_atomic_t daemon_stopped = 0;           // 1 when the daemon received SIGINT or SIGTERM
+pid_t *daemon_sessions = NULL;                      // Process of the session served in every slot, 0 if it is free
+char (*daemon_directories)[64] = NULL;              // Temporal directory of the session served in every slot
+int daemon_max_sessions = 0;                        // Number of slots, sessions served at the same time
+
+// Files that a session can leave in its directory, the network and the schedules the client sends or receives are
+// always kept there, so a request cannot read or write any other file
+const char *session_files[] = {"network.srsn", "schedule.srss", "schedule.srst", "schedule.xml", "received.network",
+                               "metrics.json", NULL};
+
+// State of the session served by this process, every session is a different process
+SchedulerOptions session_options;                   // Options of the scheduler of the session
+char session_directory[64];                         // Temporal directory with the files of the session
+char session_network[128];                          // Binary network file with the network of the session
+char session_schedule[128];                         // Compact schedule file with the last schedule found
+int session_has_network = 0;                        // 1 if the session has a network
+int session_has_schedule = 0;                       // 1 if a schedule has been found for the network of the session
+int session_in_memory = 0;                          // 1 if the network of the session is loaded in the library
+int session_scheduled = 0;                          // 1 if the network in memory is scheduled
+char *session_failed_links = NULL;                  // For every link, 1 if it has failed
+char *session_requests = NULL;                      // Received data that is not part of the requests served yet
+size_t session_length = 0;                          // Length of the received data not served yet
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Handler of SIGINT and SIGTERM, the daemon stops accepting sessions
+
+ @param signal_number number of the signal
+ */
+void stop_daemon(int signal_number) {
+    
+    daemon_stopped = 1;
+}
+
+/**
+ Sends a reply line to the client of the session
+
+ @param client socket of the client
+ @param format format of the reply as in printf, without the end of line
+ @return 0 if sent, -1 if the client closed the connection
+ */
+int send_reply(int client, const char *format, ...) {
+    
+    char reply[DAEMON_REQUEST_SIZE];
+    va_list arguments;
+    ssize_t sent;
+    int length, position = 0;
+    
+    va_start(arguments, format);
+    length = vsnprintf(reply, sizeof(reply) - 1, format, arguments);
+    va_end(arguments);
+    if (length > (int) sizeof(reply) - 2) {
+        length = (int) sizeof(reply) - 2;
+    }
+    reply[length++] = '\n';
+    
+    while (position < length) {
+        sent = write(client, reply + position, length - position);
+        if (sent <= 0) {
+            return -1;
+        }
+        position += sent;
+    }
+    return 0;
+}
+
+/**
+ Receives the bytes that the client sends after a request and writes them in a file of the session. All of them are
+ received even if the file cannot be written, so the next request starts where it has to
+
+ @param client socket of the client
+ @param size number of bytes to receive
+ @param namefile file of the session where to write the bytes
+ @return 0 if done correctly, -1 if the file could not be written, -2 if the client closed the connection
+ */
+int receive_file(int client, long long int size, char *namefile) {
+    
+    FILE *file = fopen(namefile, "wb");
+    char buffer[4096];
+    size_t length;
+    ssize_t received;
+    int status = file == NULL ? -1 : 0;
+    
+    // Part of the bytes can be already received together with the request
+    length = session_length < (size_t) size ? session_length : (size_t) size;
+    if (status == 0 && fwrite(session_requests, 1, length, file) != length) {
+        status = -1;
+    }
+    memmove(session_requests, session_requests + length, session_length - length);
+    session_length -= length;
+    size -= length;
+    
+    while (size > 0) {
+        received = read(client, buffer, size < (long long int) sizeof(buffer) ? (size_t) size : sizeof(buffer));
+        if (received <= 0) {
+            if (file != NULL) {
+                fclose(file);
+            }
+            return -2;
+        }
+        if (status == 0 && fwrite(buffer, 1, received, file) != (size_t) received) {
+            status = -1;
+        }
+        size -= received;
+    }
+    if (file != NULL && fclose(file) != 0) {
+        status = -1;
+    }
+    return status;
+}
+
+/**
+ Sends a file of the session to the client, after a reply line with its size
+
+ @param client socket of the client
+ @param namefile file of the session to send
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int send_file(int client, char *namefile) {
+    
+    char buffer[4096];
+    FILE *file;
+    long size;
+    size_t length;
+    
+    if ((file = fopen(namefile, "rb")) == NULL) {
+        return send_reply(client, "ERROR the file could not be read");
+    }
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (send_reply(client, "OK %ld", size) == -1) {
+        fclose(file);
+        return -1;
+    }
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        if (write(client, buffer, length) != (ssize_t) length) {
+            fclose(file);
+            return -1;
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+/**
+ Removes the directory of a session with all the files it can have
+
+ @param directory directory of the session
+ */
+void remove_session_directory(char *directory) {
+    
+    char namefile[128];
+    
+    for (int i = 0; session_files[i] != NULL; i++) {
+        snprintf(namefile, sizeof(namefile), "%s/%s", directory, session_files[i]);
+        unlink(namefile);
+    }
+    rmdir(directory);
+}
+
+/**
+ Frees the slot of a session whose process finished, and removes its directory if the session could not do it
+
+ @param session process of the session
+ */
+void release_session(pid_t session) {
+    
+    for (int i = 0; i < daemon_max_sessions; i++) {
+        if (daemon_sessions[i] == session) {
+            remove_session_directory(daemon_directories[i]);
+            daemon_sessions[i] = 0;
+            return;
+        }
+    }
+}
+
+/**
+ Makes sure that the network of the session is in memory and not scheduled, so it can be modified or scheduled.
+ It is loaded again from the binary network file of the session, which is much faster than parsing a xml file
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int prepare_session_network(void) {
+    
+    if (session_in_memory && !session_scheduled) {
+        return 0;
+    }
+    srs_free_network();
+    session_in_memory = 0;
+    session_scheduled = 0;
+    if (srs_load_network_binary(session_network) == -1) {
+        return -1;
+    }
+    session_in_memory = 1;
+    
+    // The binary network file does not keep which links have failed
+    for (int i = 0; i < get_number_links(); i++) {
+        if (session_failed_links[i]) {
+            set_link_failed(get_link(i), 1);
+        }
+    }
+    return 0;
+}
+
+/**
+ Saves the network in memory, after it is modified, as the network of the session
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int save_session_network(void) {
+    
+    if (srs_write_network_binary(session_network) == -1) {
+        srs_free_network();
+        session_in_memory = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Loads the network file that the client sends after the request as the network of the session, replacing the
+ previous one. The daemon does not read any file chosen by the client
+
+ @param client socket of the client
+ @param arguments arguments of the request, the size of the network file in bytes
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_load(int client, char *arguments) {
+    
+    char *bytes = strtok(arguments, " \t");
+    char received_network[128];
+    long long int size;
+    int status;
+    
+    if (bytes == NULL || (size = atoll(bytes)) <= 0) {
+        return send_reply(client, "ERROR missing size of the network file");
+    }
+    snprintf(received_network, sizeof(received_network), "%s/received.network", session_directory);
+    status = receive_file(client, size, received_network);
+    if (status == -2) {
+        return -1;
+    }
+    srs_free_network();
+    session_in_memory = 0;
+    session_scheduled = 0;
+    session_has_network = 0;
+    session_has_schedule = 0;
+    unlink(session_schedule);
+    if (status == -1 || srs_load_network(received_network) == -1) {
+        unlink(received_network);
+        return send_reply(client, "ERROR the network could not be loaded");
+    }
+    unlink(received_network);
+    session_in_memory = 1;
+    if (save_session_network() == -1) {
+        return send_reply(client, "ERROR the network could not be saved in the session");
+    }
+    session_has_network = 1;
+    free(session_failed_links);
+    session_failed_links = calloc(get_number_links(), sizeof(char));
+    return send_reply(client, "OK %d %d", get_number_frames(), get_number_links());
+}
+
+/**
+ Schedules the network of the session, keeping the offsets of the frames that did not change since the previous
+ schedule. If they leave no room, the network is scheduled from scratch with the remaining time budget
+
+ @param client socket of the client
+ @param arguments arguments of the request, the optional time budget in ms
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_schedule(int client, char *arguments) {
+    
+    SchedulerOptions options = session_options;
+    struct timeval start_time, end_time;
+    char *budget = strtok(arguments, " \t");
+    long long int remaining;
+    int status, timed_out = 0;
+    
+    gettimeofday(&start_time, NULL);
+    if (!session_has_network) {
+        return send_reply(client, "ERROR there is no network in the session");
+    }
+    if (budget != NULL) {
+        options.time_budget = atoll(budget);
+    }
+    if (session_scheduled) {
+        return send_reply(client, "OK 0");
+    }
+    
+    if (prepare_session_network() == -1) {
+        return send_reply(client, "ERROR the network of the session could not be loaded");
+    }
+    options.previous_schedule = session_has_schedule ? session_schedule : NULL;
+    status = srs_schedule(&options);
+    if (status == -1 && !is_time_budget_exceeded() && options.previous_schedule != NULL) {
+        // The pinned frames leave no room for the rest, try again from scratch in the remaining time budget
+        gettimeofday(&end_time, NULL);
+        remaining = options.time_budget - (long long int) time_diff(start_time, end_time);
+        options.previous_schedule = NULL;
+        session_in_memory = 0;
+        if (options.time_budget > 0 && remaining <= 0) {
+            timed_out = 1;
+        } else {
+            options.time_budget = options.time_budget > 0 ? remaining : 0;
+            if (prepare_session_network() != -1) {
+                status = srs_schedule(&options);
+            }
+        }
+    }
+    if (status == -1) {
+        // The library frees the network when no schedule is found
+        session_in_memory = 0;
+        if (timed_out || is_time_budget_exceeded()) {
+            return send_reply(client, "ERROR time budget exceeded");
+        }
+        return send_reply(client, "ERROR no schedule found");
+    }
+    
+    session_scheduled = 1;
+    session_has_schedule = srs_write_schedule_compact(session_schedule, 1) != -1;
+    gettimeofday(&end_time, NULL);
+    return send_reply(client, "OK %f", time_diff(start_time, end_time));
+}
+
+/**
+ Adds a new frame to the network of the session
+
+ @param client socket of the client
+ @param arguments arguments of the request, the information of the frame followed by its paths
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_add_frame(int client, char *arguments) {
+    
+    char **tokens, *link, *save;
+    int num_tokens = 0, num_paths, frame_id, status = 0;
+    int *path, len_path;
+    
+    if (!session_has_network) {
+        return send_reply(client, "ERROR there is no network in the session");
+    }
+    tokens = malloc(sizeof(char *) * (strlen(arguments) / 2 + 1));
+    for (char *token = strtok(arguments, " \t"); token != NULL; token = strtok(NULL, " \t")) {
+        tokens[num_tokens++] = token;
+    }
+    num_paths = num_tokens - 5;
+    if (num_paths <= 0) {
+        free(tokens);
+        return send_reply(client, "ERROR the frame needs its information and at least one path");
+    }
+    if (prepare_session_network() == -1) {
+        free(tokens);
+        return send_reply(client, "ERROR the network of the session could not be loaded");
+    }
+    
+    frame_id = srs_new_frame();
+    if (frame_id == -1 || srs_add_frame(frame_id, atoll(tokens[0]), atoll(tokens[1]), atoi(tokens[2]),
+                                        atoll(tokens[3]), atoll(tokens[4]), num_paths, 0) == -1) {
+        status = -1;
+    }
+    path = malloc(sizeof(int) * get_number_links() * 2);
+    for (int i = 0; i < num_paths && status == 0; i++) {
+        len_path = 0;
+        for (link = strtok_r(tokens[5 + i], ",", &save); link != NULL && len_path < get_number_links() * 2;
+             link = strtok_r(NULL, ",", &save)) {
+            path[len_path] = atoi(link);
+            if (path[len_path] >= 0 && path[len_path] < get_number_links() && session_failed_links[path[len_path]]) {
+                status = -1;
+            }
+            len_path++;
+        }
+        if (status == 0 && srs_add_frame_path(frame_id, i, path, len_path) == -1) {
+            status = -1;
+        }
+    }
+    free(path);
+    free(tokens);
+    
+    // The network in memory has a frame half added, so the network of the session is loaded again
+    if (status == -1) {
+        srs_free_network();
+        session_in_memory = 0;
+        return send_reply(client, "ERROR the frame is not valid or uses a failed link");
+    }
+    if (save_session_network() == -1) {
+        return send_reply(client, "ERROR the network could not be saved in the session");
+    }
+    return send_reply(client, "OK %d", frame_id);
+}
+
+/**
+ Removes a frame of the network of the session
+
+ @param client socket of the client
+ @param arguments arguments of the request, the identifier of the frame
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_remove_frame(int client, char *arguments) {
+    
+    char *frame = strtok(arguments, " \t");
+    
+    if (!session_has_network) {
+        return send_reply(client, "ERROR there is no network in the session");
+    }
+    if (frame == NULL) {
+        return send_reply(client, "ERROR missing frame");
+    }
+    if (prepare_session_network() == -1) {
+        return send_reply(client, "ERROR the network of the session could not be loaded");
+    }
+    if (srs_remove_frame(atoi(frame)) == -1) {
+        return send_reply(client, "ERROR the frame does not exist");
+    }
+    if (save_session_network() == -1) {
+        return send_reply(client, "ERROR the network could not be saved in the session");
+    }
+    return send_reply(client, "OK");
+}
+
+/**
+ Writes the frames of a regeneration result in a reply
+
+ @param reply string where the frames are written
+ @param size size of the reply string
+ @param num_frames number of frames
+ @param frames identifiers of the frames
+ @return number of characters written
+ */
+int write_reply_frames(char *reply, int size, int num_frames, int *frames) {
+    
+    int length = snprintf(reply, size, " %d", num_frames);
+    
+    for (int i = 0; i < num_frames && length < size - 16; i++) {
+        length += snprintf(reply + length, size - length, " %d", frames[i]);
+    }
+    return length;
+}
+
+/**
+ Fails a link of the network of the session, new frames cannot use it. The frames transmitted in it are rerouted
+ through the best paths that avoid the failed links, and removed if there is none. If the network is scheduled,
+ only the affected frames are scheduled again and the rest keep their offsets
+
+ @param client socket of the client
+ @param arguments arguments of the request, the identifier of the link and the optional time budget in ms
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_fail_link(int client, char *arguments) {
+    
+    SchedulerOptions options = session_options;
+    char *link = strtok(arguments, " \t");
+    char *budget = strtok(NULL, " \t");
+    char affected[DAEMON_REQUEST_SIZE / 2], lost[DAEMON_REQUEST_SIZE / 2];
+    RegenerationResult result;
+    int link_id, status;
+    
+    if (!session_has_network) {
+        return send_reply(client, "ERROR there is no network in the session");
+    }
+    if (link == NULL) {
+        return send_reply(client, "ERROR missing link");
+    }
+    if (budget != NULL) {
+        options.time_budget = atoll(budget);
+    }
+    link_id = atoi(link);
+    if (!session_scheduled && prepare_session_network() == -1) {
+        return send_reply(client, "ERROR the network of the session could not be loaded");
+    }
+    if (link_id < 0 || link_id >= get_number_links() || session_failed_links[link_id]) {
+        return send_reply(client, "ERROR the link does not exist or it has already failed");
+    }
+    
+    // A scheduled network is regenerated in memory, otherwise the frames are only rerouted
+    if (session_scheduled) {
+        status = srs_regenerate_link_failure(link_id, &options, &result);
+    } else {
+        status = srs_reroute_link_failure(link_id, &result);
+    }
+    session_failed_links[link_id] = 1;
+    write_reply_frames(affected, sizeof(affected), result.num_affected, result.affected_frames);
+    write_reply_frames(lost, sizeof(lost), result.num_lost, result.lost_frames);
+    free_regeneration_result(&result);
+    
+    // If no new schedule is found the network stays in memory with the frames rerouted, to be scheduled from scratch
+    if (session_scheduled && status == -1) {
+        session_scheduled = 0;
+        unlink(session_schedule);
+        session_has_schedule = 0;
+        if (save_session_network() == -1) {
+            return send_reply(client, "ERROR the network could not be saved in the session");
+        }
+        return send_reply(client, "ERROR no schedule found after the failure, the network has to be scheduled again");
+    }
+    if (save_session_network() == -1) {
+        return send_reply(client, "ERROR the network could not be saved in the session");
+    }
+    if (session_scheduled) {
+        session_has_schedule = srs_write_schedule_compact(session_schedule, 1) != -1;
+    }
+    return send_reply(client, "OK %f affected%s lost%s", result.recovery_time, affected, lost);
+}
+
+/**
+ Admits a new frame into the scheduled network of the session without scheduling it again from scratch, within the
+ time budget of the request, or of the daemon if it does not give one. If it is rejected, the network keeps its
+ schedule
+
+ @param client socket of the client
+ @param arguments arguments of the request, the information of the frame followed by its paths, and the optional
+ time budget in ms as budget=ms
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_admit_frame(int client, char *arguments) {
+    
+    SchedulerOptions options = session_options;
+    char **tokens, *link, *save;
+    char offsets[DAEMON_REQUEST_SIZE / 2], unpinned[DAEMON_REQUEST_SIZE / 2];
+    AdmissionResult result;
+    int num_tokens = 0, num_paths, status, length;
+    int **paths, *len_paths;
+    
+    if (!session_has_network) {
+        return send_reply(client, "ERROR there is no network in the session");
+    }
+    if (!session_scheduled) {
+        return send_reply(client, "ERROR the network of the session is not scheduled");
+    }
+    tokens = malloc(sizeof(char *) * (strlen(arguments) / 2 + 1));
+    for (char *token = strtok(arguments, " \t"); token != NULL; token = strtok(NULL, " \t")) {
+        tokens[num_tokens++] = token;
+    }
+    
+    // The paths are not numbered, so the time budget is marked to tell it apart from a path of a single link
+    if (num_tokens > 0 && strncmp(tokens[num_tokens - 1], "budget=", 7) == 0) {
+        options.time_budget = atoll(tokens[--num_tokens] + 7);
+    }
+    num_paths = num_tokens - 5;
+    if (num_paths <= 0) {
+        free(tokens);
+        return send_reply(client, "ERROR the frame needs its information and at least one path");
+    }
+    
+    paths = malloc(sizeof(int *) * num_paths);
+    len_paths = calloc(num_paths, sizeof(int));
+    for (int i = 0; i < num_paths; i++) {
+        paths[i] = malloc(sizeof(int) * get_number_links() * 2);
+        for (link = strtok_r(tokens[5 + i], ",", &save); link != NULL && len_paths[i] < get_number_links() * 2;
+             link = strtok_r(NULL, ",", &save)) {
+            paths[i][len_paths[i]++] = atoi(link);
+        }
+    }
+    status = srs_admit_frame(atoll(tokens[0]), atoll(tokens[1]), atoi(tokens[2]), atoll(tokens[3]),
+                             atoll(tokens[4]), num_paths, paths, len_paths, &options, &result);
+    for (int i = 0; i < num_paths; i++) {
+        free(paths[i]);
+    }
+    free(paths);
+    free(len_paths);
+    free(tokens);
+    if (status == -1) {
+        free_admission_result(&result);
+        return send_reply(client, "ERROR rejected, %s", result.reason);
+    }
+    
+    length = snprintf(offsets, sizeof(offsets), " %d", result.num_links);
+    for (int i = 0; i < result.num_links && length < (int) sizeof(offsets) - 48; i++) {
+        length += snprintf(offsets + length, sizeof(offsets) - length, " %d:%lld", result.links[i], result.offsets[i]);
+    }
+    write_reply_frames(unpinned, sizeof(unpinned), result.stage == admission_repair ? result.num_unpinned : 0,
+                       result.unpinned_frames);
+    free_admission_result(&result);
+    if (save_session_network() == -1) {
+        return send_reply(client, "ERROR the network could not be saved in the session");
+    }
+    session_has_schedule = srs_write_schedule_compact(session_schedule, 1) != -1;
+    return send_reply(client, "OK %d %s %f offsets%s unpinned%s", result.frame_id,
+                      get_admission_stage_name(result.stage), result.admission_time, offsets, unpinned);
+}
+
+/**
+ Sends the schedule of the network of the session, it has to be scheduled after its last change
+
+ @param client socket of the client
+ @param arguments arguments of the request, xml to send the schedule xml file instead of the text compact one
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_get_schedule(int client, char *arguments) {
+    
+    char *format = strtok(arguments, " \t");
+    char schedule[128];
+    int status, xml = format != NULL && strcmp(format, "xml") == 0;
+    
+    if (!session_scheduled) {
+        return send_reply(client, "ERROR the network of the session is not scheduled");
+    }
+    if (format != NULL && !xml) {
+        return send_reply(client, "ERROR unknown schedule format %s", format);
+    }
+    
+    // The schedule is written in the directory of the session and sent after the reply line with its size
+    snprintf(schedule, sizeof(schedule), "%s/%s", session_directory, xml ? "schedule.xml" : "schedule.srst");
+    if ((xml ? srs_write_schedule(schedule) : srs_write_schedule_compact(schedule, 0)) == -1) {
+        unlink(schedule);
+        return send_reply(client, "ERROR the schedule could not be written");
+    }
+    status = send_file(client, schedule);
+    unlink(schedule);
+    return status;
+}
+
+/**
+ Sends the transmission time of a frame in a link for an instance and replica of the scheduled network
+
+ @param client socket of the client
+ @param arguments arguments of the request, frame, link, instance and replica
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_get_offset(int client, char *arguments) {
+    
+    int frame_id, link_id, instance, replica;
+    long long int offset;
+    
+    if (sscanf(arguments, "%d %d %d %d", &frame_id, &link_id, &instance, &replica) != 4) {
+        return send_reply(client, "ERROR expected frame, link, instance and replica");
+    }
+    offset = srs_get_offset(frame_id, link_id, instance, replica);
+    if (offset == -1) {
+        return send_reply(client, "ERROR the network is not scheduled or the offset does not exist");
+    }
+    return send_reply(client, "OK %lld", offset);
+}
+
+/**
+ Sends the metrics of the last request that loaded or scheduled the network of the session
+
+ @param client socket of the client
+ @return 0 if the reply was sent, -1 if the client closed the connection
+ */
+int handle_metrics(int client) {
+    
+    char metrics[128], line[DAEMON_REQUEST_SIZE];
+    FILE *file;
+    
+    snprintf(metrics, sizeof(metrics), "%s/metrics.json", session_directory);
+    unlink(metrics);
+    if (srs_write_metrics(metrics, session_scheduled ? 0 : 1, 0) == -1 || (file = fopen(metrics, "r")) == NULL) {
+        return send_reply(client, "ERROR the metrics could not be written");
+    }
+    if (fgets(line, sizeof(line), file) == NULL) {
+        line[0] = '\0';
+    }
+    fclose(file);
+    unlink(metrics);
+    line[strcspn(line, "\n")] = '\0';
+    return send_reply(client, "OK %s", line);
+}
+
+/**
+ Serves a request of the session
+
+ @param client socket of the client
+ @param request line of the request
+ @return 0 to keep serving the session, -1 to close it
+ */
+int handle_request(int client, char *request) {
+    
+    char *command, *arguments;
+    
+    command = request + strspn(request, " \t");
+    arguments = command + strcspn(command, " \t");
+    if (*arguments != '\0') {
+        *arguments = '\0';
+        arguments++;
+    }
+    
+    if (*command == '\0') {
+        return 0;
+    } else if (strcmp(command, "LOAD") == 0) {
+        return handle_load(client, arguments);
+    } else if (strcmp(command, "SCHEDULE") == 0) {
+        return handle_schedule(client, arguments);
+    } else if (strcmp(command, "ADD_FRAME") == 0) {
+        return handle_add_frame(client, arguments);
+    } else if (strcmp(command, "REMOVE_FRAME") == 0) {
+        return handle_remove_frame(client, arguments);
+    } else if (strcmp(command, "ADMIT") == 0) {
+        return handle_admit_frame(client, arguments);
+    } else if (strcmp(command, "FAIL_LINK") == 0) {
+        return handle_fail_link(client, arguments);
+    } else if (strcmp(command, "GET_SCHEDULE") == 0) {
+        return handle_get_schedule(client, arguments);
+    } else if (strcmp(command, "GET_OFFSET") == 0) {
+        return handle_get_offset(client, arguments);
+    } else if (strcmp(command, "METRICS") == 0) {
+        return handle_metrics(client);
+    } else if (strcmp(command, "QUIT") == 0) {
+        send_reply(client, "OK");
+        return -1;
+    }
+    return send_reply(client, "ERROR unknown request %s", command);
+}
+
+/**
+ Serves all the requests of a session in order until the client closes the connection, in the forked process
+
+ @param client socket of the client
+ */
+void run_session(int client) {
+    
+    char *line, *line_end;
+    size_t line_length;
+    ssize_t received;
+    int status = 0;
+    
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    snprintf(session_network, sizeof(session_network), "%s/network.srsn", session_directory);
+    snprintf(session_schedule, sizeof(session_schedule), "%s/schedule.srss", session_directory);
+    
+    // Requests are lines, a read can bring several requests or only part of one
+    session_requests = malloc(DAEMON_REQUEST_SIZE);
+    line = malloc(DAEMON_REQUEST_SIZE);
+    while (status == 0) {
+        line_end = memchr(session_requests, '\n', session_length);
+        if (line_end == NULL) {
+            if (session_length == DAEMON_REQUEST_SIZE) {
+                send_reply(client, "ERROR the request is too long");
+                break;
+            }
+            received = read(client, session_requests + session_length, DAEMON_REQUEST_SIZE - session_length);
+            if (received <= 0) {
+                break;
+            }
+            session_length += received;
+            continue;
+        }
+        
+        // The line is taken out of the received data first, so the request can receive the bytes that follow it
+        line_length = line_end - session_requests;
+        memcpy(line, session_requests, line_length);
+        line[line_length] = '\0';
+        if (line_length > 0 && line[line_length - 1] == '\r') {
+            line[line_length - 1] = '\0';
+        }
+        memmove(session_requests, line_end + 1, session_length - line_length - 1);
+        session_length -= line_length + 1;
+        status = handle_request(client, line);
+    }
+    
+    free(line);
+    free(session_requests);
+    close(client);
+    srs_free_network();
+    free(session_failed_links);
+    remove_session_directory(session_directory);
+    _exit(0);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Runs the scheduler daemon in the given Unix domain socket until it receives SIGINT or SIGTERM
+ */
+int run_daemon(char *socket_path, int max_sessions, struct SchedulerOptions *options) {
+    
+    struct sockaddr_un address;
+    struct sigaction action;
+    struct stat socket_stat;
+    int server, client, slot, num_sessions = 0;
+    mode_t mask;
+    pid_t session;
+    
+    if (options == NULL) {
+        init_scheduler_options(&session_options);
+    } else {
+        session_options = *options;
+    }
+    if (session_options.num_threads == 0) {
+        session_options.num_threads = 1;        // The sessions already run in parallel
+    }
+    if (max_sessions <= 0) {
+        max_sessions = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    
+    // Create the socket, replacing the socket of a previous daemon that was not removed
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        printf("The path of the socket is too long\n");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    if (stat(socket_path, &socket_stat) == 0 && S_ISSOCK(socket_stat.st_mode)) {
+        unlink(socket_path);
+    }
+    
+    // Only the user of the daemon can connect, the socket is created without permissions for the rest
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+    mask = umask(S_IRWXG | S_IRWXO);
+    if (server == -1 || bind(server, (struct sockaddr *) &address, sizeof(address)) == -1 ||
+        chmod(socket_path, S_IRUSR | S_IWUSR) == -1 || listen(server, DAEMON_QUEUE_SIZE) == -1) {
+        umask(mask);
+        printf("The socket of the daemon could not be created\n");
+        if (server != -1) {
+            close(server);
+        }
+        return -1;
+    }
+    umask(mask);
+    daemon_max_sessions = max_sessions;
+    daemon_sessions = calloc(max_sessions, sizeof(pid_t));
+    daemon_directories = calloc(max_sessions, sizeof(*daemon_directories));
+    
+    // The signals interrupt the accept so the daemon can stop, and a closed client does not kill a session
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop_daemon;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    printf("Scheduler daemon listening in %s with %d sessions\n", socket_path, max_sessions);
+    
+    while (!daemon_stopped) {
+        while (num_sessions > 0 && (session = waitpid(-1, NULL, WNOHANG)) > 0) {
+            release_session(session);
+            num_sessions--;
+        }
+        // When all the sessions are busy, the new connections wait in the queue of the socket
+        if (num_sessions >= max_sessions) {
+            if ((session = waitpid(-1, NULL, 0)) > 0) {
+                release_session(session);
+                num_sessions--;
+            }
+            continue;
+        }
+        client = accept(server, NULL, NULL);
+        if (client == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
+        }
+        
+        // The daemon creates the directory of the session, so it can remove it when the session is stopped
+        slot = 0;
+        while (daemon_sessions[slot] != 0) {
+            slot++;
+        }
+        strcpy(daemon_directories[slot], "/tmp/srs-session-XXXXXX");
+        if (mkdtemp(daemon_directories[slot]) == NULL) {
+            send_reply(client, "ERROR the session could not be created");
+            close(client);
+            continue;
+        }
+        fflush(stdout);
+        session = fork();
+        if (session == 0) {
+            close(server);
+            strcpy(session_directory, daemon_directories[slot]);
+            run_session(client);
+        }
+        close(client);
+        if (session == -1) {
+            rmdir(daemon_directories[slot]);
+        } else {
+            daemon_sessions[slot] = session;
+            num_sessions++;
+        }
+    }
+    
+    // The sessions still served are stopped before their files and the socket are removed
+    close(server);
+    for (int i = 0; i < max_sessions; i++) {
+        if (daemon_sessions[i] != 0) {
+            kill(daemon_sessions[i], SIGTERM);
+        }
+    }
+    for (int i = 0; i < max_sessions; i++) {
+        if (daemon_sessions[i] != 0) {
+            while (waitpid(daemon_sessions[i], NULL, 0) == -1 && errno == EINTR) {
+                continue;
+            }
+            remove_session_directory(daemon_directories[i]);
+            daemon_sessions[i] = 0;
+        }
+    }
+    free(daemon_sessions);
+    free(daemon_directories);
+    unlink(socket_path);
+    printf("Scheduler daemon stopped\n");
+    return 0;
+}
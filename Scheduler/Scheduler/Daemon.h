@@ -0,0 +1,62 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Daemon.h                                                                                                           *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that keeps the scheduler running as a daemon that answers requests in a local Unix domain socket.          *
+ *  Every connection is an independent session served by its own process, forked from the daemon once the solver and   *
+ *  the xml libraries are initialized (the library keeps one network in memory, and the terms of yices2 are global).   *
+ *  A session keeps its network, and the last schedule found, between requests. The requests of a session are served   *
+ *  in order, and the connections that arrive when all sessions are busy wait in the queue of the socket.              *
+ *  Requests and replies are lines of text, every reply starts with OK or ERROR followed by its result:                *
+ *      LOAD bytes (and the network file)       -> OK frames links                                                     *
+ *      SCHEDULE [budget_ms]                    -> OK time_ms                                                          *
+ *      ADD_FRAME period deadline size end_to_end starting path... (links of a path separated by commas) -> OK frame   *
+ *      REMOVE_FRAME frame                      -> OK                                                                  *
+ *      ADMIT period deadline size end_to_end starting path... [budget=budget_ms] (as ADD_FRAME, in the scheduled      *
+ *      network)                                -> OK frame stage time_ms offsets n link:time... unpinned m frame...   *
+ *      FAIL_LINK link [budget_ms]              -> OK time_ms affected n frame... lost m frame... (lost are removed)   *
+ *      GET_SCHEDULE [xml]                      -> OK bytes (followed by the text compact schedule, or the xml one)    *
+ *      GET_OFFSET frame link instance replica  -> OK transmission_time                                                *
+ *      METRICS                                 -> OK metrics_json                                                     *
+ *      QUIT                                    -> OK (and the session is closed)                                      *
+ *  The requests without time budget use the one of the daemon. The files are sent through the socket, the daemon does *
+ *  not read or write files chosen by the client, and only its user can connect to the socket.                         *
+ *  A new schedule keeps the offsets of the frames not affected by the changes since the previous schedule. If they    *
+ *  leave no room for the rest of frames, the network is scheduled again from scratch with the remaining time budget.  *
+ *  A link that fails in a scheduled network regenerates its schedule at once, only for the frames rerouted.           *
+ *  A frame admitted in a scheduled network is placed without scheduling it again from scratch, within the time budget *
+ *  of the daemon (see Admission.h). A rejected frame leaves the network and its schedule as they were.                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Daemon_h
+#define Daemon_h
+
+#include <stdio.h>
+
+#endif /* Daemon_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define DAEMON_REQUEST_SIZE 65536       // Maximum length of a request line
+#define DAEMON_QUEUE_SIZE 128           // Connections that can wait in the socket until a session is free
+
+struct SchedulerOptions;                // Options of the scheduler, defined in Synthesizer.h
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Runs the scheduler daemon in the given Unix domain socket until it receives SIGINT or SIGTERM.
+ srs_init has to be called before, and there cannot be a network in memory
+
+ @param socket_path path of the Unix domain socket to create
+ @param max_sessions maximum number of sessions served at the same time, 0 to use one per available processor
+ @param options pointer to the options of the scheduler for all sessions, NULL to use the default ones. The time
+ budget of the options is used for the requests that do not give one
+ @return 0 if the daemon stopped correctly, -1 if the socket could not be created
+ */
+int run_daemon(char *socket_path, int max_sessions, struct SchedulerOptions *options);
@@ -11,6 +11,7 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "Frame.h"
+#include "Memory.h"
 #include <stdlib.h>
 
                                                     /* VARIABLES */
@@ -35,10 +36,11 @@ Offset * add_new_offset(Offset *offset_pt, int link) {
     // If the link is not in the linked list, we create a new offset and add it, if not we just return the found offset
     if (offset_pt->link != link) {
         offset_pt->link = link;
-        offset_pt->offset = 0;
+        offset_pt->offset = NULL;
+        offset_pt->y_offset = NULL;
         offset_pt->num_instances = 0;
         offset_pt->num_replicas = 0;
-        offset_pt->next_offset_pt = malloc(sizeof(Offset));     // We create the next offset as empty
+        offset_pt->next_offset_pt = tracked_malloc(memory_model, sizeof(Offset));  // We create the next offset as empty
         offset_pt->next_offset_pt->next_offset_pt = NULL;
         offset_pt->next_offset_pt->link = -1;                   // Just in case to control the link value
     }
@@ -46,6 +48,29 @@ Offset * add_new_offset(Offset *offset_pt, int link) {
     return offset_pt;
 }
 
+/**
+ Frees the matrices with the transmission times and yices variables of an offset
+
+ @param offset_pt pointer to the offset
+ */
+void free_offset_matrices(Offset *offset_pt) {
+    
+    if (offset_pt->offset != NULL) {
+        for (int i = 0; i < offset_pt->num_instances; i++) {
+            tracked_free(memory_model, offset_pt->offset[i]);
+        }
+        tracked_free(memory_model, offset_pt->offset);
+        offset_pt->offset = NULL;
+    }
+    if (offset_pt->y_offset != NULL) {
+        for (int i = 0; i < offset_pt->num_instances; i++) {
+            tracked_free(memory_solver, offset_pt->y_offset[i]);
+        }
+        tracked_free(memory_solver, offset_pt->y_offset);
+        offset_pt->y_offset = NULL;
+    }
+}
+
                                                     /* FUNCTIONS */
 
 /**
@@ -62,6 +87,7 @@ int init_frame(Frame *frame_pt) {
     frame_pt->split_array_ls = NULL;
     frame_pt->offset_ls = NULL;
     frame_pt->offset_hash = NULL;
+    frame_pt->pinned = 0;
     return 0;
 }
 
@@ -75,7 +101,7 @@ int init_hash(Frame *frame_pt, int num_links) {
     }
     
     // frame_pt->offset_hash = malloc(sizeof(Offset *) * num_links);
-    frame_pt->offset_hash = malloc(sizeof(Offset *) * num_links);
+    frame_pt->offset_hash = tracked_malloc(memory_model, sizeof(Offset *) * num_links);
     for (int i = 0; i < num_links; i++) {
         frame_pt->offset_hash[i] = NULL;
     }
@@ -162,6 +188,22 @@ void set_starting(Frame *frame_pt, long long int starting) {
     frame_pt->starting = starting;
 }
 
+/**
+ Get if the offsets of the given frame are fixed to a previous schedule instead of being searched by the solver
+ */
+int is_frame_pinned(Frame *frame_pt) {
+    
+    return frame_pt->pinned;
+}
+
+/**
+ Set if the offsets of the given frame are fixed to a previous schedule instead of being searched by the solver
+ */
+void set_frame_pinned(Frame *frame_pt, int pinned) {
+    
+    frame_pt->pinned = pinned;
+}
+
 /**
  Get the number of instances of the offset
  */
@@ -286,8 +328,14 @@ int get_num_paths(Frame *frame_pt) {
 void set_num_paths(Frame *frame_pt, int num_paths) {
     
     frame_pt->num_paths = num_paths;
-    frame_pt->path_array_ls = malloc(sizeof(Path) * num_paths);     // Allocate memory for all the paths roots
-    frame_pt->offset_ls = malloc(sizeof(Offset));                   // We can start allocating for the offsets too
+    // Allocate memory for all the paths roots
+    frame_pt->path_array_ls = tracked_malloc(memory_model, sizeof(Path) * num_paths);
+    for (int i = 0; i < num_paths; i++) {                           // Empty until the path is added
+        frame_pt->path_array_ls[i].link = -1;
+        frame_pt->path_array_ls[i].offset_pt = NULL;
+        frame_pt->path_array_ls[i].next_path_pt = NULL;
+    }
+    frame_pt->offset_ls = tracked_malloc(memory_model, sizeof(Offset));   // We can start allocating the offsets too
     frame_pt->offset_ls->link = -1;
     frame_pt->offset_ls->next_offset_pt = NULL;                     // Just in case
     
@@ -310,7 +358,7 @@ int add_path(Frame *frame_pt, int path_id, int *path, int len_path) {
     for (int i = 0; i < len_path; i++) {
         // Add the new path at the end of the path linked list
         path_it->link = path[i];
-        path_it->next_path_pt = malloc(sizeof(Path));       // Allocate memory for the next path
+        path_it->next_path_pt = tracked_malloc(memory_model, sizeof(Path));     // Allocate memory for the next path
         path_it->next_path_pt->next_path_pt = NULL;         // Mark as empty
         path_it->next_path_pt->link = -1;
         
@@ -322,7 +370,7 @@ int add_path(Frame *frame_pt, int path_id, int *path, int len_path) {
         
         path_it = path_it->next_path_pt;                    // Point now to the next path
     }
-
+    
     return 0;
 }
 
@@ -332,7 +380,13 @@ int add_path(Frame *frame_pt, int path_id, int *path, int len_path) {
 void set_num_splits(Frame *frame_pt, int num_splits) {
     
     frame_pt->num_splits = num_splits;
-    frame_pt->split_array_ls = malloc(sizeof(Split) * num_splits);  // Allocate memory for all the splits roots
+    // Allocate memory for all the splits roots
+    frame_pt->split_array_ls = tracked_malloc(memory_model, sizeof(Split) * num_splits);
+    for (int i = 0; i < num_splits; i++) {                          // Empty until the split is added
+        frame_pt->split_array_ls[i].link = -1;
+        frame_pt->split_array_ls[i].offset_pt = NULL;
+        frame_pt->split_array_ls[i].next_split_pt = NULL;
+    }
 }
 
 /**
@@ -350,7 +404,7 @@ int add_split(Frame *frame_pt, int split_id, int *split, int split_len) {
     split_it = &frame_pt->split_array_ls[split_id];
     for (int i = 0; i < split_len; i++) {
         split_it->link = split[i];
-        split_it->next_split_pt = malloc(sizeof(Split));        // Allocate memory for the next split
+        split_it->next_split_pt = tracked_malloc(memory_model, sizeof(Split));  // Allocate memory for the next split
         split_it = split_it->next_split_pt;                     // Point to the next split
         split_it->next_split_pt = NULL;                         // Mark it as empty
         split_it->link = -1;
@@ -400,17 +454,33 @@ void set_yices_offset(Offset *offset_pt, int instance, int replica, term_t const
     yices_set_term_name(offset_pt->y_offset[instance][replica], name);
 }
 
+/**
+ Get the identifier of the variable of the given instance and replica in solvers that do not use yices terms
+ */
+int get_offset_variable(Offset *offset_pt, int instance, int replica) {
+    
+    return offset_pt->y_offset[instance][replica];
+}
+
+/**
+ Set the identifier of the variable of the given instance and replica in solvers that do not use yices terms
+ */
+void set_offset_variable(Offset *offset_pt, int instance, int replica, int variable) {
+    
+    offset_pt->y_offset[instance][replica] = variable;
+}
+
 /**
  Allocates the memory needed and prepare all variables for the used to be ready to be used
  */
 void prepare_offset(Offset *offset_pt) {
     
     // Dynamically allocate an array for the offsets of size [num_instances][num_replicas + 1]
-    offset_pt->offset = malloc(sizeof(long long int *) * offset_pt->num_instances);
-    offset_pt->y_offset = malloc(sizeof(term_t *) * offset_pt->num_instances);
+    offset_pt->offset = tracked_malloc(memory_model, sizeof(long long int *) * offset_pt->num_instances);
+    offset_pt->y_offset = tracked_malloc(memory_solver, sizeof(term_t *) * offset_pt->num_instances);
     for (int i = 0; i < offset_pt->num_instances; i++) {
-        offset_pt->offset[i] = malloc(sizeof(long long int) * (offset_pt->num_replicas + 1));
-        offset_pt->y_offset[i] = malloc(sizeof(term_t) * (offset_pt->num_replicas + 1));
+        offset_pt->offset[i] = tracked_malloc(memory_model, sizeof(long long int) * (offset_pt->num_replicas + 1));
+        offset_pt->y_offset[i] = tracked_malloc(memory_solver, sizeof(term_t) * (offset_pt->num_replicas + 1));
     }
 }
 
@@ -422,3 +492,66 @@ Offset * get_frame_offset_by_link(Frame *frame_pt, int link) {
     
     return frame_pt->offset_hash[link];
 }
+
+/**
+ Frees the transmission times of all the offsets of the frame and unpins it, keeping its paths
+ */
+void reset_offsets(Frame *frame_pt) {
+    
+    Offset *offset_it;
+    
+    offset_it = frame_pt->offset_ls;
+    while (offset_it != NULL && !is_last_offset(offset_it)) {
+        free_offset_matrices(offset_it);
+        offset_it = get_next_offset(offset_it);
+    }
+    frame_pt->pinned = 0;
+}
+
+/**
+ Frees all the memory allocated for the paths, splits and offsets of the frame, leaving it as just initialized
+ */
+void free_frame(Frame *frame_pt) {
+    
+    Path *path_it, *next_path_pt;           // Iterators to free the paths linked lists
+    Split *split_it, *next_split_pt;        // Iterators to free the splits linked lists
+    Offset *offset_it, *next_offset_pt;     // Iterators to free the offsets linked list
+    
+    if (frame_pt == NULL) {
+        return;
+    }
+    
+    // The roots of the paths and splits are stored in the arrays, so we only free the rest of the linked lists
+    for (int i = 0; i < frame_pt->num_paths; i++) {
+        path_it = frame_pt->path_array_ls[i].next_path_pt;
+        while (path_it != NULL) {
+            next_path_pt = path_it->next_path_pt;
+            tracked_free(memory_model, path_it);
+            path_it = next_path_pt;
+        }
+    }
+    for (int i = 0; i < frame_pt->num_splits; i++) {
+        split_it = frame_pt->split_array_ls[i].next_split_pt;
+        while (split_it != NULL) {
+            next_split_pt = split_it->next_split_pt;
+            tracked_free(memory_model, split_it);
+            split_it = next_split_pt;
+        }
+    }
+    
+    // Free the offsets with its matrices of transmission times (the last offset is always empty)
+    offset_it = frame_pt->offset_ls;
+    while (offset_it != NULL) {
+        next_offset_pt = offset_it->next_offset_pt;
+        if (next_offset_pt != NULL) {
+            free_offset_matrices(offset_it);
+        }
+        tracked_free(memory_model, offset_it);
+        offset_it = next_offset_pt;
+    }
+    
+    tracked_free(memory_model, frame_pt->path_array_ls);
+    tracked_free(memory_model, frame_pt->split_array_ls);
+    tracked_free(memory_model, frame_pt->offset_hash);
+    init_frame(frame_pt);
+}
@@ -77,6 +77,7 @@ typedef struct Frame {
     Offset *offset_ls;                  // Pointer to the roof of the offsets linked list
     // Offset **offset_hash;            // Array that stores the offsets with index the link identifier (to accelerate)
     Offset **offset_hash;
+    int pinned;                         // 1 if the offsets are fixed to a previous schedule, 0 if they are searched
 }Frame;
 
                                                 /* CODE DEFINITIONS */
@@ -179,6 +180,22 @@ long long int get_starting(Frame *frame_pt);
  */
 void set_starting(Frame *frame_pt, long long int starting);
 
+/**
+ Get if the offsets of the given frame are fixed to a previous schedule instead of being searched by the solver
+
+ @param frame_pt pointer to the frame
+ @return 1 if the frame is pinned, 0 otherwise
+ */
+int is_frame_pinned(Frame *frame_pt);
+
+/**
+ Set if the offsets of the given frame are fixed to a previous schedule instead of being searched by the solver
+
+ @param frame_pt pointer to the frame
+ @param pinned 1 to pin the frame, 0 to let the solver search its offsets
+ */
+void set_frame_pinned(Frame *frame_pt, int pinned);
+
 /**
  Get the number of instances of the offset
 
@@ -380,6 +397,27 @@ term_t get_yices_offset(Offset *offset_pt, int instance, int replica);
  */
 void set_yices_offset(Offset *offset_pt, int instance, int replica, term_t constraint, char* name);
 
+/**
+ Get the identifier of the variable of the given instance and replica in solvers that do not use yices terms, such as
+ the SMT-LIB2 export. It is saved in the same matrix as the yices terms
+
+ @param offset_pt pointer to the offset
+ @param instance number of instance in the offset
+ @param replica number of replica in the offset
+ @return identifier of the variable
+ */
+int get_offset_variable(Offset *offset_pt, int instance, int replica);
+
+/**
+ Set the identifier of the variable of the given instance and replica in solvers that do not use yices terms
+
+ @param offset_pt pointer to the offset
+ @param instance number of instance in the offset
+ @param replica number of replica in the offset
+ @param variable identifier of the variable
+ */
+void set_offset_variable(Offset *offset_pt, int instance, int replica, int variable);
+
 /**
  Allocates the memory needed and prepare all variables for the used to be ready to be used
 
@@ -396,3 +434,18 @@ void prepare_offset(Offset *offset_pt);
  @return pointer to the offset of the frame that has the link given in the parameters, NULL if not in the linked list
  */
 Offset * get_frame_offset_by_link(Frame *frame_pt, int link);
+
+/**
+ Frees the transmission times of all the offsets of the frame and unpins it, keeping its paths, so the offsets can
+ be prepared again for a new schedule
+
+ @param frame_pt pointer to the frame
+ */
+void reset_offsets(Frame *frame_pt);
+
+/**
+ Frees all the memory allocated for the paths, splits and offsets of the frame, leaving it as just initialized
+
+ @param frame_pt pointer to the frame
+ */
+void free_frame(Frame *frame_pt);
@@ -0,0 +1,392 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  GateControlList.c                                                                                                  *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in GateControlList.h                                                                                   *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "GateControlList.h"
+#include "Metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Time window where a gate has to be open
+ */
+typedef struct GateWindow {
+    long long int start;                // Time in ns when the gate opens
+    long long int end;                  // Time in ns when the gate closes
+    GateState state;                    // Gate that is open
+}GateWindow;
+
+/**
+ Work shared by the threads that compile the ports
+ */
+typedef struct GateWork {
+    int next_link;                      // Next link to compile, taken atomically by the threads
+    int num_links;                      // Number of links to compile
+}GateWork;
+
+                                                    /* VARIABLES */
+
+GateControlList *gate_control_lists = NULL;     // Compiled gate control list of every link
+int num_gate_control_lists = 0;                 // Number of compiled gate control lists
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Compares two windows by their starting time, to sort them
+
+ @param a pointer to the first window
+ @param b pointer to the second window
+ @return negative, 0 or positive if the first window starts before, at the same time or after
+ */
+int compare_gate_windows(const void *a, const void *b) {
+    
+    const GateWindow *window_a = a, *window_b = b;
+    
+    if (window_a->start != window_b->start) {
+        return window_a->start < window_b->start ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Adds an entry at the end of a gate control list
+
+ @param gcl pointer to the gate control list
+ @param max_entries pointer to the number of entries that fit in the list, it grows if needed
+ @param start time in ns when the entry starts
+ @param duration time in ns that the entry lasts
+ @param state gate that is open
+ */
+void add_gate_entry(GateControlList *gcl, int *max_entries, long long int start, long long int duration,
+                    GateState state) {
+    
+    if (gcl->num_entries == *max_entries) {
+        *max_entries = *max_entries * 2 + 16;
+        gcl->entries = realloc(gcl->entries, sizeof(GateEntry) * *max_entries);
+    }
+    gcl->entries[gcl->num_entries].start = start;
+    gcl->entries[gcl->num_entries].duration = duration;
+    gcl->entries[gcl->num_entries].state = state;
+    gcl->num_entries++;
+}
+
+/**
+ Adds a window at the end of an array of windows
+
+ @param windows pointer to the array of windows, it grows if needed
+ @param num_windows pointer to the number of windows in the array
+ @param max_windows pointer to the number of windows that fit in the array
+ @param start time in ns when the gate opens
+ @param end time in ns when the gate closes
+ @param state gate that is open
+ */
+void add_gate_window(GateWindow **windows, int *num_windows, int *max_windows, long long int start, long long int end,
+                     GateState state) {
+    
+    if (*num_windows == *max_windows) {
+        *max_windows = *max_windows * 2 + 64;
+        *windows = realloc(*windows, sizeof(GateWindow) * *max_windows);
+    }
+    (*windows)[*num_windows].start = start;
+    (*windows)[*num_windows].end = end;
+    (*windows)[*num_windows].state = state;
+    (*num_windows)++;
+}
+
+/**
+ Compiles the gate control list of a link. It collects a window for every transmission in the link extended with the
+ guard band, sorts them, merges the windows of the same gate that overlap or are back-to-back, and fills the gaps
+ with entries of the best effort traffic. The guard band of a transmission close to the start of the cycle wraps
+ around to the end of the previous cycle, so the last best effort entry also ends before the transmission
+
+ @param link_id identifier of the link
+ */
+void compile_link_gate_control_list(int link_id) {
+    
+    GateControlList *gcl = &gate_control_lists[link_id];
+    GateWindow *windows = NULL, current;
+    Offset *offset_pt;
+    GateState state;
+    long long int cycle = get_hyper_period(), guard = get_time_between_frames(), time, transmission, end;
+    int num_windows = 0, max_windows = 0, max_entries = 0, protocol_frame = -1;
+    
+    if (is_protocol_active()) {
+        protocol_frame = get_number_frames() - 1;
+    }
+    gcl->link = link_id;
+    gcl->node = get_link_source(get_link(link_id));
+    gcl->cycle = cycle;
+    
+    // Collect the windows of all the transmissions in the link
+    for (int i = 0; i < get_link_number_offsets(link_id); i++) {
+        offset_pt = get_link_offset(link_id, i);
+        state = get_link_offset_frame(link_id, i) == protocol_frame ? gate_protocol : gate_scheduled;
+        for (int h = 0; h < get_number_instances(offset_pt); h++) {
+            for (int r = 0; r <= get_number_replicas(offset_pt); r++) {
+                transmission = get_offset(offset_pt, h, r);
+                end = transmission + get_timeslot_size(offset_pt) < cycle ?
+                      transmission + get_timeslot_size(offset_pt) : cycle;
+                if (transmission - guard >= 0) {
+                    add_gate_window(&windows, &num_windows, &max_windows, transmission - guard, end, state);
+                } else {
+                    // The part of the guard band before the start of the cycle is at the end of the previous one
+                    add_gate_window(&windows, &num_windows, &max_windows, 0, end, state);
+                    add_gate_window(&windows, &num_windows, &max_windows, cycle - (guard - transmission), cycle,
+                                    state);
+                }
+            }
+        }
+    }
+    qsort(windows, num_windows, sizeof(GateWindow), compare_gate_windows);
+    
+    // Merge the windows and fill the gaps between them with the best effort traffic
+    time = 0;
+    for (int i = 0; i < num_windows; i++) {
+        current = windows[i];
+        // The guard band of a window cannot close the gate of the previous window before its transmission ends
+        if (current.start < time) {
+            current.start = time;
+        }
+        while (i + 1 < num_windows && windows[i + 1].state == current.state && windows[i + 1].start <= current.end) {
+            i++;
+            if (windows[i].end > current.end) {
+                current.end = windows[i].end;
+            }
+        }
+        if (current.end <= current.start) {
+            continue;
+        }
+        if (current.start > time) {
+            add_gate_entry(gcl, &max_entries, time, current.start - time, gate_best_effort);
+        }
+        add_gate_entry(gcl, &max_entries, current.start, current.end - current.start, current.state);
+        time = current.end;
+    }
+    if (time < cycle) {
+        add_gate_entry(gcl, &max_entries, time, cycle - time, gate_best_effort);
+    }
+    free(windows);
+}
+
+/**
+ Thread that compiles ports until there are no more ports left
+
+ @param argument pointer to the shared work
+ @return NULL
+ */
+void * gate_control_list_thread(void *argument) {
+    
+    GateWork *work = argument;
+    long long int span = start_trace_span();
+    int link;
+    
+    link = __sync_fetch_and_add(&work->next_link, 1);
+    while (link < work->num_links) {
+        compile_link_gate_control_list(link);
+        link = __sync_fetch_and_add(&work->next_link, 1);
+    }
+    end_trace_span("gate control list thread", span);
+    return NULL;
+}
+
+/**
+ Get the name of a gate to write it in the files
+
+ @param state gate
+ @return name of the gate
+ */
+const char * get_gate_name(GateState state) {
+    
+    switch (state) {
+        case gate_scheduled:
+            return "scheduled";
+        case gate_protocol:
+            return "protocol";
+        default:
+            return "best_effort";
+    }
+}
+
+/**
+ Writes the gate control list of a port into a file
+
+ @param file pointer to the file
+ @param gcl pointer to the gate control list
+ */
+void write_port_gate_control_list(FILE *file, GateControlList *gcl) {
+    
+    fprintf(file, "port %d cycle %lld entries %d\n", gcl->link, gcl->cycle, gcl->num_entries);
+    for (int i = 0; i < gcl->num_entries; i++) {
+        fprintf(file, "%lld %lld %s\n", gcl->entries[i].start, gcl->entries[i].duration,
+                get_gate_name(gcl->entries[i].state));
+    }
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Compiles the gate control lists of all the ports (links) from the schedule of the network in memory
+ */
+int compile_gate_control_lists(int num_threads) {
+    
+    GateWork work;
+    pthread_t *threads;
+    int *started;
+    
+    if (get_number_links() == 0 || get_hyper_period() <= 0) {
+        return -1;
+    }
+    free_gate_control_lists();
+    num_gate_control_lists = get_number_links();
+    gate_control_lists = calloc(num_gate_control_lists, sizeof(GateControlList));
+    
+    if (num_threads <= 0) {
+        num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads > num_gate_control_lists) {
+        num_threads = num_gate_control_lists;
+    }
+    if (num_threads <= 0) {
+        num_threads = 1;
+    }
+    
+    // Every thread takes the next port to compile, the calling thread also compiles ports
+    work.next_link = 0;
+    work.num_links = num_gate_control_lists;
+    threads = malloc(sizeof(pthread_t) * num_threads);
+    started = calloc(num_threads, sizeof(int));
+    for (int i = 1; i < num_threads; i++) {
+        started[i] = pthread_create(&threads[i], NULL, gate_control_list_thread, &work) == 0;
+    }
+    gate_control_list_thread(&work);
+    for (int i = 1; i < num_threads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    free(threads);
+    free(started);
+    
+    return 0;
+}
+
+/**
+ Get the compiled gate control list of a port
+ */
+GateControlList * get_gate_control_list(int link_id) {
+    
+    if (link_id < 0 || link_id >= num_gate_control_lists) {
+        return NULL;
+    }
+    return &gate_control_lists[link_id];
+}
+
+/**
+ Prints the number of entries of the gate control list of every port against the limit of the switches
+ */
+int print_gate_control_lists(int max_entries) {
+    
+    int exceeded = 0;
+    
+    printf("Gate control lists (limit of entries per port: ");
+    if (max_entries > 0) {
+        printf("%d)\n", max_entries);
+    } else {
+        printf("none)\n");
+    }
+    printf("%8s %8s %10s\n", "Port", "Node", "Entries");
+    for (int i = 0; i < num_gate_control_lists; i++) {
+        printf("%8d %8d %10d", gate_control_lists[i].link, gate_control_lists[i].node,
+               gate_control_lists[i].num_entries);
+        if (max_entries > 0 && gate_control_lists[i].num_entries > max_entries) {
+            printf("   exceeds the limit");
+            exceeded++;
+        }
+        printf("\n");
+    }
+    if (exceeded > 0) {
+        printf("%d ports need more entries than the limit\n", exceeded);
+    }
+    return exceeded;
+}
+
+/**
+ Writes the compiled gate control lists in one file per node, named prefix + node_<id>.gcl. The ports of links with
+ unknown source are written in a file per link named prefix + link_<id>.gcl
+ */
+int write_gate_control_lists(char *prefix) {
+    
+    FILE *file;
+    char *namefile;
+    char *written;                      // 1 for the ports already written
+    int node;
+    
+    if (gate_control_lists == NULL) {
+        return -1;
+    }
+    namefile = malloc(strlen(prefix) + 32);
+    written = calloc(num_gate_control_lists, sizeof(char));
+    
+    for (int i = 0; i < num_gate_control_lists; i++) {
+        if (written[i]) {
+            continue;
+        }
+        node = gate_control_lists[i].node;
+        if (node == -1) {
+            sprintf(namefile, "%slink_%d.gcl", prefix, i);
+        } else {
+            sprintf(namefile, "%snode_%d.gcl", prefix, node);
+        }
+        file = fopen(namefile, "w");
+        if (file == NULL) {
+            printf("The gate control list file %s could not be created\n", namefile);
+            free(namefile);
+            free(written);
+            return -1;
+        }
+        
+        // Write all the ports of the same node in the file
+        if (node == -1) {
+            fprintf(file, "# Gate control list of the link %d\n", i);
+        } else {
+            fprintf(file, "# Gate control lists of the node %d\n", node);
+        }
+        fprintf(file, "# start duration gate\n");
+        for (int j = i; j < num_gate_control_lists; j++) {
+            if (j == i || (node != -1 && gate_control_lists[j].node == node)) {
+                write_port_gate_control_list(file, &gate_control_lists[j]);
+                written[j] = 1;
+            }
+        }
+        fclose(file);
+    }
+    free(namefile);
+    free(written);
+    
+    return 0;
+}
+
+/**
+ Frees the compiled gate control lists
+ */
+void free_gate_control_lists(void) {
+    
+    for (int i = 0; i < num_gate_control_lists; i++) {
+        free(gate_control_lists[i].entries);
+    }
+    free(gate_control_lists);
+    gate_control_lists = NULL;
+    num_gate_control_lists = 0;
+}
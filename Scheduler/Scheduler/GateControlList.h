@@ -0,0 +1,96 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  GateControlList.h                                                                                                  *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that compiles the schedule into the gate control lists of the egress ports of the switches.                *
+ *  Every link is an egress port of the node that transmits in it. Its gate control list repeats every hyperperiod    *
+ *  and has entries that open the gate of the scheduled traffic (or of the protocol) during the transmissions, and    *
+ *  the gate of the best effort traffic the rest of the time. The gate of the best effort traffic is closed the time   *
+ *  between frames before every transmission as guard band, and back-to-back or overlapping windows are merged to      *
+ *  use as few entries as possible, as switches can only store a limited number of entries per port.                   *
+ *  Ports are compiled in parallel and written in one file per node.                                                   *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GateControlList_h
+#define GateControlList_h
+
+#include <stdio.h>
+#include "Network.h"
+
+#endif /* GateControlList_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Gates that can be open in an entry of the gate control list
+ */
+typedef enum GateState {
+    gate_best_effort,                   // Only the best effort traffic can be transmitted
+    gate_scheduled,                     // Only the scheduled traffic can be transmitted
+    gate_protocol                       // Only the traffic of the protocol can be transmitted
+}GateState;
+
+/**
+ Entry of a gate control list, the given gate is open for the given duration
+ */
+typedef struct GateEntry {
+    long long int start;                // Time in ns in the cycle when the entry starts
+    long long int duration;             // Time in ns that the entry lasts
+    GateState state;                    // Gate that is open
+}GateEntry;
+
+/**
+ Gate control list of an egress port, one for every link
+ */
+typedef struct GateControlList {
+    int link;                           // Link of the port
+    int node;                           // Node of the port (source of the link), -1 if unknown
+    long long int cycle;                // Time in ns of the cycle of the list (hyperperiod)
+    int num_entries;                    // Number of entries in the list
+    GateEntry *entries;                 // Entries of the list sorted by starting time
+}GateControlList;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Compiles the gate control lists of all the ports (links) from the schedule of the network in memory
+
+ @param num_threads number of threads to use, 0 to use one per available processor
+ @return 0 if compiled correctly, -1 otherwise
+ */
+int compile_gate_control_lists(int num_threads);
+
+/**
+ Get the compiled gate control list of a port
+
+ @param link_id identifier of the link of the port
+ @return pointer to the gate control list, NULL if it has not been compiled
+ */
+GateControlList * get_gate_control_list(int link_id);
+
+/**
+ Prints the number of entries of the gate control list of every port against the limit of the switches
+
+ @param max_entries maximum number of entries that a port can store, 0 if there is no limit
+ @return number of ports that need more entries than the limit
+ */
+int print_gate_control_lists(int max_entries);
+
+/**
+ Writes the compiled gate control lists in one file per node, named prefix + node_<id>.gcl. The ports of links with
+ unknown source are written in a file per link named prefix + link_<id>.gcl
+
+ @param prefix path and prefix of the files to create
+ @return 0 if correctly written, -1 otherwise
+ */
+int write_gate_control_lists(char *prefix);
+
+/**
+ Frees the compiled gate control lists
+ */
+void free_gate_control_lists(void);
@@ -0,0 +1,904 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Generator.c                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Generator.h"
+#include "BinaryNetwork.h"
+#include "Topology.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+#define GENERATOR_BUFFER_SIZE 1048576   // Size of the buffer of every handle of the network file
+#define GENERATOR_SECTIONS 4            // Sections of the binary file written at the same time as the frame records
+
+/**
+ Frame being generated, its arrays are reused for all the frames
+ */
+typedef struct GeneratedFrame {
+    long long int period;               // Period of the frame in ns
+    int size;                           // Size of the frame in bytes
+    int num_paths;                      // Number of paths, one per receiver
+    int *path_starts;                   // Index where every path starts in the links of the paths (num_paths + 1)
+    int32_t *path_links;                // Links of all paths, from the sender to every receiver
+    int num_splits;                     // Number of splits
+    int *split_starts;                  // Index where every split starts in the links of the splits (num_splits + 1)
+    int32_t *split_links;               // Links of all splits
+}GeneratedFrame;
+
+                                                    /* VARIABLES */
+
+const char *topology_names[] = {"line", "ring", "star", "tree", "mesh"};
+int default_speeds[] = {100};
+long long int default_periods[] = {1000000, 2000000, 5000000, 10000000};
+
+GeneratorOptions *generator_options;    // Parameters of the network being generated
+int generated_switch_links;             // Number of links between switches, the links of end systems come after
+int generated_end_systems;              // Number of end systems of the network
+int generated_num_links;                // Number of links of the network
+int generated_num_nodes;                // Number of nodes of the network, switches first and end systems after
+int *generated_link_source;             // Node that transmits in every link
+int *generated_link_destination;        // Node that receives from every link
+int *generated_link_speed;              // Speed of every link in MB/s
+int *generated_link_type;               // Type of every link (wired or wireless)
+int *generated_node_starts;             // Index where the connections of every node start (num_nodes + 1)
+int *generated_node_links;              // Links connected to every node, transmitting or receiving
+int *switch_link_starts;                // Index where the links that leave every switch to other switches start
+int *switch_links;                      // Links that leave every switch to other switches
+int mesh_width;                         // Switches in every row of the mesh
+long long int generated_hyperperiod;    // Hyperperiod of the network
+GeneratedFrame generated_frame;         // Frame being generated
+int *frame_receivers;                   // Receivers of the frame being generated
+uint32_t *binary_rows;                  // Starts of the paths or splits of the frame written in the binary file
+char *file_buffers;                     // Buffers of the handles of the network file
+int *link_stamps;                       // Last frame that was counted in every link
+double *link_busy;                      // Time in ns that every link transmits every hyperperiod
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the next pseudo random number of a generator (splitmix64), so every platform generates the same networks
+
+ @param state pointer to the state of the generator
+ @return random number of 64 bits
+ */
+unsigned long long int generator_random(unsigned long long int *state) {
+    
+    unsigned long long int z = (*state += 0x9E3779B97F4A7C15ULL);
+    
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ Get a pseudo random integer below a bound
+
+ @param state pointer to the state of the generator
+ @param bound upper bound of the number (not included)
+ @return random number from 0 to bound - 1
+ */
+int generator_random_below(unsigned long long int *state, int bound) {
+    
+    return (int) (generator_random(state) % (unsigned long long int) bound);
+}
+
+/**
+ Get a pseudo random fraction
+
+ @param state pointer to the state of the generator
+ @return random number from 0 (included) to 1 (not included)
+ */
+double generator_random_fraction(unsigned long long int *state) {
+    
+    return (generator_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ Calculates the hyperperiod as the least common multiple of the periods and the period of the protocol
+
+ @return hyperperiod in ns, -1 if it does not fit in 64 bits
+ */
+long long int get_generated_hyperperiod(void) {
+    
+    long long int hyperperiod = 1, period, a, b;
+    
+    for (int i = 0; i <= generator_options->num_periods; i++) {
+        period = i < generator_options->num_periods ? generator_options->periods[i] :
+                 generator_options->protocol_period;
+        if (period <= 0) {
+            continue;
+        }
+        for (a = hyperperiod, b = period; b != 0;) {
+            long long int t = a % b;
+            a = b;
+            b = t;
+        }
+        if (hyperperiod / a > 0x7FFFFFFFFFFFFFFFLL / period) {
+            return -1;
+        }
+        hyperperiod = hyperperiod / a * period;
+    }
+    return hyperperiod;
+}
+
+/**
+ Adds a connection between two nodes, that is a link in each direction, with a random speed
+
+ @param state pointer to the state of the random generator of the topology
+ @param node1 first node
+ @param node2 second node
+ @param link_type type of both links
+ */
+void add_connection(unsigned long long int *state, int node1, int node2, int link_type) {
+    
+    int speed = generator_options->speeds[generator_random_below(state, generator_options->num_speeds)];
+    
+    for (int i = 0; i < 2; i++) {
+        generated_link_source[generated_num_links] = i == 0 ? node1 : node2;
+        generated_link_destination[generated_num_links] = i == 0 ? node2 : node1;
+        generated_link_speed[generated_num_links] = speed;
+        generated_link_type[generated_num_links] = link_type;
+        generated_num_links++;
+    }
+}
+
+/**
+ Builds the links of the topology, the connections of every node and the links that leave every switch to other
+ switches
+
+ @return 0 if built correctly, -1 if there is not enough memory
+ */
+int build_topology(void) {
+    
+    int num_switches = generator_options->num_switches, index;
+    int max_links = 2 * (2 * num_switches + generated_end_systems);
+    unsigned long long int state = generator_options->seed ^ 0x5851F42D4C957F2DULL;
+    
+    generated_link_source = malloc(sizeof(int) * max_links);
+    generated_link_destination = malloc(sizeof(int) * max_links);
+    generated_link_speed = malloc(sizeof(int) * max_links);
+    generated_link_type = malloc(sizeof(int) * max_links);
+    if (generated_link_source == NULL || generated_link_destination == NULL || generated_link_speed == NULL ||
+        generated_link_type == NULL) {
+        return -1;
+    }
+    
+    // Connections between switches, depending on the topology
+    generated_num_links = 0;
+    mesh_width = 1;
+    while (mesh_width * mesh_width < num_switches) {
+        mesh_width++;
+    }
+    for (int i = 1; i < num_switches; i++) {
+        switch (generator_options->topology) {
+            case topology_line:
+            case topology_ring:
+                add_connection(&state, i - 1, i, wired);
+                break;
+            case topology_star:
+                add_connection(&state, 0, i, wired);
+                break;
+            case topology_tree:
+                add_connection(&state, (i - 1) / 2, i, wired);
+                break;
+            case topology_mesh:
+                if (i % mesh_width != 0) {
+                    add_connection(&state, i - 1, i, wired);
+                }
+                if (i >= mesh_width) {
+                    add_connection(&state, i - mesh_width, i, wired);
+                }
+                break;
+        }
+    }
+    if (generator_options->topology == topology_ring && num_switches > 2) {
+        add_connection(&state, num_switches - 1, 0, wired);
+    }
+    generated_switch_links = generated_num_links;
+    
+    // Connections of the end systems to their switches, the uplink first
+    for (int i = 0; i < generated_end_systems; i++) {
+        add_connection(&state, num_switches + i, i / generator_options->end_systems,
+                       generator_random_fraction(&state) < generator_options->wireless ? wireless : wired);
+    }
+    
+    // Compressed rows of the links connected to every node and of the links that leave every switch
+    generated_node_starts = calloc(generated_num_nodes + 1, sizeof(int));
+    generated_node_links = malloc(sizeof(int) * 2 * generated_num_links);
+    switch_link_starts = calloc(num_switches + 1, sizeof(int));
+    switch_links = malloc(sizeof(int) * (generated_switch_links + 1));
+    if (generated_node_starts == NULL || generated_node_links == NULL || switch_link_starts == NULL ||
+        switch_links == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < generated_num_links; i++) {
+        generated_node_starts[generated_link_source[i] + 1]++;
+        generated_node_starts[generated_link_destination[i] + 1]++;
+        if (i < generated_switch_links) {
+            switch_link_starts[generated_link_source[i] + 1]++;
+        }
+    }
+    for (int i = 0; i < generated_num_nodes; i++) {
+        generated_node_starts[i + 1] += generated_node_starts[i];
+    }
+    for (int i = 0; i < num_switches; i++) {
+        switch_link_starts[i + 1] += switch_link_starts[i];
+    }
+    // The starts are used as the next free position and then moved back
+    for (int i = 0; i < generated_num_links; i++) {
+        generated_node_links[generated_node_starts[generated_link_source[i]]++] = i;
+        generated_node_links[generated_node_starts[generated_link_destination[i]]++] = i;
+        if (i < generated_switch_links) {
+            switch_links[switch_link_starts[generated_link_source[i]]++] = i;
+        }
+    }
+    for (index = generated_num_nodes; index > 0; index--) {
+        generated_node_starts[index] = generated_node_starts[index - 1];
+    }
+    generated_node_starts[0] = 0;
+    for (index = num_switches; index > 0; index--) {
+        switch_link_starts[index] = switch_link_starts[index - 1];
+    }
+    switch_link_starts[0] = 0;
+    return 0;
+}
+
+/**
+ Get the link that transmits from a switch to a neighbour switch. It is searched in the switch with less links, as
+ the two links of a connection are consecutive and start in an even link
+
+ @param from switch that transmits
+ @param to neighbour switch that receives
+ @return identifier of the link, -1 if the switches are not neighbours
+ */
+int get_switch_link(int from, int to) {
+    
+    int node = from, other = to;
+    
+    if (switch_link_starts[to + 1] - switch_link_starts[to] < switch_link_starts[from + 1] - switch_link_starts[from]) {
+        node = to;
+        other = from;
+    }
+    for (int i = switch_link_starts[node]; i < switch_link_starts[node + 1]; i++) {
+        if (generated_link_destination[switch_links[i]] == other) {
+            return node == from ? switch_links[i] : switch_links[i] ^ 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ Get the next switch in the shortest route from a switch to another, depending on the topology. In a ring the shortest
+ direction is taken, in a tree the route goes up to the common ancestor and then down, and in a mesh the route goes
+ horizontally and then down, or up and then horizontally, so it never leaves the last row when it is incomplete
+
+ @param from current switch
+ @param to destination switch, different from the current switch
+ @return next switch of the route
+ */
+int get_next_switch(int from, int to) {
+    
+    int num_switches = generator_options->num_switches, node = to, child = to;
+    
+    switch (generator_options->topology) {
+        case topology_line:
+            return from < to ? from + 1 : from - 1;
+        case topology_ring:
+            if ((to - from + num_switches) % num_switches <= num_switches / 2) {
+                return (from + 1) % num_switches;
+            }
+            return (from - 1 + num_switches) % num_switches;
+        case topology_star:
+            return from == 0 ? to : 0;
+        case topology_tree:
+            // The parent of a switch always has a lower identifier
+            while (node > from) {
+                child = node;
+                node = (node - 1) / 2;
+            }
+            return node == from ? child : (from - 1) / 2;
+        case topology_mesh:
+            if (to / mesh_width < from / mesh_width) {
+                return from - mesh_width;
+            } else if (to % mesh_width != from % mesh_width) {
+                return to % mesh_width > from % mesh_width ? from + 1 : from - 1;
+            }
+            return from + mesh_width;
+    }
+    return to;
+}
+
+/**
+ Calculates the splits of the paths of the generated frame: for every position of the paths where they transmit in
+ different links, a split with the different links
+
+ */
+void calculate_splits(void) {
+    
+    GeneratedFrame *frame = &generated_frame;
+    int position = 0, active, first_link, found, num_split_links = 0, link;
+    
+    frame->num_splits = 0;
+    frame->split_starts[0] = 0;
+    do {
+        active = 0;
+        first_link = -1;
+        found = 0;
+        for (int i = 0; i < frame->num_paths; i++) {
+            if (frame->path_starts[i] + position >= frame->path_starts[i + 1]) {
+                continue;
+            }
+            active++;
+            link = frame->path_links[frame->path_starts[i] + position];
+            if (first_link == -1) {
+                first_link = link;
+            } else if (link != first_link) {
+                if (!found) {
+                    frame->split_links[num_split_links++] = first_link;
+                    found = 1;
+                }
+                // Only the links not already in the split are added
+                int repeated = 0;
+                for (int j = frame->split_starts[frame->num_splits]; j < num_split_links; j++) {
+                    repeated |= frame->split_links[j] == link;
+                }
+                if (!repeated) {
+                    frame->split_links[num_split_links++] = link;
+                }
+            }
+        }
+        if (found) {
+            frame->num_splits++;
+            frame->split_starts[frame->num_splits] = num_split_links;
+        }
+        position++;
+    } while (active > 1);
+}
+
+/**
+ Builds a frame from its own random generator, seeded with the seed of the network and the identifier of the frame,
+ so it is always the same frame
+
+ @param frame_id identifier of the frame
+ @param scale factor applied to the random size of the frame
+ */
+void build_frame(int frame_id, double scale) {
+    
+    GeneratedFrame *frame = &generated_frame;
+    GeneratorOptions *options = generator_options;
+    unsigned long long int state = options->seed ^ ((unsigned long long int) (frame_id + 1) * 0xD1B54A32D192ED03ULL);
+    int sender, receiver, num_receivers = 1, max_receivers, repeated, num_links = 0, node, next;
+    
+    // Sender and receivers, all different
+    sender = generator_random_below(&state, generated_end_systems);
+    max_receivers = options->max_fanout < generated_end_systems - 1 ? options->max_fanout : generated_end_systems - 1;
+    if (generator_random_fraction(&state) < options->multicast && max_receivers >= 2) {
+        num_receivers = 2 + generator_random_below(&state, max_receivers - 1);
+    }
+    for (int i = 0; i < num_receivers; i++) {
+        do {
+            receiver = generator_random_below(&state, generated_end_systems);
+            repeated = receiver == sender;
+            for (int j = 0; j < i && !repeated; j++) {
+                repeated = frame_receivers[j] == receiver;
+            }
+        } while (repeated);
+        frame_receivers[i] = receiver;
+    }
+    
+    // Period and size
+    frame->period = options->periods[generator_random_below(&state, options->num_periods)];
+    frame->size = (int) ((options->min_size + generator_random_below(&state, options->max_size - options->min_size + 1))
+                         * scale + 0.5);
+    frame->size = frame->size < options->min_size ? options->min_size :
+                  (frame->size > options->max_size ? options->max_size : frame->size);
+    
+    // Paths through the uplink of the sender, the shortest route between the switches and the downlink of the receiver
+    frame->num_paths = num_receivers;
+    frame->path_starts[0] = 0;
+    for (int i = 0; i < num_receivers; i++) {
+        frame->path_links[num_links++] = generated_switch_links + 2 * sender;
+        receiver = frame_receivers[i] / options->end_systems;
+        for (node = sender / options->end_systems; node != receiver; node = next) {
+            next = get_next_switch(node, receiver);
+            frame->path_links[num_links++] = get_switch_link(node, next);
+        }
+        frame->path_links[num_links++] = generated_switch_links + 2 * frame_receivers[i] + 1;
+        frame->path_starts[i + 1] = num_links;
+    }
+    calculate_splits();
+}
+
+/**
+ Builds all frames to measure the time that every link transmits and to count the paths, splits and instances
+
+ @param scale factor applied to the random sizes of the frames
+ @param summary pointer where the instances, path links and utilizations are saved
+ @param header pointer where the number of paths and splits are saved, NULL if not needed
+ */
+void measure_frames(double scale, GeneratorSummary *summary, BinaryNetworkHeader *header) {
+    
+    GeneratedFrame *frame = &generated_frame;
+    long long int instances;
+    int link, used_links = 0;
+    double busy = 0;
+    
+    memset(link_busy, 0, sizeof(double) * generated_num_links);
+    memset(link_stamps, -1, sizeof(int) * generated_num_links);
+    summary->instances = 0;
+    summary->path_links = 0;
+    for (int i = 0; i < generator_options->num_frames; i++) {
+        build_frame(i, scale);
+        instances = generated_hyperperiod / frame->period;
+        for (int j = 0; j < frame->path_starts[frame->num_paths]; j++) {
+            link = frame->path_links[j];
+            if (link_stamps[link] != i) {       // Links shared by several paths are transmitted once
+                link_stamps[link] = i;
+                link_busy[link] += (double) instances * ((frame->size * 1000) / generated_link_speed[link]);
+                summary->instances += instances;
+            }
+        }
+        summary->path_links += frame->path_starts[frame->num_paths];
+        if (header != NULL) {
+            header->number_paths += frame->num_paths;
+            header->number_path_links += frame->path_starts[frame->num_paths];
+            header->number_splits += frame->num_splits;
+            header->number_split_links += frame->split_starts[frame->num_splits];
+        }
+    }
+    
+    // The utilization of the protocol is added to all the links used
+    summary->max_utilization = 0;
+    for (int i = 0; i < generated_num_links; i++) {
+        if (link_busy[i] > 0) {
+            if (generator_options->protocol_period > 0) {
+                link_busy[i] += (double) (generated_hyperperiod / generator_options->protocol_period) *
+                                generator_options->protocol_time;
+            }
+            busy += link_busy[i];
+            used_links++;
+            if (link_busy[i] / generated_hyperperiod > summary->max_utilization) {
+                summary->max_utilization = link_busy[i] / generated_hyperperiod;
+            }
+        }
+    }
+    summary->utilization = used_links > 0 ? busy / used_links / generated_hyperperiod : 0;
+}
+
+/**
+ Writes the generated network in a network xml file, in the same format as the python network generator
+
+ @param file pointer to the file
+ @param summary pointer to the summary of the network
+ @return 0 if written correctly, -1 otherwise
+ */
+int write_generated_xml(FILE *file, GeneratorSummary *summary) {
+    
+    GeneratedFrame *frame = &generated_frame;
+    GeneratorOptions *options = generator_options;
+    double scale = summary->size_scale;
+    
+    fprintf(file, "<?xml version=\"1.0\" ?>\n<Network>\n   <GeneralInformation>\n");
+    fprintf(file, "      <NumberFrames>%d</NumberFrames>\n", options->num_frames);
+    fprintf(file, "      <NumberLinks>%d</NumberLinks>\n", generated_num_links);
+    fprintf(file, "      <NumberSwitches>%d</NumberSwitches>\n", options->num_switches);
+    fprintf(file, "      <NumberEndSystems>%d</NumberEndSystems>\n", generated_end_systems);
+    fprintf(file, "      <MinimumTimeSwitch>%d</MinimumTimeSwitch>\n", options->hop_delay);
+    fprintf(file, "      <HyperPeriod>%lld</HyperPeriod>\n", generated_hyperperiod);
+    fprintf(file, "      <Utilization>%g</Utilization>\n", summary->utilization);
+    fprintf(file, "      <MaximumLinkUtilization>%g</MaximumLinkUtilization>\n", summary->max_utilization);
+    fprintf(file, "      <FrameInstances>%lld</FrameInstances>\n", summary->instances);
+    fprintf(file, "      <PeriodProtocol>%lld</PeriodProtocol>\n", options->protocol_period);
+    fprintf(file, "      <TimeProtocol>%lld</TimeProtocol>\n", options->protocol_time);
+    fprintf(file, "      <TimeBetweenFrames>%lld</TimeBetweenFrames>\n", options->time_between_frames);
+    fprintf(file, "   </GeneralInformation>\n   <NetworkDescription>\n      <Nodes>\n");
+    for (int i = 0; i < generated_num_nodes; i++) {
+        fprintf(file, "         <Node category=\"%s\">\n            <ID>%d</ID>\n            <Connections>\n",
+                i < options->num_switches ? "Switch" : "End System", i);
+        for (int j = generated_node_starts[i]; j < generated_node_starts[i + 1]; j++) {
+            fprintf(file, "               <Link>%d</Link>\n", generated_node_links[j]);
+        }
+        fprintf(file, "            </Connections>\n         </Node>\n");
+    }
+    fprintf(file, "      </Nodes>\n      <Links>\n");
+    for (int i = 0; i < generated_num_links; i++) {
+        fprintf(file, "         <Link category=\"%s\">\n            <ID>%d</ID>\n            <Speed>%d</Speed>\n"
+                "            <Source>%d</Source>\n            <Destination>%d</Destination>\n         </Link>\n",
+                generated_link_type[i] == wireless ? "Wireless" : "Wired", i, generated_link_speed[i],
+                generated_link_source[i], generated_link_destination[i]);
+    }
+    fprintf(file, "      </Links>\n   </NetworkDescription>\n   <TrafficInformation>\n      <Frames>\n");
+    for (int i = 0; i < options->num_frames; i++) {
+        build_frame(i, scale);
+        fprintf(file, "         <Frame>\n            <ID>%d</ID>\n            <Period>%lld</Period>\n"
+                "            <Starting>0</Starting>\n            <Deadline>%lld</Deadline>\n"
+                "            <Size>%d</Size>\n            <EndToEnd>%lld</EndToEnd>\n            <Paths>\n",
+                i, frame->period, frame->period, frame->size, frame->period);
+        for (int j = 0; j < frame->num_paths; j++) {
+            fprintf(file, "               <Path>");
+            for (int k = frame->path_starts[j]; k < frame->path_starts[j + 1]; k++) {
+                fprintf(file, k == frame->path_starts[j] ? "%d" : ";%d", frame->path_links[k]);
+            }
+            fprintf(file, "</Path>\n");
+        }
+        if (frame->num_splits == 0) {
+            fprintf(file, "            </Paths>\n            <Splits/>\n         </Frame>\n");
+            continue;
+        }
+        fprintf(file, "            </Paths>\n            <Splits>\n");
+        for (int j = 0; j < frame->num_splits; j++) {
+            fprintf(file, "               <Split>");
+            for (int k = frame->split_starts[j]; k < frame->split_starts[j + 1]; k++) {
+                fprintf(file, k == frame->split_starts[j] ? "%d" : ";%d", frame->split_links[k]);
+            }
+            fprintf(file, "</Split>\n");
+        }
+        fprintf(file, "            </Splits>\n         </Frame>\n");
+    }
+    fprintf(file, "      </Frames>\n   </TrafficInformation>\n</Network>\n");
+    return ferror(file) ? -1 : 0;
+}
+
+/**
+ Writes the generated network in a binary network file. The frames are built once: the frame records are written in
+ the file, and the starts and links of the paths and of the splits in their own sections, each with its own handle
+ of the file placed where the section starts (known from the header). The checksum is calculated at the end by
+ reading the file again
+
+ @param namefile path and name of the file, to open the handles of the sections
+ @param file pointer to the file, open for reading and writing
+ @param summary pointer to the summary of the network
+ @param header pointer to the header with the number of paths and splits already counted
+ @return 0 if written correctly, -1 otherwise
+ */
+int write_generated_binary(char *namefile, FILE *file, GeneratorSummary *summary, BinaryNetworkHeader *header) {
+    
+    GeneratedFrame *frame = &generated_frame;
+    BinaryLink link_record;
+    BinaryFrame frame_record;
+    FILE *sections[GENERATOR_SECTIONS]; // Starts and links of the paths, and starts and links of the splits
+    long int offset;
+    uint32_t crc, path_start = 0, split_start = 0;
+    int32_t value;
+    size_t size;
+    int status = 0;
+    
+    memcpy(header->magic, BINARY_NETWORK_MAGIC, sizeof(header->magic));
+    header->version = BINARY_NETWORK_VERSION;
+    header->number_frames = generator_options->num_frames;
+    header->number_links = generated_num_links;
+    header->number_nodes = generated_num_nodes;
+    header->number_connections = generated_node_starts[generated_num_nodes];
+    header->hop_delay = generator_options->hop_delay;
+    header->hyper_period = generated_hyperperiod;
+    header->protocol_period = generator_options->protocol_period;
+    header->protocol_time = generator_options->protocol_time;
+    header->time_between_frames = generator_options->time_between_frames;
+    
+    // The header is written again at the end, when the checksum is known
+    status |= fwrite(header, sizeof(BinaryNetworkHeader), 1, file) != 1;
+    for (int i = 0; i < generated_num_links; i++) {
+        memset(&link_record, 0, sizeof(BinaryLink));
+        link_record.speed = generated_link_speed[i];
+        link_record.type = generated_link_type[i];
+        link_record.source = generated_link_source[i];
+        link_record.destination = generated_link_destination[i];
+        status |= fwrite(&link_record, sizeof(BinaryLink), 1, file) != 1;
+    }
+    
+    // Open the sections after the frame records
+    offset = sizeof(BinaryNetworkHeader) + (long int) sizeof(BinaryLink) * generated_num_links +
+             (long int) sizeof(BinaryFrame) * generator_options->num_frames;
+    for (int i = 0; i < GENERATOR_SECTIONS; i++) {
+        sections[i] = fopen(namefile, "r+b");
+        if (sections[i] == NULL || fseek(sections[i], offset, SEEK_SET) != 0) {
+            for (int j = 0; j <= i; j++) {
+                if (sections[j] != NULL) {
+                    fclose(sections[j]);
+                }
+            }
+            return -1;
+        }
+        setvbuf(sections[i], &file_buffers[(size_t) (i + 1) * GENERATOR_BUFFER_SIZE], _IOFBF, GENERATOR_BUFFER_SIZE);
+        offset += i == 0 ? sizeof(uint32_t) * (header->number_paths + 1) :
+                  i == 1 ? sizeof(int32_t) * header->number_path_links :
+                  i == 2 ? sizeof(uint32_t) * (header->number_splits + 1) : 0;
+    }
+    
+    // Frame records and their paths and splits
+    memset(&frame_record, 0, sizeof(BinaryFrame));
+    status |= fwrite(&path_start, sizeof(uint32_t), 1, sections[0]) != 1;
+    status |= fwrite(&split_start, sizeof(uint32_t), 1, sections[2]) != 1;
+    for (int i = 0; i < generator_options->num_frames; i++) {
+        build_frame(i, summary->size_scale);
+        frame_record.period = frame->period;
+        frame_record.deadline = frame->period;
+        frame_record.end_to_end_delay = frame->period;
+        frame_record.starting = 0;
+        frame_record.size = frame->size;
+        frame_record.first_path += frame_record.num_paths;
+        frame_record.num_paths = frame->num_paths;
+        frame_record.first_split += frame_record.num_splits;
+        frame_record.num_splits = frame->num_splits;
+        status |= fwrite(&frame_record, sizeof(BinaryFrame), 1, file) != 1;
+        for (int j = 0; j < frame->num_paths; j++) {
+            binary_rows[j] = path_start + frame->path_starts[j + 1];
+        }
+        path_start += frame->path_starts[frame->num_paths];
+        status |= fwrite(binary_rows, sizeof(uint32_t), frame->num_paths, sections[0]) != (size_t) frame->num_paths;
+        status |= fwrite(frame->path_links, sizeof(int32_t), frame->path_starts[frame->num_paths], sections[1]) !=
+                  (size_t) frame->path_starts[frame->num_paths];
+        for (int j = 0; j < frame->num_splits; j++) {
+            binary_rows[j] = split_start + frame->split_starts[j + 1];
+        }
+        split_start += frame->split_starts[frame->num_splits];
+        status |= fwrite(binary_rows, sizeof(uint32_t), frame->num_splits, sections[2]) != (size_t) frame->num_splits;
+        status |= fwrite(frame->split_links, sizeof(int32_t), frame->split_starts[frame->num_splits], sections[3]) !=
+                  (size_t) frame->split_starts[frame->num_splits];
+    }
+    
+    // Category of the nodes and compressed rows of their connections, after the links of the splits
+    for (int i = 0; i < generated_num_nodes; i++) {
+        value = i < generator_options->num_switches ? switch_node : end_system_node;
+        status |= fwrite(&value, sizeof(int32_t), 1, sections[3]) != 1;
+    }
+    for (int i = 0; i <= generated_num_nodes; i++) {
+        value = generated_node_starts[i];
+        status |= fwrite(&value, sizeof(uint32_t), 1, sections[3]) != 1;
+    }
+    status |= fwrite(generated_node_links, sizeof(int32_t), generated_node_starts[generated_num_nodes],
+                     sections[3]) != (size_t) generated_node_starts[generated_num_nodes];
+    for (int i = 0; i < GENERATOR_SECTIONS; i++) {
+        status |= fclose(sections[i]) != 0;
+    }
+    
+    // Read the file again to calculate the checksum and write the header with it
+    crc = 0;
+    status |= fflush(file) != 0 || fseek(file, offsetof(BinaryNetworkHeader, number_frames), SEEK_SET) != 0;
+    while (!status && (size = fread(&file_buffers[GENERATOR_BUFFER_SIZE], 1, GENERATOR_BUFFER_SIZE, file)) > 0) {
+        crc = update_crc32(crc, &file_buffers[GENERATOR_BUFFER_SIZE], size);
+    }
+    header->checksum = crc;
+    if (status || fseek(file, 0, SEEK_SET) != 0 || fwrite(header, sizeof(BinaryNetworkHeader), 1, file) != 1) {
+        status = 1;
+    }
+    fseek(file, 0, SEEK_END);
+    return status ? -1 : 0;
+}
+
+/**
+ Tells if the generator options are valid
+
+ @param options pointer to the options
+ @return 1 if they are valid, 0 otherwise
+ */
+int check_generator_options(GeneratorOptions *options) {
+    
+    if (options->num_switches <= 0 || options->end_systems <= 0 || options->num_frames <= 0 ||
+        (long long int) options->num_switches * options->end_systems < 2) {
+        printf("The network needs at least one switch, two end systems and one frame\n");
+        return 0;
+    }
+    if (options->topology < topology_line || options->topology > topology_mesh) {
+        printf("The topology of the network is not valid\n");
+        return 0;
+    }
+    if (options->num_speeds <= 0 || options->num_periods <= 0 || options->min_size <= 0 ||
+        options->max_size < options->min_size || options->max_fanout < 1 ||
+        options->max_fanout > GENERATOR_MAX_FANOUT) {
+        printf("The speeds, periods, sizes or fan-out of the network are not valid\n");
+        return 0;
+    }
+    for (int i = 0; i < options->num_speeds; i++) {
+        if (options->speeds[i] <= 0) {
+            printf("The speed %d is not valid\n", options->speeds[i]);
+            return 0;
+        }
+    }
+    for (int i = 0; i < options->num_periods; i++) {
+        if (options->periods[i] <= 0) {
+            printf("The period %lld is not valid\n", options->periods[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ Frees all the arrays of the generated network
+ */
+void free_generator(void) {
+    
+    free(generated_link_source);
+    free(generated_link_destination);
+    free(generated_link_speed);
+    free(generated_link_type);
+    free(generated_node_starts);
+    free(generated_node_links);
+    free(switch_link_starts);
+    free(switch_links);
+    free(generated_frame.path_starts);
+    free(generated_frame.path_links);
+    free(generated_frame.split_starts);
+    free(generated_frame.split_links);
+    free(frame_receivers);
+    free(binary_rows);
+    free(file_buffers);
+    free(link_stamps);
+    free(link_busy);
+    generated_link_source = NULL;
+    generated_link_destination = NULL;
+    generated_link_speed = NULL;
+    generated_link_type = NULL;
+    generated_node_starts = NULL;
+    generated_node_links = NULL;
+    switch_link_starts = NULL;
+    switch_links = NULL;
+    memset(&generated_frame, 0, sizeof(GeneratedFrame));
+    frame_receivers = NULL;
+    binary_rows = NULL;
+    file_buffers = NULL;
+    link_stamps = NULL;
+    link_busy = NULL;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Init the generator options with the default values
+ */
+void init_generator_options(GeneratorOptions *options) {
+    
+    options->seed = 1;
+    options->topology = topology_ring;
+    options->num_switches = 8;
+    options->end_systems = 2;
+    options->num_frames = 100;
+    options->speeds = default_speeds;
+    options->num_speeds = sizeof(default_speeds) / sizeof(int);
+    options->wireless = 0;
+    options->periods = default_periods;
+    options->num_periods = sizeof(default_periods) / sizeof(long long int);
+    options->min_size = 64;
+    options->max_size = 1500;
+    options->utilization = 0;
+    options->multicast = 0.1;
+    options->max_fanout = 4;
+    options->hop_delay = 1000;
+    options->protocol_period = 0;
+    options->protocol_time = 0;
+    options->time_between_frames = 0;
+}
+
+/**
+ Get the class of topology with the given name
+ */
+int get_topology_class(const char *name) {
+    
+    for (int i = topology_line; i <= topology_mesh; i++) {
+        if (strcmp(name, topology_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ Generates a synthetic network and writes it directly in a network file, without building the network in memory
+ */
+int generate_network_file(char *namefile, GeneratorOptions *options, GeneratorSummary *summary) {
+    
+    GeneratorSummary local_summary;     // Summary used if none is given
+    BinaryNetworkHeader header;
+    FILE *file;
+    const char *extension = strrchr(namefile, '.');
+    int binary = extension != NULL && strcmp(extension, ".srsn") == 0;
+    int max_path, status, used_links = 0;
+    double frame_busy = 0, protocol_busy = 0;
+    
+    if (summary == NULL) {
+        summary = &local_summary;
+    }
+    if (!check_generator_options(options)) {
+        return -1;
+    }
+    generator_options = options;
+    if ((generated_hyperperiod = get_generated_hyperperiod()) == -1) {
+        printf("The hyperperiod of the periods does not fit in 64 bits\n");
+        return -1;
+    }
+    generated_end_systems = options->num_switches * options->end_systems;
+    generated_num_nodes = options->num_switches + generated_end_systems;
+    
+    // Topology and the arrays of the frame being generated (a path has at most all switches and two links)
+    max_path = options->num_switches + 2;
+    generated_frame.path_starts = malloc(sizeof(int) * (options->max_fanout + 1));
+    generated_frame.path_links = malloc(sizeof(int32_t) * options->max_fanout * max_path);
+    generated_frame.split_starts = malloc(sizeof(int) * (max_path + 1));
+    generated_frame.split_links = malloc(sizeof(int32_t) * options->max_fanout * max_path);
+    frame_receivers = malloc(sizeof(int) * options->max_fanout);
+    binary_rows = malloc(sizeof(uint32_t) * (options->max_fanout + max_path));
+    file_buffers = malloc((size_t) (GENERATOR_SECTIONS + 1) * GENERATOR_BUFFER_SIZE);
+    if (generated_frame.path_starts == NULL || generated_frame.path_links == NULL ||
+        generated_frame.split_starts == NULL || generated_frame.split_links == NULL || frame_receivers == NULL ||
+        binary_rows == NULL || file_buffers == NULL || build_topology() == -1) {
+        printf("There is not enough memory to generate the network\n");
+        free_generator();
+        return -1;
+    }
+    link_stamps = malloc(sizeof(int) * generated_num_links);
+    link_busy = malloc(sizeof(double) * generated_num_links);
+    if (link_stamps == NULL || link_busy == NULL) {
+        printf("There is not enough memory to generate the network\n");
+        free_generator();
+        return -1;
+    }
+    
+    // Measure the links with the random sizes, and scale the sizes to reach the utilization
+    memset(&header, 0, sizeof(BinaryNetworkHeader));
+    summary->size_scale = 1;
+    if (options->utilization > 0) {
+        measure_frames(1, summary, NULL);
+        for (int i = 0; i < generated_num_links; i++) {
+            if (link_busy[i] > 0) {
+                used_links++;
+                frame_busy += link_busy[i];
+                if (options->protocol_period > 0) {
+                    protocol_busy += (double) (generated_hyperperiod / options->protocol_period) *
+                                     options->protocol_time;
+                }
+            }
+        }
+        frame_busy -= protocol_busy;
+        if (frame_busy > 0) {
+            summary->size_scale = (options->utilization * used_links * generated_hyperperiod - protocol_busy) /
+                                  frame_busy;
+        }
+    }
+    measure_frames(summary->size_scale, summary, &header);
+    summary->num_nodes = generated_num_nodes;
+    summary->num_links = generated_num_links;
+    summary->hyperperiod = generated_hyperperiod;
+    // The sizes are limited to the minimum and maximum sizes, so the target could not be reached
+    if (options->utilization > 0 &&
+        fabs(summary->utilization - options->utilization) > options->utilization * GENERATOR_UTILIZATION_TOLERANCE) {
+        printf("The utilization of %f cannot be reached with frames from %d to %d bytes, the links used have an "
+               "average utilization of %f\n", options->utilization, options->min_size, options->max_size,
+               summary->utilization);
+    }
+    if (summary->max_utilization > 1) {
+        printf("The most used link of the network has a utilization of %f, it cannot be scheduled\n",
+               summary->max_utilization);
+    }
+    
+    file = fopen(namefile, binary ? "w+b" : "w");
+    if (file == NULL) {
+        printf("The network file %s could not be created\n", namefile);
+        free_generator();
+        return -1;
+    }
+    setvbuf(file, file_buffers, _IOFBF, GENERATOR_BUFFER_SIZE);
+    if (binary) {
+        status = write_generated_binary(namefile, file, summary, &header);
+    } else {
+        status = write_generated_xml(file, summary);
+    }
+    summary->file_size = ftell(file);
+    if (fclose(file) != 0 || status != 0) {
+        printf("The network file %s could not be written\n", namefile);
+        free_generator();
+        return -1;
+    }
+    free_generator();
+    return 0;
+}
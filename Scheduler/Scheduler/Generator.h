@@ -0,0 +1,115 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Generator.h                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that generates synthetic networks directly into network files (xml or binary), for stress tests with much  *
+ *  bigger networks than the python network generator can create.                                                      *
+ *  The switches are connected as a line, ring, star, binary tree or mesh, and every switch has the same number of     *
+ *  end systems. Every connection is a pair of links, one in each direction, with a speed chosen at random from the    *
+ *  given speeds, and the connections of the end systems can be wireless.                                              *
+ *  Every frame is sent by a random end system to one receiver, or to several (multicast) up to a maximum fan-out,     *
+ *  through the shortest paths between the switches, with a period chosen at random from the given periods. The sizes  *
+ *  of the frames are chosen at random and then scaled to reach the target utilization of the links that are used.     *
+ *  Every frame is built from its own random generator, seeded with the seed and its identifier, so the networks are   *
+ *  deterministic and the frames are built again for every part of the file instead of being kept in memory. The       *
+ *  routes are found from the structure of the topology, so only the links are kept in memory and files of several GB  *
+ *  are written in seconds.                                                                                            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Generator_h
+#define Generator_h
+
+#include <stdio.h>
+
+#endif /* Generator_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define GENERATOR_MAX_FANOUT 64         // Maximum receivers of a multicast frame
+#define GENERATOR_UTILIZATION_TOLERANCE 0.1 // Relative error of the utilization reached before it is warned
+
+/**
+ Class of the topology that connects the switches
+ */
+typedef enum TopologyClass {
+    topology_line,                      // Every switch is connected to the next one
+    topology_ring,                      // Line where the last switch is also connected to the first one
+    topology_star,                      // All switches are connected to the first one
+    topology_tree,                      // Binary tree, every switch is connected to its parent
+    topology_mesh                       // Square grid, every switch is connected to its right and lower neighbours
+}TopologyClass;
+
+/**
+ Parameters of the generated network
+ */
+typedef struct GeneratorOptions {
+    unsigned long long int seed;        // Seed of the random generators, the same seed generates the same network
+    TopologyClass topology;             // Class of the topology of the switches
+    int num_switches;                   // Number of switches
+    int end_systems;                    // Number of end systems connected to every switch
+    int num_frames;                     // Number of frames
+    int *speeds;                        // Speeds of the links in MB/s, chosen at random for every connection
+    int num_speeds;                     // Number of speeds
+    double wireless;                    // Fraction of the connections of the end systems that are wireless
+    long long int *periods;             // Periods of the frames in ns, chosen at random for every frame
+    int num_periods;                    // Number of periods
+    int min_size;                       // Minimum size of a frame in bytes
+    int max_size;                       // Maximum size of a frame in bytes
+    double utilization;                 // Target average utilization of the links used, 0 to keep the random sizes
+    double multicast;                   // Fraction of the frames with more than one receiver
+    int max_fanout;                     // Maximum number of receivers of a multicast frame
+    int hop_delay;                      // Minimum time in ns that a switch needs to relay a frame
+    long long int protocol_period;      // Period of the protocol in ns, 0 if there is no protocol
+    long long int protocol_time;        // Time reserved for the protocol every period in ns
+    long long int time_between_frames;  // Minimum time between two transmissions in the same link in ns
+}GeneratorOptions;
+
+/**
+ Summary of the generated network
+ */
+typedef struct GeneratorSummary {
+    int num_nodes;                      // Number of switches and end systems
+    int num_links;                      // Number of links
+    long long int hyperperiod;          // Hyperperiod of the network in ns
+    long long int instances;            // Instances of all frames in all their links
+    long long int path_links;           // Links of all the paths of all the frames
+    double size_scale;                  // Factor applied to the random sizes to reach the utilization
+    double utilization;                 // Average utilization of the links used (protocol included)
+    double max_utilization;             // Utilization of the most used link (protocol included)
+    long long int file_size;            // Size of the network file in bytes
+}GeneratorSummary;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Init the generator options with the default values: ring of 8 switches with 2 end systems each, 100 frames, links of
+ 100 MB/s, periods of 1, 2, 5 and 10 ms, sizes from 64 to 1500 bytes, 10% of multicast frames up to 4 receivers and
+ no protocol. The speeds and periods point to constant arrays, they have to be replaced and not modified
+
+ @param options pointer to the options to init
+ */
+void init_generator_options(GeneratorOptions *options);
+
+/**
+ Get the class of topology with the given name (line, ring, star, tree or mesh)
+
+ @param name name of the topology
+ @return class of the topology, -1 if there is no topology with that name
+ */
+int get_topology_class(const char *name);
+
+/**
+ Generates a synthetic network and writes it directly in a network file, without building the network in memory.
+ The network in memory, if any, is not modified
+
+ @param namefile path and name of the network file, binary if it ends with .srsn and xml otherwise
+ @param options pointer to the parameters of the network
+ @param summary pointer where the summary of the network is saved, NULL if not needed
+ @return 0 if the network was written, -1 if the parameters are not valid or the file could not be written
+ */
+int generate_network_file(char *namefile, GeneratorOptions *options, GeneratorSummary *summary);
@@ -0,0 +1,623 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  HyperperiodAdvisor.c                                                                                               *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in HyperperiodAdvisor.h                                                                                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "HyperperiodAdvisor.h"
+#include "Network.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+                                                    /* VARIABLES */
+
+// The frames (and the protocol as the last one) are the rows of the analysis, their links do not change
+int advisor_rows = 0;                   // Number of frames analyzed plus the protocol if it is active
+long long int *row_starting = NULL;     // Starting time of every row
+int *row_links = NULL;                  // Number of links where every row is transmitted
+int *link_row_starts = NULL;            // Index in link_rows where the rows of every link start, links + 1 elements
+int *link_rows = NULL;                  // Rows transmitted in every link, one link after another
+long long int path_formulas = 0;        // Path dependent and end to end formulas, they do not depend on the periods
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the greatest common divisor of two numbers
+
+ @param a first number
+ @param b second number
+ @return greatest common divisor
+ */
+long long int greatest_common_divisor(long long int a, long long int b) {
+    
+    long long int rest;
+    
+    while (b != 0) {
+        rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+/**
+ Get the least common multiple of two positive numbers
+
+ @param a first number
+ @param b second number
+ @return least common multiple, -1 if it does not fit in a long long int
+ */
+long long int least_common_multiple(long long int a, long long int b) {
+    
+    long long int factor = a / greatest_common_divisor(a, b);
+    
+    if (factor > LLONG_MAX / b) {
+        return -1;
+    }
+    return factor * b;
+}
+
+/**
+ Get the division of two numbers rounded towards minus infinity
+
+ @param a dividend
+ @param b divisor, positive
+ @return a / b rounded down
+ */
+long long int floor_division(long long int a, long long int b) {
+    
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ Compares two periods to sort them in ascending order
+
+ @param a pointer to the first period
+ @param b pointer to the second period
+ @return negative if the first is lower, positive if it is greater, 0 if equal
+ */
+int compare_periods(const void *a, const void *b) {
+    
+    const long long int *period_a = a, *period_b = b;
+    
+    return (*period_a > *period_b) - (*period_a < *period_b);
+}
+
+/**
+ Compares the contribution of two frames to sort them from the most to the least disjunctions
+
+ @param a pointer to the first frame inflation
+ @param b pointer to the second frame inflation
+ @return negative if the first has more disjunctions, positive if it has less, 0 if equal
+ */
+int compare_inflations(const void *a, const void *b) {
+    
+    const FrameInflation *inflation_a = a, *inflation_b = b;
+    
+    return (inflation_a->disjunctions < inflation_b->disjunctions) -
+        (inflation_a->disjunctions > inflation_b->disjunctions);
+}
+
+/**
+ Saves the rows transmitted in every link as compressed rows, with the protocol in every link that has not failed.
+ It also counts the path dependent and end to end formulas, that are the same for any period
+
+ @param num_frames number of frames of the network without the protocol
+ */
+void build_link_rows(int num_frames) {
+    
+    Frame *frame_pt;
+    Offset *offset_it;
+    Path *path_it;
+    int num_links = get_number_links();
+    int *position;
+    
+    advisor_rows = is_protocol_active() == 1 ? num_frames + 1 : num_frames;
+    row_starting = malloc(sizeof(long long int) * (advisor_rows + 1));
+    row_links = calloc(advisor_rows + 1, sizeof(int));
+    link_row_starts = calloc(num_links + 1, sizeof(int));
+    position = malloc(sizeof(int) * (num_links + 1));
+    path_formulas = 0;
+    
+    // Count the rows of every link, then place them
+    for (int i = 0; i < num_frames; i++) {
+        frame_pt = get_frame(i);
+        row_starting[i] = get_starting(frame_pt);
+        offset_it = get_offset_root(frame_pt);
+        while (!is_last_offset(offset_it)) {
+            link_row_starts[get_offset_link(offset_it) + 1]++;
+            row_links[i]++;
+            offset_it = get_next_offset(offset_it);
+        }
+        for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
+            path_it = get_path_root(frame_pt, path_id);
+            path_formulas++;            // End to end delay of the path
+            path_it = get_next_path(path_it);
+            while (!is_last_path(path_it)) {
+                path_formulas++;        // Path dependency between two consecutive links
+                path_it = get_next_path(path_it);
+            }
+        }
+    }
+    if (advisor_rows > num_frames) {
+        row_starting[num_frames] = 0;
+        for (int link_id = 0; link_id < num_links; link_id++) {
+            if (!is_link_failed(get_link(link_id))) {
+                link_row_starts[link_id + 1]++;
+                row_links[num_frames]++;
+                path_formulas++;        // The protocol has a path with only this link, with its end to end delay
+            }
+        }
+    }
+    for (int link_id = 0; link_id < num_links; link_id++) {
+        link_row_starts[link_id + 1] += link_row_starts[link_id];
+        position[link_id] = link_row_starts[link_id];
+    }
+    link_rows = malloc(sizeof(int) * (link_row_starts[num_links] + 1));
+    for (int i = 0; i < num_frames; i++) {
+        offset_it = get_offset_root(get_frame(i));
+        while (!is_last_offset(offset_it)) {
+            link_rows[position[get_offset_link(offset_it)]++] = i;
+            offset_it = get_next_offset(offset_it);
+        }
+    }
+    if (advisor_rows > num_frames) {
+        for (int link_id = 0; link_id < num_links; link_id++) {
+            if (!is_link_failed(get_link(link_id))) {
+                link_rows[position[link_id]++] = num_frames;
+            }
+        }
+    }
+    free(position);
+}
+
+/**
+ Frees the rows of every link
+ */
+void free_link_rows(void) {
+    
+    free(row_starting);
+    free(row_links);
+    free(link_row_starts);
+    free(link_rows);
+    row_starting = NULL;
+    row_links = NULL;
+    link_row_starts = NULL;
+    link_rows = NULL;
+    advisor_rows = 0;
+}
+
+/**
+ Counts the pairs of instances of two rows whose transmission windows overlap in the hyperperiod, as the solver does
+ to add a contention free disjunction. For every instance of the row with less instances, the instances of the other
+ row that overlap with it are consecutive, so they are counted at once
+
+ @param row_a first row
+ @param row_b second row
+ @param periods period of every row
+ @param deadlines deadline of every row
+ @param hyperperiod hyperperiod in ns
+ @return number of pairs of instances that overlap
+ */
+long long int count_overlaps(int row_a, int row_b, long long int *periods, long long int *deadlines,
+                             long long int hyperperiod) {
+    
+    long long int count = 0, first, last, base;
+    long long int instances_b;
+    int swap;
+    
+    if (hyperperiod / periods[row_a] > hyperperiod / periods[row_b]) {
+        swap = row_a;
+        row_a = row_b;
+        row_b = swap;
+    }
+    instances_b = hyperperiod / periods[row_b];
+    for (long long int instance = 0; instance < hyperperiod / periods[row_a]; instance++) {
+        // The instance of b overlaps if it starts before a ends and a starts before it ends
+        base = periods[row_a] * instance;
+        last = floor_division(base + deadlines[row_a] - row_starting[row_b] - 1, periods[row_b]);
+        first = floor_division(base + row_starting[row_a] - deadlines[row_b], periods[row_b]) + 1;
+        first = first < 0 ? 0 : first;
+        last = last >= instances_b ? instances_b - 1 : last;
+        if (last >= first) {
+            count += last - first + 1;
+        }
+    }
+    return count;
+}
+
+/**
+ Estimates the size of the schedule problem with the given periods and hyperperiod, and the contribution of every row
+
+ @param hyperperiod hyperperiod in ns
+ @param periods period of every row
+ @param deadlines deadline of every row
+ @param inflations array where the contribution of every row is saved, NULL to skip it
+ @param estimate pointer where the size of the problem is saved
+ */
+void estimate_constraints(long long int hyperperiod, long long int *periods, long long int *deadlines,
+                          FrameInflation *inflations, ConstraintEstimate *estimate) {
+    
+    long long int instances, overlaps, offsets = 0;
+    int num_frames = is_protocol_active() == 1 ? advisor_rows - 1 : advisor_rows;
+    
+    memset(estimate, 0, sizeof(ConstraintEstimate));
+    estimate->hyperperiod = hyperperiod;
+    for (int row = 0; row < advisor_rows; row++) {
+        instances = hyperperiod / periods[row];
+        estimate->instances += instances;
+        estimate->variables += instances * row_links[row];
+        if (row < num_frames) {
+            offsets += row_links[row];
+        }
+        if (inflations != NULL) {
+            inflations[row].frame_id = row < num_frames ? row : -1;
+            inflations[row].period = periods[row];
+            inflations[row].instances = instances;
+            inflations[row].variables = instances * row_links[row];
+            inflations[row].disjunctions = 0;
+        }
+    }
+    
+    // Every two rows that share a link add one disjunction per pair of instances that overlap
+    for (int link_id = 0; link_id < get_number_links(); link_id++) {
+        for (int i = link_row_starts[link_id]; i < link_row_starts[link_id + 1]; i++) {
+            for (int j = link_row_starts[link_id]; j < i; j++) {
+                overlaps = count_overlaps(link_rows[i], link_rows[j], periods, deadlines, hyperperiod);
+                estimate->disjunctions += overlaps;
+                if (inflations != NULL) {
+                    inflations[link_rows[i]].disjunctions += overlaps;
+                    inflations[link_rows[j]].disjunctions += overlaps;
+                }
+            }
+        }
+    }
+    
+    // Ranges of the offsets, distances to the instance 0 of the rest of instances (the protocol is not counted, as
+    // the solver does), path dependency and end to end delay, and disjunctions
+    estimate->formulas = offsets + path_formulas + estimate->disjunctions;
+    for (int row = 0; row < num_frames; row++) {
+        estimate->formulas += (hyperperiod / periods[row] - 1) * row_links[row];
+    }
+}
+
+/**
+ Rounds down the period of every frame to the largest divisor of the candidate hyperperiod within the tolerance.
+ The protocol keeps its period, so it has to divide the candidate
+
+ @param candidate candidate hyperperiod in ns
+ @param tolerance largest reduction of a period, as a fraction of the period
+ @param periods current period of every row
+ @param deadlines current deadline of every row
+ @param new_periods array where the new period of every row is saved
+ @param new_deadlines array where the new deadline of every row is saved
+ @return least common multiple of the new periods, -1 if a period cannot be rounded
+ */
+long long int round_periods(long long int candidate, double tolerance, long long int *periods,
+                            long long int *deadlines, long long int *new_periods, long long int *new_deadlines) {
+    
+    long long int lowest, first_divisor, last_divisor, hyperperiod = 1;
+    int num_frames = is_protocol_active() == 1 ? advisor_rows - 1 : advisor_rows;
+    
+    for (int row = 0; row < advisor_rows; row++) {
+        new_periods[row] = -1;
+        if (row < num_frames) {
+            lowest = periods[row] - (long long int) (periods[row] * tolerance);
+        } else {
+            lowest = periods[row];
+        }
+        
+        // The divisors candidate / q from the period down to the lowest period allowed
+        first_divisor = (candidate + periods[row] - 1) / periods[row];
+        last_divisor = candidate / (lowest > 0 ? lowest : 1);
+        if (last_divisor - first_divisor > ADVISOR_DIVISOR_SEARCH) {
+            last_divisor = first_divisor + ADVISOR_DIVISOR_SEARCH;
+        }
+        for (long long int q = first_divisor; q <= last_divisor; q++) {
+            if (candidate % q == 0) {
+                new_periods[row] = candidate / q;
+                break;
+            }
+        }
+        if (new_periods[row] == -1) {
+            return -1;
+        }
+        
+        // The frame has to be transmitted before its new period ends
+        new_deadlines[row] = deadlines[row] < new_periods[row] ? deadlines[row] : new_periods[row];
+        if (row_starting[row] >= new_deadlines[row]) {
+            return -1;
+        }
+        hyperperiod = least_common_multiple(hyperperiod, new_periods[row]);
+        if (hyperperiod == -1) {
+            return -1;
+        }
+    }
+    return hyperperiod;
+}
+
+/**
+ Returns 1 if the first proposal is at least as good as the second in everything: disjunctions, frames changed and
+ largest change of a period
+
+ @param a pointer to the first proposal
+ @param b pointer to the second proposal
+ @return 1 if the first proposal dominates the second, 0 otherwise
+ */
+int dominates_proposal(PeriodProposal *a, PeriodProposal *b) {
+    
+    return a->estimate.disjunctions <= b->estimate.disjunctions && a->num_changed <= b->num_changed &&
+        a->max_change <= b->max_change;
+}
+
+/**
+ Frees the arrays of a proposal
+
+ @param proposal pointer to the proposal
+ */
+void free_proposal(PeriodProposal *proposal) {
+    
+    free(proposal->periods);
+    free(proposal->deadlines);
+}
+
+/**
+ Adds a proposal into the proposals of the analysis, sorted from the least disjunctions, if no other proposal is as
+ good in everything. The proposals that are worse in everything than the new one are removed, so the proposals left
+ range from the smallest changes to the biggest reductions
+
+ @param analysis pointer to the analysis
+ @param max_proposals maximum number of proposals
+ @param proposal pointer to the proposal, its arrays belong to the analysis if added, otherwise they are freed
+ */
+void add_proposal(HyperperiodAnalysis *analysis, int max_proposals, PeriodProposal *proposal) {
+    
+    int position = 0, num_kept = 0;
+    
+    for (int i = 0; i < analysis->num_proposals; i++) {
+        if (dominates_proposal(&analysis->proposals[i], proposal)) {
+            free_proposal(proposal);
+            return;
+        }
+    }
+    for (int i = 0; i < analysis->num_proposals; i++) {
+        if (dominates_proposal(proposal, &analysis->proposals[i])) {
+            free_proposal(&analysis->proposals[i]);
+        } else {
+            analysis->proposals[num_kept++] = analysis->proposals[i];
+        }
+    }
+    analysis->num_proposals = num_kept;
+    
+    while (position < analysis->num_proposals &&
+           analysis->proposals[position].estimate.disjunctions <= proposal->estimate.disjunctions) {
+        position++;
+    }
+    if (position >= max_proposals) {
+        free_proposal(proposal);
+        return;
+    }
+    if (analysis->num_proposals == max_proposals) {
+        analysis->num_proposals--;
+        free_proposal(&analysis->proposals[analysis->num_proposals]);
+    }
+    memmove(&analysis->proposals[position + 1], &analysis->proposals[position],
+            sizeof(PeriodProposal) * (analysis->num_proposals - position));
+    analysis->proposals[position] = *proposal;
+    analysis->num_proposals++;
+}
+
+/**
+ Get the candidate hyperperiods: the limit itself, the multiples of every period, its multiples by powers of two and
+ the least common multiples of every two periods, all of them up to the limit, sorted and without repetitions
+
+ @param periods period of every row
+ @param limit largest candidate in ns
+ @param candidates pointer where the allocated array of candidates is saved
+ @return number of candidates
+ */
+int get_candidate_hyperperiods(long long int *periods, long long int limit, long long int **candidates) {
+    
+    long long int *distinct, multiple;
+    int num_distinct = 0, num_candidates = 0, capacity;
+    
+    // Distinct periods
+    distinct = malloc(sizeof(long long int) * (advisor_rows + 1));
+    memcpy(distinct, periods, sizeof(long long int) * advisor_rows);
+    qsort(distinct, advisor_rows, sizeof(long long int), compare_periods);
+    for (int i = 0; i < advisor_rows; i++) {
+        if (num_distinct == 0 || distinct[num_distinct - 1] != distinct[i]) {
+            distinct[num_distinct++] = distinct[i];
+        }
+    }
+    
+    capacity = num_distinct * (ADVISOR_MULTIPLES + 64) + num_distinct * num_distinct + 1;
+    *candidates = malloc(sizeof(long long int) * capacity);
+    (*candidates)[num_candidates++] = limit;
+    for (int i = 0; i < num_distinct; i++) {
+        for (int m = 1; m <= ADVISOR_MULTIPLES && distinct[i] <= limit / m; m++) {
+            (*candidates)[num_candidates++] = distinct[i] * m;
+        }
+        multiple = distinct[i];
+        while (multiple <= limit / 2) {
+            multiple *= 2;
+            (*candidates)[num_candidates++] = multiple;
+        }
+        for (int j = 0; j < i; j++) {
+            multiple = least_common_multiple(distinct[i], distinct[j]);
+            if (multiple != -1 && multiple <= limit) {
+                (*candidates)[num_candidates++] = multiple;
+            }
+        }
+    }
+    free(distinct);
+    
+    qsort(*candidates, num_candidates, sizeof(long long int), compare_periods);
+    capacity = num_candidates;
+    num_candidates = 0;
+    for (int i = 0; i < capacity; i++) {
+        if (num_candidates == 0 || (*candidates)[num_candidates - 1] != (*candidates)[i]) {
+            (*candidates)[num_candidates++] = (*candidates)[i];
+        }
+    }
+    return num_candidates;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Analyzes the contribution of every frame of the network in memory to the size of the schedule problem, and searches
+ the changes of the periods within the tolerance that shrink the hyperperiod the most
+ */
+int analyze_hyperperiod(double tolerance, int max_proposals, HyperperiodAnalysis *analysis) {
+    
+    long long int *periods, *deadlines, *new_periods, *new_deadlines, *candidates;
+    long long int hyperperiod, limit;
+    int num_frames = get_number_network_frames(), num_candidates;
+    PeriodProposal proposal;
+    
+    memset(analysis, 0, sizeof(HyperperiodAnalysis));
+    if (num_frames <= 0 || tolerance < 0 || tolerance >= 1 || max_proposals < 0) {
+        return -1;
+    }
+    build_link_rows(num_frames);
+    periods = malloc(sizeof(long long int) * (advisor_rows + 1));
+    deadlines = malloc(sizeof(long long int) * (advisor_rows + 1));
+    for (int i = 0; i < num_frames; i++) {
+        periods[i] = get_period(get_frame(i));
+        deadlines[i] = get_deadline(get_frame(i));
+    }
+    if (advisor_rows > num_frames) {
+        periods[num_frames] = get_protocol_period();
+        deadlines[num_frames] = get_protocol_period();
+    }
+    
+    // Contribution of every frame with the hyperperiod of the network
+    analysis->least_common_multiple = 1;
+    for (int row = 0; row < advisor_rows && analysis->least_common_multiple != -1; row++) {
+        analysis->least_common_multiple = least_common_multiple(analysis->least_common_multiple, periods[row]);
+    }
+    analysis->num_frames = advisor_rows;
+    analysis->frames = malloc(sizeof(FrameInflation) * (advisor_rows + 1));
+    estimate_constraints(get_hyper_period(), periods, deadlines, analysis->frames, &analysis->estimate);
+    qsort(analysis->frames, advisor_rows, sizeof(FrameInflation), compare_inflations);
+    
+    // Round the periods for every candidate hyperperiod smaller than the one of the network
+    analysis->proposals = malloc(sizeof(PeriodProposal) * (max_proposals + 1));
+    limit = get_hyper_period();
+    if (analysis->least_common_multiple != -1 && analysis->least_common_multiple < limit) {
+        limit = analysis->least_common_multiple;
+    }
+    num_candidates = get_candidate_hyperperiods(periods, limit, &candidates);
+    new_periods = malloc(sizeof(long long int) * (advisor_rows + 1));
+    new_deadlines = malloc(sizeof(long long int) * (advisor_rows + 1));
+    for (int i = 0; i < num_candidates && max_proposals > 0; i++) {
+        hyperperiod = round_periods(candidates[i], tolerance, periods, deadlines, new_periods, new_deadlines);
+        if (hyperperiod == -1 || hyperperiod >= get_hyper_period()) {
+            continue;
+        }
+        estimate_constraints(hyperperiod, new_periods, new_deadlines, NULL, &proposal.estimate);
+        proposal.num_changed = 0;
+        proposal.max_change = 0;
+        for (int row = 0; row < num_frames; row++) {
+            if (new_periods[row] != periods[row]) {
+                proposal.num_changed++;
+                if ((double) (periods[row] - new_periods[row]) / periods[row] > proposal.max_change) {
+                    proposal.max_change = (double) (periods[row] - new_periods[row]) / periods[row];
+                }
+            }
+        }
+        proposal.periods = malloc(sizeof(long long int) * (num_frames + 1));
+        proposal.deadlines = malloc(sizeof(long long int) * (num_frames + 1));
+        memcpy(proposal.periods, new_periods, sizeof(long long int) * num_frames);
+        memcpy(proposal.deadlines, new_deadlines, sizeof(long long int) * num_frames);
+        add_proposal(analysis, max_proposals, &proposal);
+    }
+    
+    free(candidates);
+    free(new_periods);
+    free(new_deadlines);
+    free(periods);
+    free(deadlines);
+    free_link_rows();
+    return analysis->num_proposals;
+}
+
+/**
+ Prints the analysis: the size of the schedule problem, the contribution of every frame, and every proposal
+ */
+void print_hyperperiod_analysis(HyperperiodAnalysis *analysis) {
+    
+    ConstraintEstimate *current = &analysis->estimate, *estimate;
+    PeriodProposal *proposal;
+    Frame *frame_pt;
+    
+    printf("Hyperperiod => %lld ns, least common multiple of the periods => %lld ns\n", current->hyperperiod,
+           analysis->least_common_multiple);
+    printf("Instances => %lld, variables => %lld, formulas => %lld, disjunctions => %lld\n", current->instances,
+           current->variables, current->formulas, current->disjunctions);
+    printf("%10s %16s %12s %12s %14s %8s\n", "Frame", "Period (ns)", "Instances", "Variables", "Disjunctions",
+           "Share");
+    for (int i = 0; i < analysis->num_frames; i++) {
+        if (analysis->frames[i].frame_id == -1) {
+            printf("%10s", "protocol");
+        } else {
+            printf("%10d", analysis->frames[i].frame_id);
+        }
+        printf(" %16lld %12lld %12lld %14lld %7.1f%%\n", analysis->frames[i].period, analysis->frames[i].instances,
+               analysis->frames[i].variables, analysis->frames[i].disjunctions, current->disjunctions == 0 ? 0 :
+               100.0 * analysis->frames[i].disjunctions / current->disjunctions);
+    }
+    
+    if (analysis->num_proposals == 0) {
+        printf("No change of the periods within the tolerance shrinks the hyperperiod\n");
+    }
+    for (int i = 0; i < analysis->num_proposals; i++) {
+        proposal = &analysis->proposals[i];
+        estimate = &proposal->estimate;
+        printf("Proposal %d => hyperperiod %lld ns (%.1f%%), variables %lld (%.1f%%), formulas %lld (%.1f%%), "
+               "disjunctions %lld (%.1f%%)\n", i + 1, estimate->hyperperiod,
+               100.0 * (estimate->hyperperiod - current->hyperperiod) / current->hyperperiod, estimate->variables,
+               current->variables == 0 ? 0 : 100.0 * (estimate->variables - current->variables) / current->variables,
+               estimate->formulas,
+               current->formulas == 0 ? 0 : 100.0 * (estimate->formulas - current->formulas) / current->formulas,
+               estimate->disjunctions, current->disjunctions == 0 ? 0 :
+               100.0 * (estimate->disjunctions - current->disjunctions) / current->disjunctions);
+        printf("    Frames changed => %d, largest change => %.1f%%\n", proposal->num_changed,
+               100.0 * proposal->max_change);
+        for (int frame_id = 0; frame_id < get_number_network_frames(); frame_id++) {
+            frame_pt = get_frame(frame_id);
+            if (proposal->periods[frame_id] != get_period(frame_pt)) {
+                printf("    Frame %d => period %lld -> %lld ns", frame_id, get_period(frame_pt),
+                       proposal->periods[frame_id]);
+                if (proposal->deadlines[frame_id] != get_deadline(frame_pt)) {
+                    printf(", deadline %lld -> %lld ns", get_deadline(frame_pt), proposal->deadlines[frame_id]);
+                }
+                printf("\n");
+            }
+        }
+    }
+}
+
+/**
+ Frees the arrays of an analysis
+ */
+void free_hyperperiod_analysis(HyperperiodAnalysis *analysis) {
+    
+    for (int i = 0; i < analysis->num_proposals; i++) {
+        free_proposal(&analysis->proposals[i]);
+    }
+    free(analysis->proposals);
+    free(analysis->frames);
+    analysis->proposals = NULL;
+    analysis->frames = NULL;
+    analysis->num_proposals = 0;
+    analysis->num_frames = 0;
+}
@@ -0,0 +1,110 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  HyperperiodAdvisor.h                                                                                               *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that analyzes how the periods of the frames inflate the schedule problem, before it is scheduled.          *
+ *  A frame is transmitted hyperperiod / period times in every link of its paths, and every instance is an offset      *
+ *  variable that has to avoid, with one disjunction, every instance of other frames in the same link whose            *
+ *  transmission window overlaps with it. So a single period that does not divide the rest multiplies the hyperperiod  *
+ *  and the number of constraints.                                                                                     *
+ *  The advisor reports the instances, variables and disjunctions of every frame, and proposes small changes of the    *
+ *  periods that shrink the hyperperiod. Every period is rounded down (the frame is sent more often, never less) to    *
+ *  the largest divisor of a candidate hyperperiod within a tolerance. The candidates are the periods and their small  *
+ *  multiples, their multiples by powers of two and the least common multiples of every two periods. Only the          *
+ *  proposals that no other beats at once in disjunctions, frames changed and largest change are kept, so they range   *
+ *  from the smallest adjustments to the biggest reductions, ranked by the estimated number of disjunctions.           *
+ *  The deadline of a frame whose period is rounded below it is reduced to the new period. The period of the protocol  *
+ *  is never changed, and the replicas of wireless links are not counted.                                              *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef HyperperiodAdvisor_h
+#define HyperperiodAdvisor_h
+
+#include <stdio.h>
+
+#endif /* HyperperiodAdvisor_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define ADVISOR_PROPOSALS 5             // Proposals returned by default
+#define ADVISOR_TOLERANCE 0.1           // Largest reduction of a period by default, as a fraction of the period
+#define ADVISOR_MULTIPLES 16            // Multiples of every period that are candidate hyperperiods
+#define ADVISOR_DIVISOR_SEARCH 1048576  // Maximum divisors of a candidate hyperperiod tried to round a period
+
+/**
+ Estimated size of the schedule problem, counted as the solver adds the constraints
+ */
+typedef struct ConstraintEstimate {
+    long long int hyperperiod;          // Hyperperiod in ns
+    long long int instances;            // Instances of all frames in the hyperperiod
+    long long int variables;            // Offset variables, the instances of every frame in every link
+    long long int formulas;             // Constraint formulas (ranges, distances, paths, end to end and disjunctions)
+    long long int disjunctions;         // Contention free disjunctions between instances in the same link
+}ConstraintEstimate;
+
+/**
+ Contribution of a frame to the size of the schedule problem
+ */
+typedef struct FrameInflation {
+    int frame_id;                       // Identifier of the frame, -1 for the protocol
+    long long int period;               // Period of the frame in ns
+    long long int instances;            // Instances of the frame in the hyperperiod
+    long long int variables;            // Instances of the frame in all its links
+    long long int disjunctions;         // Disjunctions between the instances of the frame and the rest
+}FrameInflation;
+
+/**
+ Change of the periods of the frames that shrinks the hyperperiod
+ */
+typedef struct PeriodProposal {
+    ConstraintEstimate estimate;        // Size of the schedule problem with the new periods
+    int num_changed;                    // Number of frames whose period changes
+    double max_change;                  // Largest reduction of a period, as a fraction of the period
+    long long int *periods;             // New period of every frame in ns, by identifier (without the protocol)
+    long long int *deadlines;           // New deadline of every frame in ns, by identifier (without the protocol)
+}PeriodProposal;
+
+/**
+ Analysis of the hyperperiod of the network with the proposals to shrink it
+ */
+typedef struct HyperperiodAnalysis {
+    long long int least_common_multiple;    // Least common multiple of all the periods (protocol included)
+    ConstraintEstimate estimate;        // Size of the schedule problem with the hyperperiod of the network
+    int num_frames;                     // Number of frames analyzed, plus the protocol if it is active
+    FrameInflation *frames;             // Contribution of every frame, from the most to the least disjunctions
+    int num_proposals;                  // Number of proposals found, sorted from the least disjunctions
+    PeriodProposal *proposals;          // Proposals to shrink the hyperperiod
+}HyperperiodAnalysis;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Analyzes the contribution of every frame of the network in memory to the size of the schedule problem, and searches
+ the changes of the periods within the tolerance that shrink the hyperperiod the most. The network is not modified
+
+ @param tolerance largest reduction of a period, as a fraction of the period (0.1 allows 10 ms to become 9 ms)
+ @param max_proposals maximum number of proposals returned
+ @param analysis pointer where the analysis is saved. It has to be freed with free_hyperperiod_analysis
+ @return number of proposals found, -1 if there are no frames or the tolerance is not valid
+ */
+int analyze_hyperperiod(double tolerance, int max_proposals, HyperperiodAnalysis *analysis);
+
+/**
+ Prints the analysis: the size of the schedule problem, the contribution of every frame, and every proposal with the
+ frames whose period changes
+
+ @param analysis pointer to the analysis
+ */
+void print_hyperperiod_analysis(HyperperiodAnalysis *analysis);
+
+/**
+ Frees the arrays of an analysis
+
+ @param analysis pointer to the analysis
+ */
+void free_hyperperiod_analysis(HyperperiodAnalysis *analysis);
@@ -12,490 +12,1007 @@
 
 #include "IOInterface.h"
 #include "Network.h"
+#include "Topology.h"
+#include "CompactSchedule.h"
+#include "Metrics.h"
+#include "Memory.h"
 #include <string.h>
-#include <libxml2/libxml/xmlwriter.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <pthread.h>
 
-                                                /* VARIABLES */
+                                                /* STRUCT DEFINITIONS */
 
-                                            /* AUXILIAR FUNCTIONS */
+#define FRAMES_PER_WRITER 256   // Frames formatted by every thread before writing them in the schedule file
 
 /**
- Read the general information of the network and add its into the Network variables
+ Sections of the network xml file that are relevant for the streaming parser
+ */
+typedef enum NetworkSection {
+    no_section,
+    general_section,
+    nodes_section,
+    links_section,
+    frames_section
+}NetworkSection;
+
+/**
+ Buffer with the links of all the paths (or splits) of the frame being parsed, stored one after another.
+ It is reused for all frames, so it only grows up to the size of the frame with more links
+ */
+typedef struct LinkBuffer {
+    int *links;                 // Links of all the paths one after another
+    int *starts;                // Index in the links array where each path starts
+    int num_lists;              // Number of paths in the buffer
+    int num_links;              // Number of links in the buffer
+    int max_lists;              // Number of paths that fit in the buffer
+    int max_links;              // Number of links that fit in the buffer
+}LinkBuffer;
+
+/**
+ State of the streaming parser of the network xml file
+ */
+typedef struct NetworkParser {
+    NetworkSection section;     // Section of the file that is being parsed
+    char element[32];           // Name of the element whose text is being parsed, empty if none
+    int found_frames, found_links, found_hop_delay, found_hyper_period;     // Mandatory general information found
+    long long int protocol_period, protocol_time;
+    NodeCategory node_category; // Category of the node being parsed
+    LinkBuffer connections;     // Links connected to the node being parsed
+    int link_id;                // Index of the next link
+    int speed, source, destination;
+    LinkType link_type;
+    int frame_id;               // Index of the next frame
+    long long int period, deadline, end_to_end_delay, starting;
+    int size;
+    LinkBuffer paths;
+    LinkBuffer splits;
+}NetworkParser;
+
+/**
+ Growable buffer where the xml text of the schedule is formatted
+ */
+typedef struct XmlBuffer {
+    char *data;                 // Text of the buffer
+    size_t length;              // Length of the text
+    size_t size;                // Allocated size of the buffer
+}XmlBuffer;
+
+/**
+ Thread that formats a block of frames of the schedule into its own buffer
+ */
+typedef struct ScheduleWriterThread {
+    pthread_t thread;
+    int started;                // 1 if the thread was created
+    int first_frame;            // First frame of the block
+    int last_frame;             // Frame after the last frame of the block
+    XmlBuffer buffer;
+}ScheduleWriterThread;
 
- @param file XML network document file name
- @return 1 if all the information was found and could be saved, 0 otherwise
+/**
+ State of the streaming parser of the schedule xml file, the transmissions are saved as a compact schedule
+ */
+typedef struct ScheduleParser {
+    char element[32];           // Name of the element whose text is being parsed, empty if none
+    int frame_id, link_id, instance_id;
+    long long int period;
+    long long int transmission, ending;         // Transmission and ending time of the instance being parsed
+    long long int base_offset, timeslot_size;   // Transmission of the instance 0 of the link and its timeslot
+    int instances;              // Number of instances of the link being parsed
+    int max_records;            // Number of records that fit in the schedule
+    long long int max_offsets;  // Number of base offsets that fit in the schedule
+    CompactSchedule *schedule;
+}ScheduleParser;
+
+                                                    /* VARIABLES */
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Appends to the link buffer a new list of links given as a string of identifiers separated by ';'
+
+ @param buffer pointer to the link buffer
+ @param value string with the links
  */
-int read_network_parameters(xmlDoc *file) {
+void append_link_list(LinkBuffer *buffer, const char *value) {
+    
+    char *end;
+    long int link;
     
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context;
-    xmlXPathObjectPtr result;
+    if (buffer->num_lists == buffer->max_lists) {
+        buffer->max_lists = buffer->max_lists * 2 + 4;
+        buffer->starts = tracked_realloc(memory_parser, buffer->starts, sizeof(int) * (buffer->max_lists + 1));
+    }
+    buffer->starts[buffer->num_lists] = buffer->num_links;
+    
+    // Parse the links directly from the string, without copying or tokenizing it
+    while (*value != '\0') {
+        link = strtol(value, &end, 10);
+        if (end == value) {         // Separator or whitespace
+            value++;
+            continue;
+        }
+        if (buffer->num_links == buffer->max_links) {
+            buffer->max_links = buffer->max_links * 2 + 16;
+            buffer->links = tracked_realloc(memory_parser, buffer->links, sizeof(int) * buffer->max_links);
+        }
+        buffer->links[buffer->num_links++] = (int) link;
+        value = end;
+    }
+    buffer->num_lists++;
+    buffer->starts[buffer->num_lists] = buffer->num_links;
+}
+
+/**
+ Frees the memory of the given link buffer
+
+ @param buffer pointer to the link buffer
+ */
+void free_link_buffer(LinkBuffer *buffer) {
     
-    long long int protocol_time, protocol_period, time_between_frames;
+    tracked_free(memory_parser, buffer->links);
+    tracked_free(memory_parser, buffer->starts);
+    memset(buffer, 0, sizeof(LinkBuffer));
+}
+
+/**
+ Saves the value of an element of the general information of the network
+
+ @param parser pointer to the parser state
+ @param value text of the element
+ */
+void parse_general_value(NetworkParser *parser, const char *value) {
+    
+    if (strcmp(parser->element, "NumberFrames") == 0) {
+        set_number_frames(atoi(value));
+        parser->found_frames = 1;
+    } else if (strcmp(parser->element, "NumberLinks") == 0) {
+        set_number_links(atoi(value));
+        parser->found_links = 1;
+    } else if (strcmp(parser->element, "MinimumTimeSwitch") == 0) {
+        set_hop_delay(atoi(value));
+        parser->found_hop_delay = 1;
+    } else if (strcmp(parser->element, "HyperPeriod") == 0) {
+        set_hyper_period(atoll(value));
+        parser->found_hyper_period = 1;
+    } else if (strcmp(parser->element, "PeriodProtocol") == 0) {
+        parser->protocol_period = atoll(value);
+    } else if (strcmp(parser->element, "TimeProtocol") == 0) {
+        parser->protocol_time = atoll(value);
+    } else if (strcmp(parser->element, "TimeBetweenFrames") == 0) {
+        set_time_between_frames(atoll(value));
+    }
+}
+
+/**
+ Saves the value of an element of the frame that is being parsed
+
+ @param parser pointer to the parser state
+ @param value text of the element
+ */
+void parse_frame_value(NetworkParser *parser, const char *value) {
+    
+    if (strcmp(parser->element, "Period") == 0) {
+        parser->period = atoll(value);
+    } else if (strcmp(parser->element, "Deadline") == 0) {
+        parser->deadline = atoll(value);
+    } else if (strcmp(parser->element, "Size") == 0) {
+        parser->size = atoi(value);
+    } else if (strcmp(parser->element, "EndToEnd") == 0) {
+        parser->end_to_end_delay = atoll(value);
+    } else if (strcmp(parser->element, "Starting") == 0) {
+        parser->starting = atoll(value);
+    } else if (strcmp(parser->element, "Path") == 0) {
+        append_link_list(&parser->paths, value);
+    } else if (strcmp(parser->element, "Split") == 0) {
+        append_link_list(&parser->splits, value);
+    }
+}
+
+/**
+ Checks that all the mandatory general information was found and saves the protocol parameters
+
+ @param parser pointer to the parser state
+ @return 0 if correct, -1 otherwise
+ */
+int end_general_information(NetworkParser *parser) {
     
-    // Search the number of frames in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/NumberFrames", context);
-    if (result->nodesetval->nodeTab == NULL) {
-        printf("The Network xml file is wrongly constructed, NumberFrames\n");
+    if (!parser->found_frames) {
+        printf("The Network xml file is wrongly constructed, no NumberFrames\n");
         return -1;
     }
-    value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    set_number_frames(atoi((const char*) value));
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Search the number of links in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/NumberLinks", context);
-    if (result->nodesetval->nodeTab == NULL) {
+    if (!parser->found_links) {
         printf("The Network xml file is wrongly constructed, no NumberLinks\n");
         return -1;
     }
-    value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    set_number_links(atoi((const char*) value));
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Search the minimum time in switch in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/MinimumTimeSwitch", context);
-    if (result->nodesetval->nodeTab == NULL) {
+    if (!parser->found_hop_delay) {
         printf("The Network xml file is wrongly constructed, no MinimumTimeSwitch\n");
         return -1;
     }
-    value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    set_hop_delay(atoi((const char*) value));
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Search the hyperperiod in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/HyperPeriod", context);
-    if (result->nodesetval->nodeTab == NULL) {
+    if (!parser->found_hyper_period) {
         printf("The Network xml file is wrongly constructed, no HyperPeriod\n");
         return -1;
     }
-    value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    set_hyper_period(atoll((const char*) value));
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Search the period protocol in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/PeriodProtocol", context);
-    if (result->nodesetval->nodeTab == NULL) {
-        protocol_period = 0;
-    } else {
-        value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        protocol_period = atoll((const char*) value);
-    }
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Search the period protocol in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/TimeProtocol", context);
-    if (result->nodesetval->nodeTab == NULL) {
-        protocol_time = 0;
-    } else {
-        value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        protocol_time = atoll((const char*) value);
-    }
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Search the period protocol in the network and save it
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/GeneralInformation/TimeBetweenFrames", context);
-    if (result->nodesetval->nodeTab == NULL) {
-        time_between_frames = 0;
-    } else {
-        value = xmlNodeListGetString(file, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        time_between_frames = atoll((const char*) value);
-    }
-    set_time_between_frames(time_between_frames);
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    // Save the protocol paramenters
-    set_protocol_parameters(protocol_period, protocol_time);
-    
+    set_protocol_parameters(parser->protocol_period, parser->protocol_time);
     return 0;
 }
 
 /**
- Read the information of all the links in the network file and saves it into the network links array
- 
- @param file XML network document file name
- @return 0 if read correctly, -1 otherwise
+ Saves the link that has been parsed into the network links array
+
+ @param parser pointer to the parser state
+ @return 0 if correct, -1 otherwise
  */
-int read_links(xmlDoc *file) {
+int end_link(NetworkParser *parser) {
+    
+    if (parser->speed <= 0) {
+        printf("The Network xml file is wrongly constructed, the link %d has no Speed\n", parser->link_id);
+        return -1;
+    }
+    if (add_link(parser->link_id, parser->speed, parser->link_type) == -1) {
+        printf("There are more links that the stated in the general information of the network file\n");
+        return -1;
+    }
+    add_link_nodes(parser->link_id, parser->source, parser->destination);
+    parser->link_id++;
+    return 0;
+}
 
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context, context_link = NULL;
-    xmlXPathObjectPtr result, result_link = NULL;
+/**
+ Saves the frame that has been parsed, with all its paths and splits, into the network frames array
+
+ @param parser pointer to the parser state
+ @return 0 if correct, -1 otherwise
+ */
+int end_frame(NetworkParser *parser) {
     
-    // Init variables to save the value of the link found
-    int speed;
-    LinkType link_type;
+    LinkBuffer *paths = &parser->paths, *splits = &parser->splits;
     
-    // Seach on the xml tree where the links are stored
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/NetworkDescription/Links/Link", context);
+    if (parser->period <= 0 || parser->deadline < 0 || parser->size < 0 || parser->end_to_end_delay < 0) {
+        printf("The Network xml file is wrongly constructed, the frame %d is missing information\n",
+               parser->frame_id);
+        return -1;
+    }
+    for (int i = 0; i < paths->num_links; i++) {
+        if (paths->links[i] < 0 || paths->links[i] >= get_number_links()) {
+            printf("The link %d of the path of the frame %d does not exist\n", paths->links[i], parser->frame_id);
+            return -1;
+        }
+    }
     
-    // Iterate over all links on the network file
-    for (int i = 0; i < result->nodesetval->nodeNr; i++) {
-        context_link = xmlXPathNewContext(file);
-        xmlXPathSetContextNode(result->nodesetval->nodeTab[i], context_link);   // Set the context to the actual link
-        
+    // Add the information to the frame (Important to add it before the paths and splits due to dependencies)
+    if (add_frame_information(parser->frame_id, parser->period, parser->deadline, parser->size,
+                              parser->end_to_end_delay, parser->starting) == -1) {
+        return -1;
+    }
+    add_num_paths(parser->frame_id, paths->num_lists);
+    for (int i = 0; i < paths->num_lists; i++) {
+        add_frame_path(parser->frame_id, i, &paths->links[paths->starts[i]], paths->starts[i + 1] - paths->starts[i]);
+    }
+    add_num_splits(parser->frame_id, splits->num_lists);
+    for (int i = 0; i < splits->num_lists; i++) {
+        add_frame_split(parser->frame_id, i, &splits->links[splits->starts[i]],
+                        splits->starts[i + 1] - splits->starts[i]);
+    }
+    parser->frame_id++;
+    return 0;
+}
+
+/**
+ Processes the start of an element of the network xml file
+
+ @param parser pointer to the parser state
+ @param reader xml reader positioned in the element
+ @param name name of the element
+ @param depth depth of the element in the xml tree
+ @return 0 if correct, -1 otherwise
+ */
+int start_network_element(NetworkParser *parser, xmlTextReaderPtr reader, const char *name, int depth) {
+    
+    xmlChar *category;
+    
+    if (depth == 1 && strcmp(name, "GeneralInformation") == 0) {
+        parser->section = general_section;
+    } else if (depth == 2 && strcmp(name, "Nodes") == 0) {
+        parser->section = nodes_section;
+    } else if (depth == 2 && strcmp(name, "Links") == 0) {
+        parser->section = links_section;
+    } else if (depth == 2 && strcmp(name, "Frames") == 0) {
+        if (get_number_frames() == 0) {
+            printf("The Network xml file is wrongly constructed, the frames are before the general information\n");
+            return -1;
+        }
+        parser->section = frames_section;
+    } else if (depth == 3 && parser->section == links_section && strcmp(name, "Link") == 0) {
         // Search the category of the current link
-        value = xmlGetProp(result->nodesetval->nodeTab[i], (xmlChar*) "category");
-        if (xmlStrcmp(value, (xmlChar*) "Wired") == 0) {
-            link_type = wired;
-        } else if (xmlStrcmp(value, (xmlChar*) "Wireless") == 0) {
-            link_type = wireless;
+        category = xmlTextReaderGetAttribute(reader, (xmlChar*) "category");
+        if (xmlStrcmp(category, (xmlChar*) "Wired") == 0) {
+            parser->link_type = wired;
+        } else if (xmlStrcmp(category, (xmlChar*) "Wireless") == 0) {
+            parser->link_type = wireless;
         } else {
             printf("The link has a unknown category\n");
+            xmlFree(category);
             return -1;
         }
-        xmlFree(value);
-        
-        // Search the speed of the current link
-        result_link = xmlXPathEvalExpression((xmlChar*) "Speed", context_link);
-        value = xmlNodeListGetString(file, result_link->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        speed = atoi((const char*) value);
-        
-        // Free xml objects
-        xmlFree(value);
-        xmlXPathFreeObject(result_link);
-        xmlXPathFreeContext(context_link);
-        
-        // Save the current link information into the network
-        add_link(i, speed, link_type);
-        
+        xmlFree(category);
+        parser->speed = -1;
+        parser->source = -1;
+        parser->destination = -1;
+    } else if (depth == 3 && parser->section == nodes_section && strcmp(name, "Node") == 0) {
+        // Switches relay frames, end systems only send and receive them
+        category = xmlTextReaderGetAttribute(reader, (xmlChar*) "category");
+        if (xmlStrcmp(category, (xmlChar*) "Switch") == 0) {
+            parser->node_category = switch_node;
+        } else if (xmlStrcmp(category, (xmlChar*) "End System") == 0) {
+            parser->node_category = end_system_node;
+        } else {
+            parser->node_category = unknown_node;
+        }
+        xmlFree(category);
+        parser->connections.num_lists = 0;
+        parser->connections.num_links = 0;
+    } else if (depth == 3 && parser->section == frames_section && strcmp(name, "Frame") == 0) {
+        parser->period = -1;
+        parser->deadline = -1;
+        parser->size = -1;
+        parser->end_to_end_delay = -1;
+        parser->starting = 0;
+        parser->paths.num_lists = 0;
+        parser->paths.num_links = 0;
+        parser->splits.num_lists = 0;
+        parser->splits.num_links = 0;
     }
-    // Free xml objects
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
     
+    // Remember the element, so its text can be saved when found
+    strncpy(parser->element, name, sizeof(parser->element) - 1);
     return 0;
 }
 
 /**
- Read the paths of a given frame, and store it into the paths linked lists of the frame
+ Processes the end of an element of the network xml file
 
- @param frame_id index of the frame
- @param file network xml file
- @param context_frame xml context of the frame where the paths are being read
+ @param parser pointer to the parser state
+ @param name name of the element
+ @param depth depth of the element in the xml tree
+ @return 0 if correct, -1 otherwise
  */
-void read_paths(int frame_id, xmlDoc *file, xmlXPathContextPtr context_frame) {
+int end_network_element(NetworkParser *parser, const char *name, int depth) {
+    
+    parser->element[0] = '\0';
+    if (depth == 1 && parser->section == general_section) {
+        parser->section = no_section;
+        return end_general_information(parser);
+    } else if (depth == 2 && (parser->section == nodes_section || parser->section == links_section ||
+                              parser->section == frames_section)) {
+        parser->section = no_section;
+    } else if (depth == 3 && parser->section == nodes_section && strcmp(name, "Node") == 0) {
+        if (add_node(parser->node_category, parser->connections.num_links, parser->connections.links) == -1) {
+            printf("The Network xml file is wrongly constructed, a node has a link that does not exist\n");
+            return -1;
+        }
+    } else if (depth == 3 && parser->section == links_section && strcmp(name, "Link") == 0) {
+        return end_link(parser);
+    } else if (depth == 3 && parser->section == frames_section && strcmp(name, "Frame") == 0) {
+        return end_frame(parser);
+    }
+    return 0;
+}
+
+/**
+ Processes the text of an element of the network xml file
+
+ @param parser pointer to the parser state
+ @param value text of the element
+ */
+void network_element_value(NetworkParser *parser, const char *value) {
+    
+    if (parser->section == general_section) {
+        parse_general_value(parser, value);
+    } else if (parser->section == nodes_section && strcmp(parser->element, "Link") == 0) {
+        append_link_list(&parser->connections, value);
+    } else if (parser->section == links_section && strcmp(parser->element, "Speed") == 0) {
+        parser->speed = atoi(value);
+    } else if (parser->section == links_section && strcmp(parser->element, "Source") == 0) {
+        parser->source = atoi(value);
+    } else if (parser->section == links_section && strcmp(parser->element, "Destination") == 0) {
+        parser->destination = atoi(value);
+    } else if (parser->section == frames_section) {
+        parse_frame_value(parser, value);
+    }
+}
+
+/**
+ Compares two records by their frame and link, to sort the records read from a schedule xml file
+
+ @param a pointer to the first record
+ @param b pointer to the second record
+ @return negative, 0 or positive if the first record is smaller, equal or bigger
+ */
+int compare_schedule_records(const void *a, const void *b) {
     
-    // Init xml variabels needed to search information in the file
-    xmlChar *value;
-    xmlXPathObjectPtr result_frame;
+    const ScheduleRecord *record_a = a, *record_b = b;
     
-    // Auxiliar variables to convert the path string to array of integers
-    char *link_char;
-    int link_char_it;
-    int *path_array = NULL;
+    if (record_a->frame != record_b->frame) {
+        return record_a->frame < record_b->frame ? -1 : 1;
+    }
+    if (record_a->link != record_b->link) {
+        return record_a->link < record_b->link ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Saves the transmissions of the link that has just been parsed as a new record of the compact schedule.
+ Only the transmission of the instance 0 is kept, as the rest are one period after the previous one. The schedule
+ xml does not have the replicas, they are transmitted at the same time as the replica 0
+
+ @param parser pointer to the parser state
+ @return 0 if correct, -1 if the link has no instance 0
+ */
+int end_schedule_link(ScheduleParser *parser) {
     
-    // Search on the frame tree all paths
-    result_frame = xmlXPathEvalExpression((xmlChar*) "Paths/Path", context_frame);
+    CompactSchedule *schedule = parser->schedule;
+    ScheduleRecord *record;
     
-    // Init the linked lists of the paths for the current frame
-    add_num_paths(frame_id, result_frame->nodesetval->nodeNr);
+    if (parser->base_offset < 0 || parser->frame_id < 0 || parser->link_id < 0) {
+        printf("The schedule xml file is wrongly constructed, link %d of frame %d has no instance 0\n",
+               parser->link_id, parser->frame_id);
+        return -1;
+    }
+    if (schedule->num_records == parser->max_records) {
+        parser->max_records = parser->max_records * 2 + 64;
+        schedule->records = realloc(schedule->records, sizeof(ScheduleRecord) * parser->max_records);
+    }
+    if (schedule->num_offsets == parser->max_offsets) {
+        parser->max_offsets = parser->max_offsets * 2 + 64;
+        schedule->base_offsets = realloc(schedule->base_offsets, sizeof(int64_t) * parser->max_offsets);
+    }
     
-    // Iterate over all paths of the frame
-    for (int i = 0; i < result_frame->nodesetval->nodeNr; i++) {
-        
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[i]->xmlChildrenNode, 1);
-        
-        // Parse the string into an array and save it into the frame
-        link_char = strtok((char*) value, ";");
-        link_char_it = 0;
-        while (link_char != NULL) {
-            path_array = realloc(path_array, sizeof(int) * (link_char_it + 1));     // Allocate memory for the link
-            path_array[link_char_it] = atoi(link_char);
-            link_char = strtok(NULL, ";");
-            link_char_it++;
+    record = &schedule->records[schedule->num_records++];
+    memset(record, 0, sizeof(ScheduleRecord));
+    record->frame = parser->frame_id;
+    record->link = parser->link_id;
+    record->period = parser->period;
+    record->timeslot_size = parser->timeslot_size;
+    record->instances = parser->instances;
+    record->replicas = 0;
+    record->first_offset = (uint32_t) schedule->num_offsets;
+    schedule->base_offsets[schedule->num_offsets++] = parser->base_offset;
+    if (parser->period * parser->instances > schedule->hyper_period) {
+        schedule->hyper_period = parser->period * parser->instances;
+    }
+    return 0;
+}
+
+/**
+ Processes the start, end or text of an element of the schedule xml file
+
+ @param parser pointer to the parser state
+ @param type type of the xml node
+ @param name name of the element
+ @param value text of the element, NULL if the node is not a text
+ @return 0 if correct, -1 otherwise
+ */
+int schedule_element(ScheduleParser *parser, int type, const char *name, const char *value) {
+    
+    if (type == XML_READER_TYPE_ELEMENT) {
+        if (strcmp(name, "Frame") == 0) {
+            parser->frame_id = -1;
+            parser->period = -1;
+        } else if (strcmp(name, "Link") == 0) {
+            parser->link_id = -1;
+            parser->instances = 0;
+            parser->base_offset = -1;
+        } else if (strcmp(name, "Instance") == 0) {
+            parser->instance_id = -1;
+            parser->transmission = -1;
+            parser->ending = -1;
         }
-        add_frame_path(frame_id, i, path_array, link_char_it);          // Add the found path to the frame
-        
-        xmlFree(value);
+        strncpy(parser->element, name, sizeof(parser->element) - 1);
+    } else if (type == XML_READER_TYPE_END_ELEMENT) {
+        parser->element[0] = '\0';
+        if (strcmp(name, "Instance") == 0) {
+            if (parser->instance_id == 0) {
+                parser->base_offset = parser->transmission;
+                parser->timeslot_size = parser->ending - parser->transmission + 1;
+            }
+            parser->instances++;
+        } else if (strcmp(name, "Link") == 0) {
+            return end_schedule_link(parser);
+        }
+    } else if (strcmp(parser->element, "FrameID") == 0) {
+        parser->frame_id = atoi(value);
+    } else if (strcmp(parser->element, "Period") == 0) {
+        parser->period = atoll(value);
+    } else if (strcmp(parser->element, "LinkID") == 0) {
+        parser->link_id = atoi(value);
+    } else if (strcmp(parser->element, "InstanceID") == 0) {
+        parser->instance_id = atoi(value);
+    } else if (strcmp(parser->element, "TransmissionTime") == 0) {
+        parser->transmission = atoll(value);
+    } else if (strcmp(parser->element, "EndingTime") == 0) {
+        parser->ending = atoll(value);
     }
-    
-    // Free xml structures
-    xmlXPathFreeObject(result_frame);
-    
+    return 0;
 }
 
 /**
- Read the splits of a given frame, and store it into the paths linked lists of the frame
- 
- @param frame_id index of the frame
- @param file network xml file
- @param context_frame xml context of the frame where the paths are being read
+ Writes a list of links as a string of identifiers separated by ';' into the given growable buffer
+
+ @param buffer pointer to the buffer, it is reallocated if the links do not fit
+ @param size pointer to the size of the buffer
+ @param links array with the links
+ @param num_links number of links
  */
-void read_splits(int frame_id, xmlDoc *file, xmlXPathContextPtr context_frame) {
+void format_link_list(char **buffer, int *size, int *links, int num_links) {
     
-    // Init xml variabels needed to search information in the file
-    xmlChar *value;
-    xmlXPathObjectPtr result_frame;
+    int length = 0;
     
-    // Auxiliar variables to convert the path string to array of integers
-    char *link_char;
-    int link_char_it;
-    int *split_array = NULL;
-    
-    // Search on the frame tree all paths
-    result_frame = xmlXPathEvalExpression((xmlChar*) "Splits/Split", context_frame);
-    
-    // Init the linked lists of the paths for the current frame
-    add_num_splits(frame_id, result_frame->nodesetval->nodeNr);
+    for (int i = 0; i < num_links; i++) {
+        if (*size - length < 16) {
+            *size = *size * 2 + 64;
+            *buffer = tracked_realloc(memory_output, *buffer, *size);
+        }
+        length += sprintf(&(*buffer)[length], i == 0 ? "%d" : ";%d", links[i]);
+    }
+    if (*buffer == NULL) {
+        *size = 64;
+        *buffer = tracked_malloc(memory_output, *size);
+    }
+    (*buffer)[length] = '\0';
+}
+
+/**
+ Appends formatted text at the end of a xml buffer, growing it if needed
+
+ @param buffer pointer to the xml buffer
+ @param format format of the text as in printf
+ @param ... values of the format
+ */
+void append_xml(XmlBuffer *buffer, const char *format, ...) {
+    
+    va_list arguments;
+    int length;
+    
+    while (1) {
+        va_start(arguments, format);
+        length = vsnprintf(buffer->data + buffer->length, buffer->size - buffer->length, format, arguments);
+        va_end(arguments);
+        if (length >= 0 && buffer->length + length < buffer->size) {
+            buffer->length += length;
+            return;
+        }
+        buffer->size = buffer->size * 2 + 4096;
+        buffer->data = tracked_realloc(memory_output, buffer->data, buffer->size);
+    }
+}
+
+/**
+ Formats the schedule of a frame into a xml buffer with the same format that libxml2 uses to save a document with
+ indentation (two spaces per level and empty elements closed in the same tag)
+
+ @param buffer pointer to the xml buffer
+ @param frame_id identifier of the frame
+ */
+void format_frame_schedule(XmlBuffer *buffer, int frame_id) {
     
-    // Iterate over all paths of the frame
-    for (int i = 0; i < result_frame->nodesetval->nodeNr; i++) {
-        
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[i]->xmlChildrenNode, 1);
-        
-        // Parse the string into an array and save it into the frame
-        link_char = strtok((char*) value, ";");
-        link_char_it = 0;
-        while (link_char != NULL) {
-            split_array = realloc(split_array, sizeof(int) * (link_char_it + 1));   // Allocate memory for the link
-            split_array[link_char_it] = atoi(link_char);
-            link_char = strtok(NULL, ";");
-            link_char_it++;
+    Frame *frame_pt = get_frame(frame_id);
+    Offset *offset_it;
+    Path *path_it;
+    long long int transmission;
+    
+    // Write general information about the frame to be easily to understand
+    append_xml(buffer, "    <Frame>\n      <FrameID>%d</FrameID>\n      <Period>%lld</Period>\n"
+               "      <Starting>%lld</Starting>\n      <Deadline>%lld</Deadline>\n      <Size>%d</Size>\n"
+               "      <EndToEnd>%lld</EndToEnd>\n", frame_id, get_period(frame_pt), get_starting(frame_pt),
+               get_deadline(frame_pt), get_size(frame_pt), get_end_to_end_delay(frame_pt));
+    
+    // Write the transmission times of all paths of the frame
+    for (int j = 0; j < get_num_paths(frame_pt); j++) {
+        path_it = get_path_root(frame_pt, j);
+        if (is_last_path(path_it)) {
+            append_xml(buffer, "      <Path/>\n");
+            continue;
         }
-        add_frame_split(frame_id, i, split_array, link_char_it);                    // Add the found path to the frame
+        append_xml(buffer, "      <Path>\n");
         
-        xmlFree(value);
+        // For all links in the path we have to get the transmission times in that link
+        while (!is_last_path(path_it)) {
+            offset_it = get_offset_from_path(path_it);
+            append_xml(buffer, "        <Link>\n          <LinkID>%d</LinkID>\n", get_offset_link(offset_it));
+            
+            // Write the transmission time of every instance
+            for (int h = 0; h < get_number_instances(offset_it); h++) {
+                transmission = get_offset(offset_it, h, 0);
+                append_xml(buffer, "          <Instance>\n            <InstanceID>%d</InstanceID>\n"
+                           "            <TransmissionTime>%lld</TransmissionTime>\n"
+                           "            <EndingTime>%lld</EndingTime>\n          </Instance>\n", h, transmission,
+                           transmission + get_timeslot_size(offset_it) - 1);
+            }
+            append_xml(buffer, "        </Link>\n");
+            path_it = get_next_path(path_it);
+        }
+        append_xml(buffer, "      </Path>\n");
     }
-    
-    // Free xml structures
-    xmlXPathFreeObject(result_frame);
-    
+    append_xml(buffer, "    </Frame>\n");
 }
 
 /**
- Read the frames in the network xml file and save it into the network array of frames
+ Schedule writer thread, formats its block of frames into its own xml buffer
 
- @param file name of the network xml file
- @return 0 if everything correct, -1 otherwise
+ @param argument pointer to the schedule writer thread arguments
+ @return NULL
  */
-int read_frames(xmlDoc *file) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context, context_frame = NULL;
-    xmlXPathObjectPtr result, result_frame = NULL;
-    
-    // Init variables for the general information of a frame
-    long long int period, deadline, end_to_end_delay, starting;
-    int size;
+void * schedule_writer_thread(void *argument) {
     
-    // Search on the xml tree where the frames are stored
-    context = xmlXPathNewContext(file);
-    result = xmlXPathEvalExpression((xmlChar*) "/Network/TrafficInformation/Frames/Frame", context);
+    ScheduleWriterThread *writer = argument;
+    long long int span = start_trace_span();
     
-    // Iterate over all frames on the network file
-    for (int i = 0; i < result->nodesetval->nodeNr; i++) {
-        
-        // Set the context to the actual frame
-        context_frame = xmlXPathNewContext(file);
-        xmlXPathSetContextNode(result->nodesetval->nodeTab[i], context_frame);
-        
-        // Search the period of the current frame
-        result_frame = xmlXPathEvalExpression((xmlChar*) "Period", context_frame);
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        period = atoll((const char*) value);
-        // Free xml structures
-        xmlFree(value);
-        xmlXPathFreeObject(result_frame);
-        
-        // Search the deadline of the current frame
-        result_frame = xmlXPathEvalExpression((xmlChar*) "Deadline", context_frame);
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        deadline = atoll((const char*) value);
-        // Free xml structures
-        xmlFree(value);
-        xmlXPathFreeObject(result_frame);
-        
-        // Search the size of the current frame
-        result_frame = xmlXPathEvalExpression((xmlChar*) "Size", context_frame);
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        size = atoi((const char*) value);
-        // Free xml structures
-        xmlFree(value);
-        xmlXPathFreeObject(result_frame);
-        
-        // Search the end to end delay of the current frame
-        result_frame = xmlXPathEvalExpression((xmlChar*) "EndToEnd", context_frame);
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        end_to_end_delay = atoi((const char*) value);
-        // Free xml structures
-        xmlFree(value);
-        xmlXPathFreeObject(result_frame);
-        
-        // Search the end to end delay of the current frame
-        result_frame = xmlXPathEvalExpression((xmlChar*) "Starting", context_frame);
-        value = xmlNodeListGetString(file, result_frame->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        starting = atoi((const char*) value);
-        // Free xml structures
-        xmlFree(value);
-        xmlXPathFreeObject(result_frame);
-        
-        // Add the information to the frame
-        add_frame_information(i, period, deadline, size, end_to_end_delay, starting);
-        
-        // Search and store all the paths and splits (Important to call after adding information due to dependencies)
-        read_paths(i, file, context_frame);
-        read_splits(i, file, context_frame);
-        
+    writer->buffer.length = 0;
+    for (int i = writer->first_frame; i < writer->last_frame; i++) {
+        format_frame_schedule(&writer->buffer, i);
     }
-    
-    // Free xml structures
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_frame);
-        
-    return 0;
+    end_trace_span("schedule writer thread", span);
+    return NULL;
 }
 
                                                 /* FUNCTIONS */
 
 /**
  Reads the given network xml file and parse everything into the network variables.
- It starts reading the general information of the network.
- Then continues with the important information from the network components description (links and its speeds).
- It ends with the information of each frame
+ The file is read in a single pass with a streaming reader, so the xml document is never fully stored in memory.
+ Every element is saved into the network as soon as it is closed, first the general information of the network,
+ then the nodes with their connections, the links and last the frames with their paths and splits.
  */
 int parse_network_xml(char *namefile) {
     
-    xmlDoc *file_network;       // Variable where all the xml document will be saved
-    
-    // Open the xml file if it exists;
-    file_network = xmlReadFile(namefile, NULL, 0);
-    if (file_network == NULL) {
+    xmlTextReaderPtr reader;        // Streaming reader of the xml file
+    NetworkParser parser;
+    struct stat file_stat;
+    struct timeval start_time, end_time;
+    double time_parse;
+    const char *name;
+    int type, depth, status = 0;
+    
+    // Open the xml file if it exists
+    gettimeofday(&start_time, NULL);
+    reader = xmlReaderForFile(namefile, NULL, XML_PARSE_NOBLANKS);
+    if (reader == NULL || stat(namefile, &file_stat) == -1) {
         fprintf(stderr, "The xml information of the network file does not exist\n");
+        xmlFreeTextReader(reader);
         return -1;
     }
-    
-    // Parse everything and save it into internal memory
-    if (read_network_parameters(file_network) == -1) {
-        xmlFreeDoc(file_network);
-        xmlCleanupParser();
-        return -1;
+    memset(&parser, 0, sizeof(NetworkParser));
+    
+    // Read the nodes of the file one by one and save their information when needed
+    while (status == 0 && (status = xmlTextReaderRead(reader)) == 1) {
+        status = 0;
+        type = xmlTextReaderNodeType(reader);
+        depth = xmlTextReaderDepth(reader);
+        if (type == XML_READER_TYPE_ELEMENT) {
+            name = (const char*) xmlTextReaderConstLocalName(reader);
+            status = start_network_element(&parser, reader, name, depth);
+            // Empty elements have no end node, so they are closed here
+            if (status == 0 && xmlTextReaderIsEmptyElement(reader)) {
+                status = end_network_element(&parser, name, depth);
+            }
+        } else if (type == XML_READER_TYPE_END_ELEMENT) {
+            name = (const char*) xmlTextReaderConstLocalName(reader);
+            status = end_network_element(&parser, name, depth);
+        } else if (type == XML_READER_TYPE_TEXT && parser.element[0] != '\0') {
+            network_element_value(&parser, (const char*) xmlTextReaderConstValue(reader));
+        }
     }
-    if (read_links(file_network) == -1) {
-        xmlFreeDoc(file_network);
-        xmlCleanupParser();
-        return -1;
+    if (status == 0 && get_number_frames() == 0) {
+        printf("The Network xml file is wrongly constructed, no GeneralInformation\n");
+        status = -1;
     }
-    if (read_frames(file_network) == -1) {
-        xmlFreeDoc(file_network);
-        xmlCleanupParser();
+    
+    // Free the reader and the buffers, the parser is cleaned up once when the program finishes
+    free_link_buffer(&parser.paths);
+    free_link_buffer(&parser.splits);
+    free_link_buffer(&parser.connections);
+    xmlFreeTextReader(reader);
+    if (status != 0) {
         return -1;
     }
     
-    // Cleanup of the xml library
-    xmlFreeDoc(file_network);
-    xmlCleanupParser();
+    gettimeofday(&end_time, NULL);
+    time_parse = (double) (end_time.tv_sec - start_time.tv_sec) * 1000 +
+                 (double) (end_time.tv_usec - start_time.tv_usec) / 1000;
+    printf("Time to parse in ms => %f (%.2f MB/s)\n", time_parse,
+           time_parse > 0 ? (double) file_stat.st_size / (1024 * 1024) / (time_parse / 1000) : 0);
+    
     return 0;
 }
 
 /**
- Write the obtained schedule in a XML file
+ Reads a schedule xml file, as written by write_schedule_xml, into a compact schedule.
+ The links that are shared by several paths of a frame appear once in the compact schedule
+ */
+struct CompactSchedule * read_schedule_xml(char *namefile) {
+    
+    xmlTextReaderPtr reader;        // Streaming reader of the xml file
+    ScheduleParser parser;
+    CompactSchedule *schedule;
+    const char *name;
+    int type, status = 0, num_records = 0;
+    
+    reader = xmlReaderForFile(namefile, NULL, XML_PARSE_NOBLANKS);
+    if (reader == NULL) {
+        fprintf(stderr, "The schedule xml file does not exist\n");
+        return NULL;
+    }
+    memset(&parser, 0, sizeof(ScheduleParser));
+    schedule = calloc(1, sizeof(CompactSchedule));
+    parser.schedule = schedule;
+    
+    // Read the nodes of the file one by one, the records are saved when their link is closed
+    while (status == 0 && (status = xmlTextReaderRead(reader)) == 1) {
+        status = 0;
+        type = xmlTextReaderNodeType(reader);
+        name = (const char*) xmlTextReaderConstLocalName(reader);
+        if (type == XML_READER_TYPE_ELEMENT) {
+            status = schedule_element(&parser, type, name, NULL);
+            // Empty elements have no end node, so they are closed here
+            if (status == 0 && xmlTextReaderIsEmptyElement(reader)) {
+                status = schedule_element(&parser, XML_READER_TYPE_END_ELEMENT, name, NULL);
+            }
+        } else if (type == XML_READER_TYPE_END_ELEMENT) {
+            status = schedule_element(&parser, type, name, NULL);
+        } else if (type == XML_READER_TYPE_TEXT && parser.element[0] != '\0') {
+            status = schedule_element(&parser, type, name, (const char*) xmlTextReaderConstValue(reader));
+        }
+    }
+    xmlFreeTextReader(reader);
+    if (status != 0) {
+        free_compact_schedule(schedule);
+        return NULL;
+    }
+    
+    // Sort the records by frame and link and remove the links repeated in several paths of the same frame
+    qsort(schedule->records, schedule->num_records, sizeof(ScheduleRecord), compare_schedule_records);
+    for (int i = 0; i < schedule->num_records; i++) {
+        if (num_records == 0 || compare_schedule_records(&schedule->records[num_records - 1],
+                                                         &schedule->records[i]) != 0) {
+            schedule->records[num_records++] = schedule->records[i];
+        }
+    }
+    schedule->num_records = num_records;
+    
+    return schedule;
+}
+
+/**
+ Writes the network in memory in a xml file with the same schema that is read by the parser
  */
-int write_schedule_xml(char* namefile) {
+int write_network_xml(char *namefile) {
     
-    // Init xml variables needed to search informantion in the file
-    xmlDocPtr doc;
-    xmlNodePtr root_node, frames_node, frame_node, path_node, link_node, instance_node;
-    char char_value[100];
-    int num_frames;
-    Offset *offset_it;
-    Path *path_it;
+    xmlTextWriterPtr writer;
     Frame *frame_pt;
+    Path *path_pt;
+    Split *split_pt;
+    int *links = NULL, max_links = 0, num_links;
+    char *value = NULL;
+    int value_size = 0;
+    int status = 0;
+    
+    // The memory of the xml writer is charged to the output until it is freed
+    charge_xml_memory(memory_output);
+    writer = xmlNewTextWriterFilename(namefile, 0);
+    if (writer == NULL) {
+        charge_xml_memory(memory_parser);
+        printf("The network xml file could not be created\n");
+        return -1;
+    }
+    xmlTextWriterSetIndent(writer, 1);
+    xmlTextWriterSetIndentString(writer, (xmlChar*) "   ");
+    status |= xmlTextWriterStartDocument(writer, NULL, "UTF-8", NULL) < 0;
+    status |= xmlTextWriterStartElement(writer, (xmlChar*) "Network") < 0;
+    
+    // General information of the network
+    status |= xmlTextWriterStartElement(writer, (xmlChar*) "GeneralInformation") < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "NumberFrames", "%d",
+                                              get_number_network_frames()) < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "NumberLinks", "%d", get_number_links()) < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "MinimumTimeSwitch", "%d", get_hop_delay()) < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "HyperPeriod", "%lld", get_hyper_period()) < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "PeriodProtocol", "%lld",
+                                              get_protocol_period()) < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "TimeProtocol", "%lld", get_protocol_time()) < 0;
+    status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "TimeBetweenFrames", "%lld",
+                                              get_time_between_frames()) < 0;
+    status |= xmlTextWriterEndElement(writer) < 0;
+    
+    // Nodes of the network with the links connected to them, if the network has them
+    status |= xmlTextWriterStartElement(writer, (xmlChar*) "NetworkDescription") < 0;
+    if (get_number_described_nodes() > 0) {
+        status |= xmlTextWriterStartElement(writer, (xmlChar*) "Nodes") < 0;
+        for (int i = 0; i < get_number_described_nodes(); i++) {
+            status |= xmlTextWriterStartElement(writer, (xmlChar*) "Node") < 0;
+            if (get_node_category(i) != unknown_node) {
+                status |= xmlTextWriterWriteAttribute(writer, (xmlChar*) "category",
+                                                      get_node_category(i) == switch_node ? (xmlChar*) "Switch" :
+                                                      (xmlChar*) "End System") < 0;
+            }
+            status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "ID", "%d", i) < 0;
+            status |= xmlTextWriterStartElement(writer, (xmlChar*) "Connections") < 0;
+            for (int j = 0; j < get_node_number_connections(i); j++) {
+                status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Link", "%d",
+                                                          get_node_connection(i, j)) < 0;
+            }
+            status |= xmlTextWriterEndElement(writer) < 0;
+            status |= xmlTextWriterEndElement(writer) < 0;
+        }
+        status |= xmlTextWriterEndElement(writer) < 0;
+    }
     
-    // Create the top of the file
-    doc = xmlNewDoc(BAD_CAST "1.0");
-    root_node = xmlNewNode(NULL, BAD_CAST "Schedule");
-    xmlDocSetRootElement(doc, root_node);
+    // Links of the network
+    status |= xmlTextWriterStartElement(writer, (xmlChar*) "Links") < 0;
+    for (int i = 0; i < get_number_links(); i++) {
+        status |= xmlTextWriterStartElement(writer, (xmlChar*) "Link") < 0;
+        status |= xmlTextWriterWriteAttribute(writer, (xmlChar*) "category", get_link_type(get_link(i)) == wired ?
+                                              (xmlChar*) "Wired" : (xmlChar*) "Wireless") < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "ID", "%d", i) < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Speed", "%d", get_link_speed(get_link(i))) < 0;
+        if (get_link_source(get_link(i)) != -1) {
+            status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Source", "%d",
+                                                      get_link_source(get_link(i))) < 0;
+            status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Destination", "%d",
+                                                      get_link_destination(get_link(i))) < 0;
+        }
+        status |= xmlTextWriterEndElement(writer) < 0;
+    }
+    status |= xmlTextWriterEndElement(writer) < 0;
+    status |= xmlTextWriterEndElement(writer) < 0;
     
-    // Write all the frames
+    // Frames of the network with their paths and splits
+    status |= xmlTextWriterStartElement(writer, (xmlChar*) "TrafficInformation") < 0;
+    status |= xmlTextWriterStartElement(writer, (xmlChar*) "Frames") < 0;
+    for (int i = 0; i < get_number_network_frames() && status == 0; i++) {
+        frame_pt = get_frame(i);
+        status |= xmlTextWriterStartElement(writer, (xmlChar*) "Frame") < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "ID", "%d", i) < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Period", "%lld", get_period(frame_pt)) < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Starting", "%lld", get_starting(frame_pt)) < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Deadline", "%lld", get_deadline(frame_pt)) < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "Size", "%d", get_size(frame_pt)) < 0;
+        status |= xmlTextWriterWriteFormatElement(writer, (xmlChar*) "EndToEnd", "%lld",
+                                                  get_end_to_end_delay(frame_pt)) < 0;
+        status |= xmlTextWriterStartElement(writer, (xmlChar*) "Paths") < 0;
+        for (int j = 0; j < get_num_paths(frame_pt); j++) {
+            num_links = 0;
+            for (path_pt = get_path_root(frame_pt, j); !is_last_path(path_pt); path_pt = get_next_path(path_pt)) {
+                if (num_links == max_links) {
+                    max_links = max_links * 2 + 16;
+                    links = tracked_realloc(memory_output, links, sizeof(int) * max_links);
+                }
+                links[num_links++] = path_pt->link;
+            }
+            format_link_list(&value, &value_size, links, num_links);
+            status |= xmlTextWriterWriteElement(writer, (xmlChar*) "Path", (xmlChar*) value) < 0;
+        }
+        status |= xmlTextWriterEndElement(writer) < 0;
+        if (frame_pt->num_splits > 0) {
+            status |= xmlTextWriterStartElement(writer, (xmlChar*) "Splits") < 0;
+            for (int j = 0; j < frame_pt->num_splits; j++) {
+                num_links = 0;
+                for (split_pt = &frame_pt->split_array_ls[j]; split_pt->next_split_pt != NULL;
+                     split_pt = split_pt->next_split_pt) {
+                    if (num_links == max_links) {
+                        max_links = max_links * 2 + 16;
+                        links = tracked_realloc(memory_output, links, sizeof(int) * max_links);
+                    }
+                    links[num_links++] = split_pt->link;
+                }
+                format_link_list(&value, &value_size, links, num_links);
+                status |= xmlTextWriterWriteElement(writer, (xmlChar*) "Split", (xmlChar*) value) < 0;
+            }
+            status |= xmlTextWriterEndElement(writer) < 0;
+        }
+        status |= xmlTextWriterEndElement(writer) < 0;
+    }
+    status |= xmlTextWriterEndDocument(writer) < 0;
+    xmlFreeTextWriter(writer);
+    charge_xml_memory(memory_parser);
+    tracked_free(memory_output, links);
+    tracked_free(memory_output, value);
+    
+    if (status != 0) {
+        printf("The network xml file could not be written\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Write the obtained schedule in a XML file.
+ Frames are formatted by blocks in parallel into a buffer per thread, and the buffers are written in order, so the
+ memory needed does not depend on the size of the schedule
+ */
+int write_schedule_xml(char* namefile, int num_threads) {
+    
+    FILE *file;
+    ScheduleWriterThread *writers;
+    int num_frames, first_frame, status = 0;
+    
+    // The frame of the protocol is not part of the schedule
     if (is_protocol_active()) {
         num_frames = get_number_frames() - 1;
     } else {
         num_frames = get_number_frames();
     }
-    frames_node = xmlNewChild(root_node, NULL, BAD_CAST "FramesTransmission", NULL);
-    for (int i = 0; i < num_frames; i++) {
-        
-        // Write general information about the frame to be easily to understand
-        frame_pt = get_frame(i);
-        frame_node = xmlNewChild(frames_node, NULL, BAD_CAST "Frame", NULL);
-        sprintf(char_value, "%d", i);
-        xmlNewChild(frame_node, NULL, BAD_CAST "FrameID", BAD_CAST char_value);
-        sprintf(char_value, "%lld", get_period(frame_pt));
-        xmlNewChild(frame_node, NULL, BAD_CAST "Period", BAD_CAST char_value);
-        sprintf(char_value, "%lld", get_starting(frame_pt));
-        xmlNewChild(frame_node, NULL, BAD_CAST "Starting", BAD_CAST char_value);
-        sprintf(char_value, "%lld", get_deadline(frame_pt));
-        xmlNewChild(frame_node, NULL, BAD_CAST "Deadline", BAD_CAST char_value);
-        sprintf(char_value, "%d", get_size(frame_pt));
-        xmlNewChild(frame_node, NULL, BAD_CAST "Size", BAD_CAST char_value);
-        sprintf(char_value, "%lld", get_end_to_end_delay(frame_pt));
-        xmlNewChild(frame_node, NULL, BAD_CAST "EndToEnd", BAD_CAST char_value);
-        
-        // Write the transmission times of all paths of the frame
-        for (int j = 0; j < get_num_paths(frame_pt); j++) {
-            path_node = xmlNewChild(frame_node, NULL, BAD_CAST "Path", NULL);
-            path_it = get_path_root(frame_pt, j);
-            
-            // For all links in the path we have to get the transmission times in that link
-            while (!is_last_path(path_it)) {
-                offset_it = get_offset_from_path(path_it);
-                sprintf(char_value, "%d", get_offset_link(offset_it));
-                link_node = xmlNewChild(path_node, NULL, BAD_CAST "Link", NULL);
-                xmlNewChild(link_node, NULL, BAD_CAST "LinkID", BAD_CAST char_value);
-                
-                // Write the transmission time of every instance
-                for (int h = 0; h < get_number_instances(offset_it); h++) {
-                    instance_node = xmlNewChild(link_node, NULL, BAD_CAST "Instance", NULL);
-                    sprintf(char_value, "%d", h);
-                    xmlNewChild(instance_node, NULL, BAD_CAST "InstanceID", BAD_CAST char_value);
-                    sprintf(char_value, "%lld", get_offset(offset_it, h, 0));
-                    xmlNewChild(instance_node, NULL, BAD_CAST "TransmissionTime", BAD_CAST char_value);
-                    sprintf(char_value, "%lld", get_offset(offset_it, h, 0) + get_timeslot_size(offset_it) - 1);
-                    xmlNewChild(instance_node, NULL, BAD_CAST "EndingTime", BAD_CAST char_value);
-                }
-                path_it = get_next_path(path_it);
+    if (num_threads <= 0) {
+        num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads > (num_frames + FRAMES_PER_WRITER - 1) / FRAMES_PER_WRITER) {
+        num_threads = (num_frames + FRAMES_PER_WRITER - 1) / FRAMES_PER_WRITER;
+    }
+    if (num_threads <= 0) {
+        num_threads = 1;
+    }
+    
+    file = fopen(namefile, "w");
+    if (file == NULL) {
+        printf("The schedule xml file could not be created\n");
+        return -1;
+    }
+    
+    // Create the top of the file
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Schedule>\n", file);
+    if (num_frames == 0) {
+        fputs("  <FramesTransmission/>\n", file);
+    } else {
+        fputs("  <FramesTransmission>\n", file);
+    }
+    
+    // Write all the frames, every thread formats a block of frames and then the blocks are written in order
+    writers = tracked_calloc(memory_output, num_threads, sizeof(ScheduleWriterThread));
+    for (first_frame = 0; first_frame < num_frames; first_frame += num_threads * FRAMES_PER_WRITER) {
+        for (int i = 0; i < num_threads; i++) {
+            writers[i].first_frame = first_frame + i * FRAMES_PER_WRITER;
+            writers[i].last_frame = writers[i].first_frame + FRAMES_PER_WRITER;
+            if (writers[i].first_frame > num_frames) {
+                writers[i].first_frame = num_frames;
+            }
+            if (writers[i].last_frame > num_frames) {
+                writers[i].last_frame = num_frames;
+            }
+            writers[i].started = 0;
+            if (i > 0 && writers[i].first_frame < writers[i].last_frame &&
+                pthread_create(&writers[i].thread, NULL, schedule_writer_thread, &writers[i]) == 0) {
+                writers[i].started = 1;
             }
         }
+        schedule_writer_thread(&writers[0]);        // The calling thread also formats frames
+        for (int i = 0; i < num_threads; i++) {
+            if (writers[i].started) {
+                pthread_join(writers[i].thread, NULL);
+            } else if (i > 0) {
+                schedule_writer_thread(&writers[i]);    // If the thread could not be created, format its frames here
+            }
+            if (fwrite(writers[i].buffer.data, 1, writers[i].buffer.length, file) != writers[i].buffer.length) {
+                status = -1;
+            }
+        }
+    }
+    for (int i = 0; i < num_threads; i++) {
+        tracked_free(memory_output, writers[i].buffer.data);
     }
+    tracked_free(memory_output, writers);
     
-    // Write the file and clean up everything
-    xmlSaveFormatFileEnc(namefile, doc, "UTF-8", 1);
-    xmlFreeDoc(doc);
-    xmlCleanupParser();
+    // Close the file
+    if (num_frames > 0) {
+        fputs("  </FramesTransmission>\n", file);
+    }
+    fputs("</Schedule>\n", file);
+    if (fclose(file) != 0 || status != 0) {
+        printf("The schedule xml file could not be written\n");
+        return -1;
+    }
     
     return 0;
 }
@@ -16,7 +16,7 @@
 #include <stdio.h>
 #include <libxml2/libxml/parser.h>
 #include <libxml2/libxml/tree.h>
-#include <libxml2/libxml/xpath.h>
+#include <libxml2/libxml/xmlreader.h>
 #include <libxml2/libxml/xmlstring.h>
 #include <libxml2/libxml/globals.h>
 #include <libxml2/libxml/xmlwriter.h>
@@ -36,9 +36,30 @@
 int parse_network_xml(char *namefile);
 
 /**
- Write the obtained schedule in a XML file
+ Reads a schedule xml file, as written by write_schedule_xml, into a compact schedule (see CompactSchedule.h) with
+ one record for every frame and link. The schedule xml file has no replicas, so all records have only the replica 0
+
+ @param namefile name of the schedule xml file
+ @return pointer to the compact schedule, NULL if it could not be read. It has to be freed with free_compact_schedule
+ */
+struct CompactSchedule * read_schedule_xml(char *namefile);
+
+/**
+ Writes the network in memory in a xml file with the same schema that is read by the parser.
+ The frame of the protocol, added when the network is initialized for the scheduling, is not written as it is not part
+ of the network description
+
+ @param namefile path and name of the xml file to create
+ @return 0 if correctly written, -1 otherwise
+ */
+int write_network_xml(char *namefile);
+
+/**
+ Write the obtained schedule in a XML file. The file is written while the frames are visited, without building the
+ xml document in memory
 
  @param namefile path and name of the xml file to create with the written schedule
+ @param num_threads number of threads that format the frames, 0 to use one per available processor
  @return 0 if correctly written, -1 otherwise
  */
-int write_schedule_xml(char* namefile);
+int write_schedule_xml(char* namefile, int num_threads);
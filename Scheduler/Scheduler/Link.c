@@ -25,6 +25,9 @@ int init_link(Link *link_pt) {
     
     link_pt->speed = -1;
     link_pt->type = wired;
+    link_pt->source = -1;
+    link_pt->destination = -1;
+    link_pt->failed = 0;
     return 0;
 }
 
@@ -65,3 +68,63 @@ LinkType get_link_type(Link *link_pt) {
     }
     return link_pt->type;
 }
+
+/**
+ Sets the nodes that the link connects
+ */
+int set_link_nodes(Link *link_pt, int source, int destination) {
+    
+    if (link_pt == NULL) {
+        return -1;
+    }
+    
+    link_pt->source = source;
+    link_pt->destination = destination;
+    return 0;
+}
+
+/**
+ Gets the node that transmits in the link (the egress port of the link belongs to it)
+ */
+int get_link_source(Link *link_pt) {
+    
+    if (link_pt == NULL) {
+        return -1;
+    }
+    return link_pt->source;
+}
+
+/**
+ Gets the node that receives from the link
+ */
+int get_link_destination(Link *link_pt) {
+    
+    if (link_pt == NULL) {
+        return -1;
+    }
+    return link_pt->destination;
+}
+
+/**
+ Tells if the link has failed permanently
+ */
+int is_link_failed(Link *link_pt) {
+    
+    if (link_pt == NULL) {
+        return 0;
+    }
+    return link_pt->failed;
+}
+
+/**
+ Sets if the link has failed permanently
+ */
+int set_link_failed(Link *link_pt, int failed) {
+    
+    if (link_pt == NULL) {
+        return -1;
+    }
+    
+    link_pt->failed = failed;
+    return 0;
+}
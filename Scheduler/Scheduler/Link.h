@@ -34,6 +34,9 @@ typedef enum LinkType {
 typedef struct Link {
     LinkType type;                      // Type of the link
     int speed;                          // Speed in MB/s of the link
+    int source;                         // Node that transmits in the link, -1 if unknown
+    int destination;                    // Node that receives from the link, -1 if unknown
+    int failed;                         // 1 if the link has failed permanently and nothing is transmitted in it
 }Link;
 
                                                 /* CODE DEFINITIONS */
@@ -74,3 +77,51 @@ int get_link_speed(Link *link_pt);
  @return the link type, 0 otherwise
  */
 LinkType get_link_type(Link *link_pt);
+
+
+/**
+ Sets the nodes that the link connects
+
+ @param link_pt pointer to the link to change
+ @param source node that transmits in the link
+ @param destination node that receives from the link
+ @return 0 if doing correctly, -1 otherwise
+ */
+int set_link_nodes(Link *link_pt, int source, int destination);
+
+
+/**
+ Gets the node that transmits in the link (the egress port of the link belongs to it)
+
+ @param link_pt pointer to the link
+ @return identifier of the node, -1 if unknown
+ */
+int get_link_source(Link *link_pt);
+
+
+/**
+ Gets the node that receives from the link
+
+ @param link_pt pointer to the link
+ @return identifier of the node, -1 if unknown
+ */
+int get_link_destination(Link *link_pt);
+
+
+/**
+ Tells if the link has failed permanently
+
+ @param link_pt pointer to the link
+ @return 1 if the link has failed, 0 otherwise
+ */
+int is_link_failed(Link *link_pt);
+
+
+/**
+ Sets if the link has failed permanently, so no frames can be routed through it
+
+ @param link_pt pointer to the link to change
+ @param failed 1 if the link has failed, 0 if it works again
+ @return 0 if doing correctly, -1 otherwise
+ */
+int set_link_failed(Link *link_pt, int failed);
@@ -0,0 +1,334 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Memory.c                                                                                                           *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Memory.h                                                                                            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Memory.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <libxml/xmlmemory.h>
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#define block_size(pointer) malloc_size(pointer)
+#else
+#include <malloc.h>
+#define block_size(pointer) malloc_usable_size(pointer)
+#endif
+
+                                                    /* VARIABLES */
+
+const char *subsystem_names[number_subsystems] = {"parser", "model", "solver", "output"};
+
+long long int memory_usage[number_subsystems];  // Memory allocated now by every subsystem in bytes
+long long int memory_peaks[number_subsystems];  // Peak memory of every subsystem since the peaks were reset
+long long int tracked_usage = 0;        // Memory allocated now by all the subsystems
+long long int tracked_peak = 0;         // Peak memory of all the subsystems together
+long long int memory_limit = 0;         // Maximum memory of the process in bytes, 0 for no limit
+void (*memory_limit_handler)(void) = NULL;  // Function called before exiting when the limit is exceeded
+int memory_limit_reached = 0;           // 1 once the limit is exceeded, so the program only aborts once
+MemorySubsystem xml_subsystem = memory_parser;  // Subsystem charged with the memory of libxml2
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Raises a peak to the given value if it is higher, the peaks are shared by all the threads
+
+ @param peak pointer to the peak
+ @param value current value
+ */
+void raise_memory_peak(long long int *peak, long long int value) {
+    
+    long long int current = __atomic_load_n(peak, __ATOMIC_RELAXED);
+    
+    while (value > current &&
+           !__atomic_compare_exchange_n(peak, &current, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+/**
+ Adds the size of a block allocated (positive) or freed (negative) to a subsystem, and aborts if the tracked memory
+ exceeds the limit
+
+ @param subsystem subsystem charged
+ @param size size in bytes
+ */
+void account_memory(MemorySubsystem subsystem, long long int size) {
+    
+    long long int usage, total;
+    
+    usage = __atomic_add_fetch(&memory_usage[subsystem], size, __ATOMIC_RELAXED);
+    total = __atomic_add_fetch(&tracked_usage, size, __ATOMIC_RELAXED);
+    if (size > 0) {
+        raise_memory_peak(&memory_peaks[subsystem], usage);
+        raise_memory_peak(&tracked_peak, total);
+        if (memory_limit > 0 && total > memory_limit) {
+            abort_memory_limit(subsystem == memory_parser ? "while parsing" :
+                               subsystem == memory_model ? "while building the model" :
+                               subsystem == memory_solver ? "while creating the solver variables" :
+                               "while writing the output");
+        }
+    }
+}
+
+/**
+ Frees a block of libxml2, charged to the subsystem set with charge_xml_memory
+
+ @param pointer pointer to the block
+ */
+void xml_free(void *pointer) {
+    
+    tracked_free(xml_subsystem, pointer);
+}
+
+/**
+ Allocates a block for libxml2, charged to the subsystem set with charge_xml_memory
+
+ @param size size of the block in bytes
+ @return pointer to the block
+ */
+void * xml_malloc(size_t size) {
+    
+    return tracked_malloc(xml_subsystem, size);
+}
+
+/**
+ Changes the size of a block of libxml2, charged to the subsystem set with charge_xml_memory
+
+ @param pointer pointer to the block
+ @param size new size of the block in bytes
+ @return pointer to the block
+ */
+void * xml_realloc(void *pointer, size_t size) {
+    
+    return tracked_realloc(xml_subsystem, pointer, size);
+}
+
+/**
+ Copies a string for libxml2, charged to the subsystem set with charge_xml_memory
+
+ @param string string to copy
+ @return pointer to the copy
+ */
+char * xml_strdup(const char *string) {
+    
+    size_t length = strlen(string) + 1;
+    char *copy = tracked_malloc(xml_subsystem, length);
+    
+    if (copy != NULL) {
+        memcpy(copy, string, length);
+    }
+    return copy;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Makes libxml2 allocate through the tracked functions
+ */
+int init_memory_accounting(void) {
+    
+    return xmlMemSetup(xml_free, xml_malloc, xml_realloc, xml_strdup) == 0 ? 0 : -1;
+}
+
+/**
+ Sets the subsystem charged with the memory that libxml2 allocates from now on
+ */
+void charge_xml_memory(MemorySubsystem subsystem) {
+    
+    xml_subsystem = subsystem;
+}
+
+/**
+ Allocates a block of memory charged to the given subsystem, as malloc
+ */
+void * tracked_malloc(MemorySubsystem subsystem, size_t size) {
+    
+    void *pointer = malloc(size);
+    
+    if (pointer != NULL) {
+        account_memory(subsystem, (long long int) block_size(pointer));
+    }
+    return pointer;
+}
+
+/**
+ Allocates a block of memory set to zero charged to the given subsystem, as calloc
+ */
+void * tracked_calloc(MemorySubsystem subsystem, size_t number, size_t size) {
+    
+    void *pointer = calloc(number, size);
+    
+    if (pointer != NULL) {
+        account_memory(subsystem, (long long int) block_size(pointer));
+    }
+    return pointer;
+}
+
+/**
+ Changes the size of a block of memory charged to the given subsystem, as realloc
+ */
+void * tracked_realloc(MemorySubsystem subsystem, void *pointer, size_t size) {
+    
+    long long int old_size = pointer != NULL ? (long long int) block_size(pointer) : 0;
+    void *new_pointer = realloc(pointer, size);
+    
+    // If it could not be reallocated, the old block is kept as it was
+    if (new_pointer != NULL || size == 0) {
+        account_memory(subsystem, (new_pointer != NULL ? (long long int) block_size(new_pointer) : 0) - old_size);
+    }
+    return new_pointer;
+}
+
+/**
+ Frees a block of memory charged to the given subsystem, as free
+ */
+void tracked_free(MemorySubsystem subsystem, void *pointer) {
+    
+    if (pointer != NULL) {
+        account_memory(subsystem, -(long long int) block_size(pointer));
+        free(pointer);
+    }
+}
+
+/**
+ Sets the peak of every subsystem to its current memory
+ */
+void reset_memory_peaks(void) {
+    
+    for (int i = 0; i < number_subsystems; i++) {
+        __atomic_store_n(&memory_peaks[i], __atomic_load_n(&memory_usage[i], __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&tracked_peak, __atomic_load_n(&tracked_usage, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
+
+/**
+ Get the name of a subsystem, as written in the metrics files
+ */
+const char * get_subsystem_name(MemorySubsystem subsystem) {
+    
+    return subsystem_names[subsystem];
+}
+
+/**
+ Get the memory currently allocated by a subsystem
+ */
+long long int get_memory_usage(MemorySubsystem subsystem) {
+    
+    return __atomic_load_n(&memory_usage[subsystem], __ATOMIC_RELAXED);
+}
+
+/**
+ Get the peak memory allocated by a subsystem since the peaks were reset
+ */
+long long int get_memory_peak(MemorySubsystem subsystem) {
+    
+    return __atomic_load_n(&memory_peaks[subsystem], __ATOMIC_RELAXED);
+}
+
+/**
+ Get the peak memory allocated by all the subsystems together since the peaks were reset
+ */
+long long int get_tracked_memory_peak(void) {
+    
+    return __atomic_load_n(&tracked_peak, __ATOMIC_RELAXED);
+}
+
+/**
+ Get the memory of the process that is resident now
+ */
+long long int get_process_memory(void) {
+    
+    FILE *file;
+    long long int pages = 0;
+    struct rusage usage;
+    
+    // The resident pages are the second value of statm, only in Linux
+    file = fopen("/proc/self/statm", "r");
+    if (file != NULL) {
+        if (fscanf(file, "%*s %lld", &pages) != 1) {
+            pages = 0;
+        }
+        fclose(file);
+        if (pages > 0) {
+            return pages * sysconf(_SC_PAGESIZE);
+        }
+    }
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return (long long int) usage.ru_maxrss;         // Already in bytes
+#else
+    return (long long int) usage.ru_maxrss * 1024;
+#endif
+}
+
+/**
+ Sets the memory limit of the process
+ */
+void set_memory_limit(long long int limit, void (*handler)(void)) {
+    
+    memory_limit = limit > 0 ? limit : 0;
+    memory_limit_handler = handler;
+}
+
+/**
+ Get the memory limit of the process
+ */
+long long int get_memory_limit(void) {
+    
+    return memory_limit;
+}
+
+/**
+ Checks if the memory of the process or the tracked memory exceed the memory limit
+ */
+int is_memory_limit_exceeded(void) {
+    
+    if (memory_limit == 0) {
+        return 0;
+    }
+    return __atomic_load_n(&tracked_usage, __ATOMIC_RELAXED) > memory_limit || get_process_memory() > memory_limit;
+}
+
+/**
+ Prints the memory used by every subsystem and the process, calls the handler of the limit and exits the program
+ */
+void abort_memory_limit(const char *activity) {
+    
+    // Only the first thread that exceeds the limit aborts, the handler can also allocate memory
+    if (__atomic_exchange_n(&memory_limit_reached, 1, __ATOMIC_SEQ_CST)) {
+        return;
+    }
+    fflush(stdout);
+    fprintf(stderr, "The memory limit of %.1f MB was exceeded %s, the process uses %.1f MB\n",
+            (double) memory_limit / (1024 * 1024), activity, (double) get_process_memory() / (1024 * 1024));
+    for (int i = 0; i < number_subsystems; i++) {
+        fprintf(stderr, "  %-8s %10.1f MB (peak %.1f MB)\n", subsystem_names[i],
+                (double) get_memory_usage(i) / (1024 * 1024), (double) get_memory_peak(i) / (1024 * 1024));
+    }
+    fprintf(stderr, "  The rest of the memory is used by the solver tables and the program\n");
+    if (memory_limit_handler != NULL) {
+        memory_limit_handler();
+    }
+    // The streams are flushed here as the program can be a forked worker that must not run the exit handlers
+    fflush(NULL);
+    _exit(MEMORY_EXIT_STATUS);
+}
+
+/**
+ Checks the memory limit and aborts the program if it is exceeded
+ */
+void check_memory_limit(const char *activity) {
+    
+    if (is_memory_limit_exceeded()) {
+        abort_memory_limit(activity);
+    }
+}
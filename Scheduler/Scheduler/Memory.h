@@ -0,0 +1,178 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Memory.h                                                                                                           *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that accounts the memory used by every subsystem of the scheduler and enforces an optional memory limit.   *
+ *  The subsystems allocate through the tracked functions, which count the real size of every block (as given by the   *
+ *  allocator) with its current and peak value: the parser (xml reader and its buffers), the model (frames, paths,     *
+ *  offsets with their hashes and transmission times, and the network indexes), the solver (the yices terms of the     *
+ *  offsets and guards) and the output (xml writers and their buffers). The memory allocated by libxml2 is charged to  *
+ *  the parser, or to the output while a xml file is written. The memory of the yices tables is not exposed by yices,  *
+ *  so only its number of terms and types is reported.                                                                 *
+ *  With a memory limit, the tracked memory is checked in every allocation and the memory of the process at the start  *
+ *  and end of every phase, periodically while the constraints are added and while the solver searches. When the limit *
+ *  is exceeded the program prints where and how the memory was used, calls the handler given (to write the metrics    *
+ *  of the run) and exits with MEMORY_EXIT_STATUS instead of being killed by the system without notice.                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Memory_h
+#define Memory_h
+
+#include <stdio.h>
+
+#endif /* Memory_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define MEMORY_EXIT_STATUS 3            // Exit status of the program when the memory limit is exceeded
+#define MEMORY_CHECK_INTERVAL 4096      // Formulas added into the solver between checks of the memory of the process
+#define MEMORY_POLL_INTERVAL 100        // Time in ms between checks of the memory of the process while solving
+
+/**
+ Subsystems whose memory is accounted
+ */
+typedef enum MemorySubsystem {
+    memory_parser,                      // Xml reader of the network and schedule files and its buffers
+    memory_model,                       // Frames, paths, splits, offsets and indexes of the network
+    memory_solver,                      // Yices terms of the offsets and guards of the frames
+    memory_output,                      // Xml writers of the network and schedule files and their buffers
+    number_subsystems
+}MemorySubsystem;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Makes libxml2 allocate through the tracked functions, it has to be called before the xml parser is initialized
+
+ @return 0 if done correctly, -1 if libxml2 did not accept the functions
+ */
+int init_memory_accounting(void);
+
+/**
+ Sets the subsystem charged with the memory that libxml2 allocates from now on (the parser by default)
+
+ @param subsystem subsystem charged
+ */
+void charge_xml_memory(MemorySubsystem subsystem);
+
+/**
+ Allocates a block of memory charged to the given subsystem, as malloc
+
+ @param subsystem subsystem charged
+ @param size size of the block in bytes
+ @return pointer to the block, NULL if it could not be allocated
+ */
+void * tracked_malloc(MemorySubsystem subsystem, size_t size);
+
+/**
+ Allocates a block of memory set to zero charged to the given subsystem, as calloc
+
+ @param subsystem subsystem charged
+ @param number number of elements
+ @param size size of every element in bytes
+ @return pointer to the block, NULL if it could not be allocated
+ */
+void * tracked_calloc(MemorySubsystem subsystem, size_t number, size_t size);
+
+/**
+ Changes the size of a block of memory charged to the given subsystem, as realloc
+
+ @param subsystem subsystem charged
+ @param pointer pointer to the block, NULL to allocate a new one
+ @param size new size of the block in bytes
+ @return pointer to the block, NULL if it could not be allocated
+ */
+void * tracked_realloc(MemorySubsystem subsystem, void *pointer, size_t size);
+
+/**
+ Frees a block of memory charged to the given subsystem, as free
+
+ @param subsystem subsystem charged
+ @param pointer pointer to the block, it can be NULL
+ */
+void tracked_free(MemorySubsystem subsystem, void *pointer);
+
+/**
+ Sets the peak of every subsystem to its current memory, to measure the peaks of a new run
+ */
+void reset_memory_peaks(void);
+
+/**
+ Get the name of a subsystem, as written in the metrics files
+
+ @param subsystem subsystem
+ @return name of the subsystem
+ */
+const char * get_subsystem_name(MemorySubsystem subsystem);
+
+/**
+ Get the memory currently allocated by a subsystem
+
+ @param subsystem subsystem
+ @return memory in bytes
+ */
+long long int get_memory_usage(MemorySubsystem subsystem);
+
+/**
+ Get the peak memory allocated by a subsystem since the peaks were reset
+
+ @param subsystem subsystem
+ @return memory in bytes
+ */
+long long int get_memory_peak(MemorySubsystem subsystem);
+
+/**
+ Get the peak memory allocated by all the subsystems together since the peaks were reset
+
+ @return memory in bytes
+ */
+long long int get_tracked_memory_peak(void);
+
+/**
+ Get the memory of the process that is resident now (the peak resident memory where it cannot be read)
+
+ @return memory in bytes
+ */
+long long int get_process_memory(void);
+
+/**
+ Sets the memory limit of the process. When it is exceeded the handler is called and the program exits
+
+ @param limit maximum memory in bytes, 0 for no limit
+ @param handler function called before the program exits, NULL for none
+ */
+void set_memory_limit(long long int limit, void (*handler)(void));
+
+/**
+ Get the memory limit of the process
+
+ @return maximum memory in bytes, 0 if there is no limit
+ */
+long long int get_memory_limit(void);
+
+/**
+ Checks if the memory of the process or the tracked memory exceed the memory limit
+
+ @return 1 if the limit is exceeded, 0 otherwise or if there is no limit
+ */
+int is_memory_limit_exceeded(void);
+
+/**
+ Prints the memory used by every subsystem and the process, calls the handler of the limit and exits the program with
+ MEMORY_EXIT_STATUS
+
+ @param activity what the scheduler was doing when the limit was exceeded, as "while solving the constraints"
+ */
+void abort_memory_limit(const char *activity);
+
+/**
+ Checks the memory limit and aborts the program as abort_memory_limit if it is exceeded
+
+ @param activity what the scheduler is doing, as "while solving the constraints"
+ */
+void check_memory_limit(const char *activity);
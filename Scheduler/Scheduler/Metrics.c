@@ -0,0 +1,491 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Metrics.c                                                                                                          *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Metrics.h                                                                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Metrics.h"
+#include "ConstraintSolver.h"
+#include "Memory.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Time accumulated by a phase
+ */
+typedef struct PhaseTime {
+    long long int wall;                 // Wall time spent in the phase in us
+    long long int cpu;                  // CPU time of the process spent in the phase in us
+    long long int wall_start;           // Wall time when the phase started the last time
+    long long int cpu_start;            // CPU time when the phase started the last time
+}PhaseTime;
+
+/**
+ Span of work of a thread saved as a complete event of the Chrome trace
+ */
+typedef struct TraceEvent {
+    const char *name;                   // Name of the span
+    long long int start;                // Starting time in us from the reset of the metrics
+    long long int duration;             // Duration in us
+    int thread;                         // Identifier of the thread in the trace
+}TraceEvent;
+
+/**
+ Time when a thread of the trace saved its first and last events
+ */
+typedef struct TraceThread {
+    int thread;                         // Identifier of the thread in the trace
+    long long int first;                // Starting time of its first event in us
+    long long int last;                 // Ending time of its last event in us
+}TraceThread;
+
+                                                    /* VARIABLES */
+
+const char *phase_names[number_phases] = {"parse", "init", "offsets", "contention", "path_dependent", "end_to_end",
+    "solve", "extract", "validate", "write"};
+
+PhaseTime phase_times[number_phases];   // Time accumulated by every phase
+char metrics_label[256] = "";           // Label of the record
+long long int metrics_origin = 0;       // Wall time of the reset of the metrics, origin of the trace
+
+long long int network_instances = 0;   // Instances of all frames in all links of the scheduled network
+long long int network_transmissions = 0;    // Instances of all replicas
+long long int network_offsets = 0;     // Number of frames in every link
+int network_frames = 0;                 // Frames of the scheduled network, without the frame of the protocol
+int network_links = 0;                  // Links of the scheduled network
+
+int trace_enabled = 0;                  // 1 if the trace events are saved
+TraceEvent *trace_events = NULL;        // Saved trace events
+int num_trace_events = 0;
+int max_trace_events = 0;
+int next_trace_thread = 0;              // Identifier given to the next thread that saves an event
+pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+__thread int trace_thread = -1;         // Identifier of the calling thread in the trace
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the time of the given clock in us
+
+ @param clock clock to read
+ @return time in us
+ */
+long long int get_clock_time(clockid_t clock) {
+    
+    struct timespec time;
+    
+    clock_gettime(clock, &time);
+    return (long long int) time.tv_sec * 1000000 + time.tv_nsec / 1000;
+}
+
+/**
+ Saves a span of the calling thread as an event of the trace
+
+ @param name name of the span
+ @param start starting wall time of the span in us
+ @param end ending wall time of the span in us
+ */
+void add_trace_event(const char *name, long long int start, long long int end) {
+    
+    pthread_mutex_lock(&trace_mutex);
+    if (trace_thread == -1) {
+        trace_thread = next_trace_thread++;
+    }
+    if (num_trace_events == max_trace_events) {
+        max_trace_events = max_trace_events * 2 + 256;
+        trace_events = realloc(trace_events, sizeof(TraceEvent) * max_trace_events);
+    }
+    trace_events[num_trace_events].name = name;
+    trace_events[num_trace_events].start = start - metrics_origin;
+    trace_events[num_trace_events].duration = end - start;
+    trace_events[num_trace_events].thread = trace_thread;
+    num_trace_events++;
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+/**
+ Compares two threads of the trace by the time of their first event
+
+ @param a pointer to the first thread
+ @param b pointer to the second thread
+ @return negative, 0 or positive if the first thread starts before, at the same time or after the second
+ */
+int compare_trace_threads(const void *a, const void *b) {
+    
+    const TraceThread *thread_a = a, *thread_b = b;
+    
+    return (thread_a->first > thread_b->first) - (thread_a->first < thread_b->first);
+}
+
+/**
+ Assigns the threads of the trace to lanes, so the workers created in every parallel part that do not overlap in time
+ share the same lane and the trace shows one lane per worker instead of one per created thread.
+ The first thread (the one that runs the phases) has always the lane 0
+
+ @param lanes array where the lane of every thread is saved
+ @return number of lanes
+ */
+int assign_trace_lanes(int *lanes) {
+    
+    TraceThread *threads;
+    long long int *lane_ends;
+    int num_lanes = 1, lane, thread;
+    
+    threads = malloc(sizeof(TraceThread) * (next_trace_thread + 1));
+    lane_ends = malloc(sizeof(long long int) * (next_trace_thread + 1));
+    for (int i = 0; i < next_trace_thread; i++) {
+        threads[i].thread = i;
+        threads[i].first = -1;
+        threads[i].last = -1;
+    }
+    for (int i = 0; i < num_trace_events; i++) {
+        thread = trace_events[i].thread;
+        if (threads[thread].first == -1 || trace_events[i].start < threads[thread].first) {
+            threads[thread].first = trace_events[i].start;
+        }
+        if (trace_events[i].start + trace_events[i].duration > threads[thread].last) {
+            threads[thread].last = trace_events[i].start + trace_events[i].duration;
+        }
+    }
+    qsort(threads, next_trace_thread, sizeof(TraceThread), compare_trace_threads);
+    
+    // Every worker takes the first lane that is free when it starts
+    lanes[0] = 0;
+    for (int i = 0; i < next_trace_thread; i++) {
+        if (threads[i].thread == 0) {
+            continue;
+        }
+        lane = 1;
+        while (lane < num_lanes && lane_ends[lane] > threads[i].first) {
+            lane++;
+        }
+        if (lane == num_lanes) {
+            num_lanes++;
+        }
+        lanes[threads[i].thread] = lane;
+        lane_ends[lane] = threads[i].last;
+    }
+    
+    free(threads);
+    free(lane_ends);
+    return num_lanes;
+}
+
+/**
+ Checks the memory limit at the start or end of a phase, the program exits if it is exceeded
+
+ @param phase phase
+ */
+void check_phase_memory(MetricPhase phase) {
+    
+    char activity[64];
+    
+    if (get_memory_limit() > 0) {
+        snprintf(activity, sizeof(activity), "in the %s phase", phase_names[phase]);
+        check_memory_limit(activity);
+    }
+}
+
+/**
+ Writes a string as a JSON string, between quotes and with the quotes, backslashes and control characters escaped
+
+ @param file file where to write the string
+ @param string string to write
+ */
+void write_json_string(FILE *file, const char *string) {
+    
+    fputc('"', file);
+    for (const unsigned char *c = (const unsigned char *) string; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(file, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(file, "\\u%04x", *c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ Writes a string as a CSV field, between quotes and with the quotes doubled if it has commas, quotes or line breaks
+
+ @param file file where to write the string
+ @param string string to write
+ */
+void write_csv_field(FILE *file, const char *string) {
+    
+    if (strpbrk(string, ",\"\r\n") == NULL) {
+        fputs(string, file);
+        return;
+    }
+    fputc('"', file);
+    for (const char *c = string; *c != '\0'; c++) {
+        if (*c == '"') {
+            fputc('"', file);
+        }
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Saves the size of the network in memory once it is initialized, protocol excluded
+ */
+void save_network_metrics(void) {
+    
+    Offset *offset_it;
+    
+    network_instances = 0;
+    network_transmissions = 0;
+    network_offsets = 0;
+    network_frames = is_protocol_active() == 1 ? get_number_frames() - 1 : get_number_frames();
+    network_links = get_number_links();
+    for (int i = 0; i < network_frames; i++) {
+        offset_it = get_offset_root(get_frame(i));
+        while (!is_last_offset(offset_it)) {
+            network_instances += get_number_instances(offset_it);
+            network_transmissions += (long long int) get_number_instances(offset_it) *
+                (get_number_replicas(offset_it) + 1);
+            network_offsets += 1;
+            offset_it = get_next_offset(offset_it);
+        }
+    }
+}
+
+/**
+ Removes all the measured times and trace events, and sets the label of the next record
+ */
+void reset_metrics(char *label) {
+    
+    memset(phase_times, 0, sizeof(phase_times));
+    network_instances = 0;
+    network_transmissions = 0;
+    network_offsets = 0;
+    network_frames = 0;
+    network_links = 0;
+    metrics_label[0] = '\0';
+    if (label != NULL) {
+        strncpy(metrics_label, label, sizeof(metrics_label) - 1);
+    }
+    metrics_origin = get_clock_time(CLOCK_MONOTONIC);
+    reset_memory_peaks();
+    pthread_mutex_lock(&trace_mutex);
+    num_trace_events = 0;
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+/**
+ Enables or disables the events of the Chrome trace
+ */
+void enable_trace(int enabled) {
+    
+    trace_enabled = enabled;
+    if (metrics_origin == 0) {
+        metrics_origin = get_clock_time(CLOCK_MONOTONIC);
+    }
+}
+
+/**
+ Get the name of a phase, as written in the metrics files
+ */
+const char * get_phase_name(MetricPhase phase) {
+    
+    return phase_names[phase];
+}
+
+/**
+ Starts measuring a phase in the calling thread
+ */
+void start_phase(MetricPhase phase) {
+    
+    check_phase_memory(phase);
+    phase_times[phase].wall_start = get_clock_time(CLOCK_MONOTONIC);
+    phase_times[phase].cpu_start = get_clock_time(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+/**
+ Stops measuring a phase in the calling thread and adds the time spent to the phase
+ */
+void end_phase(MetricPhase phase) {
+    
+    long long int wall_end = get_clock_time(CLOCK_MONOTONIC);
+    
+    phase_times[phase].wall += wall_end - phase_times[phase].wall_start;
+    phase_times[phase].cpu += get_clock_time(CLOCK_PROCESS_CPUTIME_ID) - phase_times[phase].cpu_start;
+    if (trace_enabled) {
+        add_trace_event(phase_names[phase], phase_times[phase].wall_start, wall_end);
+    }
+    check_phase_memory(phase);
+}
+
+/**
+ Get the wall time accumulated by a phase
+ */
+double get_phase_time(MetricPhase phase) {
+    
+    return (double) phase_times[phase].wall / 1000;
+}
+
+/**
+ Starts a span of work of the calling thread for the trace
+ */
+long long int start_trace_span(void) {
+    
+    if (!trace_enabled) {
+        return 0;
+    }
+    return get_clock_time(CLOCK_MONOTONIC);
+}
+
+/**
+ Ends a span of work of the calling thread and saves it as an event of the trace, if the trace is enabled
+ */
+void end_trace_span(const char *name, long long int start) {
+    
+    if (trace_enabled) {
+        add_trace_event(name, start, get_clock_time(CLOCK_MONOTONIC));
+    }
+}
+
+/**
+ Appends the record of the run with the metrics of the network in memory to a metrics file
+ */
+int write_metrics(char *namefile, int status, int csv) {
+    
+    FILE *file;
+    struct rusage usage;
+    
+    file = fopen(namefile, "a");
+    if (file == NULL) {
+        printf("The metrics file could not be created\n");
+        return -1;
+    }
+    getrusage(RUSAGE_SELF, &usage);
+    
+    if (csv) {
+        // The header is only written in a new file
+        fseek(file, 0, SEEK_END);
+        if (ftell(file) == 0) {
+            fprintf(file, "label,timestamp,status,frames,links,offsets,instances,transmissions,variables,formulas,"
+                    "disjunctions,peak_rss_kb");
+            for (int i = 0; i < number_subsystems; i++) {
+                fprintf(file, ",%s_peak_kb", get_subsystem_name(i));
+            }
+            fprintf(file, ",tracked_peak_kb,solver_terms,solver_types");
+            for (int i = 0; i < number_phases; i++) {
+                fprintf(file, ",%s_wall_ms,%s_cpu_ms", phase_names[i], phase_names[i]);
+            }
+            fprintf(file, "\n");
+        }
+        write_csv_field(file, metrics_label);
+        fprintf(file, ",%lld,%d,%d,%d,%lld,%lld,%lld,%d,%d,%d,%ld", (long long int) time(NULL),
+                status, network_frames, network_links, network_offsets, network_instances, network_transmissions,
+                get_number_variables(), get_number_formulas(), get_number_disjunctions(), usage.ru_maxrss);
+        for (int i = 0; i < number_subsystems; i++) {
+            fprintf(file, ",%lld", get_memory_peak(i) / 1024);
+        }
+        fprintf(file, ",%lld,%d,%d", get_tracked_memory_peak() / 1024, get_number_terms(), get_number_types());
+        for (int i = 0; i < number_phases; i++) {
+            fprintf(file, ",%.3f,%.3f", (double) phase_times[i].wall / 1000, (double) phase_times[i].cpu / 1000);
+        }
+        fprintf(file, "\n");
+    } else {
+        fprintf(file, "{\"label\": ");
+        write_json_string(file, metrics_label);
+        fprintf(file, ", \"timestamp\": %lld, \"status\": %d, \"frames\": %d, \"links\": %d, "
+                "\"offsets\": %lld, \"instances\": %lld, \"transmissions\": %lld, \"variables\": %d, "
+                "\"formulas\": %d, \"disjunctions\": %d, \"peak_rss_kb\": %ld, \"memory_peak_kb\": {",
+                (long long int) time(NULL), status, network_frames, network_links, network_offsets,
+                network_instances, network_transmissions, get_number_variables(), get_number_formulas(),
+                get_number_disjunctions(), usage.ru_maxrss);
+        for (int i = 0; i < number_subsystems; i++) {
+            fprintf(file, "\"%s\": %lld, ", get_subsystem_name(i), get_memory_peak(i) / 1024);
+        }
+        fprintf(file, "\"tracked\": %lld}, \"solver_terms\": %d, \"solver_types\": %d, \"phases\": {",
+                get_tracked_memory_peak() / 1024, get_number_terms(), get_number_types());
+        for (int i = 0; i < number_phases; i++) {
+            fprintf(file, "%s\"%s\": {\"wall_ms\": %.3f, \"cpu_ms\": %.3f}", i > 0 ? ", " : "", phase_names[i],
+                    (double) phase_times[i].wall / 1000, (double) phase_times[i].cpu / 1000);
+        }
+        fprintf(file, "}}\n");
+    }
+    
+    if (fclose(file) != 0) {
+        printf("The metrics file could not be written\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Writes all the saved events of the trace in a Chrome trace file
+ */
+int write_trace(char *namefile) {
+    
+    FILE *file;
+    int *lanes, num_lanes;
+    
+    file = fopen(namefile, "w");
+    if (file == NULL) {
+        printf("The trace file could not be created\n");
+        return -1;
+    }
+    
+    // The first lane is the thread that runs the phases, the rest are the workers of the parallel parts
+    pthread_mutex_lock(&trace_mutex);
+    lanes = malloc(sizeof(int) * (next_trace_thread + 1));
+    num_lanes = assign_trace_lanes(lanes);
+    fprintf(file, "{\"traceEvents\": [\n");
+    for (int i = 0; i < num_lanes; i++) {
+        if (i == 0) {
+            fprintf(file, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, "
+                    "\"args\": {\"name\": \"scheduler\"}},\n");
+        } else {
+            fprintf(file, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+                    "\"args\": {\"name\": \"worker %d\"}},\n", i, i);
+        }
+    }
+    for (int i = 0; i < num_trace_events; i++) {
+        fprintf(file, "{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %lld, \"dur\": %lld}%s\n",
+                trace_events[i].name, lanes[trace_events[i].thread], trace_events[i].start,
+                trace_events[i].duration, i < num_trace_events - 1 ? "," : "");
+    }
+    free(lanes);
+    fprintf(file, "], \"displayTimeUnit\": \"ms\", \"otherData\": {\"label\": ");
+    write_json_string(file, metrics_label);
+    fprintf(file, "}}\n");
+    pthread_mutex_unlock(&trace_mutex);
+    
+    if (fclose(file) != 0) {
+        printf("The trace file could not be written\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Frees the memory used by the trace events
+ */
+void free_metrics(void) {
+    
+    pthread_mutex_lock(&trace_mutex);
+    free(trace_events);
+    trace_events = NULL;
+    num_trace_events = 0;
+    max_trace_events = 0;
+    pthread_mutex_unlock(&trace_mutex);
+}
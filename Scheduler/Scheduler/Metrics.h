@@ -0,0 +1,136 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Metrics.h                                                                                                          *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that measures the performance of the scheduler in a machine readable way.                                  *
+ *  The wall and CPU time of every phase (parse, init, every family of constraints, solve, extract, validate and       *
+ *  write) are accumulated while the network is loaded and scheduled. They are written, together with the peak memory  *
+ *  of the process and of every subsystem (see Memory.h), the number of variables, formulas and disjunctions of the    *
+ *  solver, the terms and types of the yices tables and the size of the network, as one record per run appended to a   *
+ *  JSON lines or CSV file, so runs of different networks and releases can be compared.                                *
+ *  Optionally the phases and the work of every thread are also kept as events of a Chrome trace file (it can be       *
+ *  opened in chrome://tracing or Perfetto).                                                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Metrics_h
+#define Metrics_h
+
+#include <stdio.h>
+#include "Network.h"
+
+#endif /* Metrics_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Phases of the scheduler that are measured
+ */
+typedef enum MetricPhase {
+    phase_parse,                        // Read the network file
+    phase_init,                         // Prepare the network and the solver
+    phase_offsets,                      // Offset variables with their ranges
+    phase_contention,                   // Contention free constraints
+    phase_path_dependent,               // Path dependent constraints
+    phase_end_to_end,                   // End to end delay constraints
+    phase_solve,                        // Solve the logical context
+    phase_extract,                      // Save the offsets found by the solver
+    phase_validate,                     // Validate the schedule
+    phase_write,                        // Write the output files
+    number_phases
+}MetricPhase;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Removes all the measured times and trace events, and sets the label of the next record (usually the network file)
+
+ @param label label written in the record, NULL for none
+ */
+void reset_metrics(char *label);
+
+/**
+ Saves the size of the network in memory (frames, links and instances) for the record, it is called once the network
+ is initialized for the scheduling
+ */
+void save_network_metrics(void);
+
+/**
+ Enables or disables the events of the Chrome trace, they are disabled by default as they take memory for every span
+
+ @param enabled 1 to save the trace events, 0 otherwise
+ */
+void enable_trace(int enabled);
+
+/**
+ Get the name of a phase, as written in the metrics files
+
+ @param phase phase
+ @return name of the phase
+ */
+const char * get_phase_name(MetricPhase phase);
+
+/**
+ Starts measuring a phase in the calling thread
+
+ @param phase phase that starts
+ */
+void start_phase(MetricPhase phase);
+
+/**
+ Stops measuring a phase in the calling thread and adds the time spent to the phase
+
+ @param phase phase that ends
+ */
+void end_phase(MetricPhase phase);
+
+/**
+ Get the wall time accumulated by a phase
+
+ @param phase phase
+ @return wall time in ms
+ */
+double get_phase_time(MetricPhase phase);
+
+/**
+ Starts a span of work of the calling thread for the trace
+
+ @return starting time of the span in us, to give it to end_trace_span
+ */
+long long int start_trace_span(void);
+
+/**
+ Ends a span of work of the calling thread and saves it as an event of the trace, if the trace is enabled
+
+ @param name name of the span, it has to be a constant string
+ @param start starting time returned by start_trace_span
+ */
+void end_trace_span(const char *name, long long int start);
+
+/**
+ Appends the record of the run with the metrics of the network in memory to a metrics file. In the CSV format, the
+ header is written when the file is empty
+
+ @param namefile path and name of the metrics file
+ @param status exit status of the run, 0 if the schedule was found
+ @param csv 1 to write a CSV row, 0 to write a JSON line
+ @return 0 if written correctly, -1 otherwise
+ */
+int write_metrics(char *namefile, int status, int csv);
+
+/**
+ Writes all the saved events of the trace in a Chrome trace file
+
+ @param namefile path and name of the trace file
+ @return 0 if written correctly, -1 otherwise
+ */
+int write_trace(char *namefile);
+
+/**
+ Frees the memory used by the trace events
+ */
+void free_metrics(void);
@@ -11,6 +11,8 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "Network.h"
+#include "Topology.h"
+#include "Memory.h"
 #include <stdlib.h>
 
                                                     /* VARIABLES */
@@ -25,9 +27,99 @@ int hop_delay;                      // Time to wait to relay a frame after being
 long long int protocol_period;      // Period that we save for the protocol
 long long int protocol_time;        // Time saved in every period for the protocol
 long long int time_between_frames;  // Time between transmissions between frames
+int *link_num_offsets;              // Number of offsets transmitted in every link (size is num_links)
+Offset ***link_offsets;             // For every link, array with all the offsets transmitted in it
+int **link_offsets_frame;           // For every link, array with the frame identifier of each of its offsets
+int network_initialized = 0;        // 1 after initializing the network, when the frame of the protocol was added
 
                                                 /* AUXILIAR FUNCTIONS */
 
+/**
+ Frees the index of offsets by link if it exists
+ */
+void free_link_index(void) {
+    
+    if (link_num_offsets != NULL) {
+        for (int i = 0; i < num_links; i++) {
+            tracked_free(memory_model, link_offsets[i]);
+            tracked_free(memory_model, link_offsets_frame[i]);
+        }
+        tracked_free(memory_model, link_num_offsets);
+        tracked_free(memory_model, link_offsets);
+        tracked_free(memory_model, link_offsets_frame);
+        link_num_offsets = NULL;
+        link_offsets = NULL;
+        link_offsets_frame = NULL;
+    }
+}
+
+/**
+ Calculates the greatest common divisor of two times, the absolute value is used for negative times
+
+ @param a first time in ns
+ @param b second time in ns
+ @return greatest common divisor, the other time if one of them is 0
+ */
+long long int time_common_divisor(long long int a, long long int b) {
+    
+    long long int remainder;
+    
+    a = a < 0 ? -a : a;
+    b = b < 0 ? -b : b;
+    while (b != 0) {
+        remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+/**
+ Tells if the fastest transmission of every path of a frame fits in a time granularity whenever it fits in ns. In the
+ unit, the margins that are strict in ns take a whole unit: the transmission in the next link of a path is one unit
+ after the hop delay, the last link is one unit before the end to end delay, and, as the transmission times are
+ TIME_GRID_ORIGIN ns after a multiple of the unit, the last possible transmission is one unit before the deadline
+
+ @param frame_pt pointer to the frame
+ @param granularity time unit in ns
+ @return 1 if the frame fits in the unit when it fits in ns, 0 otherwise
+ */
+int is_granularity_exact(Frame *frame_pt, long long int granularity) {
+    
+    Path *path_it;
+    long long int latency, grid_latency, margin, size, starting, deadline, end_to_end;
+    int fits, grid_fits;
+    
+    starting = get_starting(frame_pt);
+    deadline = get_deadline(frame_pt);
+    end_to_end = get_end_to_end_delay(frame_pt);
+    for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
+        latency = 0;
+        grid_latency = 0;
+        path_it = get_path_root(frame_pt, path_id);
+        size = get_timeslot_size(get_offset_from_path(path_it));
+        while (!is_last_path(get_next_path(path_it))) {
+            margin = hop_delay + size + 1;
+            latency += margin;
+            grid_latency += (margin + granularity - 1) / granularity * granularity;
+            path_it = get_next_path(path_it);
+            size = get_timeslot_size(get_offset_from_path(path_it));
+        }
+        
+        // The first link starts after the starting time, and the last one ends before the end to end delay and the
+        // deadline, that in the unit are rounded as the solver does
+        fits = latency < end_to_end - size && starting + 1 + latency <= deadline - size;
+        grid_fits = end_to_end - size > 0 && deadline - size - TIME_GRID_ORIGIN >= 0 &&
+                    grid_latency < (end_to_end - size + granularity - 1) / granularity * granularity &&
+                    (starting + granularity - 1) / granularity * granularity + grid_latency <=
+                    (deadline - size - TIME_GRID_ORIGIN) / granularity * granularity;
+        if (fits && !grid_fits) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
                                                     /* FUNCTIONS */
 
 /**
@@ -38,13 +130,28 @@ int get_number_frames(void) {
     return num_frames;
 }
 
+/**
+ Get the number of frames of the network without the fake frame of the protocol
+ */
+int get_number_network_frames(void) {
+    
+    if (network_initialized && protocol_period != 0) {
+        return num_frames - 1;
+    }
+    return num_frames;
+}
+
 /**
  Set the number of frames in the network
  */
 void set_number_frames(int number_frames) {
     
     num_frames = number_frames;
-    frames = malloc(sizeof(Frame) * num_frames);        // Init the array of frames now that we now the number
+    // Init the array of frames now that we now the number
+    frames = tracked_malloc(memory_model, sizeof(Frame) * num_frames);
+    for (int i = 0; i < num_frames; i++) {
+        init_frame(&frames[i]);
+    }
 }
 
 /**
@@ -61,7 +168,45 @@ Frame * get_frame(int frame_id) {
 void set_number_links(int number_links) {
     
     num_links = number_links;
-    links = malloc(sizeof(Link) * number_links);        // Init the array of links now that we now the number
+    // Init the array of links now that we now the number
+    links = tracked_malloc(memory_model, sizeof(Link) * number_links);
+    for (int i = 0; i < num_links; i++) {
+        init_link(&links[i]);
+    }
+}
+
+/**
+ Get the number of links in the network
+ */
+int get_number_links(void) {
+    
+    return num_links;
+}
+
+/**
+ Get the number of nodes of the network, given by the biggest node identifier connected by a link
+ */
+int get_number_nodes(void) {
+    
+    int num_nodes = 0;
+    
+    for (int i = 0; i < num_links; i++) {
+        if (get_link_source(&links[i]) >= num_nodes) {
+            num_nodes = get_link_source(&links[i]) + 1;
+        }
+        if (get_link_destination(&links[i]) >= num_nodes) {
+            num_nodes = get_link_destination(&links[i]) + 1;
+        }
+    }
+    return num_nodes;
+}
+
+/**
+ Get the link pointer given the link id
+ */
+Link * get_link(int link_id) {
+    
+    return &links[link_id];
 }
 
 /**
@@ -76,7 +221,7 @@ int get_hop_delay(void) {
  Sets the hop delay of the switches in the network
  */
 void set_hop_delay(int hp) {
-
+    
     hop_delay = hp;
 }
 
@@ -88,6 +233,14 @@ void set_hyper_period(long long int hyper_period) {
     hyperperiod = hyper_period;
 }
 
+/**
+ Get the hyperperiod of the network schedule
+ */
+long long int get_hyper_period(void) {
+    
+    return hyperperiod;
+}
+
 /**
  Sets the parameters of the protocol
  */
@@ -97,6 +250,22 @@ void set_protocol_parameters(long long int period, long long int time) {
     protocol_time = time;
 }
 
+/**
+ Get the period of the protocol
+ */
+long long int get_protocol_period(void) {
+    
+    return protocol_period;
+}
+
+/**
+ Get the time reserved for the protocol every protocol period
+ */
+long long int get_protocol_time(void) {
+    
+    return protocol_time;
+}
+
 /**
  Get the time between frames
  */
@@ -125,6 +294,18 @@ int add_link(int link_id, int speed, LinkType link_type) {
     return 0;
 }
 
+/**
+ Add the nodes that a link of the link array connects
+ */
+int add_link_nodes(int link_id, int source, int destination) {
+    
+    if (link_id < 0 || link_id >= num_links) {
+        return -1;
+    }
+    set_link_nodes(&links[link_id], source, destination);
+    return 0;
+}
+
 /**
  Adds to the given index frame the general information of the period, deadline and size in the frame array
  */
@@ -202,6 +383,62 @@ int add_frame_split(int frame_id, int split_id, int *split, int len_split) {
     return 0;
 }
 
+/**
+ Adds a new empty frame at the end of the frame array
+ */
+int append_frame(void) {
+    
+    num_frames++;
+    frames = tracked_realloc(memory_model, frames, sizeof(Frame) * num_frames);
+    init_frame(&frames[num_frames - 1]);
+    return num_frames - 1;
+}
+
+/**
+ Removes the last frame of the frame array
+ */
+int remove_last_frame(void) {
+    
+    if (num_frames == 0 || network_initialized) {
+        return -1;
+    }
+    num_frames--;
+    free_frame(&frames[num_frames]);
+    return 0;
+}
+
+/**
+ Removes the paths and splits of a frame keeping its information
+ */
+int remove_frame(int frame_id) {
+    
+    return set_frame_paths(frame_id, 0, NULL, NULL);
+}
+
+/**
+ Replaces all the paths of a frame, keeping its information
+ */
+int set_frame_paths(int frame_id, int num_paths, int **paths, int *len_paths) {
+    
+    Frame previous;
+    
+    if (frame_id < 0 || frame_id >= num_frames) {
+        return -1;
+    }
+    
+    // Free all the paths, splits and offsets, then add the new paths that create the new offsets
+    previous = frames[frame_id];
+    free_frame(&frames[frame_id]);
+    add_frame_information(frame_id, previous.period, previous.deadline, previous.size, previous.end_to_end_delay,
+                          previous.starting);
+    add_num_paths(frame_id, num_paths);
+    for (int i = 0; i < num_paths; i++) {
+        add_frame_path(frame_id, i, paths[i], len_paths[i]);
+    }
+    add_num_splits(frame_id, 0);
+    return 0;
+}
+
 /**
  Init to reserve bandwitch for the protocol creating a fake frame.
  The fake frame has the period of the protocol, the timesize slot of the protocol and the same number of paths as links
@@ -210,17 +447,27 @@ int add_frame_split(int frame_id, int split_id, int *split, int len_split) {
 void initialize_protocol(void) {
     
     int path[1];
+    int num_paths = 0;
     
     // If there are protocol, add an extra fake frame
     if (protocol_period != 0) {
         num_frames++;
-        frames = realloc(frames, sizeof(Frame) * num_frames);   // Allocate space for the new fake frame
+        frames = tracked_realloc(memory_model, frames, sizeof(Frame) * num_frames);     // Space for the fake frame
+        init_frame(&frames[num_frames - 1]);
         add_frame_information(num_frames - 1, protocol_period, protocol_period, 0, protocol_time + 1, 0);
-        add_num_paths(num_frames - 1, num_links);               // As many paths as links
         for (int i = 0; i < num_links; i++) {
-            path[0] = i;
-            add_path(&frames[num_frames - 1], i, path , 1);
+            num_paths += !is_link_failed(&links[i]);
+        }
+        add_num_paths(num_frames - 1, num_paths);               // As many paths as links that have not failed
+        num_paths = 0;
+        for (int i = 0; i < num_links; i++) {
+            if (!is_link_failed(&links[i])) {
+                path[0] = i;
+                add_path(&frames[num_frames - 1], num_paths, path , 1);
+                num_paths++;
+            }
         }
+        add_num_splits(num_frames - 1, 0);
     }
     
 }
@@ -235,6 +482,7 @@ void initialize_network(void) {
     Offset *offset_it;          // Iterator to go through all offsets
     
     initialize_protocol();
+    network_initialized = 1;
     
     // For all frames, init the offset to -1, and set the appearances and the replicas depending on its period and
     // if they are wired or wireless link transmissions, also time for transmission
@@ -264,6 +512,94 @@ void initialize_network(void) {
             offset_it = get_next_offset(offset_it);     // Advance to the next offset
         }
     }
+    
+    // Index the offsets by link, so the frames sharing a link can be found without searching all frames
+    index_link_offsets();
+}
+
+/**
+ Returns the initialized network to its state before initialize_network, so it can be modified and scheduled again
+ */
+void reset_network(void) {
+    
+    if (!network_initialized) {
+        return;
+    }
+    free_link_index();
+    if (protocol_period != 0) {
+        num_frames--;
+        free_frame(&frames[num_frames]);
+    }
+    for (int i = 0; i < num_frames; i++) {
+        reset_offsets(&frames[i]);
+    }
+    network_initialized = 0;
+}
+
+/**
+ Creates the index of offsets by link, with all the offsets of all frames (including the protocol) that are
+ transmitted in every link. It has to be called again every time the paths of the frames change
+ */
+void index_link_offsets(void) {
+    
+    Offset *offset_it;          // Iterator to go through all offsets
+    int link;                   // Link of the offset
+    
+    free_link_index();
+    link_num_offsets = tracked_calloc(memory_model, num_links, sizeof(int));
+    link_offsets = tracked_malloc(memory_model, sizeof(Offset **) * num_links);
+    link_offsets_frame = tracked_malloc(memory_model, sizeof(int *) * num_links);
+    
+    // First count how many offsets has every link to allocate the exact memory, then fill the arrays
+    for (int i = 0; i < num_frames; i++) {
+        offset_it = get_offset_root(&frames[i]);
+        while (offset_it != NULL && !is_last_offset(offset_it)) {
+            link_num_offsets[get_offset_link(offset_it)]++;
+            offset_it = get_next_offset(offset_it);
+        }
+    }
+    for (int i = 0; i < num_links; i++) {
+        link_offsets[i] = tracked_malloc(memory_model, sizeof(Offset *) * link_num_offsets[i]);
+        link_offsets_frame[i] = tracked_malloc(memory_model, sizeof(int) * link_num_offsets[i]);
+        link_num_offsets[i] = 0;
+    }
+    for (int i = 0; i < num_frames; i++) {
+        offset_it = get_offset_root(&frames[i]);
+        while (offset_it != NULL && !is_last_offset(offset_it)) {
+            link = get_offset_link(offset_it);
+            link_offsets[link][link_num_offsets[link]] = offset_it;
+            link_offsets_frame[link][link_num_offsets[link]] = i;
+            link_num_offsets[link]++;
+            offset_it = get_next_offset(offset_it);
+        }
+    }
+}
+
+/**
+ Get the number of offsets transmitted in the given link
+ */
+int get_link_number_offsets(int link_id) {
+    
+    if (link_num_offsets == NULL) {
+        return 0;
+    }
+    return link_num_offsets[link_id];
+}
+
+/**
+ Get the offset in the given position of the offsets transmitted in the given link
+ */
+Offset * get_link_offset(int link_id, int index) {
+    
+    return link_offsets[link_id][index];
+}
+
+/**
+ Get the frame identifier of the offset in the given position of the offsets transmitted in the given link
+ */
+int get_link_offset_frame(int link_id, int index) {
+    
+    return link_offsets_frame[link_id][index];
 }
 
 /**
@@ -360,6 +696,77 @@ int check_schedule_correctness(void) {
     return 0;
 }
 
+/**
+ Calculates the time granularity of the network, the greatest unit of time in which all the transmissions are done
+ */
+long long int get_time_granularity(long long int macrotick) {
+    
+    Frame *frame_pt;
+    Offset *offset_it;
+    Path *path_it;
+    long long int granularity, size;
+    int protocol_frame = is_protocol_active() ? num_frames - 1 : -1;
+    
+    // With macrotick only the times that are not rounded have to be exact, the periods and the pinned offsets
+    granularity = macrotick > 0 ? macrotick : 0;
+    for (int i = 0; i < num_frames; i++) {
+        frame_pt = &frames[i];
+        granularity = time_common_divisor(granularity, get_period(frame_pt));
+        offset_it = get_offset_root(frame_pt);
+        while (!is_last_offset(offset_it)) {
+            size = get_timeslot_size(offset_it);
+            if (is_frame_pinned(frame_pt)) {
+                for (int instance = 0; instance < get_number_instances(offset_it); instance++) {
+                    for (int replica = 0; replica <= get_number_replicas(offset_it); replica++) {
+                        granularity = time_common_divisor(granularity,
+                                                          get_offset(offset_it, instance, replica) - TIME_GRID_ORIGIN);
+                    }
+                }
+            }
+            // Without macrotick the limits of the constraints are multiple of the unit, the starting time, the
+            // deadline - transmission time and the end of the transmissions of other frames in the link
+            if (macrotick <= 0) {
+                granularity = time_common_divisor(granularity, size + time_between_frames);
+                if (i != protocol_frame && !is_frame_pinned(frame_pt)) {
+                    granularity = time_common_divisor(granularity, get_starting(frame_pt));
+                    granularity = time_common_divisor(granularity, get_deadline(frame_pt) - size);
+                }
+            }
+            offset_it = get_next_offset(offset_it);
+        }
+        
+        // And the hop delay in the next link of a path, and the end to end delay in the last link. The 1 ns that
+        // makes them strict is left out, as in the unit it is a whole unit
+        if (macrotick <= 0 && i != protocol_frame && !is_frame_pinned(frame_pt)) {
+            for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
+                path_it = get_path_root(frame_pt, path_id);
+                while (!is_last_path(path_it)) {
+                    size = get_timeslot_size(get_offset_from_path(path_it));
+                    path_it = get_next_path(path_it);
+                    if (!is_last_path(path_it)) {
+                        granularity = time_common_divisor(granularity, hop_delay + size);
+                    } else {
+                        granularity = time_common_divisor(granularity, get_end_to_end_delay(frame_pt) - size);
+                    }
+                }
+            }
+        }
+    }
+    if (granularity <= 1) {
+        return 1;
+    }
+    
+    // A strict margin of 1 ns takes a whole unit, so the unit is only used if every frame still fits in it
+    for (int i = 0; i < num_frames && macrotick <= 0; i++) {
+        if (i != protocol_frame && !is_frame_pinned(&frames[i]) && !is_granularity_exact(&frames[i], granularity)) {
+            printf("The frame %d does not fit in a time granularity of %lld ns, the solver uses 1 ns\n", i,
+                   granularity);
+            return 1;
+        }
+    }
+    return granularity;
+}
+
 /**
  Tells if the protocol for bandwitch allocation is active or not
  */
@@ -370,3 +777,27 @@ int is_protocol_active(void) {
     }
     return 1;
 }
+
+/**
+ Frees all the frames and links of the network and resets its parameters, so a new network can be loaded
+ */
+void free_network(void) {
+    
+    free_link_index();
+    free_topology();
+    for (int i = 0; i < num_frames; i++) {
+        free_frame(&frames[i]);
+    }
+    tracked_free(memory_model, frames);
+    tracked_free(memory_model, links);
+    frames = NULL;
+    links = NULL;
+    num_frames = 0;
+    num_links = 0;
+    hyperperiod = 0;
+    hop_delay = 0;
+    protocol_period = 0;
+    protocol_time = 0;
+    time_between_frames = 0;
+    network_initialized = 0;
+}
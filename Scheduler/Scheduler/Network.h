@@ -24,6 +24,8 @@
 
                                                 /* STRUCT DEFINITIONS */
 
+#define TIME_GRID_ORIGIN 1              // Transmission times of the scaled solver, 1 ns after a multiple of the unit
+
 
                                                 /* CODE DEFINITIONS */
 
@@ -34,6 +36,14 @@
  */
 int get_number_frames(void);
 
+/**
+ Get the number of frames of the network without the fake frame of the protocol, that is added when the network is
+ initialized
+
+ @return number of frames
+ */
+int get_number_network_frames(void);
+
 /**
  Set the number of frames in the network
 
@@ -49,6 +59,28 @@ void set_number_frames(int number_frames);
  */
 Frame * get_frame(int frame_id);
 
+/**
+ Get the number of links in the network
+
+ @return number of links in the network
+ */
+int get_number_links(void);
+
+/**
+ Get the number of nodes of the network, given by the biggest node identifier connected by a link
+
+ @return number of nodes, 0 if the links do not have their nodes
+ */
+int get_number_nodes(void);
+
+/**
+ Get the link pointer given the link id
+
+ @param link_id integer with the link identifier
+ @return pointer of the link
+ */
+Link * get_link(int link_id);
+
 /**
  Set the number of links in the network
 
@@ -77,6 +109,13 @@ void set_hop_delay(int hp);
  */
 void set_hyper_period(long long int hyper_period);
 
+/**
+ Get the hyperperiod of the network schedule
+
+ @return long long int with the hyperperiod in ns
+ */
+long long int get_hyper_period(void);
+
 /**
  Sets the parameters of the protocol
 
@@ -85,6 +124,20 @@ void set_hyper_period(long long int hyper_period);
  */
 void set_protocol_parameters(long long int period, long long int time);
 
+/**
+ Get the period of the protocol
+
+ @return long long integer with the period of the protocol in ns, 0 if there is no protocol
+ */
+long long int get_protocol_period(void);
+
+/**
+ Get the time reserved for the protocol every protocol period
+
+ @return long long integer with the time of the protocol in ns
+ */
+long long int get_protocol_time(void);
+
 /**
  Get the time between frames
 
@@ -109,6 +162,16 @@ void set_time_between_frames(long long int time);
  */
 int add_link(int link_id, int speed, LinkType link_type);
 
+/**
+ Add the nodes that a link of the link array connects
+
+ @param link_id index of the link
+ @param source identifier of the node that transmits in the link
+ @param destination identifier of the node that receives from the link
+ @return 0 if added correctly, -1 if out of index
+ */
+int add_link_nodes(int link_id, int source, int destination);
+
 /**
  Adds to the given index frame the general information of the period, deadline and size in the frame array
 
@@ -163,11 +226,87 @@ int add_num_splits(int frame_id, int num_splits);
  */
 int add_frame_split(int frame_id, int split_id, int *split, int len_split);
 
+/**
+ Adds a new empty frame at the end of the frame array, its information, paths and splits have to be added later.
+ It can only be done before the network is initialized
+
+ @return identifier of the new frame
+ */
+int append_frame(void);
+
+/**
+ Removes the last frame of the frame array, added with append_frame, freeing all its memory.
+ It can only be done before the network is initialized
+
+ @return 0 if correct, -1 if there are no frames or the network is initialized
+ */
+int remove_last_frame(void);
+
+/**
+ Removes the paths and splits of a frame, so it is not transmitted anymore. The frame keeps its identifier and its
+ information, so the identifiers of the rest of frames do not change
+
+ @param frame_id identifier of the frame
+ @return 0 if correct, -1 if the frame does not exist
+ */
+int remove_frame(int frame_id);
+
+/**
+ Replaces all the paths of a frame, keeping its information, to route it through other links. The splits of the frame
+ are removed, as they do not match the new paths
+
+ @param frame_id identifier of the frame
+ @param num_paths number of new paths
+ @param paths array with the links of every new path, from the sender to the receiver
+ @param len_paths array with the number of links of every new path
+ @return 0 if correct, -1 if the frame does not exist
+ */
+int set_frame_paths(int frame_id, int num_paths, int **paths, int *len_paths);
+
 /**
  Init all the needed variables in the network to start the scheduling, such as frame appearances, instances and similar
  */
 void initialize_network(void);
 
+/**
+ Returns the network, initialized to be scheduled, to its state before initialize_network: the frame of the protocol
+ is removed and the transmission times of all offsets are freed. Then the frames can be modified and the network can
+ be scheduled again
+ */
+void reset_network(void);
+
+/**
+ Creates the index of offsets by link, with all the offsets of all frames (including the protocol) that are
+ transmitted in every link. It has to be called again every time the paths of the frames change
+ */
+void index_link_offsets(void);
+
+/**
+ Get the number of offsets transmitted in the given link
+
+ @param link_id identifier of the link
+ @return number of offsets of all frames transmitted in the link
+ */
+int get_link_number_offsets(int link_id);
+
+/**
+ Get the offset in the given position of the offsets transmitted in the given link
+
+ @param link_id identifier of the link
+ @param index position of the offset in the link (from 0 to the number of offsets in the link - 1)
+ @return pointer to the offset
+ */
+Offset * get_link_offset(int link_id, int index);
+
+/**
+ Get the frame identifier of the offset in the given position of the offsets transmitted in the given link
+
+ @param link_id identifier of the link
+ @param index position of the offset in the link (from 0 to the number of offsets in the link - 1)
+ @return identifier of the frame
+ */
+int get_link_offset_frame(int link_id, int index);
+
 /**
  Check if the schedule stored is correct and satisfies all the constraints
 
@@ -175,9 +314,32 @@ void initialize_network(void);
  */
 int check_schedule_correctness(void);
 
+/**
+ Calculates the time granularity of the network once it is initialized, the time unit in which the solver searches the
+ transmission times, TIME_GRID_ORIGIN ns after a multiple of it (as the protocol, that transmits 1 ns after its period).
+ Without macrotick it is the greatest common divisor of the limits of the constraints that are not strict: the
+ periods, the starting time and the deadline - transmission time of every offset, the transmission time + time between
+ frames, the hop delay + transmission time between the links of a path, and the end to end delay - transmission time of
+ the last link. The 1 ns that makes a limit strict becomes a whole unit in the solver, so the unit is only used if the
+ fastest transmission of every path still fits in it, otherwise it is 1 and a message tells which frame does not fit.
+ Frames packed closer than a unit in ns can still need the 1 ns, so the scheduler searches again in ns when it finds
+ no schedule in the unit (see schedule_network), and no schedule is lost. With a macrotick, only the periods have to be
+ multiple of it and the rest of limits are rounded conservatively, so every schedule found is correct but some
+ schedules can be lost. The transmission times of the frames pinned to a previous schedule are always kept exact
+
+ @param macrotick time unit in ns wanted for the solver, 0 to use the greatest common granularity of the network
+ @return time granularity in ns, 1 if the times do not share any divisor or a frame does not fit in it
+ */
+long long int get_time_granularity(long long int macrotick);
+
 /**
  Tells if the protocol for bandwitch allocation is active or not
 
  @return 1 if active, 0 if not
  */
 int is_protocol_active(void);
+
+/**
+ Frees all the frames, links and nodes of the network and resets its parameters, so a new network can be loaded
+ */
+void free_network(void);
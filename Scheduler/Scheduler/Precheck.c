@@ -0,0 +1,174 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Precheck.c                                                                                                         *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Precheck.h                                                                                          *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Precheck.h"
+#include <stdlib.h>
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Compares two link loads by utilization, from the most to the least loaded
+
+ @param a pointer to the first load
+ @param b pointer to the second load
+ @return negative, 0 or positive if the first load goes before, with or after the second
+ */
+int compare_link_loads(const void *a, const void *b) {
+    
+    const LinkLoad *load_a = a, *load_b = b;
+    
+    if (load_a->utilization != load_b->utilization) {
+        return load_a->utilization < load_b->utilization ? 1 : -1;
+    }
+    return load_a->link - load_b->link;
+}
+
+/**
+ Calculates the load of every link in the hyperperiod with all the offsets transmitted in it
+
+ @param loads array where the load of every link is saved
+ */
+void calculate_link_loads(LinkLoad *loads) {
+    
+    Offset *offset_pt;
+    long long int transmissions;
+    
+    for (int i = 0; i < get_number_links(); i++) {
+        loads[i].link = i;
+        loads[i].num_frames = get_link_number_offsets(i);
+        loads[i].transmissions = 0;
+        loads[i].busy = 0;
+        for (int j = 0; j < loads[i].num_frames; j++) {
+            offset_pt = get_link_offset(i, j);
+            transmissions = (long long int) get_number_instances(offset_pt) * (get_number_replicas(offset_pt) + 1);
+            loads[i].transmissions += transmissions;
+            loads[i].busy += transmissions * get_timeslot_size(offset_pt);
+        }
+        // The time between frames separates every two consecutive transmissions
+        if (loads[i].transmissions > 0) {
+            loads[i].busy += (loads[i].transmissions - 1) * get_time_between_frames();
+        }
+        loads[i].utilization = (double) loads[i].busy / get_hyper_period();
+    }
+}
+
+/**
+ Calculates the minimum latency of a path, from the start of its first transmission to the end of the last one
+
+ @param frame_pt pointer to the frame
+ @param path_id identifier of the path
+ @return minimum latency in ns
+ */
+long long int get_minimum_latency(Frame *frame_pt, int path_id) {
+    
+    Path *path_it;
+    long long int latency = 0;
+    
+    path_it = get_path_root(frame_pt, path_id);
+    while (!is_last_path(path_it)) {
+        latency += get_timeslot_size(get_offset_from_path(path_it));
+        path_it = get_next_path(path_it);
+        // As in the path dependent constraints, the next link starts after the hop delay and one more ns
+        if (!is_last_path(path_it)) {
+            latency += get_hop_delay() + 1;
+        }
+    }
+    return latency;
+}
+
+/**
+ Prints the utilization of the most loaded links and the summary of all the links used
+
+ @param loads array with the load of every link, it is sorted by utilization
+ */
+void print_utilization_table(LinkLoad *loads) {
+    
+    int num_used = 0;
+    double total = 0;
+    
+    qsort(loads, get_number_links(), sizeof(LinkLoad), compare_link_loads);
+    for (int i = 0; i < get_number_links(); i++) {
+        if (loads[i].transmissions > 0) {
+            num_used++;
+            total += loads[i].utilization;
+        }
+    }
+    printf("Utilization of the most loaded links (time between frames and protocol included):\n");
+    printf("  %8s %8s %14s %16s %12s\n", "Link", "Frames", "Transmissions", "Busy ns", "Utilization");
+    for (int i = 0; i < num_used && i < PRECHECK_TABLE_LINKS; i++) {
+        printf("  %8d %8d %14lld %16lld %11.2f%%\n", loads[i].link, loads[i].num_frames, loads[i].transmissions,
+               loads[i].busy, loads[i].utilization * 100);
+    }
+    printf("Links used => %d of %d, average utilization => %.2f%%, maximum utilization => %.2f%%\n", num_used,
+           get_number_links(), num_used > 0 ? total / num_used * 100 : 0,
+           num_used > 0 ? loads[0].utilization * 100 : 0);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Checks the necessary conditions of any schedule of the initialized network
+ */
+int precheck_network(int print_table) {
+    
+    LinkLoad *loads;
+    Frame *frame_pt;
+    long long int latency;
+    int num_frames, num_violations = 0;
+    
+    // Every link has to fit all its transmissions in the hyperperiod
+    loads = malloc(sizeof(LinkLoad) * (get_number_links() + 1));
+    calculate_link_loads(loads);
+    for (int i = 0; i < get_number_links(); i++) {
+        if (loads[i].busy > get_hyper_period()) {
+            if (num_violations < PRECHECK_REPORTED) {
+                printf("Link %d needs %lld ns for %lld transmissions of %d frames, more than the hyperperiod of %lld "
+                       "ns (%.2f%%)\n", i, loads[i].busy, loads[i].transmissions, loads[i].num_frames,
+                       get_hyper_period(), loads[i].utilization * 100);
+            }
+            num_violations++;
+        }
+    }
+    
+    // Every path has to fit its minimum latency within its end to end delay, that the solver does not reach, and in
+    // the window of its frame, as the first transmission starts at least 1 ns after the starting time
+    num_frames = is_protocol_active() == 1 ? get_number_frames() - 1 : get_number_frames();
+    for (int i = 0; i < num_frames; i++) {
+        frame_pt = get_frame(i);
+        for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
+            latency = get_minimum_latency(frame_pt, path_id);
+            if (latency >= get_end_to_end_delay(frame_pt)) {
+                if (num_violations < PRECHECK_REPORTED) {
+                    printf("Frame %d needs at least %lld ns in path %d, not less than its end to end delay of %lld "
+                           "ns\n", i, latency, path_id, get_end_to_end_delay(frame_pt));
+                }
+                num_violations++;
+            } else if (get_starting(frame_pt) + latency >= get_deadline(frame_pt)) {
+                if (num_violations < PRECHECK_REPORTED) {
+                    printf("Frame %d needs at least %lld ns in path %d after its starting time, not less than the "
+                           "%lld ns to its deadline\n", i, latency, path_id,
+                           get_deadline(frame_pt) - get_starting(frame_pt));
+                }
+                num_violations++;
+            }
+        }
+    }
+    if (num_violations > PRECHECK_REPORTED) {
+        printf("And %d more links and paths that cannot be scheduled\n", num_violations - PRECHECK_REPORTED);
+    }
+    
+    if (print_table) {
+        print_utilization_table(loads);
+    }
+    free(loads);
+    return num_violations;
+}
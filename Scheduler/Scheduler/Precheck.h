@@ -0,0 +1,54 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Precheck.h                                                                                                         *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that checks necessary conditions of any schedule of the initialized network before the solver is used, so  *
+ *  the networks that obviously cannot be scheduled fail in milliseconds instead of after minutes of solving.          *
+ *  Every link has to fit all the transmissions of all the frames (and the protocol) in the hyperperiod, with the time *
+ *  between frames after every transmission but the last one, as the validator requires. And every path of a frame has *
+ *  to fit its minimum latency, the transmission time of every link plus the hop delay between two links, strictly     *
+ *  within its end to end delay and between its starting time and deadline, as the solver bounds them.                 *
+ *  The offending links and frames are reported, and a table with the utilization of the most loaded links is printed  *
+ *  when asked, even if the network passes.                                                                            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Precheck_h
+#define Precheck_h
+
+#include <stdio.h>
+#include "Network.h"
+
+#endif /* Precheck_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define PRECHECK_TABLE_LINKS 10         // Most loaded links printed in the utilization table
+#define PRECHECK_REPORTED 20            // Offending links and frames printed, the rest are only counted
+
+/**
+ Load of a link in the hyperperiod
+ */
+typedef struct LinkLoad {
+    int link;                           // Identifier of the link
+    int num_frames;                     // Frames transmitted in the link, the protocol included
+    long long int transmissions;        // Transmissions of all instances and replicas in the hyperperiod
+    long long int busy;                 // Time in ns of the transmissions plus the time between frames
+    double utilization;                 // Busy time as a fraction of the hyperperiod
+}LinkLoad;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Checks the necessary conditions of any schedule of the network, that has to be initialized. Every link whose
+ transmissions do not fit in the hyperperiod and every path whose minimum latency is not less than the end to end
+ delay or the time between the starting time and deadline of its frame is printed
+
+ @param print_table 1 to also print the utilization of the most loaded links, 0 otherwise
+ @return number of links and paths that cannot be scheduled, 0 if the network passes
+ */
+int precheck_network(int print_table);
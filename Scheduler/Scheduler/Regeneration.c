@@ -0,0 +1,301 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Regeneration.c                                                                                                     *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Regeneration.h                                                                                      *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Regeneration.h"
+#include "Network.h"
+#include "CompactSchedule.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+                                                    /* VARIABLES */
+
+PathRanking reroute_ranking = rank_hops;    // Criteria to choose the new paths of the affected frames
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Tells if a frame has another path equal to the given one
+
+ @param paths array with the links of every path of the frame
+ @param len_paths array with the number of links of every path
+ @param num_paths number of paths of the frame
+ @param path_id identifier of the path to compare with the rest
+ @param path array with the links of the path
+ @param length number of links of the path
+ @return 1 if another path is equal, 0 otherwise
+ */
+int is_path_repeated(int **paths, int *len_paths, int num_paths, int path_id, int *path, int length) {
+    
+    for (int i = 0; i < num_paths; i++) {
+        if (i != path_id && len_paths[i] == length && memcmp(paths[i], path, sizeof(int) * length) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Reroutes the paths of a frame that use a failed link through the best path between the same nodes, the rest of
+ paths of the frame are kept. A frame with several paths gets different paths while there are enough alternatives
+
+ @param frame_id identifier of the frame
+ @return 0 if all the paths were rerouted, -1 if any path has no alternative (the frame is not changed)
+ */
+int reroute_frame(int frame_id) {
+    
+    Frame *frame_pt = get_frame(frame_id);
+    Path *path_it;
+    PathSet *alternatives;
+    int num_paths = get_num_paths(frame_pt);
+    int **paths, *len_paths, *failed, *alternative, status = 0, first, last, chosen, length;
+    
+    paths = malloc(sizeof(int *) * num_paths);
+    len_paths = malloc(sizeof(int) * num_paths);
+    failed = calloc(num_paths, sizeof(int));
+    for (int i = 0; i < num_paths; i++) {
+        paths[i] = malloc(sizeof(int) * (get_number_topology_nodes() + get_number_links() + 1));
+        len_paths[i] = 0;
+        for (path_it = get_path_root(frame_pt, i); !is_last_path(path_it); path_it = get_next_path(path_it)) {
+            paths[i][len_paths[i]++] = path_it->link;
+            failed[i] |= is_link_failed(get_link(path_it->link));
+        }
+    }
+    
+    // Every failed path takes the best alternative that is not already a path of the frame
+    for (int i = 0; i < num_paths && status == 0; i++) {
+        if (!failed[i] || len_paths[i] == 0) {
+            continue;
+        }
+        first = get_link_source(get_link(paths[i][0]));
+        last = get_link_destination(get_link(paths[i][len_paths[i] - 1]));
+        alternatives = get_k_shortest_paths(first, last, num_paths, reroute_ranking);
+        if (alternatives == NULL || alternatives->num_paths == 0) {
+            status = -1;
+            continue;
+        }
+        chosen = 0;
+        for (int j = 0; j < alternatives->num_paths; j++) {
+            alternative = &alternatives->links[alternatives->starts[j]];
+            length = alternatives->starts[j + 1] - alternatives->starts[j];
+            if (!is_path_repeated(paths, len_paths, num_paths, i, alternative, length)) {
+                chosen = j;
+                break;
+            }
+        }
+        len_paths[i] = alternatives->starts[chosen + 1] - alternatives->starts[chosen];
+        memcpy(paths[i], &alternatives->links[alternatives->starts[chosen]], sizeof(int) * len_paths[i]);
+    }
+    
+    if (status == 0) {
+        set_frame_paths(frame_id, num_paths, paths, len_paths);
+    }
+    for (int i = 0; i < num_paths; i++) {
+        free(paths[i]);
+    }
+    free(paths);
+    free(len_paths);
+    free(failed);
+    return status;
+}
+
+/**
+ Checks that the links exist, are not repeated and have not failed yet
+
+ @param num_links number of failed links
+ @param link_ids identifiers of the failed links
+ @return 0 if correct, -1 otherwise
+ */
+int check_failed_links(int num_links, int *link_ids) {
+    
+    for (int i = 0; i < num_links; i++) {
+        if (link_ids[i] < 0 || link_ids[i] >= get_number_links() || is_link_failed(get_link(link_ids[i]))) {
+            printf("The link %d does not exist or it had already failed\n", link_ids[i]);
+            return -1;
+        }
+        for (int j = 0; j < i; j++) {
+            if (link_ids[j] == link_ids[i]) {
+                printf("The link %d is repeated\n", link_ids[i]);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ Marks the links as failed
+
+ @param num_links number of failed links
+ @param link_ids identifiers of the failed links
+ */
+void fail_links(int num_links, int *link_ids) {
+    
+    for (int i = 0; i < num_links; i++) {
+        set_link_failed(get_link(link_ids[i]), 1);
+    }
+    invalidate_topology_paths();
+}
+
+/**
+ Reroutes the affected frames of the result through the shortest paths that avoid the failed links, the frames that
+ cannot be rerouted are removed from the network and added to the lost frames of the result
+
+ @param result pointer to the result with the affected frames
+ */
+void reroute_affected_frames(RegenerationResult *result) {
+    
+    for (int i = 0; i < result->num_affected; i++) {
+        if (reroute_frame(result->affected_frames[i]) == -1) {
+            remove_frame(result->affected_frames[i]);
+            result->lost_frames[result->num_lost++] = result->affected_frames[i];
+        }
+    }
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Sets the criteria to choose the new paths of the frames affected by a failure
+ */
+void set_reroute_ranking(PathRanking ranking) {
+    
+    reroute_ranking = ranking;
+}
+
+/**
+ Marks the link as failed in the network in memory and reroutes the frames transmitted in it
+ */
+int reroute_link_failure(int link_id, RegenerationResult *result) {
+    
+    return reroute_links_failure(1, &link_id, result);
+}
+
+/**
+ Marks the links as failed in the network in memory and reroutes the frames transmitted in any of them
+ */
+int reroute_links_failure(int num_links, int *link_ids, RegenerationResult *result) {
+    
+    struct timeval start_time, end_time;
+    
+    memset(result, 0, sizeof(RegenerationResult));
+    if (check_failed_links(num_links, link_ids) == -1) {
+        return -1;
+    }
+    gettimeofday(&start_time, NULL);
+    fail_links(num_links, link_ids);
+    result->affected_frames = malloc(sizeof(int) * (get_number_frames() + 1));
+    result->lost_frames = malloc(sizeof(int) * (get_number_frames() + 1));
+    
+    // The network is not initialized, so the index of offsets by link does not exist
+    for (int i = 0; i < get_number_frames(); i++) {
+        for (int j = 0; j < num_links; j++) {
+            if (get_frame_offset_by_link(get_frame(i), link_ids[j]) != NULL) {
+                result->affected_frames[result->num_affected++] = i;
+                break;
+            }
+        }
+    }
+    reroute_affected_frames(result);
+    
+    gettimeofday(&end_time, NULL);
+    result->reroute_time = time_diff(start_time, end_time);
+    result->recovery_time = result->reroute_time;
+    return 0;
+}
+
+/**
+ Regenerates the schedule of the scheduled network in memory after the permanent failure of a link
+ */
+int regenerate_link_failure(int link_id, SchedulerOptions *options, RegenerationResult *result) {
+    
+    return regenerate_links_failure(1, &link_id, options, result);
+}
+
+/**
+ Regenerates the schedule of the scheduled network in memory after the permanent failure of several links
+ */
+int regenerate_links_failure(int num_links, int *link_ids, SchedulerOptions *options, RegenerationResult *result) {
+    
+    SchedulerOptions regeneration_options;
+    CompactSchedule *previous;
+    struct timeval start_time, end_time;
+    char *affected;
+    int status, num_frames, frame_id;
+    
+    memset(result, 0, sizeof(RegenerationResult));
+    if (check_failed_links(num_links, link_ids) == -1) {
+        return -1;
+    }
+    gettimeofday(&start_time, NULL);
+    
+    // Keep the schedule before the failure, then find the affected frames with the index of offsets by link
+    previous = build_compact_schedule();
+    num_frames = get_number_network_frames();
+    affected = calloc(num_frames + 1, sizeof(char));
+    result->affected_frames = malloc(sizeof(int) * (num_frames + 1));
+    result->lost_frames = malloc(sizeof(int) * (num_frames + 1));
+    for (int i = 0; i < num_links; i++) {
+        for (int j = 0; j < get_link_number_offsets(link_ids[i]); j++) {
+            frame_id = get_link_offset_frame(link_ids[i], j);
+            if (frame_id < num_frames && !affected[frame_id]) {     // The frame of the protocol is not rerouted
+                affected[frame_id] = 1;
+                result->affected_frames[result->num_affected++] = frame_id;
+            }
+        }
+    }
+    free(affected);
+    
+    // Reroute the affected frames in the network returned to its state before the scheduling
+    reset_network();
+    fail_links(num_links, link_ids);
+    reroute_affected_frames(result);
+    gettimeofday(&end_time, NULL);
+    result->reroute_time = time_diff(start_time, end_time);
+    
+    // Schedule only the affected frames, the rest keep the offsets of the schedule before the failure
+    if (options == NULL) {
+        init_scheduler_options(&regeneration_options);
+    } else {
+        regeneration_options = *options;
+    }
+    regeneration_options.previous_schedule = NULL;
+    regeneration_options.previous_compact = previous;
+    regeneration_options.movable_frames = result->affected_frames;
+    regeneration_options.num_movable_frames = result->num_affected;
+    regeneration_options.movable_links = NULL;
+    regeneration_options.num_movable_links = 0;
+    status = schedule_network(&regeneration_options);
+    free_compact_schedule(previous);
+    
+    gettimeofday(&end_time, NULL);
+    result->recovery_time = time_diff(start_time, end_time);
+    result->schedule_time = result->recovery_time - result->reroute_time;
+    if (status == -1) {
+        reset_network();
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Frees the arrays of a regeneration result
+ */
+void free_regeneration_result(RegenerationResult *result) {
+    
+    free(result->affected_frames);
+    free(result->lost_frames);
+    result->affected_frames = NULL;
+    result->lost_frames = NULL;
+    result->num_affected = 0;
+    result->num_lost = 0;
+}
@@ -0,0 +1,107 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Regeneration.h                                                                                                     *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that regenerates the schedule of the network in memory after a permanent link failure.                     *
+ *  The frames affected are found with the index of offsets by link. Their paths that use a failed link are rerouted   *
+ *  through the best path between the same nodes that avoids the failed links (see Topology.h, ranked by hops unless   *
+ *  set otherwise), and the frames that have no such path are removed from the network. Then only the affected frames  *
+ *  are scheduled again, while the rest of frames are pinned to their offsets in the schedule before the failure, so   *
+ *  the nodes not affected keep their configuration. The time to recover, from the failure until the new schedule is   *
+ *  found, is measured.                                                                                                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Regeneration_h
+#define Regeneration_h
+
+#include <stdio.h>
+#include "Synthesizer.h"
+#include "Topology.h"
+
+#endif /* Regeneration_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Result of regenerating the schedule after a link failure
+ */
+typedef struct RegenerationResult {
+    int num_affected;                   // Number of frames that were transmitted in the failed link
+    int *affected_frames;               // Identifiers of the affected frames
+    int num_lost;                       // Number of affected frames without any path that avoids the failed links
+    int *lost_frames;                   // Identifiers of the lost frames, they are removed from the network
+    double reroute_time;                // Time in ms to find the new paths of the affected frames
+    double schedule_time;               // Time in ms to schedule the affected frames
+    double recovery_time;               // Time in ms from the failure until the new schedule is found
+}RegenerationResult;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Sets the criteria to choose the new paths of the frames affected by a failure, by hops if not set
+
+ @param ranking criteria to rank the paths
+ */
+void set_reroute_ranking(PathRanking ranking);
+
+/**
+ Marks the link as failed in the network in memory, not initialized for the scheduling, and reroutes the frames
+ transmitted in it through the best paths that avoid all failed links. The frames without such paths are removed
+
+ @param link_id identifier of the failed link
+ @param result pointer where the affected and lost frames and the reroute time are saved. It has to be freed with
+ free_regeneration_result
+ @return 0 if done correctly, -1 if the link does not exist or it had already failed
+ */
+int reroute_link_failure(int link_id, RegenerationResult *result);
+
+/**
+ Marks several links as failed at the same time in the network in memory, not initialized for the scheduling, and
+ reroutes the frames transmitted in any of them, as reroute_link_failure. The links of a failed node fail together
+
+ @param num_links number of failed links
+ @param link_ids identifiers of the failed links
+ @param result pointer where the affected and lost frames and the reroute time are saved. It has to be freed with
+ free_regeneration_result
+ @return 0 if done correctly, -1 if any link does not exist, it had already failed or it is repeated
+ */
+int reroute_links_failure(int num_links, int *link_ids, RegenerationResult *result);
+
+/**
+ Regenerates the schedule of the scheduled network in memory after the permanent failure of a link. The affected
+ frames are rerouted and scheduled again, the rest of frames keep their offsets. If no schedule is found for the
+ affected frames, the network is left not initialized (with the frames rerouted) to be scheduled again from scratch
+
+ @param link_id identifier of the failed link
+ @param options pointer to the options of the scheduler, NULL to use the default ones. The previous schedule and the
+ movable frames of the options are replaced by the schedule before the failure and the affected frames
+ @param result pointer where the affected and lost frames and the times are saved. It has to be freed with
+ free_regeneration_result
+ @return 0 if the new schedule was found, -1 otherwise
+ */
+int regenerate_link_failure(int link_id, SchedulerOptions *options, RegenerationResult *result);
+
+/**
+ Regenerates the schedule of the scheduled network in memory after the permanent failure of several links at the same
+ time, as regenerate_link_failure
+
+ @param num_links number of failed links
+ @param link_ids identifiers of the failed links
+ @param options pointer to the options of the scheduler, NULL to use the default ones
+ @param result pointer where the affected and lost frames and the times are saved. It has to be freed with
+ free_regeneration_result
+ @return 0 if the new schedule was found, -1 otherwise
+ */
+int regenerate_links_failure(int num_links, int *link_ids, SchedulerOptions *options, RegenerationResult *result);
+
+/**
+ Frees the arrays of a regeneration result
+
+ @param result pointer to the result
+ */
+void free_regeneration_result(RegenerationResult *result);
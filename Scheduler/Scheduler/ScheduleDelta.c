@@ -0,0 +1,487 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  ScheduleDelta.c                                                                                                    *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in ScheduleDelta.h                                                                                     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ScheduleDelta.h"
+#include "BinaryNetwork.h"
+#include <stdlib.h>
+#include <string.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Growable buffer where a delta is encoded
+ */
+typedef struct DeltaBuffer {
+    unsigned char *data;                // Encoded bytes
+    size_t length;                      // Number of encoded bytes
+    size_t size;                        // Allocated size of the buffer
+    size_t position;                    // Position of the next byte to decode
+}DeltaBuffer;
+
+/**
+ Delta of a node (or of a link with unknown source)
+ */
+typedef struct DeltaUnit {
+    int node;                           // Node of the delta, -1 if it is the delta of a link with unknown source
+    int link;                           // Link of the delta if the node is unknown
+    int num_records;                    // Number of records in the delta
+    int last_frame;                     // Frame of the last record encoded, the next frame is encoded as difference
+    DeltaBuffer buffer;                 // Encoded records
+}DeltaUnit;
+
+                                                    /* VARIABLES */
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Appends an unsigned integer to a delta buffer, encoded with 7 bits per byte and the highest bit set when more bytes
+ follow
+
+ @param buffer pointer to the delta buffer
+ @param value value to encode
+ */
+void append_varint(DeltaBuffer *buffer, uint64_t value) {
+    
+    if (buffer->size - buffer->length < 10) {
+        buffer->size = buffer->size * 2 + 256;
+        buffer->data = realloc(buffer->data, buffer->size);
+    }
+    while (value >= 0x80) {
+        buffer->data[buffer->length++] = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    buffer->data[buffer->length++] = (unsigned char) value;
+}
+
+/**
+ Appends a signed integer to a delta buffer, small absolute values are encoded in few bytes (zigzag encoding)
+
+ @param buffer pointer to the delta buffer
+ @param value value to encode
+ */
+void append_signed_varint(DeltaBuffer *buffer, int64_t value) {
+    
+    append_varint(buffer, ((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+}
+
+/**
+ Reads an unsigned integer from a delta buffer
+
+ @param buffer pointer to the delta buffer
+ @param value pointer where to save the value
+ @return 0 if read correctly, -1 if the buffer ends before the value
+ */
+int read_varint(DeltaBuffer *buffer, uint64_t *value) {
+    
+    int shift = 0;
+    
+    *value = 0;
+    while (buffer->position < buffer->length && shift < 64) {
+        *value |= (uint64_t) (buffer->data[buffer->position] & 0x7F) << shift;
+        if ((buffer->data[buffer->position++] & 0x80) == 0) {
+            return 0;
+        }
+        shift += 7;
+    }
+    return -1;
+}
+
+/**
+ Reads a signed integer from a delta buffer
+
+ @param buffer pointer to the delta buffer
+ @param value pointer where to save the value
+ @return 0 if read correctly, -1 if the buffer ends before the value
+ */
+int read_signed_varint(DeltaBuffer *buffer, int64_t *value) {
+    
+    uint64_t encoded;
+    
+    if (read_varint(buffer, &encoded) == -1) {
+        return -1;
+    }
+    *value = (int64_t) (encoded >> 1) ^ -(int64_t) (encoded & 1);
+    return 0;
+}
+
+/**
+ Compares the frame and link of two records
+
+ @param a pointer to the first record
+ @param b pointer to the second record
+ @return negative, 0 or positive if the first record is smaller, equal or bigger
+ */
+int compare_delta_records(const ScheduleRecord *a, const ScheduleRecord *b) {
+    
+    if (a->frame != b->frame) {
+        return a->frame < b->frame ? -1 : 1;
+    }
+    if (a->link != b->link) {
+        return a->link < b->link ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Tells if two records transmit in the same way, only their base offsets can be different
+
+ @param a pointer to the first record
+ @param b pointer to the second record
+ @return 1 if they have the same period, timeslot, instances and replicas, 0 otherwise
+ */
+int same_record_shape(const ScheduleRecord *a, const ScheduleRecord *b) {
+    
+    return a->period == b->period && a->timeslot_size == b->timeslot_size && a->instances == b->instances &&
+           a->replicas == b->replicas;
+}
+
+/**
+ Encodes a record into the delta of its unit
+
+ @param unit pointer to the delta unit
+ @param operation operation of the record
+ @param schedule compact schedule of the record (the new one, or the previous one if it is removed)
+ @param record pointer to the record
+ @param previous previous compact schedule, to encode changed offsets as differences
+ @param previous_record pointer to the previous record if the operation is changed
+ */
+void encode_delta_record(DeltaUnit *unit, DeltaOperation operation, CompactSchedule *schedule,
+                         ScheduleRecord *record, CompactSchedule *previous, ScheduleRecord *previous_record) {
+    
+    append_varint(&unit->buffer, (uint64_t) (record->frame - unit->last_frame));
+    append_varint(&unit->buffer, (uint64_t) record->link);
+    append_varint(&unit->buffer, (uint64_t) operation);
+    if (operation == delta_changed) {
+        for (int r = 0; r <= record->replicas; r++) {
+            append_signed_varint(&unit->buffer, schedule->base_offsets[record->first_offset + r] -
+                                 previous->base_offsets[previous_record->first_offset + r]);
+        }
+    } else if (operation == delta_added) {
+        append_varint(&unit->buffer, (uint64_t) record->period);
+        append_varint(&unit->buffer, (uint64_t) record->timeslot_size);
+        append_varint(&unit->buffer, (uint64_t) record->instances);
+        append_varint(&unit->buffer, (uint64_t) record->replicas);
+        for (int r = 0; r <= record->replicas; r++) {
+            append_signed_varint(&unit->buffer, schedule->base_offsets[record->first_offset + r]);
+        }
+    }
+    unit->last_frame = record->frame;
+    unit->num_records++;
+}
+
+/**
+ Adds a record at the end of a compact schedule that is being built
+
+ @param schedule pointer to the compact schedule
+ @param max_records pointer to the number of records that fit in the schedule
+ @param max_offsets pointer to the number of base offsets that fit in the schedule
+ @param record pointer to the record to copy
+ @param base_offsets base offsets of the record
+ */
+void append_schedule_record(CompactSchedule *schedule, int *max_records, long long int *max_offsets,
+                            ScheduleRecord *record, int64_t *base_offsets) {
+    
+    if (schedule->num_records == *max_records) {
+        *max_records = *max_records * 2 + 64;
+        schedule->records = realloc(schedule->records, sizeof(ScheduleRecord) * *max_records);
+    }
+    while (schedule->num_offsets + record->replicas + 1 > *max_offsets) {
+        *max_offsets = *max_offsets * 2 + 64;
+        schedule->base_offsets = realloc(schedule->base_offsets, sizeof(int64_t) * *max_offsets);
+    }
+    schedule->records[schedule->num_records] = *record;
+    schedule->records[schedule->num_records].first_offset = (uint32_t) schedule->num_offsets;
+    memcpy(&schedule->base_offsets[schedule->num_offsets], base_offsets, sizeof(int64_t) * (record->replicas + 1));
+    schedule->num_offsets += record->replicas + 1;
+    schedule->num_records++;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Writes the delta between the previous schedule and the new one in one file per node that has changes
+ */
+long long int write_schedule_delta(CompactSchedule *previous, CompactSchedule *current, char *prefix) {
+    
+    DeltaUnit *units;
+    DeltaBuffer header;
+    int *link_units;                    // Unit of every link
+    int *node_units = NULL;             // Unit of every node
+    int num_units = 0, max_node = -1, node, i = 0, j = 0, changed, removed, status = 0;
+    ScheduleRecord *record;
+    FILE *file;
+    char *namefile;
+    uint32_t crc;
+    long long int total_bytes = 0;
+    
+    // Every node is a unit, and every link with unknown source is its own unit
+    link_units = malloc(sizeof(int) * (get_number_links() + 1));
+    units = calloc(get_number_links() + 1, sizeof(DeltaUnit));
+    for (int l = 0; l < get_number_links(); l++) {
+        if (get_link_source(get_link(l)) > max_node) {
+            max_node = get_link_source(get_link(l));
+        }
+    }
+    node_units = malloc(sizeof(int) * (max_node + 2));
+    for (int n = 0; n <= max_node; n++) {
+        node_units[n] = -1;
+    }
+    for (int l = 0; l < get_number_links(); l++) {
+        node = get_link_source(get_link(l));
+        if (node >= 0 && node_units[node] != -1) {
+            link_units[l] = node_units[node];
+            continue;
+        }
+        units[num_units].node = node;
+        units[num_units].link = l;
+        link_units[l] = num_units;
+        if (node >= 0) {
+            node_units[node] = num_units;
+        }
+        num_units++;
+    }
+    
+    // Both schedules are sorted by frame and link, so they are compared by merging them
+    while (status == 0 && (i < previous->num_records || j < current->num_records)) {
+        // Flag instead of comparing the record pointers, both schedules can be the same
+        removed = j == current->num_records ||
+                  (i < previous->num_records && compare_delta_records(&previous->records[i], &current->records[j]) < 0);
+        record = removed ? &previous->records[i] : &current->records[j];
+        if (record->link < 0 || record->link >= get_number_links()) {
+            printf("The link %d of the schedule does not exist in the network\n", record->link);
+            status = -1;
+            break;
+        }
+        
+        if (removed) {
+            encode_delta_record(&units[link_units[record->link]], delta_removed, previous, record, NULL, NULL);
+            i++;
+        } else if (i == previous->num_records ||
+                   compare_delta_records(&previous->records[i], &current->records[j]) != 0) {
+            encode_delta_record(&units[link_units[record->link]], delta_added, current, record, NULL, NULL);
+            j++;
+        } else {
+            if (!same_record_shape(&previous->records[i], record)) {
+                encode_delta_record(&units[link_units[record->link]], delta_added, current, record, NULL, NULL);
+            } else {
+                changed = 0;
+                for (int r = 0; r <= record->replicas; r++) {
+                    if (current->base_offsets[record->first_offset + r] !=
+                        previous->base_offsets[previous->records[i].first_offset + r]) {
+                        changed = 1;
+                    }
+                }
+                if (changed) {
+                    encode_delta_record(&units[link_units[record->link]], delta_changed, current, record, previous,
+                                        &previous->records[i]);
+                }
+            }
+            i++;
+            j++;
+        }
+    }
+    
+    // Write the units with changes, with a header with the node and the number of records, and the checksum
+    namefile = malloc(strlen(prefix) + 32);
+    memset(&header, 0, sizeof(DeltaBuffer));
+    for (int u = 0; u < num_units && status == 0; u++) {
+        if (units[u].num_records == 0) {
+            continue;
+        }
+        header.length = 0;
+        append_varint(&header, SCHEDULE_DELTA_VERSION);
+        append_varint(&header, (uint64_t) (units[u].node + 1));
+        if (units[u].node == -1) {
+            append_varint(&header, (uint64_t) units[u].link);
+            sprintf(namefile, "%slink_%d.delta", prefix, units[u].link);
+        } else {
+            sprintf(namefile, "%snode_%d.delta", prefix, units[u].node);
+        }
+        append_varint(&header, (uint64_t) units[u].num_records);
+        crc = update_crc32(0, header.data, header.length);
+        crc = update_crc32(crc, units[u].buffer.data, units[u].buffer.length);
+        
+        file = fopen(namefile, "wb");
+        if (file == NULL || fwrite(SCHEDULE_DELTA_MAGIC, 4, 1, file) != 1 ||
+            fwrite(header.data, header.length, 1, file) != 1 ||
+            fwrite(units[u].buffer.data, units[u].buffer.length, 1, file) != 1 ||
+            fwrite(&crc, sizeof(uint32_t), 1, file) != 1) {
+            printf("The delta file %s could not be written\n", namefile);
+            status = -1;
+        }
+        if (file != NULL) {
+            fclose(file);
+        }
+        total_bytes += 4 + header.length + units[u].buffer.length + sizeof(uint32_t);
+        printf("Delta of %s: %d records in %zu bytes\n", namefile, units[u].num_records,
+               4 + header.length + units[u].buffer.length + sizeof(uint32_t));
+    }
+    
+    for (int u = 0; u < num_units; u++) {
+        free(units[u].buffer.data);
+    }
+    free(units);
+    free(header.data);
+    free(namefile);
+    free(link_units);
+    free(node_units);
+    
+    if (status != 0) {
+        return -1;
+    }
+    return total_bytes;
+}
+
+/**
+ Applies a delta file to the previous schedule of a node and returns the new schedule
+ */
+CompactSchedule * apply_schedule_delta(CompactSchedule *previous, char *namefile) {
+    
+    FILE *file;
+    DeltaBuffer delta;
+    CompactSchedule *schedule;
+    ScheduleRecord record;
+    uint64_t version, node, link, num_records, frame_difference, operation, value;
+    int64_t base_offsets_value, *base_offsets = NULL;
+    int max_records = 0, max_base_offsets = 0, frame = 0, i = 0, status = 0;
+    long long int max_offsets = 0;
+    uint32_t crc;
+    long file_size;
+    
+    // Read the whole delta and check its checksum
+    file = fopen(namefile, "rb");
+    if (file == NULL) {
+        printf("The delta file does not exist\n");
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    file_size = ftell(file);
+    rewind(file);
+    memset(&delta, 0, sizeof(DeltaBuffer));
+    if (file_size < 8) {
+        fclose(file);
+        printf("The delta file is too small\n");
+        return NULL;
+    }
+    delta.data = malloc(file_size);
+    delta.size = file_size;
+    if (fread(delta.data, file_size, 1, file) != 1 || memcmp(delta.data, SCHEDULE_DELTA_MAGIC, 4) != 0) {
+        status = -1;
+    }
+    fclose(file);
+    delta.length = file_size - sizeof(uint32_t);
+    delta.position = 4;
+    memcpy(&crc, &delta.data[delta.length], sizeof(uint32_t));
+    if (status == -1 || crc != update_crc32(0, &delta.data[4], delta.length - 4)) {
+        printf("The file is not a delta file or its checksum is not correct\n");
+        free(delta.data);
+        return NULL;
+    }
+    if (read_varint(&delta, &version) == -1 || version != SCHEDULE_DELTA_VERSION ||
+        read_varint(&delta, &node) == -1 || (node == 0 && read_varint(&delta, &link) == -1) ||
+        read_varint(&delta, &num_records) == -1) {
+        printf("The version of the delta file is not supported\n");
+        free(delta.data);
+        return NULL;
+    }
+    
+    // Merge the records of the previous schedule with the records of the delta, both sorted by frame and link
+    schedule = calloc(1, sizeof(CompactSchedule));
+    schedule->hyper_period = previous->hyper_period;
+    for (uint64_t k = 0; k <= num_records && status == 0; k++) {
+        if (k < num_records) {
+            memset(&record, 0, sizeof(ScheduleRecord));
+            if (read_varint(&delta, &frame_difference) == -1 || read_varint(&delta, &link) == -1 ||
+                read_varint(&delta, &operation) == -1) {
+                status = -1;
+                break;
+            }
+            frame += (int) frame_difference;
+            record.frame = frame;
+            record.link = (int32_t) link;
+        } else {
+            record.frame = INT32_MAX;           // Copy the rest of the previous schedule
+            record.link = INT32_MAX;
+            operation = delta_removed;
+        }
+        
+        // The previous records before the record of the delta do not change
+        while (i < previous->num_records && compare_delta_records(&previous->records[i], &record) < 0) {
+            append_schedule_record(schedule, &max_records, &max_offsets, &previous->records[i],
+                                   &previous->base_offsets[previous->records[i].first_offset]);
+            i++;
+        }
+        if (k == num_records) {
+            break;
+        }
+        if (operation == delta_changed) {
+            if (i == previous->num_records || compare_delta_records(&previous->records[i], &record) != 0) {
+                status = -1;
+                break;
+            }
+            record = previous->records[i];
+            if (record.replicas + 1 > max_base_offsets) {
+                max_base_offsets = record.replicas + 1;
+                base_offsets = realloc(base_offsets, sizeof(int64_t) * max_base_offsets);
+            }
+            for (int r = 0; r <= record.replicas && status == 0; r++) {
+                status = read_signed_varint(&delta, &base_offsets_value);
+                base_offsets[r] = previous->base_offsets[record.first_offset + r] + base_offsets_value;
+            }
+            append_schedule_record(schedule, &max_records, &max_offsets, &record, base_offsets);
+            i++;
+        } else if (operation == delta_added) {
+            if (read_varint(&delta, &value) == -1) {
+                status = -1;
+                break;
+            }
+            record.period = (int64_t) value;
+            status |= read_varint(&delta, &value);
+            record.timeslot_size = (int64_t) value;
+            status |= read_varint(&delta, &value);
+            record.instances = (int32_t) value;
+            status |= read_varint(&delta, &value);
+            record.replicas = (int32_t) value;
+            if (status != 0 || record.replicas < 0) {
+                status = -1;
+                break;
+            }
+            if (record.replicas + 1 > max_base_offsets) {
+                max_base_offsets = record.replicas + 1;
+                base_offsets = realloc(base_offsets, sizeof(int64_t) * max_base_offsets);
+            }
+            for (int r = 0; r <= record.replicas && status == 0; r++) {
+                status = read_signed_varint(&delta, &base_offsets[r]);
+            }
+            append_schedule_record(schedule, &max_records, &max_offsets, &record, base_offsets);
+            // An added record replaces the previous record of the same frame and link
+            if (i < previous->num_records && compare_delta_records(&previous->records[i], &record) == 0) {
+                i++;
+            }
+        } else if (operation == delta_removed) {
+            if (i < previous->num_records && compare_delta_records(&previous->records[i], &record) == 0) {
+                i++;
+            }
+        } else {
+            status = -1;
+        }
+    }
+    free(base_offsets);
+    free(delta.data);
+    
+    if (status != 0) {
+        printf("The delta file is wrongly constructed\n");
+        free_compact_schedule(schedule);
+        return NULL;
+    }
+    return schedule;
+}
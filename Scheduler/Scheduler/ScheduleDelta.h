@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  ScheduleDelta.h                                                                                                    *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that computes the difference between a previous schedule and a new one, to send to every node only the    *
+ *  transmissions that changed after a regeneration.                                                                   *
+ *  Both schedules are compared as compact schedules (one record per frame and link). The changed, added and removed   *
+ *  records are grouped by the node that transmits in the link and written in one delta file per node, encoded with    *
+ *  variable length integers: frames as the difference with the previous record, and changed base offsets as the       *
+ *  difference with the previous base offset. Every delta file ends with the CRC32 of its content.                     *
+ *  A node applies its delta to its previous schedule to obtain the new one.                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef ScheduleDelta_h
+#define ScheduleDelta_h
+
+#include <stdio.h>
+#include "CompactSchedule.h"
+
+#endif /* ScheduleDelta_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define SCHEDULE_DELTA_MAGIC "SRSD"
+#define SCHEDULE_DELTA_VERSION 1
+
+/**
+ Operations of a record of a delta schedule
+ */
+typedef enum DeltaOperation {
+    delta_changed,                      // The base offsets of the record changed
+    delta_added,                        // The record is new or its period, timeslot, instances or replicas changed
+    delta_removed                       // The record does not exist in the new schedule
+}DeltaOperation;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Writes the delta between the previous schedule and the new one in one file per node that has changes, named
+ prefix + node_<id>.delta. Records of links with unknown source are written in files named prefix + link_<id>.delta.
+ The nodes of the links are taken from the network in memory
+
+ @param previous pointer to the previous compact schedule
+ @param current pointer to the new compact schedule
+ @param prefix path and prefix of the files to create
+ @return number of bytes of all the delta files, -1 if they could not be written
+ */
+long long int write_schedule_delta(CompactSchedule *previous, CompactSchedule *current, char *prefix);
+
+/**
+ Applies a delta file to the previous schedule of a node and returns the new schedule
+
+ @param previous pointer to the previous compact schedule
+ @param namefile path and name of the delta file
+ @return pointer to the new compact schedule, NULL if the delta could not be read. It has to be freed with
+ free_compact_schedule
+ */
+CompactSchedule * apply_schedule_delta(CompactSchedule *previous, char *namefile);
@@ -0,0 +1,640 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  SelfRegeneratingScheduler.c                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in SelfRegeneratingScheduler.h                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "IOInterface.h"
+#include "BinaryNetwork.h"
+#include "GateControlList.h"
+#include "ScheduleDelta.h"
+#include "Validator.h"
+#include "Metrics.h"
+#include "Memory.h"
+#include <string.h>
+
+                                                    /* VARIABLES */
+
+int srs_network_loaded = 0;             // 1 if there is a network in memory (built or parsed)
+int srs_network_scheduled = 0;          // 1 if the network in memory has been scheduled
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the offset of a frame in a link checking that the network is scheduled and the identifiers are valid
+
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @return pointer to the offset, NULL if it does not exist
+ */
+Offset * get_scheduled_offset(int frame_id, int link_id) {
+    
+    int num_frames;
+    
+    if (!srs_network_scheduled) {
+        return NULL;
+    }
+    
+    // The frame of the protocol is hidden to the users of the library
+    if (is_protocol_active()) {
+        num_frames = get_number_frames() - 1;
+    } else {
+        num_frames = get_number_frames();
+    }
+    if (frame_id < 0 || frame_id >= num_frames || link_id < 0 || link_id >= get_number_links()) {
+        return NULL;
+    }
+    
+    return get_frame_offset_by_link(get_frame(frame_id), link_id);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Initializes the solver and the xml libraries, it has to be called once before any other function of the library
+ */
+int srs_init(void) {
+    
+    init_memory_accounting();       // Before the xml parser allocates anything
+    xmlInitParser();
+    init_solver(yices2);
+    reset_metrics(NULL);
+    srs_network_loaded = 0;
+    srs_network_scheduled = 0;
+    return 0;
+}
+
+/**
+ Frees the network in memory and finishes the solver and xml libraries, no other function can be called afterwards
+ */
+void srs_exit(void) {
+    
+    srs_free_network();
+    free_metrics();
+    exit_solver(yices2);
+    xmlCleanupParser();
+}
+
+/**
+ Creates a new empty network in memory with the given general information, links and frames have to be added later
+ */
+int srs_new_network(int number_frames, int number_links, int hop_delay, long long int hyperperiod,
+                    long long int protocol_period, long long int protocol_time, long long int time_between_frames) {
+    
+    if (srs_network_loaded) {
+        printf("There is already a network in memory, free it before creating a new one\n");
+        return -1;
+    }
+    if (number_frames <= 0 || number_links <= 0 || hyperperiod <= 0) {
+        printf("The network needs at least one frame, one link and a hyperperiod\n");
+        return -1;
+    }
+    
+    reset_metrics(NULL);
+    set_number_frames(number_frames);
+    set_number_links(number_links);
+    set_hop_delay(hop_delay);
+    set_hyper_period(hyperperiod);
+    set_protocol_parameters(protocol_period, protocol_time);
+    set_time_between_frames(time_between_frames);
+    srs_network_loaded = 1;
+    return 0;
+}
+
+/**
+ Loads a new network in memory from the given network xml file
+ */
+int srs_load_network_xml(char *namefile) {
+    
+    int status;
+    
+    if (srs_network_loaded) {
+        printf("There is already a network in memory, free it before loading a new one\n");
+        return -1;
+    }
+    
+    srs_network_loaded = 1;
+    reset_metrics(namefile);
+    start_phase(phase_parse);
+    status = parse_network_xml(namefile);
+    end_phase(phase_parse);
+    if (status == -1) {
+        srs_free_network();
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Loads a new network in memory from the given binary network file
+ */
+int srs_load_network_binary(char *namefile) {
+    
+    int status;
+    
+    if (srs_network_loaded) {
+        printf("There is already a network in memory, free it before loading a new one\n");
+        return -1;
+    }
+    
+    srs_network_loaded = 1;
+    reset_metrics(namefile);
+    start_phase(phase_parse);
+    status = read_network_binary(namefile);
+    end_phase(phase_parse);
+    if (status == -1) {
+        srs_free_network();
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Loads a new network in memory from the given file, that can be a binary network file or a network xml file
+ */
+int srs_load_network(char *namefile) {
+    
+    if (is_network_binary(namefile)) {
+        return srs_load_network_binary(namefile);
+    }
+    return srs_load_network_xml(namefile);
+}
+
+/**
+ Writes the network in memory in a binary network file
+ */
+int srs_write_network_binary(char *namefile) {
+    
+    if (!srs_network_loaded) {
+        printf("There is no network in memory\n");
+        return -1;
+    }
+    return write_network_binary(namefile);
+}
+
+/**
+ Writes the network in memory in a network xml file
+ */
+int srs_write_network_xml(char *namefile) {
+    
+    if (!srs_network_loaded) {
+        printf("There is no network in memory\n");
+        return -1;
+    }
+    return write_network_xml(namefile);
+}
+
+/**
+ Sets the speed and type of a link of the network in memory
+ */
+int srs_add_link(int link_id, int speed, LinkType link_type) {
+    
+    if (!srs_network_loaded || srs_network_scheduled || link_id < 0 || speed <= 0) {
+        return -1;
+    }
+    return add_link(link_id, speed, link_type);
+}
+
+/**
+ Sets the nodes that a link of the network in memory connects, needed to group the output by node
+ */
+int srs_add_link_nodes(int link_id, int source, int destination) {
+    
+    if (!srs_network_loaded || link_id < 0) {
+        return -1;
+    }
+    return add_link_nodes(link_id, source, destination);
+}
+
+/**
+ Sets the information of a frame of the network in memory and reserves the space for its paths and splits
+ */
+int srs_add_frame(int frame_id, long long int period, long long int deadline, int size, long long int end_to_end,
+                  long long int starting, int num_paths, int num_splits) {
+    
+    if (!srs_network_loaded || srs_network_scheduled || frame_id < 0 || period <= 0 || num_paths <= 0 ||
+        num_splits < 0) {
+        return -1;
+    }
+    if (add_frame_information(frame_id, period, deadline, size, end_to_end, starting) == -1) {
+        return -1;
+    }
+    add_num_paths(frame_id, num_paths);
+    add_num_splits(frame_id, num_splits);
+    return 0;
+}
+
+/**
+ Sets a path of a frame of the network in memory, the frame has to be added before
+ */
+int srs_add_frame_path(int frame_id, int path_id, int *path, int len_path) {
+    
+    Frame *frame_pt;
+    
+    if (!srs_network_loaded || srs_network_scheduled || frame_id < 0 || frame_id >= get_number_frames()) {
+        return -1;
+    }
+    frame_pt = get_frame(frame_id);
+    if (path_id < 0 || path_id >= get_num_paths(frame_pt) || len_path <= 0) {
+        return -1;
+    }
+    for (int i = 0; i < len_path; i++) {
+        if (path[i] < 0 || path[i] >= get_number_links()) {
+            printf("The link %d of the path of the frame %d does not exist\n", path[i], frame_id);
+            return -1;
+        }
+    }
+    return add_frame_path(frame_id, path_id, path, len_path);
+}
+
+/**
+ Sets a split of a frame of the network in memory, the frame has to be added before
+ */
+int srs_add_frame_split(int frame_id, int split_id, int *split, int len_split) {
+    
+    if (!srs_network_loaded || srs_network_scheduled || frame_id < 0 || frame_id >= get_number_frames()) {
+        return -1;
+    }
+    if (split_id < 0 || split_id >= get_frame(frame_id)->num_splits || len_split <= 0) {
+        return -1;
+    }
+    for (int i = 0; i < len_split; i++) {
+        if (split[i] < 0 || split[i] >= get_number_links()) {
+            printf("The link %d of the split of the frame %d does not exist\n", split[i], frame_id);
+            return -1;
+        }
+    }
+    return add_frame_split(frame_id, split_id, split, len_split);
+}
+
+/**
+ Adds a new frame at the end of the frames of the network in memory, before it is scheduled
+ */
+int srs_new_frame(void) {
+    
+    if (!srs_network_loaded || srs_network_scheduled) {
+        printf("There is no network in memory that has not been scheduled\n");
+        return -1;
+    }
+    return append_frame();
+}
+
+/**
+ Removes a frame of the network in memory, before it is scheduled
+ */
+int srs_remove_frame(int frame_id) {
+    
+    if (!srs_network_loaded || srs_network_scheduled) {
+        printf("There is no network in memory that has not been scheduled\n");
+        return -1;
+    }
+    return remove_frame(frame_id);
+}
+
+/**
+ Synthesizes the schedule of the network in memory. A network can only be scheduled once
+ */
+int srs_schedule(SchedulerOptions *options) {
+    
+    if (!srs_network_loaded) {
+        printf("There is no network in memory to schedule\n");
+        return -1;
+    }
+    if (srs_network_scheduled) {
+        printf("The network in memory is already scheduled\n");
+        return -1;
+    }
+    
+    // The network is initialized when scheduled, so if no schedule is found it is freed and has to be loaded again
+    srs_network_scheduled = 1;
+    if (schedule_network(options) == -1) {
+        srs_network_scheduled = 0;
+        srs_network_loaded = 0;
+        free_network();
+        return -1;
+    }
+    if (options != NULL && options->constraints_only) {
+        srs_network_scheduled = 0;
+    }
+    return 0;
+}
+
+/**
+ Writes the constraints of the network in memory in a SMT-LIB2 file without scheduling it
+ */
+int srs_export_constraints(char *namefile, SchedulerOptions *options) {
+    
+    if (!srs_network_loaded || srs_network_scheduled) {
+        printf("There is no network in memory that has not been scheduled\n");
+        return -1;
+    }
+    return export_constraints(namefile, options);
+}
+
+/**
+ Marks a link of the network in memory as failed and reroutes the frames transmitted in it, before it is scheduled
+ */
+int srs_reroute_link_failure(int link_id, RegenerationResult *result) {
+    
+    if (!srs_network_loaded || srs_network_scheduled) {
+        printf("There is no network in memory that has not been scheduled\n");
+        return -1;
+    }
+    return reroute_link_failure(link_id, result);
+}
+
+/**
+ Regenerates the schedule of the network in memory after the permanent failure of one of its links
+ */
+int srs_regenerate_link_failure(int link_id, SchedulerOptions *options, RegenerationResult *result) {
+    
+    return srs_regenerate_links_failure(1, &link_id, options, result);
+}
+
+/**
+ Regenerates the schedule of the network in memory after the permanent failure of several of its links
+ */
+int srs_regenerate_links_failure(int num_links, int *link_ids, SchedulerOptions *options, RegenerationResult *result) {
+    
+    if (!srs_network_scheduled) {
+        printf("There is no scheduled network in memory\n");
+        return -1;
+    }
+    
+    // The gate control lists and the validator belong to the schedule before the failure
+    free_validator();
+    free_gate_control_lists();
+    srs_network_scheduled = 0;
+    if (regenerate_links_failure(num_links, link_ids, options, result) == -1) {
+        if (result->affected_frames == NULL) {              // The link was not valid, the schedule has not changed
+            srs_network_scheduled = 1;
+        }
+        return -1;
+    }
+    srs_network_scheduled = 1;
+    return 0;
+}
+
+/**
+ Admits a new frame into the scheduled network in memory without scheduling it again from scratch
+ */
+int srs_admit_frame(long long int period, long long int deadline, int size, long long int end_to_end,
+                    long long int starting, int num_paths, int **paths, int *len_paths, SchedulerOptions *options,
+                    AdmissionResult *result) {
+    
+    if (!srs_network_scheduled) {
+        printf("There is no scheduled network in memory\n");
+        memset(result, 0, sizeof(AdmissionResult));
+        result->frame_id = -1;
+        snprintf(result->reason, ADMISSION_REASON_SIZE, "the network is not scheduled");
+        return -1;
+    }
+    
+    // The gate control lists and the validator belong to the schedule before the new frame
+    free_validator();
+    free_gate_control_lists();
+    return admit_frame(period, deadline, size, end_to_end, starting, num_paths, paths, len_paths, options, result);
+}
+
+/**
+ Get the number of instances that a frame has in a link of the scheduled network
+ */
+int srs_get_number_instances(int frame_id, int link_id) {
+    
+    Offset *offset_pt = get_scheduled_offset(frame_id, link_id);
+    
+    if (offset_pt == NULL) {
+        return -1;
+    }
+    return get_number_instances(offset_pt);
+}
+
+/**
+ Get the number of replicas that a frame has in a link of the scheduled network (replica 0 is not counted)
+ */
+int srs_get_number_replicas(int frame_id, int link_id) {
+    
+    Offset *offset_pt = get_scheduled_offset(frame_id, link_id);
+    
+    if (offset_pt == NULL) {
+        return -1;
+    }
+    return get_number_replicas(offset_pt);
+}
+
+/**
+ Get the transmission time of a frame in a link for the given instance and replica of the scheduled network
+ */
+long long int srs_get_offset(int frame_id, int link_id, int instance, int replica) {
+    
+    Offset *offset_pt = get_scheduled_offset(frame_id, link_id);
+    
+    if (offset_pt == NULL || instance < 0 || instance >= get_number_instances(offset_pt) || replica < 0 ||
+        replica > get_number_replicas(offset_pt)) {
+        return -1;
+    }
+    return get_offset(offset_pt, instance, replica);
+}
+
+/**
+ Validates the schedule of the scheduled network, completely or only the given modified frames
+ */
+int srs_validate_schedule(int *frame_ids, int num_frames, int num_threads) {
+    
+    if (!srs_network_scheduled) {
+        printf("The network in memory is not scheduled\n");
+        return -1;
+    }
+    if (frame_ids == NULL) {
+        return validate_schedule(num_threads);
+    }
+    for (int i = 0; i < num_frames; i++) {
+        if (frame_ids[i] < 0 || frame_ids[i] >= get_number_frames()) {
+            printf("The frame %d does not exist\n", frame_ids[i]);
+            return -1;
+        }
+    }
+    return validate_frames(frame_ids, num_frames, num_threads);
+}
+
+/**
+ Writes the schedule of the scheduled network in the format given by the extension of the file name
+ */
+int srs_write_schedule(char *namefile) {
+    
+    const char *extension = strrchr(namefile, '.');
+    
+    if (extension != NULL && strcmp(extension, ".srss") == 0) {
+        return srs_write_schedule_compact(namefile, 1);
+    }
+    if (extension != NULL && strcmp(extension, ".srst") == 0) {
+        return srs_write_schedule_compact(namefile, 0);
+    }
+    return srs_write_schedule_xml(namefile);
+}
+
+/**
+ Writes the schedule of the scheduled network in a xml file
+ */
+int srs_write_schedule_xml(char *namefile) {
+    
+    int status;
+    
+    if (!srs_network_scheduled) {
+        printf("The network in memory is not scheduled\n");
+        return -1;
+    }
+    start_phase(phase_write);
+    status = write_schedule_xml(namefile, 0);
+    end_phase(phase_write);
+    return status;
+}
+
+/**
+ Writes the schedule of the scheduled network in a compact schedule file, binary or text
+ */
+int srs_write_schedule_compact(char *namefile, int binary) {
+    
+    int status;
+    
+    if (!srs_network_scheduled) {
+        printf("The network in memory is not scheduled\n");
+        return -1;
+    }
+    start_phase(phase_write);
+    status = binary ? write_schedule_binary(namefile) : write_schedule_text(namefile);
+    end_phase(phase_write);
+    return status;
+}
+
+/**
+ Writes the frames left out of the schedule of the scheduled network by the maximum subset option
+ */
+int srs_write_dropped_frames(char *namefile) {
+    
+    FILE *file;
+    
+    if (!srs_network_scheduled) {
+        printf("The network in memory is not scheduled\n");
+        return -1;
+    }
+    file = fopen(namefile, "w");
+    if (file == NULL) {
+        printf("The file of the dropped frames could not be created\n");
+        return -1;
+    }
+    for (int i = 0; i < get_number_dropped_frames(); i++) {
+        fprintf(file, "%d\n", get_dropped_frame(i));
+    }
+    fclose(file);
+    return get_number_dropped_frames();
+}
+
+/**
+ Writes the difference between a previous compact schedule and the schedule of the scheduled network in one delta
+ file per node
+ */
+long long int srs_write_schedule_delta(char *previous_file, char *prefix) {
+    
+    CompactSchedule *previous, *current;
+    long long int bytes;
+    
+    if (!srs_network_scheduled) {
+        printf("The network in memory is not scheduled\n");
+        return -1;
+    }
+    previous = read_compact_schedule(previous_file);
+    if (previous == NULL) {
+        return -1;
+    }
+    start_phase(phase_write);
+    current = build_compact_schedule();
+    bytes = write_schedule_delta(previous, current, prefix);
+    end_phase(phase_write);
+    if (bytes != -1) {
+        printf("Bytes of the delta schedule: %lld\n", bytes);
+        bytes_needed();
+    }
+    free_compact_schedule(previous);
+    free_compact_schedule(current);
+    return bytes;
+}
+
+/**
+ Compiles the schedule of the scheduled network into the gate control lists of the egress ports and writes them in one
+ file per node
+ */
+int srs_write_gate_control_lists(char *prefix, int max_entries, int num_threads) {
+    
+    int exceeded;
+    
+    if (!srs_network_scheduled) {
+        printf("The network in memory is not scheduled\n");
+        return -1;
+    }
+    start_phase(phase_write);
+    if (compile_gate_control_lists(num_threads) == -1) {
+        end_phase(phase_write);
+        return -1;
+    }
+    exceeded = print_gate_control_lists(max_entries);
+    if (write_gate_control_lists(prefix) == -1) {
+        exceeded = -1;
+    }
+    end_phase(phase_write);
+    return exceeded;
+}
+
+/**
+ Enables or disables the trace of the phases and threads of the scheduler
+ */
+void srs_enable_trace(int enabled) {
+    
+    enable_trace(enabled);
+}
+
+/**
+ Sets the memory limit of the process, the program exits cleanly when it is exceeded
+ */
+void srs_set_memory_limit(long long int megabytes, void (*handler)(void)) {
+    
+    set_memory_limit(megabytes * 1024 * 1024, handler);
+}
+
+/**
+ Appends the metrics of the last network loaded or built, and its schedule, to a metrics file
+ */
+int srs_write_metrics(char *namefile, int status, int csv) {
+    
+    return write_metrics(namefile, status, csv);
+}
+
+/**
+ Writes the trace of the last network loaded or built in a Chrome trace file
+ */
+int srs_write_trace(char *namefile) {
+    
+    return write_trace(namefile);
+}
+
+/**
+ Frees the network in memory, after that a new network can be built or loaded
+ */
+void srs_free_network(void) {
+    
+    if (srs_network_loaded) {
+        free_validator();
+        free_gate_control_lists();
+        free_network();
+    }
+    srs_network_loaded = 0;
+    srs_network_scheduled = 0;
+}
@@ -0,0 +1,394 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  SelfRegeneratingScheduler.h                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Public interface of the scheduler library (libsrs) to embed it into other programs without temporal files.         *
+ *  A network can be loaded from a xml or binary file or built in memory with its links, frames, paths and splits.     *
+ *  Then it is scheduled with the given options and the transmission times of every frame, link, instance and replica  *
+ *  can be queried directly, or serialized into a xml schedule file on demand.                                         *
+ *  The library keeps one network in memory at a time, it has to be freed before a new one is loaded or built.         *
+ *  A typical use is:                                                                                                  *
+ *      srs_init() -> srs_new_network() -> srs_add_link()... -> srs_add_frame()... -> srs_add_frame_path()... ->       *
+ *      srs_schedule() -> srs_get_offset()... -> srs_free_network() -> srs_exit()                                      *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef SelfRegeneratingScheduler_h
+#define SelfRegeneratingScheduler_h
+
+#include <stdio.h>
+#include "Regeneration.h"
+#include "Admission.h"
+
+#endif /* SelfRegeneratingScheduler_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Initializes the solver and the xml libraries, it has to be called once before any other function of the library
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_init(void);
+
+/**
+ Frees the network in memory and finishes the solver and xml libraries, no other function can be called afterwards
+ */
+void srs_exit(void);
+
+/**
+ Creates a new empty network in memory with the given general information, links and frames have to be added later
+
+ @param number_frames number of frames of the network
+ @param number_links number of links of the network
+ @param hop_delay minimum time in ns that a switch needs to relay a frame
+ @param hyperperiod hyperperiod of the schedule in ns
+ @param protocol_period period in ns of the bandwidth reserved for the protocol, 0 if there is no protocol
+ @param protocol_time time in ns reserved for the protocol every protocol period
+ @param time_between_frames minimum time in ns between two transmissions in the same link
+ @return 0 if created correctly, -1 if there is already a network in memory or the parameters are wrong
+ */
+int srs_new_network(int number_frames, int number_links, int hop_delay, long long int hyperperiod,
+                    long long int protocol_period, long long int protocol_time, long long int time_between_frames);
+
+/**
+ Loads a new network in memory from the given network xml file
+
+ @param namefile path and name of the xml network file
+ @return 0 if loaded correctly, -1 if there is already a network in memory or the file could not be parsed
+ */
+int srs_load_network_xml(char *namefile);
+
+/**
+ Loads a new network in memory from the given binary network file, which is much faster than parsing a xml file
+
+ @param namefile path and name of the binary network file
+ @return 0 if loaded correctly, -1 if there is already a network in memory or the file is not valid
+ */
+int srs_load_network_binary(char *namefile);
+
+/**
+ Loads a new network in memory from the given file, that can be a binary network file or a network xml file
+
+ @param namefile path and name of the network file
+ @return 0 if loaded correctly, -1 if there is already a network in memory or the file could not be read
+ */
+int srs_load_network(char *namefile);
+
+/**
+ Writes the network in memory in a binary network file, also after it is scheduled (with the paths of its frames
+ after regenerating the schedule from failures)
+
+ @param namefile path and name of the binary network file to create
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_network_binary(char *namefile);
+
+/**
+ Writes the network in memory in a network xml file, also after it is scheduled
+
+ @param namefile path and name of the xml network file to create
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_network_xml(char *namefile);
+
+/**
+ Sets the speed and type of a link of the network in memory
+
+ @param link_id identifier of the link
+ @param speed speed of the link in MB/s
+ @param link_type type of the link (wired or wireless)
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_add_link(int link_id, int speed, LinkType link_type);
+
+/**
+ Sets the nodes that a link of the network in memory connects, needed to group the output by node
+
+ @param link_id identifier of the link
+ @param source identifier of the node that transmits in the link
+ @param destination identifier of the node that receives from the link
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_add_link_nodes(int link_id, int source, int destination);
+
+/**
+ Sets the information of a frame of the network in memory and reserves the space for its paths and splits
+
+ @param frame_id identifier of the frame
+ @param period period of the frame in ns
+ @param deadline deadline of the frame in ns
+ @param size size of the frame in bytes
+ @param end_to_end maximum end to end delay of the frame in ns
+ @param starting starting time of the frame in ns
+ @param num_paths number of paths that the frame will have
+ @param num_splits number of splits that the frame will have
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_add_frame(int frame_id, long long int period, long long int deadline, int size, long long int end_to_end,
+                  long long int starting, int num_paths, int num_splits);
+
+/**
+ Sets a path of a frame of the network in memory, the frame has to be added before
+
+ @param frame_id identifier of the frame
+ @param path_id identifier of the path in the frame (from 0 to num_paths - 1)
+ @param path array with the links of the path, from the sender to the receiver
+ @param len_path number of links in the path
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_add_frame_path(int frame_id, int path_id, int *path, int len_path);
+
+/**
+ Sets a split of a frame of the network in memory, the frame has to be added before
+
+ @param frame_id identifier of the frame
+ @param split_id identifier of the split in the frame (from 0 to num_splits - 1)
+ @param split array with the links of the split
+ @param len_split number of links in the split
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_add_frame_split(int frame_id, int split_id, int *split, int len_split);
+
+/**
+ Adds a new frame at the end of the frames of the network in memory, before it is scheduled. Its information, paths
+ and splits are set afterwards with srs_add_frame, srs_add_frame_path and srs_add_frame_split
+
+ @return identifier of the new frame, -1 if there is no network in memory that has not been scheduled
+ */
+int srs_new_frame(void);
+
+/**
+ Removes a frame of the network in memory, before it is scheduled, so it is not transmitted anymore. The identifiers
+ of the rest of frames do not change
+
+ @param frame_id identifier of the frame
+ @return 0 if removed correctly, -1 otherwise
+ */
+int srs_remove_frame(int frame_id);
+
+/**
+ Synthesizes the schedule of the network in memory. A network can only be scheduled once, unless only its constraints
+ are added (constraints_only in the options)
+
+ @param options pointer to the scheduler options (init them with init_scheduler_options), NULL for the default ones
+ @return 0 if the schedule was found, -1 otherwise
+ */
+int srs_schedule(SchedulerOptions *options);
+
+/**
+ Writes the constraints of the network in memory in a SMT-LIB2 file without scheduling it, see export_constraints
+
+ @param namefile path and name of the SMT-LIB2 file to create
+ @param options pointer to the options of the scheduler, NULL to use the default ones
+ @return 0 if the file was written, -1 otherwise
+ */
+int srs_export_constraints(char *namefile, SchedulerOptions *options);
+
+/**
+ Marks a link of the network in memory as failed, before it is scheduled, and reroutes the frames transmitted in it
+ through the best paths that avoid the failed links. The frames without such paths are removed
+
+ @param link_id identifier of the failed link
+ @param result pointer where the affected and lost frames are saved, free it with free_regeneration_result
+ @return 0 if done correctly, -1 otherwise
+ */
+int srs_reroute_link_failure(int link_id, RegenerationResult *result);
+
+/**
+ Regenerates the schedule of the network in memory after the permanent failure of one of its links. Only the frames
+ transmitted in the link are rerouted and scheduled again, the rest keep their offsets. If no schedule is found, the
+ network stays in memory, not scheduled and with the frames rerouted, so it can be scheduled again from scratch
+
+ @param link_id identifier of the failed link
+ @param options pointer to the scheduler options, NULL for the default ones
+ @param result pointer where the affected and lost frames and the recovery time are saved, free it with
+ free_regeneration_result
+ @return 0 if the new schedule was found, -1 otherwise
+ */
+int srs_regenerate_link_failure(int link_id, SchedulerOptions *options, RegenerationResult *result);
+
+/**
+ Regenerates the schedule of the network in memory after the permanent failure of several of its links at the same
+ time, such as all the links of a failed node, as srs_regenerate_link_failure
+
+ @param num_links number of failed links
+ @param link_ids identifiers of the failed links
+ @param options pointer to the scheduler options, NULL for the default ones
+ @param result pointer where the affected and lost frames and the recovery time are saved, free it with
+ free_regeneration_result
+ @return 0 if the new schedule was found, -1 otherwise
+ */
+int srs_regenerate_links_failure(int num_links, int *link_ids, SchedulerOptions *options, RegenerationResult *result);
+
+/**
+ Admits a new frame into the scheduled network in memory without scheduling it again from scratch (see Admission.h).
+ It is placed first in the free time of its links, then by the solver with the rest of frames pinned, and then
+ unpinning the frames that share its links. If it is not admitted, the network keeps the schedule it had
+
+ @param period period of the frame in ns, it has to divide the hyperperiod
+ @param deadline deadline of the frame in ns
+ @param size size of the frame in bytes
+ @param end_to_end maximum end to end delay of the frame in ns
+ @param starting starting time of the frame in ns
+ @param num_paths number of paths of the frame
+ @param paths array with the links of every path, from the sender to the receiver
+ @param len_paths array with the number of links of every path
+ @param options pointer to the scheduler options, NULL for the default ones. The time budget is the latency budget of
+ the admission
+ @param result pointer where the new frame and its offsets, or the reason of the rejection, are saved, free it with
+ free_admission_result
+ @return 0 if the frame was admitted, -1 otherwise
+ */
+int srs_admit_frame(long long int period, long long int deadline, int size, long long int end_to_end,
+                    long long int starting, int num_paths, int **paths, int *len_paths, SchedulerOptions *options,
+                    AdmissionResult *result);
+
+/**
+ Get the number of instances that a frame has in a link of the scheduled network
+
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @return number of instances, -1 if the network is not scheduled or the frame is not transmitted in the link
+ */
+int srs_get_number_instances(int frame_id, int link_id);
+
+/**
+ Get the number of replicas that a frame has in a link of the scheduled network (replica 0 is not counted)
+
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @return number of replicas, -1 if the network is not scheduled or the frame is not transmitted in the link
+ */
+int srs_get_number_replicas(int frame_id, int link_id);
+
+/**
+ Get the transmission time of a frame in a link for the given instance and replica of the scheduled network
+
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @param instance number of the instance
+ @param replica number of the replica
+ @return transmission time in ns, -1 if the network is not scheduled or any of the given identifiers is not valid
+ */
+long long int srs_get_offset(int frame_id, int link_id, int instance, int replica);
+
+/**
+ Validates the schedule of the scheduled network. If frames are given, only those frames are validated against the
+ occupancy of the links from the last validation (the schedule is always validated once when scheduled), which is
+ much faster after local changes in the schedule
+
+ @param frame_ids array with the identifiers of the modified frames, NULL to validate the whole schedule
+ @param num_frames number of modified frames
+ @param num_threads number of threads to use, 0 to use one per available processor
+ @return 0 if correct, the number of violations found if not correct, -1 if the network is not scheduled
+ */
+int srs_validate_schedule(int *frame_ids, int num_frames, int num_threads);
+
+/**
+ Writes the schedule of the scheduled network in the format given by the extension of the file name: .srss for the
+ binary compact schedule, .srst for the text compact schedule and xml otherwise
+
+ @param namefile path and name of the file to create
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_schedule(char *namefile);
+
+/**
+ Writes the schedule of the scheduled network in a xml file
+
+ @param namefile path and name of the xml file to create
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_schedule_xml(char *namefile);
+
+/**
+ Writes the schedule of the scheduled network in a compact schedule file, with one record for every frame and link
+ instead of every instance. It can be read with the functions of CompactSchedule.h
+
+ @param namefile path and name of the file to create
+ @param binary 1 to write the binary variant, 0 to write the text variant
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_schedule_compact(char *namefile, int binary);
+
+/**
+ Writes the frames left out of the schedule of the scheduled network by the maximum subset option, one identifier per
+ line. The file is empty if all frames were scheduled
+
+ @param namefile path and name of the file to create
+ @return number of frames left out, -1 if the file could not be written
+ */
+int srs_write_dropped_frames(char *namefile);
+
+/**
+ Writes the difference between a previous compact schedule and the schedule of the scheduled network in one delta
+ file per node with changes (see ScheduleDelta.h). The bytes of the delta are printed together with the bytes needed
+ to send the whole schedule
+
+ @param previous_file path and name of the previous compact schedule file (binary or text)
+ @param prefix path and prefix of the delta files to create
+ @return number of bytes of all the delta files, -1 if they could not be written
+ */
+long long int srs_write_schedule_delta(char *previous_file, char *prefix);
+
+/**
+ Compiles the schedule of the scheduled network into the gate control lists of the egress ports (one per link) and
+ writes them in one file per node (see GateControlList.h). The number of entries of every port is printed
+
+ @param prefix path and prefix of the files to create
+ @param max_entries maximum number of entries that a port can store, 0 if there is no limit
+ @param num_threads number of threads to use, 0 to use one per available processor
+ @return number of ports that need more entries than the limit, -1 if the lists could not be written
+ */
+int srs_write_gate_control_lists(char *prefix, int max_entries, int num_threads);
+
+/**
+ Enables or disables the trace of the phases and threads of the scheduler. It has to be enabled before the network is
+ loaded or built to trace all the phases
+
+ @param enabled 1 to trace, 0 otherwise
+ */
+void srs_enable_trace(int enabled);
+
+/**
+ Sets the memory limit of the process (see Memory.h). When the memory of the process exceeds it, the scheduler prints
+ the memory used by every subsystem, calls the handler and exits with status MEMORY_EXIT_STATUS (3), instead of being
+ killed by the system without notice
+
+ @param megabytes maximum memory in MB, 0 for no limit
+ @param handler function called before the program exits (for example to write the metrics), NULL for none
+ */
+void srs_set_memory_limit(long long int megabytes, void (*handler)(void));
+
+/**
+ Appends the metrics of the last network loaded or built, and its schedule, to a metrics file (see Metrics.h): the
+ wall and CPU time of every phase, the peak memory of the process and of every subsystem, the size of the solver
+ problem and the size of the network.
+ They have to be written before the network is freed
+
+ @param namefile path and name of the metrics file
+ @param status exit status of the run, 0 if the schedule was found and written
+ @param csv 1 to write a CSV row, 0 to write a JSON line
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_metrics(char *namefile, int status, int csv);
+
+/**
+ Writes the trace of the phases and threads of the last network loaded or built in a Chrome trace file
+
+ @param namefile path and name of the trace file
+ @return 0 if written correctly, -1 otherwise
+ */
+int srs_write_trace(char *namefile);
+
+/**
+ Frees the network in memory, after that a new network can be built or loaded
+ */
+void srs_free_network(void);
@@ -13,17 +13,40 @@
 #include "Synthesizer.h"
 #include "Network.h"
 #include "IOInterface.h"
-#include "ConstraintSolver.h"
+#include "Validator.h"
+#include "CompactSchedule.h"
+#include "Metrics.h"
+#include "Memory.h"
+#include "Precheck.h"
+#include <stdlib.h>
+#include <errno.h>
+#include <pthread.h>
 #include <sys/time.h>
 
                                                     /* VARIABLES */
 
-// Variables to measure execution time
-struct timeval start_time_solver, end_time_solver;              // Solver time
-struct timeval start_time_parse, end_time_parse;                // Parse time
-struct timeval start_time_constraints, end_time_constraints;    // Constraints time
-struct timeval start_time_check, end_time_check;                // Check schedule time
+// Variables to measure execution time, the time of every phase is measured in the metrics
 struct timeval start_time_total, end_time_total;                // Total time
+int time_budget_exceeded = 0;                                   // 1 if the last schedule ran out of time budget
+int *dropped_frames = NULL;                                     // Frames left out of the last schedule
+int num_dropped_frames = 0;                                     // Number of frames left out of the last schedule
+
+                                                /* STRUCT DEFINITIONS */
+
+#define UNLIMITED_BUDGET 315360000      // Seconds until the deadline when there is no time budget (10 years)
+
+/**
+ Watchdog that stops the solver if it is still searching when the time budget ends or the memory limit is exceeded
+ */
+typedef struct SolverWatchdog {
+    Solver solver;                      // Solver to stop
+    struct timespec deadline;           // Absolute time when the time budget ends
+    int finished;                       // 1 when the solver finished before the deadline
+    int expired;                        // 1 if the solver was stopped
+    int memory_exceeded;                // 1 if the solver was stopped because the memory limit was exceeded
+    pthread_mutex_t mutex;
+    pthread_cond_t finished_cond;
+}SolverWatchdog;
 
                                                 /* AUXILIAR FUNCTIONS */
 
@@ -42,76 +65,706 @@ double time_diff(struct timeval x , struct timeval y) {
     return diff / 1000;
 }
 
-                                                    /* FUNCTIONS */
+/**
+ Thread of the watchdog, waits until the solver finishes or the deadline arrives, in that case it stops the solver.
+ With a memory limit it also wakes up periodically and stops the solver if the memory of the process exceeds it
+
+ @param arg pointer to the watchdog
+ @return NULL
+ */
+void * solver_watchdog_thread(void *arg) {
+    
+    SolverWatchdog *watchdog = (SolverWatchdog *) arg;
+    struct timespec wake;
+    int status = 0;
+    
+    pthread_mutex_lock(&watchdog->mutex);
+    while (!watchdog->finished && status != ETIMEDOUT) {
+        wake = watchdog->deadline;
+        if (get_memory_limit() > 0) {
+            clock_gettime(CLOCK_REALTIME, &wake);
+            wake.tv_nsec += MEMORY_POLL_INTERVAL * 1000000L;
+            if (wake.tv_nsec >= 1000000000L) {
+                wake.tv_sec++;
+                wake.tv_nsec -= 1000000000L;
+            }
+            if (wake.tv_sec > watchdog->deadline.tv_sec ||
+                (wake.tv_sec == watchdog->deadline.tv_sec && wake.tv_nsec > watchdog->deadline.tv_nsec)) {
+                wake = watchdog->deadline;
+            }
+        }
+        status = pthread_cond_timedwait(&watchdog->finished_cond, &watchdog->mutex, &wake);
+        if (status == ETIMEDOUT && !watchdog->finished && is_memory_limit_exceeded()) {
+            watchdog->memory_exceeded = 1;
+        } else if (status == ETIMEDOUT &&
+                   (wake.tv_sec != watchdog->deadline.tv_sec || wake.tv_nsec != watchdog->deadline.tv_nsec)) {
+            status = 0;             // Only the memory was checked, the deadline has not arrived yet
+        }
+    }
+    if (!watchdog->finished) {
+        watchdog->expired = 1;
+        stop_solver(watchdog->solver);
+    }
+    pthread_mutex_unlock(&watchdog->mutex);
+    return NULL;
+}
 
 /**
- Produces the schedule solving all constraints in one call to the SMT Solver for a given network.
- It inits the solver and the network.
- It starts creating all the constraints (one variable for each transmission offset), then adds constraints relating
- different offsets. At the end solves the logical context and the model obtained is the solver.
- It creates an xml file with the output schedule.
- It also creates different constraint files for every switch in the network containing specific constraints for each
- switch
+ Checks the solver with the remaining time budget, stopping it with a watchdog thread if the budget ends. If the
+ watchdog stops it because the memory limit is exceeded, the program aborts
+
+ @param csolver indicates which solver are we using
+ @param deadline absolute time when the time budget ends
+ @param active_frames frames whose guards are assumed (see check_solver_subset), NULL to check all the constraints
+ @return 1 if the schedule was found, 0 if a subset of frames is unsatisfiable, -1 if not found or the budget ended
+ (time_budget_exceeded is set)
  */
-int one_shot_scheduling(char *network_file, char *param_file) {
+int check_solver_with_budget(Solver csolver, struct timeval deadline, int *active_frames) {
     
-    // Variables
-    Solver csolver = yices2;            // State the constraint solver we want to use
+    SolverWatchdog watchdog;
+    pthread_t thread;
+    struct timeval now;
+    int status;
     
-    gettimeofday(&start_time_total, NULL);
+    gettimeofday(&now, NULL);
+    if (time_diff(now, deadline) <= 0) {
+        time_budget_exceeded = 1;
+        return -1;
+    }
+    
+    watchdog.solver = csolver;
+    watchdog.deadline.tv_sec = deadline.tv_sec;
+    watchdog.deadline.tv_nsec = deadline.tv_usec * 1000;
+    watchdog.finished = 0;
+    watchdog.expired = 0;
+    watchdog.memory_exceeded = 0;
+    pthread_mutex_init(&watchdog.mutex, NULL);
+    pthread_cond_init(&watchdog.finished_cond, NULL);
+    if (pthread_create(&thread, NULL, solver_watchdog_thread, &watchdog) != 0) {
+        pthread_mutex_destroy(&watchdog.mutex);
+        pthread_cond_destroy(&watchdog.finished_cond);
+        return active_frames == NULL ? check_solver(csolver) : check_solver_subset(csolver, active_frames);
+    }
+    
+    status = active_frames == NULL ? check_solver(csolver) : check_solver_subset(csolver, active_frames);
+    
+    pthread_mutex_lock(&watchdog.mutex);
+    watchdog.finished = 1;
+    pthread_cond_signal(&watchdog.finished_cond);
+    pthread_mutex_unlock(&watchdog.mutex);
+    pthread_join(thread, NULL);
+    pthread_mutex_destroy(&watchdog.mutex);
+    pthread_cond_destroy(&watchdog.finished_cond);
+    
+    if (watchdog.memory_exceeded) {
+        abort_memory_limit("while solving the constraints");
+    }
+    if (status == -1 && watchdog.expired) {
+        time_budget_exceeded = 1;
+    }
+    return status;
+}
+
+/**
+ Returns 1 if the given identifier is in the array of identifiers
+
+ @param ids array of identifiers
+ @param num_ids number of identifiers
+ @param id identifier to search
+ @return 1 if found, 0 otherwise
+ */
+int contains_id(int *ids, int num_ids, int id) {
     
-    // Read the network file, parse it into internal memory, and prepare the network and solver
-    gettimeofday(&start_time_parse, NULL);
-    parse_network_xml(network_file);
+    for (int i = 0; i < num_ids; i++) {
+        if (ids[i] == id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Returns 1 if the frame can keep the offsets of the previous schedule: it is not movable, it is not transmitted in a
+ movable link, all its links are in the previous schedule with the same period, timeslot and instances, and the
+ previous offsets still satisfy its own ranges, path dependency and end to end delay
+
+ @param frame_id identifier of the frame
+ @param previous pointer to the previous compact schedule
+ @param options pointer to the options of the scheduler with the movable frames and links
+ @return 1 if the frame can be pinned, 0 otherwise
+ */
+int can_pin_frame(int frame_id, CompactSchedule *previous, SchedulerOptions *options) {
+    
+    Frame *frame_pt = get_frame(frame_id);
+    Offset *offset_it, *offset_pt;
+    Path *path_it;
+    ScheduleRecord *record;
+    long long int base, next_base, first_base, last_base;
+    
+    if (contains_id(options->movable_frames, options->num_movable_frames, frame_id)) {
+        return 0;
+    }
+    
+    // All the offsets of the frame have to be in the previous schedule, in the same conditions and in range
+    offset_it = get_offset_root(frame_pt);
+    while (!is_last_offset(offset_it)) {
+        if (contains_id(options->movable_links, options->num_movable_links, get_offset_link(offset_it))) {
+            return 0;
+        }
+        record = get_schedule_record(previous, frame_id, get_offset_link(offset_it));
+        if (record == NULL || record->period != get_period(frame_pt) ||
+            record->timeslot_size != get_timeslot_size(offset_it) ||
+            record->instances != get_number_instances(offset_it)) {
+            return 0;
+        }
+        base = get_record_transmission(previous, record, 0, 0);
+        if (base <= get_starting(frame_pt) || base > get_deadline(frame_pt) - get_timeslot_size(offset_it)) {
+            return 0;
+        }
+        offset_it = get_next_offset(offset_it);
+    }
+    
+    // The paths have to follow the hop delay and end to end delay with the previous offsets
+    for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
+        path_it = get_path_root(frame_pt, path_id);
+        if (is_last_path(path_it)) {
+            continue;
+        }
+        offset_pt = get_offset_from_path(path_it);
+        first_base = get_record_transmission(previous, get_schedule_record(previous, frame_id,
+                                                                           get_offset_link(offset_pt)), 0, 0);
+        base = first_base;
+        last_base = first_base;
+        path_it = get_next_path(path_it);
+        while (!is_last_path(path_it)) {
+            next_base = get_record_transmission(previous, get_schedule_record(previous, frame_id,
+                                                    get_offset_link(get_offset_from_path(path_it))), 0, 0);
+            if (next_base < base + get_hop_delay() + get_timeslot_size(offset_pt) + 1) {
+                return 0;
+            }
+            offset_pt = get_offset_from_path(path_it);
+            base = next_base;
+            last_base = next_base;
+            path_it = get_next_path(path_it);
+        }
+        if (last_base >= first_base + get_end_to_end_delay(frame_pt) - get_timeslot_size(offset_pt)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ Pins the frames that can keep the offsets of the previous schedule given in the options (file or in memory), their
+ transmission times are saved in their offsets and the solver uses them as constants
+
+ @param options pointer to the options of the scheduler
+ @return number of pinned frames, -1 if the previous schedule could not be read
+ */
+int pin_previous_schedule(SchedulerOptions *options) {
+    
+    CompactSchedule *previous;
+    ScheduleRecord *record;
+    Frame *frame_pt;
+    Offset *offset_it;
+    int num_frames, num_pinned = 0;
+    
+    if (options->previous_schedule != NULL) {
+        previous = read_compact_schedule(options->previous_schedule);
+        if (previous == NULL) {
+            return -1;
+        }
+    } else {
+        previous = options->previous_compact;
+    }
+    
+    // The frame of the protocol is always fixed, so it is not pinned
+    num_frames = is_protocol_active() == 1 ? get_number_frames() - 1 : get_number_frames();
+    for (int i = 0; i < num_frames; i++) {
+        frame_pt = get_frame(i);
+        if (!can_pin_frame(i, previous, options)) {
+            continue;
+        }
+        
+        // All replicas are transmitted at the same time as the replica 0 of their instance
+        offset_it = get_offset_root(frame_pt);
+        while (!is_last_offset(offset_it)) {
+            record = get_schedule_record(previous, i, get_offset_link(offset_it));
+            for (int instance = 0; instance < get_number_instances(offset_it); instance++) {
+                for (int replica = 0; replica <= get_number_replicas(offset_it); replica++) {
+                    set_offset(offset_it, instance, replica, get_record_transmission(previous, record, instance, 0));
+                }
+            }
+            offset_it = get_next_offset(offset_it);
+        }
+        set_frame_pinned(frame_pt, 1);
+        num_pinned++;
+    }
+    
+    if (previous != options->previous_compact) {
+        free_compact_schedule(previous);
+    }
+    return num_pinned;
+}
+
+/**
+ Get the priority of a frame to be kept in the schedule when frames are left out, 1 if not given in the options
+
+ @param options pointer to the options of the scheduler
+ @param frame_id identifier of the frame
+ @return priority of the frame, the higher the more important
+ */
+int get_frame_priority(SchedulerOptions *options, int frame_id) {
+    
+    if (options->frame_priorities == NULL || frame_id >= options->num_frame_priorities) {
+        return 1;
+    }
+    return options->frame_priorities[frame_id];
+}
+
+/**
+ Compares two identifiers to sort them in ascending order
+
+ @param id1 pointer to the first identifier
+ @param id2 pointer to the second identifier
+ @return negative, zero or positive if the first identifier is lower, equal or greater than the second
+ */
+int compare_ids(const void *id1, const void *id2) {
+    
+    return *(const int *) id1 - *(const int *) id2;
+}
+
+/**
+ Checks the solver with only the constraints of the active frames, with the time budget if there is one
+
+ @param csolver indicates which solver are we using
+ @param active_frames array with 1 for the frames whose constraints hold and 0 for the rest
+ @param options pointer to the options of the scheduler
+ @param deadline absolute time when the time budget ends
+ @return 1 if the schedule was found, 0 if the active frames are unsatisfiable, -1 if stopped or failed
+ */
+int check_frames(Solver csolver, int *active_frames, SchedulerOptions *options, struct timeval deadline) {
+    
+    if (options->time_budget > 0 || get_memory_limit() > 0) {
+        return check_solver_with_budget(csolver, deadline, active_frames);
+    }
+    return check_solver_subset(csolver, active_frames);
+}
+
+/**
+ Searches the largest set of frames that can be scheduled together, with the constraints of every frame guarded.
+ While the solver finds the active frames unsatisfiable, the frame with the lowest priority (the last one if tied) of
+ the unsatisfiable core is left out. As the cores are not minimal, the frames left out are then added back one by
+ one, the most important first, if the rest can still be scheduled with them. The frames left out are saved in the
+ dropped frames
+
+ @param csolver indicates which solver are we using
+ @param options pointer to the options of the scheduler with the priorities of the frames
+ @param deadline absolute time when the time budget ends
+ @return 1 if a schedule was found for the rest of frames, -1 if not found or the budget ended
+ */
+int search_maximum_subset(Solver csolver, SchedulerOptions *options, struct timeval deadline) {
+    
+    int *active_frames;                 // 1 for the frames whose constraints hold, 0 for the frames left out
+    int *conflicting_frames;            // Frames of the last unsatisfiable core
+    int num_guards, num_conflicting, num_tried = 0, best, frame_id, status;
+    
+    num_guards = is_protocol_active() == 1 ? get_number_frames() - 1 : get_number_frames();
+    active_frames = malloc(sizeof(int) * (num_guards + 1));
+    conflicting_frames = malloc(sizeof(int) * (num_guards + 1));
+    free(dropped_frames);
+    dropped_frames = malloc(sizeof(int) * (num_guards + 1));
+    for (int i = 0; i < num_guards; i++) {
+        active_frames[i] = 1;
+    }
+    
+    // Leave out the least important frame of every unsatisfiable core until the rest of frames are satisfiable
+    status = check_frames(csolver, active_frames, options, deadline);
+    while (status == 0) {
+        num_conflicting = get_conflicting_frames(csolver, conflicting_frames);
+        frame_id = -1;
+        for (int i = 0; i < num_conflicting; i++) {
+            if (frame_id == -1 ||
+                get_frame_priority(options, conflicting_frames[i]) < get_frame_priority(options, frame_id) ||
+                (get_frame_priority(options, conflicting_frames[i]) == get_frame_priority(options, frame_id) &&
+                 conflicting_frames[i] > frame_id)) {
+                frame_id = conflicting_frames[i];
+            }
+        }
+        if (frame_id == -1) {           // Unsatisfiable without any frame, only the protocol is left
+            status = -1;
+            break;
+        }
+        active_frames[frame_id] = 0;
+        dropped_frames[num_dropped_frames++] = frame_id;
+        status = check_frames(csolver, active_frames, options, deadline);
+    }
+    
+    // Add back the frames left out that fit with the rest, the most important first
+    while (status == 1 && num_tried < num_dropped_frames) {
+        best = num_tried;
+        for (int i = num_tried + 1; i < num_dropped_frames; i++) {
+            if (get_frame_priority(options, dropped_frames[i]) > get_frame_priority(options, dropped_frames[best])) {
+                best = i;
+            }
+        }
+        frame_id = dropped_frames[best];
+        dropped_frames[best] = dropped_frames[num_tried];
+        dropped_frames[num_tried] = frame_id;
+        
+        active_frames[frame_id] = 1;
+        status = check_frames(csolver, active_frames, options, deadline);
+        if (status == 1) {
+            dropped_frames[num_tried] = dropped_frames[--num_dropped_frames];
+        } else if (status == 0) {
+            active_frames[frame_id] = 0;
+            num_tried++;
+            status = 1;                 // The rest of frames are still satisfiable without it
+        }
+    }
+    qsort(dropped_frames, num_dropped_frames, sizeof(int), compare_ids);
+    
+    free(active_frames);
+    free(conflicting_frames);
+    return status;
+}
+
+/**
+ Inits the network, checks the necessary conditions of any schedule before the solver is used, inits the solver, pins
+ the frames that keep the offsets of the previous schedule, and adds all the constraints of the network into the
+ solver. If something fails, the solver is closed
+
+ @param csolver indicates which solver are we using
+ @param options pointer to the options of the scheduler
+ @return 0 if all the constraints were added, -1 otherwise
+ */
+int add_constraints(Solver csolver, SchedulerOptions *options) {
+    
+    int num_pinned;                     // Number of frames pinned to the previous schedule
+    int num_infeasible;                 // Links and paths that cannot be scheduled
+    int status;                         // Result of every phase
+    
+    // Prepare the network and solver
+    start_phase(phase_init);
     initialize_network();               // Prepare the network variables to start scheduling
+    // Networks that break a necessary condition fail before solving, unless frames can be left out to schedule the
+    // rest or the constraints are only measured or exported
+    num_infeasible = precheck_network(options->verbose);
+    if (num_infeasible > 0 && csolver == yices2 && !options->maximum_subset && !options->constraints_only) {
+        printf("The network cannot be scheduled, %d links and paths break necessary conditions\n", num_infeasible);
+        end_phase(phase_init);
+        return -1;
+    }
     initialize_solver(csolver);         // Prepare the constraint solver to start scheduling
-    gettimeofday(&end_time_parse, NULL);
-    printf("Time to parse in ms => %f\n", time_diff(start_time_parse, end_time_parse));
+    save_network_metrics();
+    // Keep the offsets of the frames that are not affected from the previous schedule
+    if (options->previous_schedule != NULL || options->previous_compact != NULL) {
+        num_pinned = pin_previous_schedule(options);
+        if (num_pinned == -1) {
+            printf("The previous schedule could not be read\n");
+            end_phase(phase_init);
+            close_solver(csolver);
+            return -1;
+        }
+        if (options->verbose) {
+            printf("Frames pinned to the previous schedule => %d\n", num_pinned);
+        }
+    }
+    // Search the offsets in the greatest time unit where every frame fits (or the macrotick) to shrink the integers of
+    // the solver, the pinned offsets are already known so they are kept exact
+    set_solver_granularity(get_time_granularity(options->macrotick), csolver);
+    if (options->verbose) {
+        printf("Time granularity of the solver in ns => %lld\n", get_solver_granularity());
+    }
+    // Guard the constraints of every frame to be able to leave frames out
+    if (options->maximum_subset) {
+        create_frame_guards(csolver);
+    }
+    end_phase(phase_init);
+    if (options->verbose) {
+        printf("Time to init in ms => %f\n", get_phase_time(phase_init));
+    }
     
     // Create all the offset variables with the allowed ranges of transmissions
-    gettimeofday(&start_time_constraints, NULL);
-    if (create_offset_variables(csolver) == -1) {
+    start_phase(phase_offsets);
+    status = create_offset_variables(csolver);
+    end_phase(phase_offsets);
+    if (status == -1) {
         printf("There was a problem creating and Initializing constraint variables\n");
+        close_solver(csolver);
         return -1;
     }
     // Make sure that frames are not transmitted at the same time at the same link
-    if (contention_free(csolver) == -1) {
+    start_phase(phase_contention);
+    status = contention_free(csolver);
+    end_phase(phase_contention);
+    if (status == -1) {
         printf("There was a problem making the contention free constraints");
+        close_solver(csolver);
         return -1;
     }
     // Make all the frame to be path dependent, they should follow an order
-    if (frame_path_dependent(csolver) == -1) {
+    start_phase(phase_path_dependent);
+    status = frame_path_dependent(csolver);
+    end_phase(phase_path_dependent);
+    if (status == -1) {
         printf("There was a a problem making the frames to be path dependent\n");
+        close_solver(csolver);
         return -1;
     }
     // Generate end to end delays constraings for all the frames
-    if (frame_end_to_end_delay(csolver) == -1) {
+    start_phase(phase_end_to_end);
+    status = frame_end_to_end_delay(csolver);
+    end_phase(phase_end_to_end);
+    if (status == -1) {
         printf("There was a problem making the end to end delay of the frames\n");
+        close_solver(csolver);
         return -1;
     }
-    gettimeofday(&end_time_constraints, NULL);
-    printf("Time to add constraints in ms => %f\n", time_diff(start_time_constraints, end_time_constraints));
+    if (options->verbose) {
+        printf("Time to add constraints in ms => %f\n", get_phase_time(phase_offsets) +
+               get_phase_time(phase_contention) + get_phase_time(phase_path_dependent) +
+               get_phase_time(phase_end_to_end));
+    }
+    return 0;
+}
+
+/**
+ Synthesizes the schedule of the network in memory: it inits the network and the solver, adds all the constraints,
+ solves them and saves the offsets found in the frames. If frames are left out to find a schedule, they are removed
+ from the network and the schedule of the rest of frames is synthesized again, so it is saved and checked as usual
+
+ @param options pointer to the options of the scheduler
+ @param deadline absolute time when the time budget ends
+ @return 0 if the schedule was found, -1 if not found or so problem happened
+ */
+int synthesize_schedule(SchedulerOptions *options, struct timeval deadline) {
+    
+    SchedulerOptions subset_options;    // Options to schedule again without the frames left out
+    SchedulerOptions exact_options;     // Options to schedule again in ns when the granularity finds no schedule
+    Solver csolver = options->solver;   // State the constraint solver we want to use
+    int status;                         // Result of the solver
+    
+    // Prepare the network and the solver, and add all the constraints
+    if (add_constraints(csolver, options) == -1) {
+        return -1;
+    }
+    // Only the constraints are measured, the network is left without schedule
+    if (options->constraints_only) {
+        close_solver(csolver);
+        reset_network();
+        return 0;
+    }
     
     // Solve the logical context and get the schedule if it exist
-    gettimeofday(&start_time_solver, NULL);
-    if (check_solver(csolver) == -1) {
+    start_phase(phase_solve);
+    if (options->maximum_subset) {
+        status = search_maximum_subset(csolver, options, deadline);
+    } else if (options->time_budget > 0 || get_memory_limit() > 0) {
+        status = check_solver_with_budget(csolver, deadline, NULL);
+    } else {
+        status = check_solver(csolver);
+    }
+    end_phase(phase_solve);
+    // A strict limit takes a whole unit of the granularity, so when no schedule is found in it (or frames are left
+    // out) the network is searched again in ns, where they can still fit
+    if (!time_budget_exceeded && options->macrotick <= 0 && get_solver_granularity() > 1 &&
+        (status == -1 || (options->maximum_subset && num_dropped_frames > 0))) {
+        printf("No schedule found in the time granularity of %lld ns, searching again in ns\n",
+               get_solver_granularity());
+        close_solver(csolver);
+        reset_network();
+        num_dropped_frames = 0;
+        exact_options = *options;
+        exact_options.macrotick = 1;
+        return synthesize_schedule(&exact_options, deadline);
+    }
+    if (status == -1 && time_budget_exceeded) {
+        printf("The time budget ended before a schedule was found\n");
+        close_solver(csolver);
+        return -1;
+    }
+    if (status == -1) {
         printf("The constraints were unsatisfiable, no schedule was found\n");
+        close_solver(csolver);
         return -1;
     }
-    gettimeofday(&end_time_solver, NULL);
-    printf("Time to solve in ms => %f\n", time_diff(start_time_solver, end_time_solver));
+    if (options->verbose) {
+        printf("Time to solve in ms => %f\n", get_phase_time(phase_solve));
+    }
     
-    // Save the values obtained by the solver
+    // Remove the frames left out and schedule the rest again, now known to be satisfiable
+    if (options->maximum_subset && num_dropped_frames > 0) {
+        close_solver(csolver);
+        if (options->verbose) {
+            printf("Frames left out of the schedule => %d\n", num_dropped_frames);
+        }
+        reset_network();
+        for (int i = 0; i < num_dropped_frames; i++) {
+            remove_frame(dropped_frames[i]);
+        }
+        subset_options = *options;
+        subset_options.maximum_subset = 0;
+        return synthesize_schedule(&subset_options, deadline);
+    }
+    
+    // Save the values obtained by the solver, after that the solver is not needed anymore
+    start_phase(phase_extract);
     save_offsets(csolver);
+    close_solver(csolver);
+    end_phase(phase_extract);
     
     // Check if the scheduled done is correct
-    gettimeofday(&start_time_check, NULL);
-    if (check_schedule_correctness() == -1) {
-        printf("The schedule is not correct\n");
+    if (options->check_schedule) {
+        start_phase(phase_validate);
+        status = validate_schedule(options->num_threads);
+        end_phase(phase_validate);
+        if (status != 0) {
+            printf("The schedule is not correct, %d violations found\n", get_number_violations());
+            return -1;
+        }
+        if (options->verbose) {
+            printf("Time check schedule in ms => %f\n", get_phase_time(phase_validate));
+        }
+    }
+    
+    return 0;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Init the scheduler options with the default values (yices2, schedule checked in parallel and times printed)
+ */
+void init_scheduler_options(SchedulerOptions *options) {
+    
+    options->solver = yices2;
+    options->check_schedule = 1;
+    options->num_threads = 0;
+    options->verbose = 1;
+    options->previous_schedule = NULL;
+    options->previous_compact = NULL;
+    options->movable_frames = NULL;
+    options->num_movable_frames = 0;
+    options->movable_links = NULL;
+    options->num_movable_links = 0;
+    options->time_budget = 0;
+    options->maximum_subset = 0;
+    options->frame_priorities = NULL;
+    options->num_frame_priorities = 0;
+    options->constraints_only = 0;
+    options->macrotick = 0;
+}
+
+/**
+ Synthesizes the schedule of the network already loaded in memory (parsed or built with the network functions).
+ It inits the network and the solver, adds all the constraints, solves them and saves the offsets found in the frames
+ */
+int schedule_network(SchedulerOptions *options) {
+    
+    SchedulerOptions default_options;   // Options used if none are given
+    struct timeval deadline;            // Time when the time budget ends
+    
+    if (options == NULL) {
+        init_scheduler_options(&default_options);
+        options = &default_options;
+    }
+    time_budget_exceeded = 0;
+    num_dropped_frames = 0;
+    // Without time budget the deadline never arrives, the watchdog of the solver only checks the memory limit
+    gettimeofday(&deadline, NULL);
+    deadline.tv_sec += options->time_budget > 0 ? options->time_budget / 1000 : UNLIMITED_BUDGET;
+    deadline.tv_usec += (options->time_budget % 1000) * 1000;
+    if (deadline.tv_usec >= 1000000) {
+        deadline.tv_sec++;
+        deadline.tv_usec -= 1000000;
+    }
+    
+    return synthesize_schedule(options, deadline);
+}
+
+/**
+ Writes the constraints of the network in memory in a SMT-LIB2 file, as they are added to synthesize its schedule
+ */
+int export_constraints(char *namefile, SchedulerOptions *options) {
+    
+    SchedulerOptions default_options;   // Options used if none are given
+    
+    if (options == NULL) {
+        init_scheduler_options(&default_options);
+        options = &default_options;
+    }
+    if (set_smtlib2_file(namefile) == -1) {
+        return -1;
+    }
+    if (add_constraints(smtlib2, options) == -1) {
+        reset_network();
+        return -1;
+    }
+    close_solver(smtlib2);
+    if (options->verbose) {
+        printf("Variables written => %d, formulas written => %d\n", get_number_variables(), get_number_formulas());
+    }
+    reset_network();
+    return 0;
+}
+
+/**
+ Tells if the last schedule was not found because the time budget ended
+ */
+int is_time_budget_exceeded(void) {
+    
+    return time_budget_exceeded;
+}
+
+/**
+ Get the number of frames left out of the last schedule
+ */
+int get_number_dropped_frames(void) {
+    
+    return num_dropped_frames;
+}
+
+/**
+ Get a frame left out of the last schedule
+ */
+int get_dropped_frame(int index) {
+    
+    if (index < 0 || index >= num_dropped_frames) {
+        return -1;
+    }
+    return dropped_frames[index];
+}
+
+/**
+ Produces the schedule solving all constraints in one call to the SMT Solver for a given network.
+ It inits the solver and the network.
+ It starts creating all the constraints (one variable for each transmission offset), then adds constraints relating
+ different offsets. At the end solves the logical context and the model obtained is the solver.
+ It creates an xml file with the output schedule.
+ It also creates different constraint files for every switch in the network containing specific constraints for each
+ switch
+ */
+int one_shot_scheduling(char *network_file, char *param_file) {
+    
+    int status;
+    
+    gettimeofday(&start_time_total, NULL);
+    reset_metrics(network_file);
+    
+    // Read the network file and parse it into internal memory (the parse time is printed by the parser)
+    start_phase(phase_parse);
+    status = parse_network_xml(network_file);
+    end_phase(phase_parse);
+    if (status == -1) {
+        printf("The network file could not be parsed\n");
+        return -1;
+    }
+    
+    // Synthesize the schedule with the default options
+    if (schedule_network(NULL) == -1) {
         return -1;
     }
-    gettimeofday(&end_time_check, NULL);
-    printf("Time check schedule in ms => %f\n", time_diff(start_time_check, end_time_check));
     
     gettimeofday(&end_time_total, NULL);
     printf("Total time in ms => %f\n", time_diff(start_time_total, end_time_total));
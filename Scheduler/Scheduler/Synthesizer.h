@@ -21,11 +21,35 @@
 #define Synthesizer_h
 
 #include <stdio.h>
+#include <sys/time.h>
+#include "ConstraintSolver.h"
 
 #endif /* Synthesizer_h */
 
                                                 /* STRUCT DEFINITIONS */
 
+/**
+ Options that modify how a schedule is synthesized for the network loaded in memory
+ */
+typedef struct SchedulerOptions {
+    Solver solver;                      // Constraint solver used to synthesize the schedule
+    int check_schedule;                 // 1 to check the correctness of the schedule found, 0 to skip it
+    int num_threads;                    // Threads used to check the schedule, 0 for one per available processor
+    int verbose;                        // 1 to print the time spent in every phase, 0 to stay silent
+    char *previous_schedule;            // Schedule file (xml or compact) whose offsets are kept, NULL for none
+    struct CompactSchedule *previous_compact;   // Schedule in memory whose offsets are kept if there is no file
+    int *movable_frames;                // Frames that can change their offsets from the previous schedule
+    int num_movable_frames;             // Number of movable frames
+    int *movable_links;                 // Links where the frames transmitted can change their offsets
+    int num_movable_links;              // Number of movable links
+    long long int time_budget;          // Maximum time in ms to synthesize the schedule, 0 for no limit
+    int maximum_subset;                 // 1 to leave out the frames that prevent a schedule, 0 to fail instead
+    int *frame_priorities;              // Priority of every frame to be kept when frames are left out, higher first
+    int num_frame_priorities;           // Number of priorities, the frames without priority have priority 1
+    int constraints_only;               // 1 to only add the constraints without solving them (to measure them)
+    long long int macrotick;            // Time unit in ns of the solver, 0 for the exact granularity of the network
+}SchedulerOptions;
+
                                                 /* AUXILIAR FUNCTIONS */
 
 /**
@@ -39,6 +63,70 @@ double time_diff(struct timeval x , struct timeval y);
 
                                                 /* CODE DEFINITIONS */
 
+/**
+ Init the scheduler options with the default values (yices2, schedule checked in parallel and times printed)
+
+ @param options pointer to the options to init
+ */
+void init_scheduler_options(SchedulerOptions *options);
+
+/**
+ Synthesizes the schedule of the network already loaded in memory (parsed or built with the network functions).
+ It inits the network and the solver, adds all the constraints, solves them and saves the offsets found in the frames.
+ If a previous schedule is given in the options, the frames that are not movable and still fit in their previous
+ offsets are pinned to them, so the solver only searches the offsets of the rest of frames.
+ If a time budget is given, the search of the solver is stopped when the budget ends.
+ The offsets are searched in the time granularity of the network (see get_time_granularity), where every frame fits
+ as in ns, or in the macrotick given, that can lose schedules, so the solver handles smaller integers, and they are
+ saved in ns. If no schedule is found in the granularity of the network (or frames are left out), it is searched again
+ in ns, so no schedule is lost.
+ With the maximum subset option, the constraints of every frame are guarded and the frames that prevent a schedule are
+ left out (see get_number_dropped_frames): the least important frame of every unsatisfiable core found by the solver
+ is left out until the rest are satisfiable, then the frames left out that still fit are added back. The schedule of
+ the frames kept is then synthesized again without the rest.
+ With the constraints only option, the solver is closed once all the constraints are added and the network is left
+ as it was, without schedule
+
+ @param options pointer to the options of the scheduler, NULL to use the default ones
+ @return 0 if the schedule was found, -1 if not found or so problem happened
+ */
+int schedule_network(SchedulerOptions *options);
+
+/**
+ Writes the constraints of the network in memory in a SMT-LIB2 file, exactly as they are added into the solver to
+ synthesize its schedule (with the frames pinned to the previous schedule of the options as constants), so other
+ solvers can be benchmarked offline with the same problem. Every constraint is written as it is added, without
+ keeping the problem in memory. The network is left as it was, so it can still be scheduled
+
+ @param namefile path and name of the SMT-LIB2 file to create
+ @param options pointer to the options of the scheduler, NULL to use the default ones. The solver is ignored
+ @return 0 if the file was written, -1 otherwise
+ */
+int export_constraints(char *namefile, SchedulerOptions *options);
+
+/**
+ Tells if the last schedule was not found because the solver was stopped when the time budget of the options ended
+
+ @return 1 if the time budget was exceeded, 0 otherwise
+ */
+int is_time_budget_exceeded(void);
+
+/**
+ Get the number of frames left out of the last schedule synthesized with the maximum subset option. Such frames are
+ removed from the network (they keep their identifiers but have no paths), so they are not in the schedule
+
+ @return number of frames left out, 0 if all frames were scheduled
+ */
+int get_number_dropped_frames(void);
+
+/**
+ Get a frame left out of the last schedule, sorted by identifier
+
+ @param index index of the frame left out, from 0 to the number of frames left out - 1
+ @return identifier of the frame, -1 if the index is not valid
+ */
+int get_dropped_frame(int index);
+
 /**
  Produces the schedule solving all constraints in one call to the SMT Solver for a given network.
  It inits the solver and the network.
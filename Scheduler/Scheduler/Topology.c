@@ -0,0 +1,592 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Topology.c                                                                                                         *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Topology.h                                                                                          *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Topology.h"
+#include <stdlib.h>
+#include <string.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Element of the priority queue of the Dijkstra search
+ */
+typedef struct SearchEntry {
+    double cost;                        // Cost to reach the node
+    int node;
+}SearchEntry;
+
+/**
+ Growable list of paths, used for the paths found and the candidates of the Yen algorithm
+ */
+typedef struct PathList {
+    int num_paths;
+    int max_paths;
+    int **links;                        // Links of every path
+    int *lengths;                       // Number of links of every path
+    double *costs;                      // Cost of every path
+}PathList;
+
+                                                    /* VARIABLES */
+
+// Nodes read from the network, with the links connected to them as compressed rows
+int num_described_nodes = 0;
+int max_described_nodes = 0;
+NodeCategory *node_categories = NULL;
+int *connection_starts = NULL;          // Index where the connections of every node start, one more than nodes
+int *connection_links = NULL;           // Links connected to all nodes one after another
+int max_connection_links = 0;
+
+// Graph to search paths, with the outgoing links of every node as compressed rows
+int graph_built = 0;                    // 1 if the graph and the costs are ready
+int graph_num_nodes = 0;
+int *graph_starts = NULL;               // Index where the outgoing links of every node start
+int *graph_links = NULL;                // Outgoing links of all nodes one after another
+PathRanking graph_ranking = rank_hops;  // Ranking used for the costs of the links and the cached paths
+double *link_costs = NULL;              // Cost of every link, negative if it cannot be used
+PathSet **path_cache = NULL;            // Paths found for every source and destination, NULL if not searched yet
+
+// Memory of the Dijkstra searches
+double *search_costs = NULL;            // Cost to reach every node
+int *search_previous = NULL;            // Link used to reach every node, -1 if not reached
+char *search_done = NULL;               // 1 if the node has its final cost
+SearchEntry *search_queue = NULL;       // Binary heap with the nodes to expand
+char *blocked_links = NULL;             // Links that the search cannot use
+char *blocked_nodes = NULL;             // Nodes that the search cannot use
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Computes the cost of every link for the given ranking. The load of a link is the utilization of the frames whose
+ paths use it (a frame sent to several receivers is counted once in the links shared by its paths), a link full or
+ failed cannot be used
+
+ @param ranking criteria to rank the paths
+ */
+void compute_link_costs(PathRanking ranking) {
+    
+    Frame *frame_pt;
+    Path *path_it;
+    double *utilization;
+    int *last_frame;                    // Last frame counted in every link
+    
+    utilization = calloc(get_number_links() + 1, sizeof(double));
+    last_frame = malloc(sizeof(int) * (get_number_links() + 1));
+    for (int i = 0; i <= get_number_links(); i++) {
+        last_frame[i] = -1;
+    }
+    if (ranking == rank_load) {
+        for (int i = 0; i < get_number_frames(); i++) {
+            frame_pt = get_frame(i);
+            if (get_period(frame_pt) <= 0) {
+                continue;
+            }
+            for (int j = 0; j < get_num_paths(frame_pt); j++) {
+                for (path_it = get_path_root(frame_pt, j); !is_last_path(path_it); path_it = get_next_path(path_it)) {
+                    if (last_frame[path_it->link] == i) {
+                        continue;
+                    }
+                    last_frame[path_it->link] = i;
+                    utilization[path_it->link] += ((double) get_size(frame_pt) * 1000 /
+                                                   get_link_speed(get_link(path_it->link))) / get_period(frame_pt);
+                }
+            }
+        }
+    }
+    
+    for (int i = 0; i < get_number_links(); i++) {
+        if (is_link_failed(get_link(i))) {
+            link_costs[i] = -1;
+        } else if (ranking == rank_hops) {
+            link_costs[i] = 1;
+        } else if (ranking == rank_latency) {
+            link_costs[i] = get_hop_delay() + (double) MAXIMUM_FRAME_SIZE * 1000 / get_link_speed(get_link(i));
+        } else {
+            link_costs[i] = utilization[i] < 1 ? 1 / (1 - utilization[i]) : -1;
+        }
+    }
+    free(utilization);
+    free(last_frame);
+}
+
+/**
+ Builds the graph with the outgoing links of every node, the costs of the links and the memory of the searches
+
+ @param ranking criteria to rank the paths
+ */
+void build_graph(PathRanking ranking) {
+    
+    int source, *next;
+    
+    graph_num_nodes = get_number_topology_nodes();
+    graph_starts = calloc(graph_num_nodes + 1, sizeof(int));
+    graph_links = malloc(sizeof(int) * (get_number_links() + 1));
+    
+    // Count the outgoing links of every node, and then place every link after the previous ones of its node
+    for (int i = 0; i < get_number_links(); i++) {
+        source = get_link_source(get_link(i));
+        if (source >= 0 && source < graph_num_nodes && get_link_destination(get_link(i)) >= 0) {
+            graph_starts[source + 1]++;
+        }
+    }
+    for (int i = 0; i < graph_num_nodes; i++) {
+        graph_starts[i + 1] += graph_starts[i];
+    }
+    next = calloc(graph_num_nodes + 1, sizeof(int));
+    for (int i = 0; i < get_number_links(); i++) {
+        source = get_link_source(get_link(i));
+        if (source >= 0 && source < graph_num_nodes && get_link_destination(get_link(i)) >= 0) {
+            graph_links[graph_starts[source] + next[source]++] = i;
+        }
+    }
+    free(next);
+    
+    link_costs = malloc(sizeof(double) * (get_number_links() + 1));
+    compute_link_costs(ranking);
+    graph_ranking = ranking;
+    path_cache = calloc((size_t) graph_num_nodes * graph_num_nodes + 1, sizeof(PathSet *));
+    search_costs = malloc(sizeof(double) * (graph_num_nodes + 1));
+    search_previous = malloc(sizeof(int) * (graph_num_nodes + 1));
+    search_done = malloc(sizeof(char) * (graph_num_nodes + 1));
+    search_queue = malloc(sizeof(SearchEntry) * (get_number_links() + 2));
+    blocked_links = calloc(get_number_links() + 1, sizeof(char));
+    blocked_nodes = calloc(graph_num_nodes + 1, sizeof(char));
+    graph_built = 1;
+}
+
+/**
+ Frees a set of paths
+
+ @param path_set pointer to the set of paths
+ */
+void free_path_set(PathSet *path_set) {
+    
+    if (path_set != NULL) {
+        free(path_set->starts);
+        free(path_set->links);
+        free(path_set->costs);
+        free(path_set);
+    }
+}
+
+/**
+ Adds an entry to the priority queue of the search
+
+ @param size pointer to the number of entries of the queue
+ @param cost cost to reach the node
+ @param node identifier of the node
+ */
+void push_search_entry(int *size, double cost, int node) {
+    
+    int position = (*size)++, parent;
+    SearchEntry entry = {cost, node};
+    
+    while (position > 0) {
+        parent = (position - 1) / 2;
+        if (search_queue[parent].cost <= cost) {
+            break;
+        }
+        search_queue[position] = search_queue[parent];
+        position = parent;
+    }
+    search_queue[position] = entry;
+}
+
+/**
+ Removes the entry with the lowest cost from the priority queue of the search
+
+ @param size pointer to the number of entries of the queue
+ @return entry with the lowest cost
+ */
+SearchEntry pop_search_entry(int *size) {
+    
+    SearchEntry first = search_queue[0], last = search_queue[--(*size)];
+    int position = 0, child;
+    
+    while ((child = position * 2 + 1) < *size) {
+        if (child + 1 < *size && search_queue[child + 1].cost < search_queue[child].cost) {
+            child++;
+        }
+        if (last.cost <= search_queue[child].cost) {
+            break;
+        }
+        search_queue[position] = search_queue[child];
+        position = child;
+    }
+    search_queue[position] = last;
+    return first;
+}
+
+/**
+ Finds the path with the lowest cost between two nodes with a Dijkstra search, that does not use the blocked links and
+ nodes nor the links that cannot be used, and does not relay in end systems
+
+ @param source node where the path starts
+ @param destination node where the path ends
+ @param path array where the links of the path are saved, its size has to be at least the number of nodes
+ @param cost pointer where the cost of the path is saved
+ @return number of links of the path, -1 if there is no path
+ */
+int search_path(int source, int destination, int *path, double *cost) {
+    
+    SearchEntry entry;
+    int size = 0, node, next, link, length = 0;
+    
+    for (int i = 0; i < graph_num_nodes; i++) {
+        search_costs[i] = -1;
+        search_previous[i] = -1;
+        search_done[i] = 0;
+    }
+    search_costs[source] = 0;
+    push_search_entry(&size, 0, source);
+    while (size > 0) {
+        entry = pop_search_entry(&size);
+        node = entry.node;
+        if (search_done[node]) {
+            continue;
+        }
+        search_done[node] = 1;
+        if (node == destination) {
+            break;
+        }
+        if (node != source && get_node_category(node) == end_system_node) {
+            continue;
+        }
+        for (int i = graph_starts[node]; i < graph_starts[node + 1]; i++) {
+            link = graph_links[i];
+            next = get_link_destination(get_link(link));
+            if (link_costs[link] < 0 || blocked_links[link] || next >= graph_num_nodes || blocked_nodes[next] ||
+                search_done[next]) {
+                continue;
+            }
+            if (search_costs[next] < 0 || entry.cost + link_costs[link] < search_costs[next]) {
+                search_costs[next] = entry.cost + link_costs[link];
+                search_previous[next] = link;
+                push_search_entry(&size, search_costs[next], next);
+            }
+        }
+    }
+    if (source == destination || !search_done[destination]) {
+        return -1;
+    }
+    
+    // Follow the links back from the destination and then reverse them
+    for (node = destination; node != source; node = get_link_source(get_link(search_previous[node]))) {
+        path[length++] = search_previous[node];
+    }
+    for (int i = 0; i < length / 2; i++) {
+        link = path[i];
+        path[i] = path[length - 1 - i];
+        path[length - 1 - i] = link;
+    }
+    *cost = search_costs[destination];
+    return length;
+}
+
+/**
+ Tells if a list of paths already has the given path
+
+ @param list pointer to the list
+ @param path array with the links of the path
+ @param length number of links of the path
+ @return 1 if found, 0 otherwise
+ */
+int has_path(PathList *list, int *path, int length) {
+    
+    for (int i = 0; i < list->num_paths; i++) {
+        if (list->lengths[i] == length && memcmp(list->links[i], path, sizeof(int) * length) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Adds a copy of a path at the end of a list of paths
+
+ @param list pointer to the list
+ @param path array with the links of the path
+ @param length number of links of the path
+ @param cost cost of the path
+ */
+void append_path(PathList *list, int *path, int length, double cost) {
+    
+    if (list->num_paths == list->max_paths) {
+        list->max_paths = list->max_paths * 2 + 4;
+        list->links = realloc(list->links, sizeof(int *) * list->max_paths);
+        list->lengths = realloc(list->lengths, sizeof(int) * list->max_paths);
+        list->costs = realloc(list->costs, sizeof(double) * list->max_paths);
+    }
+    list->links[list->num_paths] = malloc(sizeof(int) * (length + 1));
+    memcpy(list->links[list->num_paths], path, sizeof(int) * length);
+    list->lengths[list->num_paths] = length;
+    list->costs[list->num_paths] = cost;
+    list->num_paths++;
+}
+
+/**
+ Frees the paths of a list of paths
+
+ @param list pointer to the list
+ */
+void free_path_list(PathList *list) {
+    
+    for (int i = 0; i < list->num_paths; i++) {
+        free(list->links[i]);
+    }
+    free(list->links);
+    free(list->lengths);
+    free(list->costs);
+}
+
+/**
+ Finds the k shortest loop free paths between two nodes with the Yen algorithm. Every new path deviates from the
+ previous one at one of its nodes (the spur node), keeping the links before it (the root path) and searching the rest
+ without the links that the paths already found take after the same root, nor the nodes of the root
+
+ @param source node where the paths start
+ @param destination node where the paths end
+ @param k maximum number of paths to find
+ @return pointer to the set of paths found
+ */
+PathSet * search_k_shortest_paths(int source, int destination, int k) {
+    
+    PathList found = {0}, candidates = {0};
+    PathSet *path_set;
+    int *previous, *candidate, *spur_path, length, spur, best, total = 0;
+    double root_cost, spur_cost;
+    
+    candidate = malloc(sizeof(int) * (graph_num_nodes + 1));
+    spur_path = malloc(sizeof(int) * (graph_num_nodes + 1));
+    length = search_path(source, destination, candidate, &spur_cost);
+    if (length > 0) {
+        append_path(&found, candidate, length, spur_cost);
+    }
+    
+    while (found.num_paths > 0 && found.num_paths < k) {
+        previous = found.links[found.num_paths - 1];
+        spur = source;
+        root_cost = 0;
+        for (int i = 0; i < found.lengths[found.num_paths - 1]; i++) {
+            // Block the next link of the paths with the same root, and the nodes of the root
+            for (int j = 0; j < found.num_paths; j++) {
+                if (found.lengths[j] > i && memcmp(found.links[j], previous, sizeof(int) * i) == 0) {
+                    blocked_links[found.links[j][i]] = 1;
+                }
+            }
+            for (int j = 0; j < i; j++) {
+                blocked_nodes[get_link_source(get_link(previous[j]))] = 1;
+            }
+            
+            length = search_path(spur, destination, spur_path, &spur_cost);
+            if (length > 0) {
+                memcpy(candidate, previous, sizeof(int) * i);
+                memcpy(candidate + i, spur_path, sizeof(int) * length);
+                if (!has_path(&found, candidate, i + length) && !has_path(&candidates, candidate, i + length)) {
+                    append_path(&candidates, candidate, i + length, root_cost + spur_cost);
+                }
+            }
+            
+            memset(blocked_links, 0, sizeof(char) * get_number_links());
+            memset(blocked_nodes, 0, sizeof(char) * graph_num_nodes);
+            root_cost += link_costs[previous[i]];
+            spur = get_link_destination(get_link(previous[i]));
+        }
+        if (candidates.num_paths == 0) {
+            break;
+        }
+        
+        // Move the best candidate (fewer links if the cost is the same) to the paths found
+        best = 0;
+        for (int i = 1; i < candidates.num_paths; i++) {
+            if (candidates.costs[i] < candidates.costs[best] ||
+                (candidates.costs[i] == candidates.costs[best] && candidates.lengths[i] < candidates.lengths[best])) {
+                best = i;
+            }
+        }
+        append_path(&found, candidates.links[best], candidates.lengths[best], candidates.costs[best]);
+        free(candidates.links[best]);
+        candidates.num_paths--;
+        candidates.links[best] = candidates.links[candidates.num_paths];
+        candidates.lengths[best] = candidates.lengths[candidates.num_paths];
+        candidates.costs[best] = candidates.costs[candidates.num_paths];
+    }
+    
+    // Save the paths found as compressed rows
+    path_set = malloc(sizeof(PathSet));
+    path_set->num_paths = found.num_paths;
+    path_set->max_paths = k;
+    path_set->starts = malloc(sizeof(int) * (found.num_paths + 1));
+    path_set->costs = malloc(sizeof(double) * (found.num_paths + 1));
+    for (int i = 0; i < found.num_paths; i++) {
+        total += found.lengths[i];
+    }
+    path_set->links = malloc(sizeof(int) * (total + 1));
+    path_set->starts[0] = 0;
+    for (int i = 0; i < found.num_paths; i++) {
+        memcpy(&path_set->links[path_set->starts[i]], found.links[i], sizeof(int) * found.lengths[i]);
+        path_set->starts[i + 1] = path_set->starts[i] + found.lengths[i];
+        path_set->costs[i] = found.costs[i];
+    }
+    free_path_list(&found);
+    free_path_list(&candidates);
+    free(candidate);
+    free(spur_path);
+    return path_set;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Adds a node after the last node of the network, with the links connected to its ports
+ */
+int add_node(NodeCategory category, int num_connections, int *connections) {
+    
+    for (int i = 0; i < num_connections; i++) {
+        if (connections[i] < 0 || connections[i] >= get_number_links()) {
+            printf("The link %d connected to the node %d does not exist\n", connections[i], num_described_nodes);
+            return -1;
+        }
+    }
+    if (num_described_nodes == max_described_nodes) {
+        max_described_nodes = max_described_nodes * 2 + 16;
+        node_categories = realloc(node_categories, sizeof(NodeCategory) * max_described_nodes);
+        connection_starts = realloc(connection_starts, sizeof(int) * (max_described_nodes + 1));
+        if (num_described_nodes == 0) {
+            connection_starts[0] = 0;
+        }
+    }
+    if (connection_starts[num_described_nodes] + num_connections > max_connection_links) {
+        max_connection_links = (connection_starts[num_described_nodes] + num_connections) * 2;
+        connection_links = realloc(connection_links, sizeof(int) * max_connection_links);
+    }
+    
+    node_categories[num_described_nodes] = category;
+    memcpy(&connection_links[connection_starts[num_described_nodes]], connections, sizeof(int) * num_connections);
+    connection_starts[num_described_nodes + 1] = connection_starts[num_described_nodes] + num_connections;
+    invalidate_topology_paths();
+    return num_described_nodes++;
+}
+
+/**
+ Get the number of nodes of the topology
+ */
+int get_number_topology_nodes(void) {
+    
+    return num_described_nodes > get_number_nodes() ? num_described_nodes : get_number_nodes();
+}
+
+/**
+ Get the number of nodes read from the Nodes section of the network
+ */
+int get_number_described_nodes(void) {
+    
+    return num_described_nodes;
+}
+
+/**
+ Get the category of a node
+ */
+NodeCategory get_node_category(int node_id) {
+    
+    if (node_id < 0 || node_id >= num_described_nodes) {
+        return unknown_node;
+    }
+    return node_categories[node_id];
+}
+
+/**
+ Get the number of links connected to a node read from the network
+ */
+int get_node_number_connections(int node_id) {
+    
+    if (node_id < 0 || node_id >= num_described_nodes) {
+        return 0;
+    }
+    return connection_starts[node_id + 1] - connection_starts[node_id];
+}
+
+/**
+ Get a link connected to a node read from the network
+ */
+int get_node_connection(int node_id, int index) {
+    
+    return connection_links[connection_starts[node_id] + index];
+}
+
+/**
+ Get the k best loop free paths between two nodes that do not use any failed link, nor relay in end systems
+ */
+PathSet * get_k_shortest_paths(int source, int destination, int k, PathRanking ranking) {
+    
+    PathSet **cached;
+    
+    if (graph_built && ranking != graph_ranking) {
+        invalidate_topology_paths();
+    }
+    if (!graph_built) {
+        build_graph(ranking);
+    }
+    if (source < 0 || destination < 0 || source >= graph_num_nodes || destination >= graph_num_nodes || k <= 0) {
+        return NULL;
+    }
+    
+    // The cached paths are enough if they are as many as needed, or if there are no more paths
+    cached = &path_cache[(size_t) source * graph_num_nodes + destination];
+    if (*cached != NULL && ((*cached)->max_paths >= k || (*cached)->num_paths < (*cached)->max_paths)) {
+        return *cached;
+    }
+    free_path_set(*cached);
+    *cached = search_k_shortest_paths(source, destination, k);
+    return *cached;
+}
+
+/**
+ Removes all the paths of the cache and the graph
+ */
+void invalidate_topology_paths(void) {
+    
+    if (!graph_built) {
+        return;
+    }
+    for (size_t i = 0; i < (size_t) graph_num_nodes * graph_num_nodes; i++) {
+        free_path_set(path_cache[i]);
+    }
+    free(path_cache);
+    free(graph_starts);
+    free(graph_links);
+    free(link_costs);
+    free(search_costs);
+    free(search_previous);
+    free(search_done);
+    free(search_queue);
+    free(blocked_links);
+    free(blocked_nodes);
+    path_cache = NULL;
+    graph_built = 0;
+}
+
+/**
+ Frees the nodes, the graph and the cached paths
+ */
+void free_topology(void) {
+    
+    invalidate_topology_paths();
+    free(node_categories);
+    free(connection_starts);
+    free(connection_links);
+    node_categories = NULL;
+    connection_starts = NULL;
+    connection_links = NULL;
+    num_described_nodes = 0;
+    max_described_nodes = 0;
+    max_connection_links = 0;
+}
@@ -0,0 +1,136 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Topology.h                                                                                                         *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package with the nodes of the network and the search of alternative paths between them.                            *
+ *  The nodes are read from the Nodes section of the network, with their category and the links connected to their     *
+ *  ports, and saved as compressed rows (an array with the index where the connections of every node start, and an     *
+ *  array with all the connected links one after another). The graph used to search paths is built from the nodes      *
+ *  where every link starts and ends, also as compressed rows with the outgoing links of every node.                   *
+ *  The k shortest loop free paths between two nodes are found with the algorithm of Yen, over Dijkstra searches that  *
+ *  skip the failed links and do not relay frames through end systems. The paths are ranked by number of hops, by the  *
+ *  load of their links (every link costs 1 / (1 - utilization), so paths avoid the busiest links) or by their latency *
+ *  (switch delay plus the transmission of a maximum size frame in every link). The paths found between every source   *
+ *  and destination are cached until a link fails or the frames change their paths.                                    *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Topology_h
+#define Topology_h
+
+#include <stdio.h>
+#include "Network.h"
+
+#endif /* Topology_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define MAXIMUM_FRAME_SIZE 1522         // Bytes of the biggest Ethernet frame, used to rank paths by latency
+
+/**
+ Category of a node
+ */
+typedef enum NodeCategory {
+    unknown_node,                       // The network has no information of the node, it can relay frames
+    switch_node,                        // Relays frames between its ports
+    end_system_node                     // Only sends and receives frames, it cannot relay them
+}NodeCategory;
+
+/**
+ Criteria to rank the paths between two nodes
+ */
+typedef enum PathRanking {
+    rank_hops,                          // Number of links of the path
+    rank_load,                          // Sum of 1 / (1 - utilization) of the links of the path
+    rank_latency                        // Sum of the switch delay and the transmission time of the links of the path
+}PathRanking;
+
+/**
+ Set of paths between two nodes, ordered from the best to the worst, stored as compressed rows
+ */
+typedef struct PathSet {
+    int num_paths;                      // Number of paths found
+    int max_paths;                      // Number of paths that were searched, there are no more if num_paths is less
+    int *starts;                        // Index in the links array where every path starts, num_paths + 1 elements
+    int *links;                         // Links of all the paths one after another
+    double *costs;                      // Cost of every path for the ranking used
+}PathSet;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Adds a node after the last node of the network, with the links connected to its ports
+
+ @param category category of the node
+ @param num_connections number of links connected to the node
+ @param connections array with the links connected to the node
+ @return identifier of the node, -1 if any link does not exist
+ */
+int add_node(NodeCategory category, int num_connections, int *connections);
+
+/**
+ Get the number of nodes of the topology, the nodes read from the network or, if there are none, the nodes connected
+ by the links
+
+ @return number of nodes
+ */
+int get_number_topology_nodes(void);
+
+/**
+ Get the number of nodes read from the Nodes section of the network
+
+ @return number of nodes read, 0 if the network has no nodes section
+ */
+int get_number_described_nodes(void);
+
+/**
+ Get the category of a node
+
+ @param node_id identifier of the node
+ @return category of the node, unknown_node if the network has no information of it
+ */
+NodeCategory get_node_category(int node_id);
+
+/**
+ Get the number of links connected to a node read from the network
+
+ @param node_id identifier of the node
+ @return number of links connected
+ */
+int get_node_number_connections(int node_id);
+
+/**
+ Get a link connected to a node read from the network
+
+ @param node_id identifier of the node
+ @param index index of the connection, from 0 to the number of connections - 1
+ @return identifier of the link
+ */
+int get_node_connection(int node_id, int index);
+
+/**
+ Get the k best loop free paths between two nodes that do not use any failed link, nor relay in end systems.
+ The paths are cached and returned again while no link fails, the ranking is the same and no more paths are needed
+
+ @param source node where the paths start
+ @param destination node where the paths end
+ @param k maximum number of paths to find
+ @param ranking criteria to rank the paths
+ @return pointer to the set of paths (it belongs to the cache, do not free it), NULL if the nodes do not exist
+ */
+PathSet * get_k_shortest_paths(int source, int destination, int k, PathRanking ranking);
+
+/**
+ Removes all the paths of the cache and the graph, so they are searched again with the current failed links and load
+ of the links. It has to be called when a link fails or the paths of the frames change
+ */
+void invalidate_topology_paths(void);
+
+/**
+ Frees the nodes, the graph and the cached paths
+ */
+void free_topology(void);
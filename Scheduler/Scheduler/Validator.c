@@ -0,0 +1,765 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Validator.c                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Description in Validator.h                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Validator.h"
+#include "Metrics.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Growable list of violations, every thread fills its own list to avoid locks
+ */
+typedef struct ViolationList {
+    Violation *violations;              // Array of violations
+    int num_violations;                 // Number of violations in the array
+    int size;                           // Allocated size of the array
+}ViolationList;
+
+/**
+ Work shared by all the threads of a validation, every thread takes the next item (link or frame) until all done
+ */
+typedef struct ValidationWork {
+    int next_item;                      // Next item to validate, taken atomically by the threads
+    int num_items;                      // Number of items to validate
+    void (*validate_item)(int item, ViolationList *list);   // Function that validates one item
+}ValidationWork;
+
+/**
+ Arguments of every validation thread
+ */
+typedef struct ValidationThread {
+    pthread_t thread;                   // Thread identifier
+    ValidationWork *work;               // Work shared by all threads
+    ViolationList list;                 // Violations found by the thread
+}ValidationThread;
+
+/**
+ Timeline of a link kept after a validation, with the occupancy of the link to validate changed frames later
+ */
+typedef struct LinkTimeline {
+    Transmission *transmissions;        // Transmissions of the link sorted by starting time
+    int num_transmissions;              // Number of transmissions in the link
+    long long int max_length;           // Longest transmission in the link, to bound the searches in the timeline
+}LinkTimeline;
+
+                                                    /* VARIABLES */
+
+ViolationList found_violations;         // Violations found in the last validation
+LinkTimeline *link_timelines = NULL;    // Cached timeline of every link from the last validation
+int num_timeline_links = 0;             // Number of links with a cached timeline
+int **frame_timeline_links = NULL;      // For every frame, links where it is in the cached timelines
+int *frame_num_timeline_links = NULL;   // For every frame, number of links where it is in the cached timelines
+int num_timeline_frames = 0;            // Number of frames in the cached timelines
+char *modified_frames = NULL;           // Marks the frames being validated in an incremental validation
+int *modified_links = NULL;             // Links touched by the frames being validated in an incremental validation
+int *modified_frame_ids = NULL;         // Frames being validated in an incremental validation
+int num_modified_frames = 0;            // Number of frames being validated in an incremental validation
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Adds a violation to the given list of violations
+
+ @param list pointer to the list of violations
+ @param type type of the violation
+ @param frame frame that violates the constraint
+ @param link link where the violation happens
+ @param instance instance of the frame
+ @param replica replica of the frame
+ @param other_frame colliding frame or -1
+ @param other_instance instance of the colliding frame or -1
+ @param time transmission time where the violation happens
+ */
+void add_violation(ViolationList *list, ViolationType type, int frame, int link, int instance, int replica,
+                   int other_frame, int other_instance, long long int time) {
+    
+    Violation *violation_pt;
+    
+    if (list->num_violations == list->size) {
+        list->size = list->size == 0 ? 16 : list->size * 2;
+        list->violations = realloc(list->violations, sizeof(Violation) * list->size);
+    }
+    violation_pt = &list->violations[list->num_violations];
+    violation_pt->type = type;
+    violation_pt->frame = frame;
+    violation_pt->link = link;
+    violation_pt->instance = instance;
+    violation_pt->replica = replica;
+    violation_pt->other_frame = other_frame;
+    violation_pt->other_instance = other_instance;
+    violation_pt->time = time;
+    list->num_violations++;
+}
+
+/**
+ Compares two transmissions by starting time, to sort timelines with qsort
+
+ @param a pointer to the first transmission
+ @param b pointer to the second transmission
+ @return negative if a starts before b, positive if after, 0 if at the same time
+ */
+int compare_transmissions(const void *a, const void *b) {
+    
+    const Transmission *t1 = a, *t2 = b;
+    
+    if (t1->start != t2->start) {
+        return t1->start < t2->start ? -1 : 1;
+    }
+    return t1->frame - t2->frame;
+}
+
+/**
+ Compares two violations by frame, link, instance and type, to report them always in the same order
+
+ @param a pointer to the first violation
+ @param b pointer to the second violation
+ @return negative if a goes before b, positive if after, 0 if equal
+ */
+int compare_violations(const void *a, const void *b) {
+    
+    const Violation *v1 = a, *v2 = b;
+    
+    if (v1->frame != v2->frame) {
+        return v1->frame - v2->frame;
+    }
+    if (v1->link != v2->link) {
+        return v1->link - v2->link;
+    }
+    if (v1->instance != v2->instance) {
+        return v1->instance - v2->instance;
+    }
+    return (int)v1->type - (int)v2->type;
+}
+
+/**
+ Get the longest transmission of a timeline
+
+ @param timeline array of transmissions
+ @param num_transmissions number of transmissions in the array
+ @return longest transmission time in ns
+ */
+long long int get_max_length(Transmission *timeline, int num_transmissions) {
+    
+    long long int max_length = 0;
+    
+    for (int i = 0; i < num_transmissions; i++) {
+        if (timeline[i].end - timeline[i].start > max_length) {
+            max_length = timeline[i].end - timeline[i].start;
+        }
+    }
+    return max_length;
+}
+
+/**
+ Checks that no transmissions collide in the link with a linear sweep over its sorted timeline.
+ A transmission has to start after the end of all the previous ones plus the time between frames, so it is enough
+ to compare it with the previous transmission that finishes the latest.
+ The timeline is kept as occupancy of the link for later incremental validations
+
+ @param link_id identifier of the link
+ @param list list where to save the violations found
+ */
+void validate_link(int link_id, ViolationList *list) {
+    
+    Transmission *timeline;             // Sorted transmissions of the link
+    int num_transmissions;              // Number of transmissions in the timeline
+    int latest = 0;                     // Index of the transmission that finishes the latest so far
+    long long int time_between_frames = get_time_between_frames();
+    
+    timeline = build_link_timeline(link_id, &num_transmissions);
+    for (int i = 1; i < num_transmissions; i++) {
+        if (timeline[i].start < timeline[latest].end + time_between_frames) {
+            add_violation(list, collision, timeline[i].frame, link_id, timeline[i].instance, timeline[i].replica,
+                          timeline[latest].frame, timeline[latest].instance, timeline[i].start);
+        }
+        if (timeline[i].end > timeline[latest].end) {
+            latest = i;
+        }
+    }
+    
+    link_timelines[link_id].transmissions = timeline;
+    link_timelines[link_id].num_transmissions = num_transmissions;
+    link_timelines[link_id].max_length = get_max_length(timeline, num_transmissions);
+}
+
+/**
+ Builds the timeline of the given link only with the transmissions of the modified frames, sorted by starting time
+
+ @param link_id identifier of the link
+ @param num_transmissions pointer where to save the number of transmissions of the timeline
+ @return array with the transmissions sorted by starting time (to free by the caller)
+ */
+Transmission * build_modified_timeline(int link_id, int *num_transmissions) {
+    
+    Transmission *timeline;
+    Offset *offset_pt;
+    int size = 0;
+    int position = 0;
+    
+    for (int i = 0; i < num_modified_frames; i++) {
+        offset_pt = get_frame_offset_by_link(get_frame(modified_frame_ids[i]), link_id);
+        if (offset_pt != NULL) {
+            size += get_number_instances(offset_pt) * (get_number_replicas(offset_pt) + 1);
+        }
+    }
+    timeline = malloc(sizeof(Transmission) * (size > 0 ? size : 1));
+    
+    for (int i = 0; i < num_modified_frames; i++) {
+        offset_pt = get_frame_offset_by_link(get_frame(modified_frame_ids[i]), link_id);
+        if (offset_pt == NULL) {
+            continue;
+        }
+        for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+            for (int replica = 0; replica <= get_number_replicas(offset_pt); replica++) {
+                timeline[position].start = get_offset(offset_pt, instance, replica);
+                timeline[position].end = timeline[position].start + get_timeslot_size(offset_pt);
+                timeline[position].frame = modified_frame_ids[i];
+                timeline[position].instance = instance;
+                timeline[position].replica = replica;
+                position++;
+            }
+        }
+    }
+    
+    qsort(timeline, size, sizeof(Transmission), compare_transmissions);
+    *num_transmissions = size;
+    return timeline;
+}
+
+/**
+ Checks that the transmissions of the modified frames in the link do not collide with the occupancy of the link from
+ the last validation nor between them. Then updates the occupancy of the link with the new transmissions.
+ The occupancy is sorted, so for every new transmission we only look at the transmissions that start close to it
+
+ @param item position of the link in the modified links
+ @param list list where to save the violations found
+ */
+void validate_modified_link(int item, ViolationList *list) {
+    
+    int link_id = modified_links[item];
+    LinkTimeline *cached_pt = &link_timelines[link_id];
+    Transmission *timeline;             // Sorted transmissions of the modified frames in the link
+    Transmission *occupancy;            // New occupancy of the link
+    int num_transmissions;              // Number of transmissions in the new occupancy
+    int num_modified;                   // Number of transmissions of the modified frames
+    int latest = 0;                     // Index of the modified transmission that finishes the latest so far
+    int low, high, middle;              // Indexes for the binary search
+    int position;                       // Position in the cached timeline
+    long long int time_between_frames = get_time_between_frames();
+    Transmission *cached;
+    
+    // Build the timeline with the transmissions of the modified frames in the link
+    timeline = build_modified_timeline(link_id, &num_modified);
+    
+    for (int i = 0; i < num_modified; i++) {
+        
+        // Collisions between modified frames, with the same sweep as in the complete validation
+        if (i > 0) {
+            if (timeline[i].start < timeline[latest].end + time_between_frames) {
+                add_violation(list, collision, timeline[i].frame, link_id, timeline[i].instance, timeline[i].replica,
+                              timeline[latest].frame, timeline[latest].instance, timeline[i].start);
+            }
+            if (timeline[i].end > timeline[latest].end) {
+                latest = i;
+            }
+        }
+        
+        // Binary search of the first transmission in the occupancy that could collide with the new transmission
+        low = 0;
+        high = cached_pt->num_transmissions;
+        while (low < high) {
+            middle = (low + high) / 2;
+            if (cached_pt->transmissions[middle].start <
+                timeline[i].start - cached_pt->max_length - time_between_frames) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        
+        // Check all the transmissions of not modified frames that start before the new one ends
+        for (position = low; position < cached_pt->num_transmissions; position++) {
+            cached = &cached_pt->transmissions[position];
+            if (cached->start >= timeline[i].end + time_between_frames) {
+                break;
+            }
+            if (modified_frames[cached->frame]) {
+                continue;
+            }
+            if (cached->end + time_between_frames > timeline[i].start) {
+                add_violation(list, collision, timeline[i].frame, link_id, timeline[i].instance, timeline[i].replica,
+                              cached->frame, cached->instance, timeline[i].start);
+            }
+        }
+    }
+    
+    // Merge the occupancy without the modified frames and the new transmissions, both sorted
+    occupancy = malloc(sizeof(Transmission) * (cached_pt->num_transmissions + num_modified + 1));
+    num_transmissions = 0;
+    position = 0;
+    for (int i = 0; i < cached_pt->num_transmissions; i++) {
+        cached = &cached_pt->transmissions[i];
+        if (modified_frames[cached->frame]) {
+            continue;
+        }
+        while (position < num_modified && compare_transmissions(&timeline[position], cached) < 0) {
+            occupancy[num_transmissions++] = timeline[position++];
+        }
+        occupancy[num_transmissions++] = *cached;
+    }
+    while (position < num_modified) {
+        occupancy[num_transmissions++] = timeline[position++];
+    }
+    
+    free(cached_pt->transmissions);
+    free(timeline);
+    cached_pt->transmissions = occupancy;
+    cached_pt->num_transmissions = num_transmissions;
+    cached_pt->max_length = get_max_length(occupancy, num_transmissions);
+}
+
+/**
+ Checks that all the instances and replicas of the frame are periodic and inside its starting time and deadline, and
+ that all its paths satisfy the path dependency and the end to end delay in every instance
+
+ @param frame_id identifier of the frame
+ @param list list where to save the violations found
+ */
+void validate_frame(int frame_id, ViolationList *list) {
+    
+    Frame *frame_pt = get_frame(frame_id);
+    Offset *offset_it, *next_offset_pt, *first_offset_pt;
+    Path *path_it;
+    long long int period = get_period(frame_pt);
+    long long int transmission, first_transmission, next_transmission;
+    int hop_delay = get_hop_delay();
+    
+    // Check the range and periodicity of all the instances and replicas in all the links
+    offset_it = get_offset_root(frame_pt);
+    while (offset_it != NULL && !is_last_offset(offset_it)) {
+        for (int instance = 0; instance < get_number_instances(offset_it); instance++) {
+            for (int replica = 0; replica <= get_number_replicas(offset_it); replica++) {
+                transmission = get_offset(offset_it, instance, replica);
+                if (transmission < (period * instance) + get_starting(frame_pt) ||
+                    transmission + get_timeslot_size(offset_it) > (period * instance) + get_deadline(frame_pt)) {
+                    add_violation(list, out_of_range, frame_id, get_offset_link(offset_it), instance, replica, -1,
+                                  -1, transmission);
+                }
+                if (transmission != get_offset(offset_it, 0, replica) + (period * instance)) {
+                    add_violation(list, not_periodic, frame_id, get_offset_link(offset_it), instance, replica, -1,
+                                  -1, transmission);
+                }
+            }
+        }
+        offset_it = get_next_offset(offset_it);
+    }
+    
+    // Check the path dependency and end to end delay of all the instances of every path
+    for (int path_id = 0; path_id < get_num_paths(frame_pt); path_id++) {
+        path_it = get_path_root(frame_pt, path_id);
+        first_offset_pt = get_offset_from_path(path_it);
+        while (!is_last_path(path_it)) {
+            offset_it = get_offset_from_path(path_it);
+            path_it = get_next_path(path_it);
+            for (int instance = 0; instance < get_number_instances(offset_it); instance++) {
+                transmission = get_offset(offset_it, instance, 0);
+                if (!is_last_path(path_it)) {
+                    // The next link can only be transmitted once the frame is received and relayed by the switch
+                    next_offset_pt = get_offset_from_path(path_it);
+                    next_transmission = get_offset(next_offset_pt, instance, 0);
+                    if (next_transmission < transmission + get_timeslot_size(offset_it) + hop_delay) {
+                        add_violation(list, path_dependency, frame_id, get_offset_link(next_offset_pt), instance, 0,
+                                      get_offset_link(offset_it), instance, next_transmission);
+                    }
+                } else {
+                    // Last link of the path, check the end to end delay from the first transmission
+                    first_transmission = get_offset(first_offset_pt, instance, 0);
+                    if (transmission + get_timeslot_size(offset_it) - first_transmission >
+                        get_end_to_end_delay(frame_pt)) {
+                        add_violation(list, end_to_end, frame_id, get_offset_link(offset_it), instance, 0, -1, -1,
+                                      transmission);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ Checks the frame in the given position of the modified frames
+
+ @param item position of the frame in the modified frames
+ @param list list where to save the violations found
+ */
+void validate_modified_frame(int item, ViolationList *list) {
+    
+    validate_frame(modified_frame_ids[item], list);
+}
+
+/**
+ Saves the links where the given frame is transmitted, to know which occupancies have to be updated if it changes
+
+ @param frame_id identifier of the frame
+ */
+void save_frame_timeline_links(int frame_id) {
+    
+    Offset *offset_it;
+    int num_links = 0;
+    
+    offset_it = get_offset_root(get_frame(frame_id));
+    while (offset_it != NULL && !is_last_offset(offset_it)) {
+        num_links++;
+        offset_it = get_next_offset(offset_it);
+    }
+    free(frame_timeline_links[frame_id]);
+    frame_timeline_links[frame_id] = malloc(sizeof(int) * (num_links + 1));
+    frame_num_timeline_links[frame_id] = num_links;
+    
+    num_links = 0;
+    offset_it = get_offset_root(get_frame(frame_id));
+    while (offset_it != NULL && !is_last_offset(offset_it)) {
+        frame_timeline_links[frame_id][num_links++] = get_offset_link(offset_it);
+        offset_it = get_next_offset(offset_it);
+    }
+}
+
+/**
+ Frees the cached timelines of all links
+ */
+void free_link_timelines(void) {
+    
+    for (int i = 0; i < num_timeline_links; i++) {
+        free(link_timelines[i].transmissions);
+    }
+    for (int i = 0; i < num_timeline_frames; i++) {
+        free(frame_timeline_links[i]);
+    }
+    free(link_timelines);
+    free(frame_timeline_links);
+    free(frame_num_timeline_links);
+    link_timelines = NULL;
+    frame_timeline_links = NULL;
+    frame_num_timeline_links = NULL;
+    num_timeline_links = 0;
+    num_timeline_frames = 0;
+}
+
+/**
+ Number of threads to use given the requested ones
+
+ @param num_threads number of threads requested, 0 to use one per available processor
+ @return number of threads to use
+ */
+int get_validation_threads(int num_threads) {
+    
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads <= 0) {
+            num_threads = 1;
+        }
+    }
+    return num_threads;
+}
+
+/**
+ Validation thread, takes items from the shared work until there are no more items
+
+ @param argument pointer to the validation thread arguments
+ @return NULL
+ */
+void * validation_thread(void *argument) {
+    
+    ValidationThread *thread_pt = argument;
+    ValidationWork *work = thread_pt->work;
+    long long int span = start_trace_span();
+    int item;
+    
+    item = __sync_fetch_and_add(&work->next_item, 1);
+    while (item < work->num_items) {
+        work->validate_item(item, &thread_pt->list);
+        item = __sync_fetch_and_add(&work->next_item, 1);
+    }
+    end_trace_span("validation thread", span);
+    return NULL;
+}
+
+/**
+ Validates all the items with the given function in parallel, and adds the violations to the found violations
+
+ @param num_items number of items to validate
+ @param validate_item function that validates one item
+ @param num_threads number of threads to use
+ */
+void validate_in_parallel(int num_items, void (*validate_item)(int item, ViolationList *list), int num_threads) {
+    
+    ValidationWork work;
+    ValidationThread *threads;
+    
+    work.next_item = 0;
+    work.num_items = num_items;
+    work.validate_item = validate_item;
+    if (num_threads > num_items) {
+        num_threads = num_items > 0 ? num_items : 1;
+    }
+    
+    threads = calloc(num_threads, sizeof(ValidationThread));
+    for (int i = 0; i < num_threads; i++) {
+        threads[i].work = &work;
+        if (i > 0 && pthread_create(&threads[i].thread, NULL, validation_thread, &threads[i]) != 0) {
+            threads[i].work = NULL;     // If the thread cannot be created, the rest of threads do its work
+        }
+    }
+    validation_thread(&threads[0]);     // The calling thread also validates
+    
+    // Wait for all threads and collect its violations
+    for (int i = 0; i < num_threads; i++) {
+        if (i > 0 && threads[i].work != NULL) {
+            pthread_join(threads[i].thread, NULL);
+        }
+        for (int j = 0; j < threads[i].list.num_violations; j++) {
+            add_violation(&found_violations, threads[i].list.violations[j].type, threads[i].list.violations[j].frame,
+                          threads[i].list.violations[j].link, threads[i].list.violations[j].instance,
+                          threads[i].list.violations[j].replica, threads[i].list.violations[j].other_frame,
+                          threads[i].list.violations[j].other_instance, threads[i].list.violations[j].time);
+        }
+        free(threads[i].list.violations);
+    }
+    free(threads);
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Builds the timeline of the given link with all the transmissions of all instances and replicas of all offsets in the
+ link, sorted by starting time
+ */
+Transmission * build_link_timeline(int link_id, int *num_transmissions) {
+    
+    Transmission *timeline;
+    Offset *offset_pt;
+    int frame_id;
+    int size = 0;
+    int position = 0;
+    
+    // Count the transmissions to allocate the timeline at once
+    for (int i = 0; i < get_link_number_offsets(link_id); i++) {
+        offset_pt = get_link_offset(link_id, i);
+        size += get_number_instances(offset_pt) * (get_number_replicas(offset_pt) + 1);
+    }
+    timeline = malloc(sizeof(Transmission) * (size > 0 ? size : 1));
+    
+    for (int i = 0; i < get_link_number_offsets(link_id); i++) {
+        offset_pt = get_link_offset(link_id, i);
+        frame_id = get_link_offset_frame(link_id, i);
+        for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+            for (int replica = 0; replica <= get_number_replicas(offset_pt); replica++) {
+                timeline[position].start = get_offset(offset_pt, instance, replica);
+                timeline[position].end = timeline[position].start + get_timeslot_size(offset_pt);
+                timeline[position].frame = frame_id;
+                timeline[position].instance = instance;
+                timeline[position].replica = replica;
+                position++;
+            }
+        }
+    }
+    
+    qsort(timeline, size, sizeof(Transmission), compare_transmissions);
+    *num_transmissions = size;
+    return timeline;
+}
+
+/**
+ Checks that the schedule stored in the network satisfies all the constraints, for all instances and replicas.
+ Links and frames are checked in parallel, and all the violations found are saved and printed
+ */
+int validate_schedule(int num_threads) {
+    
+    free_violations();
+    num_threads = get_validation_threads(num_threads);
+    
+    // The timelines of the links are kept as occupancy for the incremental validations
+    free_link_timelines();
+    num_timeline_links = get_number_links();
+    link_timelines = calloc(num_timeline_links, sizeof(LinkTimeline));
+    num_timeline_frames = get_number_frames();
+    frame_timeline_links = calloc(num_timeline_frames, sizeof(int *));
+    frame_num_timeline_links = calloc(num_timeline_frames, sizeof(int));
+    for (int i = 0; i < num_timeline_frames; i++) {
+        save_frame_timeline_links(i);
+    }
+    
+    validate_in_parallel(get_number_links(), validate_link, num_threads);
+    validate_in_parallel(get_number_frames(), validate_frame, num_threads);
+    
+    if (found_violations.num_violations > 0) {
+        qsort(found_violations.violations, found_violations.num_violations, sizeof(Violation), compare_violations);
+        print_violations();
+    }
+    return found_violations.num_violations;
+}
+
+/**
+ Checks only the given modified frames against the occupancy of the links they touch from the last validation, and
+ their own range, periodicity, path dependency and end to end delay
+ */
+int validate_frames(int *frame_ids, int num_frames, int num_threads) {
+    
+    char *touched_links;                // Marks the links already added to the modified links
+    int num_modified_links = 0;         // Number of links touched by the modified frames
+    Offset *offset_it;
+    int link;
+    
+    // Without occupancy from a previous validation, all the schedule has to be validated
+    if (link_timelines == NULL || num_timeline_links != get_number_links()) {
+        return validate_schedule(num_threads);
+    }
+    
+    free_violations();
+    num_threads = get_validation_threads(num_threads);
+    
+    // New frames could have been added to the network since the last validation
+    if (get_number_frames() > num_timeline_frames) {
+        frame_timeline_links = realloc(frame_timeline_links, sizeof(int *) * get_number_frames());
+        frame_num_timeline_links = realloc(frame_num_timeline_links, sizeof(int) * get_number_frames());
+        for (int i = num_timeline_frames; i < get_number_frames(); i++) {
+            frame_timeline_links[i] = NULL;
+            frame_num_timeline_links[i] = 0;
+        }
+        num_timeline_frames = get_number_frames();
+    }
+    
+    // Mark the modified frames and collect the links they touch now and touched in the last validation
+    modified_frames = calloc(num_timeline_frames, sizeof(char));
+    touched_links = calloc(get_number_links(), sizeof(char));
+    modified_links = malloc(sizeof(int) * get_number_links());
+    modified_frame_ids = frame_ids;
+    num_modified_frames = num_frames;
+    for (int i = 0; i < num_frames; i++) {
+        modified_frames[frame_ids[i]] = 1;
+        for (int j = 0; j < frame_num_timeline_links[frame_ids[i]]; j++) {
+            link = frame_timeline_links[frame_ids[i]][j];
+            if (!touched_links[link]) {
+                touched_links[link] = 1;
+                modified_links[num_modified_links++] = link;
+            }
+        }
+        offset_it = get_offset_root(get_frame(frame_ids[i]));
+        while (offset_it != NULL && !is_last_offset(offset_it)) {
+            link = get_offset_link(offset_it);
+            if (!touched_links[link]) {
+                touched_links[link] = 1;
+                modified_links[num_modified_links++] = link;
+            }
+            offset_it = get_next_offset(offset_it);
+        }
+    }
+    
+    validate_in_parallel(num_modified_links, validate_modified_link, num_threads);
+    validate_in_parallel(num_frames, validate_modified_frame, num_threads);
+    
+    // The modified frames are now in the occupancy of its new links
+    for (int i = 0; i < num_frames; i++) {
+        save_frame_timeline_links(frame_ids[i]);
+    }
+    free(modified_frames);
+    free(modified_links);
+    free(touched_links);
+    modified_frames = NULL;
+    modified_links = NULL;
+    modified_frame_ids = NULL;
+    num_modified_frames = 0;
+    
+    if (found_violations.num_violations > 0) {
+        qsort(found_violations.violations, found_violations.num_violations, sizeof(Violation), compare_violations);
+        print_violations();
+    }
+    return found_violations.num_violations;
+}
+
+/**
+ Get the number of violations found in the last validation
+ */
+int get_number_violations(void) {
+    
+    return found_violations.num_violations;
+}
+
+/**
+ Get a violation found in the last validation
+ */
+Violation * get_violation(int violation_id) {
+    
+    return &found_violations.violations[violation_id];
+}
+
+/**
+ Prints all the violations found in the last validation
+ */
+void print_violations(void) {
+    
+    Violation *violation_pt;
+    
+    for (int i = 0; i < found_violations.num_violations; i++) {
+        violation_pt = &found_violations.violations[i];
+        switch (violation_pt->type) {
+            case collision:
+                printf("Error, frame %d instance %d replica %d collides with frame %d instance %d in link %d at %lld\n",
+                       violation_pt->frame, violation_pt->instance, violation_pt->replica, violation_pt->other_frame,
+                       violation_pt->other_instance, violation_pt->link, violation_pt->time);
+                break;
+            case out_of_range:
+                printf("Error, frame %d instance %d replica %d in link %d at %lld is out of its starting and "
+                       "deadline\n", violation_pt->frame, violation_pt->instance, violation_pt->replica, violation_pt->link,
+                       violation_pt->time);
+                break;
+            case not_periodic:
+                printf("Error, frame %d instance %d replica %d in link %d at %lld is not periodic\n",
+                       violation_pt->frame, violation_pt->instance, violation_pt->replica, violation_pt->link,
+                       violation_pt->time);
+                break;
+            case path_dependency:
+                printf("Error, frame %d instance %d in link %d at %lld is transmitted before link %d is relayed\n",
+                       violation_pt->frame, violation_pt->instance, violation_pt->link, violation_pt->time,
+                       violation_pt->other_frame);
+                break;
+            case end_to_end:
+                printf("Error, frame %d instance %d ending in link %d at %lld exceeds its end to end delay\n",
+                       violation_pt->frame, violation_pt->instance, violation_pt->link, violation_pt->time);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ Frees the violations and the occupancy of the links of the last validation
+ */
+void free_validator(void) {
+    
+    free_violations();
+    free_link_timelines();
+}
+
+/**
+ Frees the violations of the last validation
+ */
+void free_violations(void) {
+    
+    free(found_violations.violations);
+    found_violations.violations = NULL;
+    found_violations.num_violations = 0;
+    found_violations.size = 0;
+}
@@ -0,0 +1,129 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Validator.h                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Package that validates the schedule stored in the network.                                                         *
+ *  Instead of comparing every offset with every other offset, for every link it builds a timeline with all the        *
+ *  transmissions of all instances and replicas in the hyperperiod sorted by starting time, and checks collisions and  *
+ *  the time between frames with a linear sweep. Links are validated in parallel, and then frames (deadlines,          *
+ *  periodicity, path dependency and end to end delays) also in parallel.                                              *
+ *  All violations are collected and reported, not only the first one found.                                           *
+ *  The timelines are kept as occupancy of the links, so after a local change only the modified frames have to be     *
+ *  checked against the links they touch (incremental validation).                                                     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Validator_h
+#define Validator_h
+
+#include <stdio.h>
+#include "Network.h"
+
+#endif /* Validator_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Types of violations that can be found in a schedule
+ */
+typedef enum ViolationType {
+    collision,                          // Two transmissions share the link or do not respect the time between frames
+    out_of_range,                       // A transmission starts before its starting time or ends after its deadline
+    not_periodic,                       // An instance is not transmitted one period after the previous one
+    path_dependency,                    // A link in a path is transmitted before the previous link has finished
+    end_to_end                          // A path takes more time than the end to end delay of the frame
+}ViolationType;
+
+/**
+ Information of a violation found in the schedule
+ */
+typedef struct Violation {
+    ViolationType type;                 // Type of the violation
+    int frame;                          // Frame that violates the constraint
+    int link;                           // Link where the violation happens
+    int instance;                       // Instance of the frame that violates the constraint
+    int replica;                        // Replica of the frame that violates the constraint
+    int other_frame;                    // Frame colliding or previous link in the path (-1 if not needed)
+    int other_instance;                 // Instance of the colliding frame (-1 if not needed)
+    long long int time;                 // Transmission time in ns where the violation happens
+}Violation;
+
+/**
+ Transmission of an instance and replica of a frame in a link
+ */
+typedef struct Transmission {
+    long long int start;                // Starting transmission time in ns
+    long long int end;                  // Ending transmission time in ns (start + timeslots)
+    int frame;                          // Frame identifier of the transmission
+    int instance;                       // Instance of the transmission
+    int replica;                        // Replica of the transmission
+}Transmission;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Builds the timeline of the given link with all the transmissions of all instances and replicas of all offsets in the
+ link, sorted by starting time
+
+ @param link_id identifier of the link
+ @param num_transmissions pointer where to save the number of transmissions of the timeline
+ @return array with the transmissions of the link sorted by starting time (to free by the caller)
+ */
+Transmission * build_link_timeline(int link_id, int *num_transmissions);
+
+/**
+ Checks that the schedule stored in the network satisfies all the constraints, for all instances and replicas.
+ Links and frames are checked in parallel, and all the violations found are saved and printed
+
+ @param num_threads number of threads to use, 0 to use one per available processor
+ @return 0 if the schedule is correct, otherwise the number of violations found
+ */
+int validate_schedule(int num_threads);
+
+/**
+ Checks only the given modified frames (added, rerouted or with new offsets) against the occupancy of the links they
+ touch from the last validation, plus their own range, periodicity, path dependency and end to end delay.
+ The occupancy of the touched links is updated with the new transmissions. If there was no previous validation, the
+ whole schedule is validated. It gives the same guarantees as validate_schedule() if the rest of the schedule did not
+ change since the last validation
+
+ @param frame_ids array with the identifiers of the modified frames
+ @param num_frames number of modified frames
+ @param num_threads number of threads to use, 0 to use one per available processor
+ @return 0 if the modified frames are correct, otherwise the number of violations found
+ */
+int validate_frames(int *frame_ids, int num_frames, int num_threads);
+
+/**
+ Get the number of violations found in the last validation
+
+ @return number of violations
+ */
+int get_number_violations(void);
+
+/**
+ Get a violation found in the last validation
+
+ @param violation_id index of the violation (from 0 to number of violations - 1)
+ @return pointer to the violation
+ */
+Violation * get_violation(int violation_id);
+
+/**
+ Prints all the violations found in the last validation
+ */
+void print_violations(void);
+
+/**
+ Frees the violations and the occupancy of the links of the last validation
+ */
+void free_validator(void);
+
+/**
+ Frees the violations of the last validation
+ */
+void free_violations(void);
@@ -6,19 +6,396 @@
  *  Created by Francisco Pozo on 15/09/17.                                                                             *
  *  Copyright © 2017 Francisco Pozo. All rights reserved.                                                              *
  *                                                                                                                     *
+ *  Command line client of the scheduler library                                                                       *
+ *  Usage: Scheduler [options] network.xml|network.srsn schedule.xml|schedule.srss|schedule.srst                       *
+ *  The schedule is written in xml, or in the binary (.srss) or text (.srst) compact formats                           *
+ *  The options can also write the gate control lists of the ports and the delta with a previous schedule, see --help  *
+ *  A previous schedule can be given to keep the offsets of the frames that are not affected by a change               *
+ *  The metrics of every run can be appended to a JSON lines or CSV file, and its phases traced in a Chrome trace      *
+ *  Batch mode: Scheduler [options] --batch manifest|directory [--workers N] [--output DIR] [--summary FILE]           *
+ *  Daemon mode: Scheduler [options] --daemon socket [--sessions N], the requests are described in Daemon.h            *
+ *  Contingency mode: Scheduler [options] --contingency network --output DIR [--nodes] [--workers N]                   *
+ *  With --max-subset the frames that prevent a schedule are left out, and the rest are scheduled                      *
+ *  Advisor mode: Scheduler --advise network [--tolerance PERCENT], reports how the periods inflate the hyperperiod    *
+ *  Export mode: Scheduler [options] --smtlib FILE network, writes the constraints in SMT-LIB2 instead of solving them *
+ *  With --memory-limit the run exits with status 3 and its metrics when the process exceeds the memory given          *
+ *  The offsets are searched in the greatest time unit that loses no schedule, or in the one given with --macrotick    *
+ *                                                                                                                     *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <stdio.h>
-#include "Synthesizer.h"
-#include "IOInterface.h"
-#include <sys/time.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "Batch.h"
+#include "Daemon.h"
+#include "Contingency.h"
+#include "HyperperiodAdvisor.h"
+#include "Memory.h"
+
+                                                    /* VARIABLES */
+
+char *metrics_file = NULL;              // File where the metrics of the run are appended, NULL for none
+char *trace_file = NULL;                // File where the trace of the run is written, NULL for none
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Parses a list of identifiers separated by commas
+
+ @param list string with the identifiers
+ @param ids pointer where the allocated array of identifiers is saved
+ @return number of identifiers
+ */
+int parse_id_list(const char *list, int **ids) {
+    
+    char *end;
+    int num_ids = 0;
+    
+    *ids = malloc(sizeof(int) * (strlen(list) / 2 + 1));
+    while (*list != '\0') {
+        (*ids)[num_ids] = (int) strtol(list, &end, 10);
+        if (end == list) {          // Separator
+            list++;
+            continue;
+        }
+        num_ids++;
+        list = end;
+    }
+    return num_ids;
+}
+
+/**
+ Prints the usage of the command line client
+
+ @param program name of the program
+ */
+void print_usage(const char *program) {
+    
+    printf("Usage: %s [options] network.xml|network.srsn schedule.xml|schedule.srss|schedule.srst\n", program);
+    printf("       %s [options] --batch MANIFEST|DIRECTORY\n", program);
+    printf("       %s [options] --daemon SOCKET\n", program);
+    printf("       %s [options] --contingency NETWORK --output DIR\n", program);
+    printf("       %s --advise NETWORK [--tolerance PERCENT]\n", program);
+    printf("       %s [options] --smtlib FILE NETWORK\n", program);
+    printf("Options:\n");
+    printf("  --threads N            threads used to validate and write the schedule (0 for all processors)\n");
+    printf("  --no-check             do not validate the schedule\n");
+    printf("  --budget MS            maximum time to synthesize the schedule, the solver is stopped when it ends\n");
+    printf("  --gcl PREFIX           write the gate control lists of the ports in one file per node\n");
+    printf("  --gcl-limit N          maximum number of gate control list entries per port\n");
+    printf("  --delta-from FILE      previous compact schedule to compute the delta with the new schedule\n");
+    printf("  --delta PREFIX         write the delta schedule in one file per node (needs --delta-from)\n");
+    printf("  --previous FILE        keep the offsets of a previous schedule (xml or compact) for unaffected frames\n");
+    printf("  --movable-frames LIST  frames separated by commas that can change from the previous schedule\n");
+    printf("  --movable-links LIST   links separated by commas whose frames can change from the previous schedule\n");
+    printf("  --metrics FILE         append the metrics of the run to a JSON lines file (CSV if it ends in .csv)\n");
+    printf("  --trace FILE           write a Chrome trace with the phases and threads of the run\n");
+    printf("  --batch INPUT          schedule all networks of a manifest (network [schedule] per line) or directory\n");
+    printf("  --workers N            networks or failures scheduled at the same time in batch or contingency mode\n");
+    printf("  --output DIR           directory of the schedules in batch mode (next to the networks by default)\n");
+    printf("  --summary FILE         also write the summary table of the batch in a file\n");
+    printf("  --daemon SOCKET        serve scheduling requests in a Unix domain socket until SIGINT or SIGTERM\n");
+    printf("  --sessions N           sessions served at the same time in daemon mode (0 for all processors)\n");
+    printf("  --contingency NETWORK  precompute the repaired schedules of every link failure as deltas in --output\n");
+    printf("  --nodes                also precompute the failure of every node in contingency mode\n");
+    printf("  --ranking RANK         rank the alternative paths of failed frames by hops, load or latency\n");
+    printf("  --max-subset           leave out the frames that prevent a schedule and schedule the rest\n");
+    printf("  --priorities LIST      priority of every frame separated by commas, the lowest are left out first\n");
+    printf("  --dropped FILE         write the frames left out by --max-subset, one per line\n");
+    printf("  --advise NETWORK       report the instances and disjunctions of every frame and the changes of the\n");
+    printf("                         periods that shrink the hyperperiod\n");
+    printf("  --tolerance PERCENT    largest reduction of a period proposed by --advise (10 by default)\n");
+    printf("  --smtlib FILE          write the constraints in a SMT-LIB2 file instead of solving them\n");
+    printf("  --memory-limit MB      exit with status %d (and the metrics of the run) if the process exceeds it\n",
+           MEMORY_EXIT_STATUS);
+    printf("  --macrotick NS         time unit of the solver, the schedules found are correct but some can be lost\n");
+    printf("                         (by default the greatest unit that loses no schedule, 1 for ns)\n");
+}
+
+/**
+ Writes the metrics and the trace of the run, if they were requested
+
+ @param status exit status of the run
+ */
+void write_run_records(int status) {
+    
+    char *extension;
+    
+    if (metrics_file != NULL) {
+        extension = strrchr(metrics_file, '.');
+        srs_write_metrics(metrics_file, status, extension != NULL && strcmp(extension, ".csv") == 0);
+    }
+    if (trace_file != NULL) {
+        srs_write_trace(trace_file);
+    }
+}
 
-struct timeval start_time_write, end_time_write;              // Solver time
+/**
+ Handler of the memory limit, the metrics and trace of the run are written before the program exits
+ */
+void write_memory_limit_records(void) {
+    
+    write_run_records(MEMORY_EXIT_STATUS);
+}
 
-int main(int argc, const char * argv[]) {
+                                                    /* FUNCTIONS */
+
+int main(int argc, char * const argv[]) {
+    
+    SchedulerOptions options;           // Options of the scheduler
+    int result = 1;                     // Exit code of the program
+    char *gcl_prefix = NULL, *delta_previous = NULL, *delta_prefix = NULL;
+    char *batch_input = NULL, *batch_output = NULL, *batch_summary = NULL, *daemon_socket = NULL;
+    char *contingency_network = NULL, *dropped_file = NULL, *advise_network = NULL, *smtlib_file = NULL;
+    double tolerance = ADVISOR_TOLERANCE;
+    HyperperiodAnalysis analysis;
+    long long int memory_limit = 0;     // Memory limit of the process in MB, 0 for no limit
+    int gcl_limit = 0, num_workers = 0, num_sessions = 0, include_nodes = 0, option;
+    
+    static struct option long_options[] = {
+        {"threads", required_argument, NULL, 't'},
+        {"no-check", no_argument, NULL, 'n'},
+        {"budget", required_argument, NULL, 'B'},
+        {"gcl", required_argument, NULL, 'g'},
+        {"gcl-limit", required_argument, NULL, 'l'},
+        {"delta-from", required_argument, NULL, 'f'},
+        {"delta", required_argument, NULL, 'd'},
+        {"previous", required_argument, NULL, 'p'},
+        {"movable-frames", required_argument, NULL, 'm'},
+        {"movable-links", required_argument, NULL, 'k'},
+        {"metrics", required_argument, NULL, 'M'},
+        {"trace", required_argument, NULL, 'T'},
+        {"batch", required_argument, NULL, 'b'},
+        {"workers", required_argument, NULL, 'w'},
+        {"output", required_argument, NULL, 'o'},
+        {"summary", required_argument, NULL, 's'},
+        {"daemon", required_argument, NULL, 'D'},
+        {"sessions", required_argument, NULL, 'S'},
+        {"contingency", required_argument, NULL, 'C'},
+        {"nodes", no_argument, NULL, 'N'},
+        {"ranking", required_argument, NULL, 'r'},
+        {"max-subset", no_argument, NULL, 'x'},
+        {"priorities", required_argument, NULL, 'P'},
+        {"dropped", required_argument, NULL, 'L'},
+        {"advise", required_argument, NULL, 'A'},
+        {"tolerance", required_argument, NULL, 'E'},
+        {"smtlib", required_argument, NULL, 'F'},
+        {"memory-limit", required_argument, NULL, 'R'},
+        {"macrotick", required_argument, NULL, 'u'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    
+    init_scheduler_options(&options);
+    while ((option = getopt_long(argc, argv, "t:nB:g:l:f:d:p:m:k:M:T:b:w:o:s:D:S:C:Nr:xP:L:A:E:F:R:u:h", long_options,
+                                 NULL)) != -1) {
+        switch (option) {
+            case 't':
+                options.num_threads = atoi(optarg);
+                break;
+            case 'n':
+                options.check_schedule = 0;
+                break;
+            case 'B':
+                options.time_budget = atoll(optarg);
+                break;
+            case 'g':
+                gcl_prefix = optarg;
+                break;
+            case 'l':
+                gcl_limit = atoi(optarg);
+                break;
+            case 'f':
+                delta_previous = optarg;
+                break;
+            case 'd':
+                delta_prefix = optarg;
+                break;
+            case 'p':
+                options.previous_schedule = optarg;
+                break;
+            case 'm':
+                free(options.movable_frames);
+                options.num_movable_frames = parse_id_list(optarg, &options.movable_frames);
+                break;
+            case 'k':
+                free(options.movable_links);
+                options.num_movable_links = parse_id_list(optarg, &options.movable_links);
+                break;
+            case 'M':
+                metrics_file = optarg;
+                break;
+            case 'T':
+                trace_file = optarg;
+                break;
+            case 'b':
+                batch_input = optarg;
+                break;
+            case 'w':
+                num_workers = atoi(optarg);
+                break;
+            case 'o':
+                batch_output = optarg;
+                break;
+            case 's':
+                batch_summary = optarg;
+                break;
+            case 'D':
+                daemon_socket = optarg;
+                break;
+            case 'S':
+                num_sessions = atoi(optarg);
+                break;
+            case 'C':
+                contingency_network = optarg;
+                break;
+            case 'N':
+                include_nodes = 1;
+                break;
+            case 'r':
+                if (strcmp(optarg, "hops") == 0) {
+                    set_reroute_ranking(rank_hops);
+                } else if (strcmp(optarg, "load") == 0) {
+                    set_reroute_ranking(rank_load);
+                } else if (strcmp(optarg, "latency") == 0) {
+                    set_reroute_ranking(rank_latency);
+                } else {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'x':
+                options.maximum_subset = 1;
+                break;
+            case 'P':
+                free(options.frame_priorities);
+                options.num_frame_priorities = parse_id_list(optarg, &options.frame_priorities);
+                break;
+            case 'L':
+                dropped_file = optarg;
+                break;
+            case 'A':
+                advise_network = optarg;
+                break;
+            case 'E':
+                tolerance = atof(optarg) / 100;
+                break;
+            case 'F':
+                smtlib_file = optarg;
+                break;
+            case 'R':
+                memory_limit = atoll(optarg);
+                break;
+            case 'u':
+                options.macrotick = atoll(optarg);
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    // The limit applies to every worker in the modes with several processes, only a single run writes its metrics
+    srs_set_memory_limit(memory_limit, NULL);
     
-    if (one_shot_scheduling((char*) argv[1], NULL) != -1) {
-        write_schedule_xml((char*) argv[2]);
+    // Batch of networks, the program fails if any network is not scheduled
+    if (batch_input != NULL) {
+        srs_init();
+        result = schedule_batch(batch_input, batch_output, num_workers, &options, batch_summary) == 0 ? 0 : 1;
+        srs_exit();
+        free(options.movable_frames);
+        free(options.movable_links);
+        free(options.frame_priorities);
+        return result;
+    }
+    // Daemon that serves scheduling requests until it is stopped
+    if (daemon_socket != NULL) {
+        srs_init();
+        result = run_daemon(daemon_socket, num_sessions, &options) == 0 ? 0 : 1;
+        srs_exit();
+        free(options.movable_frames);
+        free(options.movable_links);
+        free(options.frame_priorities);
+        return result;
+    }
+    // Repaired schedules of every single failure, the program fails if any failure has no repair
+    if (contingency_network != NULL) {
+        if (batch_output == NULL) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        srs_init();
+        result = precompute_contingencies(contingency_network, batch_output, include_nodes, num_workers,
+                                          &options) == 0 ? 0 : 1;
+        srs_exit();
+        free(options.movable_frames);
+        free(options.movable_links);
+        free(options.frame_priorities);
+        return result;
+    }
+    // Analysis of the periods of a network, without scheduling it
+    if (advise_network != NULL) {
+        srs_init();
+        if (srs_load_network(advise_network) != -1 &&
+            analyze_hyperperiod(tolerance, ADVISOR_PROPOSALS, &analysis) != -1) {
+            print_hyperperiod_analysis(&analysis);
+            free_hyperperiod_analysis(&analysis);
+            result = 0;
+        }
+        srs_exit();
+        free(options.movable_frames);
+        free(options.movable_links);
+        free(options.frame_priorities);
+        return result;
+    }
+    // Constraints of the network written for other solvers, without scheduling it
+    if (smtlib_file != NULL) {
+        if (argc - optind < 1) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        srs_init();
+        if (srs_load_network(argv[optind]) != -1 && srs_export_constraints(smtlib_file, &options) != -1) {
+            result = 0;
+        }
+        srs_exit();
+        free(options.movable_frames);
+        free(options.movable_links);
+        free(options.frame_priorities);
+        return result;
     }
-    return 0;
+    if (argc - optind < 2 || (delta_prefix != NULL && delta_previous == NULL)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    srs_init();
+    srs_enable_trace(trace_file != NULL);
+    srs_set_memory_limit(memory_limit, write_memory_limit_records);
+    if (srs_load_network(argv[optind]) != -1 && srs_schedule(&options) != -1) {
+        if (srs_write_schedule(argv[optind + 1]) != -1) {
+            result = 0;
+        }
+        // Gate control lists of the ports, the program fails if any port exceeds the limit of entries
+        if (result == 0 && gcl_prefix != NULL &&
+            srs_write_gate_control_lists(gcl_prefix, gcl_limit, options.num_threads) != 0) {
+            result = 1;
+        }
+        // Only the changes with the previous schedule, to reconfigure the nodes after a regeneration
+        if (result == 0 && delta_prefix != NULL && srs_write_schedule_delta(delta_previous, delta_prefix) == -1) {
+            result = 1;
+        }
+        // Frames left out of the schedule to be able to schedule the rest
+        if (result == 0 && dropped_file != NULL && srs_write_dropped_frames(dropped_file) == -1) {
+            result = 1;
+        }
+    }
+    
+    // Metrics and trace of the run, written even if no schedule was found
+    write_run_records(result);
+    srs_exit();
+    free(options.movable_frames);
+    free(options.movable_links);
+    free(options.frame_priorities);
+    return result;
 }
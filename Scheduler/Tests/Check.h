@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Check.h                                                                                                            *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Minimal checks shared by the test programs run by make check.                                                      *
+ *  A failed check prints its file, line and expression (and both values if they are numbers) and is counted. Every    *
+ *  test program builds small networks and schedules by hand, so the expected results are known, and returns the       *
+ *  number of failed checks as exit code.                                                                              *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Check_h
+#define Check_h
+
+#include <stdio.h>
+
+#endif /* Check_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+static int check_failures = 0;          // Number of failed checks of the test program
+
+/**
+ Checks that the expression is true, otherwise prints it and counts the check as failed
+ */
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expression); \
+            check_failures++; \
+        } \
+    } while (0)
+
+/**
+ Checks that two integer numbers are equal, otherwise prints both and counts the check as failed
+ */
+#define CHECK_EQUAL(actual, expected) \
+    do { \
+        long long int check_actual = (long long int) (actual), check_expected = (long long int) (expected); \
+        if (check_actual != check_expected) { \
+            printf("%s:%d: check failed: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, check_actual, \
+                   check_expected); \
+            check_failures++; \
+        } \
+    } while (0)
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Prints the result of the test program
+
+ @param name name of the test program
+ @return number of failed checks, the exit code of the test program
+ */
+static int check_result(char *name) {
+    
+    if (check_failures > 0) {
+        printf("%s: %d checks failed\n", name, check_failures);
+    } else {
+        printf("%s: passed\n", name);
+    }
+    return check_failures;
+}
@@ -0,0 +1,136 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestAdmission.c                                                                                                    *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests the admission of new frames into a hand-built schedule, in the stages that do not need the solver. A frame   *
+ *  that fits in the free time of its links is placed by the first fit at the first free times that keep the time      *
+ *  between frames and the margins of the solver, and the schedule is still valid. The requests with wrong parameters, *
+ *  paths that are not connected or use failed links, and links without enough free time are rejected, and the         *
+ *  network keeps its frames and schedule.                                                                             *
+ *  Usage: TestAdmission                                                                                               *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <string.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "Validator.h"
+#include "Check.h"
+
+#define TEST_HYPERPERIOD 100000         // Hyperperiod of the network in ns
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates the network and its schedule, frame 0 goes through links 0 and 1 twice per hyperperiod, at 1000 and 3000 ns,
+ and frame 1 through links 2 and 1 once, at 10000 and 20000 ns. All transmissions take 1000 ns, with 100 ns between
+ frames and a hop delay of 1000 ns
+
+ @return 0 if created correctly, -1 otherwise
+ */
+int create_network(void) {
+    
+    int path_0[2] = {0, 1}, path_1[2] = {2, 1};
+    long long int transmissions[2][2] = {{1000, 3000}, {10000, 20000}};
+    Offset *offset_pt;
+    int status = 0;
+    
+    status += srs_new_network(2, 3, 1000, TEST_HYPERPERIOD, 0, 0, 100);
+    for (int i = 0; i < 3; i++) {
+        status += srs_add_link(i, 1000, wired);
+    }
+    status += srs_add_link_nodes(0, 0, 1);
+    status += srs_add_link_nodes(1, 1, 2);
+    status += srs_add_link_nodes(2, 3, 1);
+    status += srs_add_frame(0, 50000, 50000, 1000, 10000, 0, 1, 0);
+    status += srs_add_frame_path(0, 0, path_0, 2);
+    status += srs_add_frame(1, 100000, 100000, 1000, 20000, 0, 1, 0);
+    status += srs_add_frame_path(1, 0, path_1, 2);
+    if (status != 0) {
+        return -1;
+    }
+    initialize_network();
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            offset_pt = get_frame_offset_by_link(get_frame(i), i == 0 ? path_0[j] : path_1[j]);
+            for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+                set_offset(offset_pt, instance, 0, transmissions[i][j] + get_period(get_frame(i)) * instance);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ Requests the admission of a frame with a single path and checks that it is rejected with the given reason, without
+ changing the frames of the network
+
+ @param period period of the frame in ns
+ @param size size of the frame in bytes
+ @param path array with the links of the path
+ @param len_path number of links of the path
+ @param reason expected reason of the rejection
+ */
+void check_rejected(long long int period, int size, int *path, int len_path, char *reason) {
+    
+    AdmissionResult result;
+    int num_frames = get_number_frames();
+    
+    CHECK_EQUAL(admit_frame(period, period, size, period, 0, 1, &path, &len_path, NULL, &result), -1);
+    CHECK_EQUAL(result.stage, admission_rejected);
+    CHECK_EQUAL(result.frame_id, -1);
+    CHECK(strcmp(result.reason, reason) == 0);
+    CHECK_EQUAL(get_number_frames(), num_frames);
+    free_admission_result(&result);
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    AdmissionResult result;
+    int path[2] = {0, 1}, reversed[2] = {1, 0}, single[1] = {2}, *paths = path, len_path = 2;
+    
+    srs_init();
+    if (create_network() == -1) {
+        printf("The network of the test could not be created\n");
+        return 1;
+    }
+    CHECK_EQUAL(validate_schedule(1), 0);
+    
+    // Link 0 is free after the first transmission of frame 0 and 100 ns between frames, and link 1 after the hop
+    // delay and the strict 1 ns, as it is free at that time
+    CHECK_EQUAL(admit_frame(50000, 50000, 1000, 10000, 0, 1, &paths, &len_path, NULL, &result), 0);
+    CHECK_EQUAL(result.stage, admission_first_fit);
+    CHECK_EQUAL(result.frame_id, 2);
+    CHECK_EQUAL(result.num_links, 2);
+    if (result.num_links == 2) {
+        CHECK_EQUAL(result.links[0], 0);
+        CHECK_EQUAL(result.offsets[0], 2100);
+        CHECK_EQUAL(result.links[1], 1);
+        CHECK_EQUAL(result.offsets[1], 4101);
+    }
+    free_admission_result(&result);
+    CHECK_EQUAL(get_number_frames(), 3);
+    CHECK_EQUAL(get_offset(get_frame_offset_by_link(get_frame(0), 0), 1, 0), 51000);
+    CHECK_EQUAL(get_offset(get_frame_offset_by_link(get_frame(2), 1), 1, 0), 54101);
+    CHECK_EQUAL(validate_schedule(1), 0);
+    
+    // Requests rejected before searching any transmission time
+    check_rejected(30000, 1000, path, 2, "the period does not divide the hyperperiod");
+    check_rejected(50000, 0, path, 2, "the information of the frame is not valid");
+    check_rejected(50000, 1000, reversed, 2, "the path 0 is not connected");
+    check_rejected(TEST_HYPERPERIOD, 99001, single, 1, "the link 2 has not enough free time");
+    set_link_failed(get_link(2), 1);
+    check_rejected(TEST_HYPERPERIOD, 1000, single, 1, "the link 2 does not exist or has failed");
+    CHECK_EQUAL(get_offset(get_frame_offset_by_link(get_frame(1), 2), 0, 0), 10000);
+    
+    srs_free_network();
+    srs_exit();
+    return check_result("TestAdmission");
+}
@@ -0,0 +1,251 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestBinaryNetwork.c                                                                                                *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests that a network written in the binary format, and converted to xml and back, is read exactly as it was built. *
+ *  The network has every field that the formats store: the general information with protocol and time between frames, *
+ *  wired and wireless links, frames with several paths and splits, and the described nodes with their categories and  *
+ *  connections. Every field of the network read is compared with the values used to build it.                         *
+ *  Usage: TestBinaryNetwork                                                                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <string.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "BinaryNetwork.h"
+#include "Check.h"
+
+#define TEST_FRAMES 2                   // Frames of the network
+#define TEST_LINKS 4                    // Links of the network
+#define TEST_NODES 4                    // Described nodes of the network
+#define TEST_MAX_PATHS 2                // Maximum paths (and splits) of a frame
+#define TEST_MAX_LINKS 4                // Maximum links of a path, a split or the connections of a node
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Route of a frame (path or split) or connections of a node, the list ends with -1
+ */
+typedef int TestList[TEST_MAX_LINKS + 1];
+
+                                                    /* VARIABLES */
+
+static int link_speeds[TEST_LINKS] = {100, 1000, 1000, 50};
+static LinkType link_types[TEST_LINKS] = {wired, wired, wired, wireless};
+static int link_nodes[TEST_LINKS][2] = {{0, 1}, {1, 2}, {1, 3}, {3, 1}};
+static long long int frame_times[TEST_FRAMES][4] = {{1000000, 800000, 400000, 1000},    // Period, deadline, end to
+                                                    {500000, 500000, 250000, 0}};       // end delay and starting
+static int frame_sizes[TEST_FRAMES] = {500, 1500};
+static TestList frame_paths[TEST_FRAMES][TEST_MAX_PATHS] = {{{0, 1, -1}, {0, 2, -1}}, {{3, 1, -1}, {-1}}};
+static TestList frame_splits[TEST_FRAMES][TEST_MAX_PATHS] = {{{1, 2, -1}, {-1}}, {{-1}, {-1}}};
+static NodeCategory node_categories[TEST_NODES] = {end_system_node, switch_node, end_system_node, end_system_node};
+static TestList node_connections[TEST_NODES] = {{0, -1}, {0, 1, 2, 3, -1}, {1, -1}, {2, 3, -1}};
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the number of elements of a list
+
+ @param list list ended with -1
+ @return number of elements before the -1
+ */
+int get_list_length(int *list) {
+    
+    int length = 0;
+    
+    while (list[length] != -1) {
+        length++;
+    }
+    return length;
+}
+
+/**
+ Creates the network in memory with the library
+
+ @return 0 if created correctly, -1 otherwise
+ */
+int create_network(void) {
+    
+    int status = 0, num_paths, num_splits;
+    
+    status += srs_new_network(TEST_FRAMES, TEST_LINKS, 2000, 1000000, 250000, 5000, 100);
+    for (int i = 0; i < TEST_LINKS; i++) {
+        status += srs_add_link(i, link_speeds[i], link_types[i]);
+        status += srs_add_link_nodes(i, link_nodes[i][0], link_nodes[i][1]);
+    }
+    for (int i = 0; i < TEST_FRAMES; i++) {
+        num_paths = 0;
+        num_splits = 0;
+        while (num_paths < TEST_MAX_PATHS && frame_paths[i][num_paths][0] != -1) {
+            num_paths++;
+        }
+        while (num_splits < TEST_MAX_PATHS && frame_splits[i][num_splits][0] != -1) {
+            num_splits++;
+        }
+        status += srs_add_frame(i, frame_times[i][0], frame_times[i][1], frame_sizes[i], frame_times[i][2],
+                                frame_times[i][3], num_paths, num_splits);
+        for (int j = 0; j < num_paths; j++) {
+            status += srs_add_frame_path(i, j, frame_paths[i][j], get_list_length(frame_paths[i][j]));
+        }
+        for (int j = 0; j < num_splits; j++) {
+            status += srs_add_frame_split(i, j, frame_splits[i][j], get_list_length(frame_splits[i][j]));
+        }
+    }
+    for (int i = 0; i < TEST_NODES; i++) {
+        if (add_node(node_categories[i], get_list_length(node_connections[i]), node_connections[i]) != i) {
+            status = -1;
+        }
+    }
+    return status == 0 ? 0 : -1;
+}
+
+/**
+ Checks that every field of the network in memory has the value used to build it
+ */
+void check_network(void) {
+    
+    Frame *frame_pt;
+    Path *path_pt;
+    Split *split_pt;
+    int num_paths, num_splits, position;
+    
+    CHECK_EQUAL(get_number_frames(), TEST_FRAMES);
+    CHECK_EQUAL(get_number_links(), TEST_LINKS);
+    CHECK_EQUAL(get_hop_delay(), 2000);
+    CHECK_EQUAL(get_hyper_period(), 1000000);
+    CHECK_EQUAL(get_protocol_period(), 250000);
+    CHECK_EQUAL(get_protocol_time(), 5000);
+    CHECK_EQUAL(get_time_between_frames(), 100);
+    if (get_number_frames() != TEST_FRAMES || get_number_links() != TEST_LINKS) {
+        return;
+    }
+    
+    for (int i = 0; i < TEST_LINKS; i++) {
+        CHECK_EQUAL(get_link_speed(get_link(i)), link_speeds[i]);
+        CHECK_EQUAL(get_link_type(get_link(i)), link_types[i]);
+        CHECK_EQUAL(get_link_source(get_link(i)), link_nodes[i][0]);
+        CHECK_EQUAL(get_link_destination(get_link(i)), link_nodes[i][1]);
+    }
+    
+    for (int i = 0; i < TEST_FRAMES; i++) {
+        frame_pt = get_frame(i);
+        CHECK_EQUAL(get_period(frame_pt), frame_times[i][0]);
+        CHECK_EQUAL(get_deadline(frame_pt), frame_times[i][1]);
+        CHECK_EQUAL(get_end_to_end_delay(frame_pt), frame_times[i][2]);
+        CHECK_EQUAL(get_starting(frame_pt), frame_times[i][3]);
+        CHECK_EQUAL(get_size(frame_pt), frame_sizes[i]);
+        num_paths = 0;
+        while (num_paths < TEST_MAX_PATHS && frame_paths[i][num_paths][0] != -1) {
+            num_paths++;
+        }
+        CHECK_EQUAL(get_num_paths(frame_pt), num_paths);
+        for (int j = 0; j < num_paths && j < get_num_paths(frame_pt); j++) {
+            position = 0;
+            for (path_pt = get_path_root(frame_pt, j); !is_last_path(path_pt); path_pt = get_next_path(path_pt)) {
+                CHECK_EQUAL(path_pt->link, frame_paths[i][j][position]);
+                if (frame_paths[i][j][position] != -1) {
+                    position++;
+                }
+            }
+            CHECK_EQUAL(position, get_list_length(frame_paths[i][j]));
+        }
+        num_splits = 0;
+        while (num_splits < TEST_MAX_PATHS && frame_splits[i][num_splits][0] != -1) {
+            num_splits++;
+        }
+        CHECK_EQUAL(frame_pt->num_splits, num_splits);
+        for (int j = 0; j < num_splits && j < frame_pt->num_splits; j++) {
+            position = 0;
+            for (split_pt = &frame_pt->split_array_ls[j]; split_pt->next_split_pt != NULL;
+                 split_pt = split_pt->next_split_pt) {
+                CHECK_EQUAL(split_pt->link, frame_splits[i][j][position]);
+                if (frame_splits[i][j][position] != -1) {
+                    position++;
+                }
+            }
+            CHECK_EQUAL(position, get_list_length(frame_splits[i][j]));
+        }
+    }
+    
+    CHECK_EQUAL(get_number_described_nodes(), TEST_NODES);
+    for (int i = 0; i < TEST_NODES && i < get_number_described_nodes(); i++) {
+        CHECK_EQUAL(get_node_category(i), node_categories[i]);
+        CHECK_EQUAL(get_node_number_connections(i), get_list_length(node_connections[i]));
+        for (int j = 0; j < get_node_number_connections(i) && j < get_list_length(node_connections[i]); j++) {
+            CHECK_EQUAL(get_node_connection(i, j), node_connections[i][j]);
+        }
+    }
+}
+
+/**
+ Checks that two files have the same bytes
+
+ @param namefile_a path and name of the first file
+ @param namefile_b path and name of the second file
+ @return 1 if they are equal, 0 otherwise
+ */
+int are_files_equal(char *namefile_a, char *namefile_b) {
+    
+    FILE *file_a, *file_b;
+    int byte_a, byte_b, equal = 1;
+    
+    file_a = fopen(namefile_a, "rb");
+    file_b = fopen(namefile_b, "rb");
+    if (file_a == NULL || file_b == NULL) {
+        equal = 0;
+    }
+    while (equal) {
+        byte_a = fgetc(file_a);
+        byte_b = fgetc(file_b);
+        if (byte_a != byte_b) {
+            equal = 0;
+        } else if (byte_a == EOF) {
+            break;
+        }
+    }
+    if (file_a != NULL) {
+        fclose(file_a);
+    }
+    if (file_b != NULL) {
+        fclose(file_b);
+    }
+    return equal;
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    srs_init();
+    if (create_network() == -1) {
+        printf("The network of the test could not be created\n");
+        return 1;
+    }
+    check_network();
+    
+    // Binary round trip
+    CHECK_EQUAL(srs_write_network_binary("TestNetwork.srsn"), 0);
+    srs_free_network();
+    CHECK(is_network_binary("TestNetwork.srsn"));
+    CHECK_EQUAL(srs_load_network("TestNetwork.srsn"), 0);
+    check_network();
+    
+    // Conversion to xml and back to binary, that gives the same file
+    CHECK_EQUAL(srs_write_network_xml("TestNetwork.xml"), 0);
+    srs_free_network();
+    CHECK(!is_network_binary("TestNetwork.xml"));
+    CHECK_EQUAL(srs_load_network("TestNetwork.xml"), 0);
+    check_network();
+    CHECK_EQUAL(srs_write_network_binary("TestNetworkConverted.srsn"), 0);
+    CHECK(are_files_equal("TestNetwork.srsn", "TestNetworkConverted.srsn"));
+    srs_free_network();
+    
+    srs_exit();
+    return check_result("TestBinaryNetwork");
+}
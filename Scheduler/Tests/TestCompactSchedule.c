@@ -0,0 +1,280 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestCompactSchedule.c                                                                                              *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests that the compact schedule keeps every transmission of a hand-built schedule of a small network with a        *
+ *  protocol. The compact schedule built from the network has a record for every frame and link but the protocol, and  *
+ *  its transmissions are the offsets of the network. The schedule written in the binary, text and xml formats is read *
+ *  back with the same records and transmissions. The delta files between two schedules, with changed, added and       *
+ *  removed records, are only written for the nodes with changes and give the new schedule when applied to the         *
+ *  previous one.                                                                                                      *
+ *  Usage: TestCompactSchedule                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <string.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "IOInterface.h"
+#include "ScheduleDelta.h"
+#include "Check.h"
+
+#define TEST_FRAMES 3                   // Frames of the network, without the protocol
+#define TEST_RECORDS 5                  // Frames and links with transmissions, without the protocol
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates the network, frames with different periods that share links 0 and 1 and a protocol every 50000 ns, and
+ initializes it so the offsets can be set by hand
+
+ @return 0 if created correctly, -1 otherwise
+ */
+int create_network(void) {
+    
+    int path_0[2] = {0, 1}, path_1[2] = {2, 1}, path_2[1] = {0};
+    int status = 0;
+    
+    status += srs_new_network(TEST_FRAMES, 3, 1000, 100000, 50000, 1000, 0);
+    for (int i = 0; i < 3; i++) {
+        status += srs_add_link(i, 100, wired);
+    }
+    status += srs_add_link_nodes(0, 0, 1);
+    status += srs_add_link_nodes(1, 1, 2);
+    status += srs_add_link_nodes(2, 3, 1);
+    status += srs_add_frame(0, 25000, 25000, 50, 10000, 0, 1, 0);
+    status += srs_add_frame_path(0, 0, path_0, 2);
+    status += srs_add_frame(1, 50000, 50000, 100, 20000, 0, 1, 0);
+    status += srs_add_frame_path(1, 0, path_1, 2);
+    status += srs_add_frame(2, 100000, 100000, 200, 100000, 0, 1, 0);
+    status += srs_add_frame_path(2, 0, path_2, 1);
+    if (status != 0) {
+        return -1;
+    }
+    initialize_network();
+    return 0;
+}
+
+/**
+ Sets the transmission of all the instances of a frame in a link, one period after the other
+
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @param transmission transmission time of the first instance in ns
+ */
+void set_transmission(int frame_id, int link_id, long long int transmission) {
+    
+    Frame *frame_pt = get_frame(frame_id);
+    Offset *offset_pt = get_frame_offset_by_link(frame_pt, link_id);
+    
+    for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+        set_offset(offset_pt, instance, 0, transmission + get_period(frame_pt) * instance);
+    }
+}
+
+/**
+ Sets the schedule of the network, the protocol is transmitted at the start of its period in all the links
+ */
+void set_schedule(void) {
+    
+    for (int i = 0; i < get_number_links(); i++) {
+        set_transmission(TEST_FRAMES, i, TIME_GRID_ORIGIN);
+    }
+    set_transmission(0, 0, 1500);
+    set_transmission(0, 1, 3000);
+    set_transmission(1, 2, 2000);
+    set_transmission(1, 1, 4000);
+    set_transmission(2, 0, 7000);
+}
+
+/**
+ Checks that a compact schedule has the transmissions of the network in memory and nothing of the protocol
+
+ @param schedule pointer to the compact schedule
+ */
+void check_network_schedule(CompactSchedule *schedule) {
+    
+    Offset *offset_pt;
+    ScheduleRecord *record;
+    
+    CHECK(schedule != NULL);
+    if (schedule == NULL) {
+        return;
+    }
+    CHECK_EQUAL(schedule->hyper_period, get_hyper_period());
+    CHECK_EQUAL(schedule->num_records, TEST_RECORDS);
+    for (int i = 0; i < TEST_FRAMES; i++) {
+        for (offset_pt = get_offset_root(get_frame(i)); !is_last_offset(offset_pt);
+             offset_pt = get_next_offset(offset_pt)) {
+            record = get_schedule_record(schedule, i, get_offset_link(offset_pt));
+            CHECK(record != NULL);
+            if (record == NULL) {
+                continue;
+            }
+            CHECK_EQUAL(record->period, get_period(get_frame(i)));
+            CHECK_EQUAL(record->timeslot_size, get_timeslot_size(offset_pt));
+            CHECK_EQUAL(record->instances, get_number_instances(offset_pt));
+            CHECK_EQUAL(record->replicas, get_number_replicas(offset_pt));
+            for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+                CHECK_EQUAL(get_record_transmission(schedule, record, instance, 0), get_offset(offset_pt, instance, 0));
+            }
+            CHECK_EQUAL(get_record_transmission(schedule, record, get_number_instances(offset_pt), 0), -1);
+        }
+    }
+    CHECK(get_schedule_record(schedule, 2, 1) == NULL);
+    CHECK(get_schedule_record(schedule, TEST_FRAMES, 0) == NULL);
+}
+
+/**
+ Checks that two compact schedules have the same records and transmissions
+
+ @param schedule pointer to the compact schedule
+ @param expected pointer to the expected compact schedule
+ */
+void check_same_schedule(CompactSchedule *schedule, CompactSchedule *expected) {
+    
+    ScheduleRecord *record, *expected_record;
+    
+    CHECK(schedule != NULL);
+    if (schedule == NULL) {
+        return;
+    }
+    CHECK_EQUAL(schedule->hyper_period, expected->hyper_period);
+    CHECK_EQUAL(schedule->num_records, expected->num_records);
+    for (int i = 0; i < schedule->num_records && i < expected->num_records; i++) {
+        record = &schedule->records[i];
+        expected_record = &expected->records[i];
+        CHECK_EQUAL(record->frame, expected_record->frame);
+        CHECK_EQUAL(record->link, expected_record->link);
+        CHECK_EQUAL(record->period, expected_record->period);
+        CHECK_EQUAL(record->timeslot_size, expected_record->timeslot_size);
+        CHECK_EQUAL(record->instances, expected_record->instances);
+        CHECK_EQUAL(record->replicas, expected_record->replicas);
+        for (int instance = 0; instance < record->instances; instance++) {
+            for (int replica = 0; replica <= record->replicas; replica++) {
+                CHECK_EQUAL(get_record_transmission(schedule, record, instance, replica),
+                            get_record_transmission(expected, expected_record, instance, replica));
+            }
+        }
+    }
+}
+
+/**
+ Removes the record of a frame and link from a compact schedule, as if the frame was not transmitted in the link
+
+ @param schedule pointer to the compact schedule
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ */
+void remove_schedule_record(CompactSchedule *schedule, int frame_id, int link_id) {
+    
+    ScheduleRecord *record = get_schedule_record(schedule, frame_id, link_id);
+    
+    if (record != NULL) {
+        memmove(record, record + 1, sizeof(ScheduleRecord) * (&schedule->records[schedule->num_records] - record - 1));
+        schedule->num_records--;
+    }
+}
+
+/**
+ Applies the delta files of the given nodes one after the other to the previous schedule
+
+ @param previous pointer to the previous compact schedule, it is not modified
+ @param nodes array with the nodes that have a delta file
+ @param num_nodes number of nodes
+ @return pointer to the new compact schedule, NULL if a delta file could not be applied
+ */
+CompactSchedule * apply_node_deltas(CompactSchedule *previous, int *nodes, int num_nodes) {
+    
+    CompactSchedule *schedule = previous, *next;
+    char namefile[64];
+    
+    for (int i = 0; i < num_nodes && schedule != NULL; i++) {
+        sprintf(namefile, "TestSchedule_node_%d.delta", nodes[i]);
+        next = apply_schedule_delta(schedule, namefile);
+        if (schedule != previous) {
+            free_compact_schedule(schedule);
+        }
+        schedule = next;
+    }
+    return schedule;
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    CompactSchedule *schedule, *previous, *current;
+    FILE *file;
+    int changed_nodes[3] = {0, 1, 3};
+    
+    srs_init();
+    if (create_network() == -1) {
+        printf("The network of the test could not be created\n");
+        return 1;
+    }
+    set_schedule();
+    
+    // Schedule built from the network in memory
+    schedule = build_compact_schedule();
+    check_network_schedule(schedule);
+    free_compact_schedule(schedule);
+    
+    // Round trips of the binary, text and xml schedule files
+    CHECK_EQUAL(write_schedule_binary("TestSchedule.srss"), 0);
+    schedule = read_compact_schedule("TestSchedule.srss");
+    check_network_schedule(schedule);
+    free_compact_schedule(schedule);
+    CHECK_EQUAL(write_schedule_text("TestSchedule.srst"), 0);
+    schedule = read_compact_schedule("TestSchedule.srst");
+    check_network_schedule(schedule);
+    free_compact_schedule(schedule);
+    CHECK_EQUAL(write_schedule_xml("TestSchedule.xml", 1), 0);
+    schedule = read_compact_schedule("TestSchedule.xml");
+    check_network_schedule(schedule);
+    free_compact_schedule(schedule);
+    
+    // Delta between the schedule and the schedule after moving some frames, with a record added in the links of node 3
+    // and a record removed in the links of node 0, that gives the new schedule when applied to the previous one
+    previous = build_compact_schedule();
+    set_transmission(0, 0, 1600);
+    set_transmission(0, 1, 3100);
+    set_transmission(1, 1, 4500);
+    current = build_compact_schedule();
+    remove_schedule_record(previous, 1, 2);
+    remove_schedule_record(current, 2, 0);
+    CHECK_EQUAL(current->num_records, TEST_RECORDS - 1);
+    CHECK(write_schedule_delta(previous, current, "TestSchedule_") > 0);
+    file = fopen("TestSchedule_node_2.delta", "rb");
+    CHECK(file == NULL);
+    if (file != NULL) {
+        fclose(file);
+    }
+    schedule = apply_node_deltas(previous, changed_nodes, 3);
+    check_same_schedule(schedule, current);
+    if (schedule != NULL) {
+        free_compact_schedule(schedule);
+    }
+    CHECK_EQUAL(write_schedule_delta(current, current, "TestSchedule_same_"), 0);
+    
+    // A delta with a wrong byte is not applied
+    file = fopen("TestSchedule_node_1.delta", "r+b");
+    CHECK(file != NULL);
+    if (file != NULL) {
+        fseek(file, 6, SEEK_SET);
+        fputc(0xFF, file);
+        fclose(file);
+    }
+    CHECK(apply_schedule_delta(previous, "TestSchedule_node_1.delta") == NULL);
+    free_compact_schedule(previous);
+    free_compact_schedule(current);
+    
+    srs_free_network();
+    srs_exit();
+    return check_result("TestCompactSchedule");
+}
@@ -0,0 +1,112 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestGateControlList.c                                                                                              *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests the gate control lists compiled from a hand-built schedule with a time between frames of 500 ns, used as     *
+ *  guard band before every transmission. The guard band of a transmission that starts before the guard band ends      *
+ *  wraps around to the end of the cycle, a transmission at exactly the guard band does not wrap, and the windows of   *
+ *  transmissions closer than the guard band are merged in one entry.                                                  *
+ *  Usage: TestGateControlList                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "GateControlList.h"
+#include "Check.h"
+
+#define TEST_HYPERPERIOD 100000         // Hyperperiod of the network and cycle of the lists in ns
+#define TEST_GUARD 500                  // Time between frames of the network in ns
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates the network, four frames of 1000 ns per transmission once per hyperperiod, frame 0 in link 0, frames 1 and 2
+ in link 1 and frame 3 in link 2, and sets their transmissions
+
+ @return 0 if created correctly, -1 otherwise
+ */
+int create_network(void) {
+    
+    int links[4] = {0, 1, 1, 2};
+    long long int transmissions[4] = {200, 5000, 6200, TEST_GUARD};
+    int status = 0;
+    
+    status += srs_new_network(4, 3, 1000, TEST_HYPERPERIOD, 0, 0, TEST_GUARD);
+    for (int i = 0; i < 3; i++) {
+        status += srs_add_link(i, 1000, wired);
+        status += srs_add_link_nodes(i, i, i + 1);
+    }
+    for (int i = 0; i < 4; i++) {
+        status += srs_add_frame(i, TEST_HYPERPERIOD, TEST_HYPERPERIOD, 1000, TEST_HYPERPERIOD, 0, 1, 0);
+        status += srs_add_frame_path(i, 0, &links[i], 1);
+    }
+    if (status != 0) {
+        return -1;
+    }
+    initialize_network();
+    for (int i = 0; i < 4; i++) {
+        set_offset(get_frame_offset_by_link(get_frame(i), links[i]), 0, 0, transmissions[i]);
+    }
+    return 0;
+}
+
+/**
+ Checks that the gate control list of a link has the given entries
+
+ @param link_id identifier of the link
+ @param entries array with the expected entries
+ @param num_entries number of expected entries
+ */
+void check_gate_control_list(int link_id, GateEntry *entries, int num_entries) {
+    
+    GateControlList *gcl = get_gate_control_list(link_id);
+    
+    CHECK(gcl != NULL);
+    if (gcl == NULL) {
+        return;
+    }
+    CHECK_EQUAL(gcl->link, link_id);
+    CHECK_EQUAL(gcl->node, link_id);
+    CHECK_EQUAL(gcl->cycle, TEST_HYPERPERIOD);
+    CHECK_EQUAL(gcl->num_entries, num_entries);
+    for (int i = 0; i < gcl->num_entries && i < num_entries; i++) {
+        CHECK_EQUAL(gcl->entries[i].start, entries[i].start);
+        CHECK_EQUAL(gcl->entries[i].duration, entries[i].duration);
+        CHECK_EQUAL(gcl->entries[i].state, entries[i].state);
+    }
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    // The guard band of the transmission at 200 takes the last 300 ns of the previous cycle
+    GateEntry wrapped[3] = {{0, 1200, gate_scheduled}, {1200, 98500, gate_best_effort},
+                            {TEST_HYPERPERIOD - 300, 300, gate_scheduled}};
+    // Transmissions at 5000 and 6200 with their guard bands from 4500 to 7200
+    GateEntry merged[3] = {{0, 4500, gate_best_effort}, {4500, 2700, gate_scheduled},
+                           {7200, TEST_HYPERPERIOD - 7200, gate_best_effort}};
+    // The guard band of the transmission at 500 starts exactly at the start of the cycle
+    GateEntry not_wrapped[2] = {{0, 1500, gate_scheduled}, {1500, TEST_HYPERPERIOD - 1500, gate_best_effort}};
+    
+    srs_init();
+    if (create_network() == -1) {
+        printf("The network of the test could not be created\n");
+        return 1;
+    }
+    
+    CHECK_EQUAL(compile_gate_control_lists(2), 0);
+    check_gate_control_list(0, wrapped, 3);
+    check_gate_control_list(1, merged, 3);
+    check_gate_control_list(2, not_wrapped, 2);
+    
+    srs_free_network();
+    srs_exit();
+    return check_result("TestGateControlList");
+}
@@ -0,0 +1,93 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestGranularity.c                                                                                                  *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests the time granularity of small networks whose limits are all multiple of 1000 ns. The unit is 1000 ns while   *
+ *  the fastest transmission of the frame fits in it, and 1 ns when the frame only fits with the strict margins of     *
+ *  1 ns, although the end to end delay is still a multiple of the unit. A limit that is not multiple of a whole unit, *
+ *  the transmission times of a pinned frame and a macrotick give the common divisor of the times they keep exact.     *
+ *  Usage: TestGranularity                                                                                             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "Check.h"
+
+#define TEST_PERIOD 1000000             // Period of the frames and hyperperiod of the network in ns
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates the network and gets its time granularity. Frame 0 goes through links 0 and 1 with a hop delay of 1000 ns,
+ its fastest transmission takes 2001 ns until the start of link 1, the size plus the hop delay and the strict 1 ns.
+ Frame 1 is pinned to the given transmission in link 2. All links transmit a byte per ns
+
+ @param size size of frame 0 in bytes, the time of its transmissions
+ @param end_to_end end to end delay of frame 0
+ @param pinned transmission time of the pinned frame 1 in ns, -1 to not add it
+ @param macrotick time unit in ns wanted for the solver, 0 to use the greatest common granularity of the network
+ @return time granularity in ns, -1 if the network could not be created
+ */
+long long int get_test_granularity(int size, long long int end_to_end, long long int pinned, long long int macrotick) {
+    
+    int path_0[2] = {0, 1}, path_1[1] = {2};
+    int status = 0, num_frames = pinned >= 0 ? 2 : 1;
+    long long int granularity;
+    
+    status += srs_new_network(num_frames, 3, 1000, TEST_PERIOD, 0, 0, 0);
+    for (int i = 0; i < 3; i++) {
+        status += srs_add_link(i, 1000, wired);
+        status += srs_add_link_nodes(i, i, i + 1);
+    }
+    status += srs_add_frame(0, TEST_PERIOD, TEST_PERIOD, size, end_to_end, 0, 1, 0);
+    status += srs_add_frame_path(0, 0, path_0, 2);
+    if (pinned >= 0) {
+        status += srs_add_frame(1, TEST_PERIOD, TEST_PERIOD, 1000, TEST_PERIOD, 0, 1, 0);
+        status += srs_add_frame_path(1, 0, path_1, 1);
+    }
+    if (status != 0) {
+        srs_free_network();
+        return -1;
+    }
+    initialize_network();
+    if (pinned >= 0) {
+        set_frame_pinned(get_frame(1), 1);
+        set_offset(get_frame_offset_by_link(get_frame(1), 2), 0, 0, pinned);
+    }
+    granularity = get_time_granularity(macrotick);
+    srs_free_network();
+    return granularity;
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    srs_init();
+    
+    // The 2001 ns of the fastest transmission take 3000 ns in the unit, less than the 4000 ns to the end of link 1
+    CHECK_EQUAL(get_test_granularity(1000, 100000, -1, 0), 1000);
+    CHECK_EQUAL(get_test_granularity(1000, 5000, -1, 0), 1000);
+    
+    // With 3000 ns to the end of link 1 the frame fits in ns but not in the unit
+    CHECK_EQUAL(get_test_granularity(1000, 4000, -1, 0), 1);
+    
+    // A transmission of 1001 ns does not share any divisor with the rest of limits
+    CHECK_EQUAL(get_test_granularity(1001, 100000, -1, 0), 1);
+    
+    // A pinned frame transmitted at 2500 ns after the origin of the grid
+    CHECK_EQUAL(get_test_granularity(1000, 100000, 2500 + TIME_GRID_ORIGIN, 0), 500);
+    
+    // With a macrotick only the periods and the pinned transmissions have to be exact, even if the frame does not fit
+    CHECK_EQUAL(get_test_granularity(1000, 4000, -1, 300), 100);
+    CHECK_EQUAL(get_test_granularity(1001, 100000, 2500 + TIME_GRID_ORIGIN, 2000), 500);
+    
+    srs_exit();
+    return check_result("TestGranularity");
+}
@@ -0,0 +1,86 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestPrecheck.c                                                                                                     *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests the limits of the precheck on a small network. A link that is busy exactly the whole hyperperiod, with the   *
+ *  time between frames, passes and 1 ns more does not. A path whose minimum latency is exactly its end to end delay,  *
+ *  or exactly the time between the starting time and deadline of its frame, does not pass, as the solver bounds them  *
+ *  strictly, and 1 ns less passes.                                                                                    *
+ *  Usage: TestPrecheck                                                                                                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "Precheck.h"
+#include "Check.h"
+
+#define TEST_HYPERPERIOD 10000          // Hyperperiod of the network in ns
+#define TEST_LATENCY 3001               // Minimum latency of frame 2, two transmissions of 1000 ns and the hop delay
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates and prechecks the network. Link 0 has two instances of frame 0 and one of frame 1, with 100 ns between
+ them, 2200 ns plus the transmission of frame 1. Frame 2 goes through links 1 and 2, with a hop delay of 1000 ns.
+ All links transmit a byte per ns
+
+ @param size_1 size of frame 1 in bytes, the time of its transmission
+ @param end_to_end_2 end to end delay of frame 2
+ @param deadline_2 deadline of frame 2
+ @param print_table 1 to print the utilization table, 0 otherwise
+ @return number of links and paths that cannot be scheduled, -1 if the network could not be created
+ */
+int precheck_test_network(int size_1, long long int end_to_end_2, long long int deadline_2, int print_table) {
+    
+    int path_0[1] = {0}, path_2[2] = {1, 2};
+    int status = 0, result;
+    
+    status += srs_new_network(3, 3, 1000, TEST_HYPERPERIOD, 0, 0, 100);
+    for (int i = 0; i < 3; i++) {
+        status += srs_add_link(i, 1000, wired);
+        status += srs_add_link_nodes(i, i, i + 1);
+    }
+    status += srs_add_frame(0, 5000, 5000, 1000, 5000, 0, 1, 0);
+    status += srs_add_frame_path(0, 0, path_0, 1);
+    status += srs_add_frame(1, TEST_HYPERPERIOD, TEST_HYPERPERIOD, size_1, TEST_HYPERPERIOD, 0, 1, 0);
+    status += srs_add_frame_path(1, 0, path_0, 1);
+    status += srs_add_frame(2, TEST_HYPERPERIOD, deadline_2, 1000, end_to_end_2, 0, 1, 0);
+    status += srs_add_frame_path(2, 0, path_2, 2);
+    if (status != 0) {
+        srs_free_network();
+        return -1;
+    }
+    initialize_network();
+    result = precheck_network(print_table);
+    srs_free_network();
+    return result;
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    srs_init();
+    
+    // Everything exactly at the limits that pass
+    CHECK_EQUAL(precheck_test_network(7800, TEST_LATENCY + 1, TEST_LATENCY + 1, 1), 0);
+    
+    // Link 0 busy 1 ns more than the hyperperiod
+    CHECK_EQUAL(precheck_test_network(7801, TEST_LATENCY + 1, TEST_LATENCY + 1, 0), 1);
+    
+    // Minimum latency of frame 2 exactly its end to end delay, or the time to its deadline
+    CHECK_EQUAL(precheck_test_network(7800, TEST_LATENCY, TEST_LATENCY + 1, 0), 1);
+    CHECK_EQUAL(precheck_test_network(7800, TEST_LATENCY + 1, TEST_LATENCY, 0), 1);
+    
+    // Both the link and the path, the path is only counted once
+    CHECK_EQUAL(precheck_test_network(7801, TEST_LATENCY, TEST_LATENCY, 1), 2);
+    
+    srs_exit();
+    return check_result("TestPrecheck");
+}
@@ -0,0 +1,150 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestTopology.c                                                                                                     *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests the k shortest paths search on a hand-built graph of 5 nodes and 7 links with 5 loop free paths from node 0  *
+ *  to node 4. The speeds of the links give a different latency to every path, so the order of the paths is known. The *
+ *  search is also checked when there are fewer paths than asked, with a failed link and with end systems in the       *
+ *  middle of the paths, that cannot relay frames.                                                                     *
+ *  Usage: TestTopology                                                                                                *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "Check.h"
+
+#define TEST_LINKS 7                    // Links of the graph
+#define TEST_NODES 5                    // Nodes of the graph
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates the graph, its links, with the latency of a frame of maximum size in them, are:
+ 0: 0 -> 1 (1522 ns), 1: 1 -> 4 (1522 ns), 2: 0 -> 2 (3044 ns), 3: 2 -> 4 (3044 ns), 4: 1 -> 2 (761 ns),
+ 5: 2 -> 3 (6088 ns) and 6: 3 -> 4 (6088 ns). The only frame of the network goes through links 0 and 1
+
+ @return 0 if created correctly, -1 otherwise
+ */
+int create_network(void) {
+    
+    int speeds[TEST_LINKS] = {1000, 1000, 500, 500, 2000, 250, 250};
+    int nodes[TEST_LINKS][2] = {{0, 1}, {1, 4}, {0, 2}, {2, 4}, {1, 2}, {2, 3}, {3, 4}};
+    int path[2] = {0, 1};
+    int status = 0;
+    
+    status += srs_new_network(1, TEST_LINKS, 0, 1000000, 0, 0, 0);
+    for (int i = 0; i < TEST_LINKS; i++) {
+        status += srs_add_link(i, speeds[i], wired);
+        status += srs_add_link_nodes(i, nodes[i][0], nodes[i][1]);
+    }
+    status += srs_add_frame(0, 1000000, 1000000, 100, 1000000, 0, 1, 0);
+    status += srs_add_frame_path(0, 0, path, 2);
+    return status == 0 ? 0 : -1;
+}
+
+/**
+ Checks that a path of a set of paths has the given links and cost
+
+ @param paths pointer to the set of paths
+ @param path_id position of the path in the set
+ @param links array with the expected links of the path
+ @param num_links number of expected links
+ @param cost expected cost of the path
+ */
+void check_path(PathSet *paths, int path_id, int *links, int num_links, double cost) {
+    
+    CHECK(paths != NULL && path_id < paths->num_paths);
+    if (paths == NULL || path_id >= paths->num_paths) {
+        return;
+    }
+    CHECK_EQUAL(paths->starts[path_id + 1] - paths->starts[path_id], num_links);
+    for (int i = 0; i < num_links && paths->starts[path_id] + i < paths->starts[path_id + 1]; i++) {
+        CHECK_EQUAL(paths->links[paths->starts[path_id] + i], links[i]);
+    }
+    CHECK(paths->costs[path_id] == cost);
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    PathSet *paths;
+    int path_a[2] = {0, 1}, path_b[3] = {0, 4, 3}, path_c[2] = {2, 3}, path_d[4] = {0, 4, 5, 6}, path_e[3] = {2, 5, 6};
+    NodeCategory categories[TEST_NODES] = {end_system_node, switch_node, end_system_node, switch_node, end_system_node};
+    int connections[TEST_NODES][4] = {{0, 2}, {0, 1, 4}, {2, 3, 4, 5}, {5, 6}, {1, 3, 6}};
+    int num_connections[TEST_NODES] = {2, 3, 4, 2, 3};
+    double costs[5] = {2, 2, 3, 3, 4};
+    
+    srs_init();
+    if (create_network() == -1) {
+        printf("The network of the test could not be created\n");
+        return 1;
+    }
+    
+    // The 3 paths with the lowest latency, and then all of them
+    paths = get_k_shortest_paths(0, 4, 3, rank_latency);
+    CHECK(paths != NULL);
+    if (paths != NULL) {
+        CHECK_EQUAL(paths->num_paths, 3);
+        check_path(paths, 0, path_a, 2, 3044);
+        check_path(paths, 1, path_b, 3, 5327);
+        check_path(paths, 2, path_c, 2, 6088);
+    }
+    paths = get_k_shortest_paths(0, 4, 10, rank_latency);
+    CHECK(paths != NULL);
+    if (paths != NULL) {
+        CHECK_EQUAL(paths->num_paths, 5);
+        CHECK_EQUAL(paths->max_paths, 10);
+        check_path(paths, 0, path_a, 2, 3044);
+        check_path(paths, 1, path_b, 3, 5327);
+        check_path(paths, 2, path_c, 2, 6088);
+        check_path(paths, 3, path_d, 4, 14459);
+        check_path(paths, 4, path_e, 3, 15220);
+    }
+    CHECK(get_k_shortest_paths(0, TEST_NODES, 1, rank_latency) == NULL);
+    CHECK_EQUAL(get_k_shortest_paths(4, 0, 1, rank_latency)->num_paths, 0);
+    
+    // Ranked by hops, the paths with the same number of hops can come in any order
+    paths = get_k_shortest_paths(0, 4, 10, rank_hops);
+    CHECK(paths != NULL);
+    if (paths != NULL) {
+        CHECK_EQUAL(paths->num_paths, 5);
+        for (int i = 0; i < paths->num_paths && i < 5; i++) {
+            CHECK(paths->costs[i] == costs[i]);
+        }
+    }
+    
+    // Without link 0 only the paths that start in link 2 are left
+    set_link_failed(get_link(0), 1);
+    invalidate_topology_paths();
+    paths = get_k_shortest_paths(0, 4, 10, rank_latency);
+    CHECK(paths != NULL);
+    if (paths != NULL) {
+        CHECK_EQUAL(paths->num_paths, 2);
+        check_path(paths, 0, path_c, 2, 6088);
+        check_path(paths, 1, path_e, 3, 15220);
+    }
+    set_link_failed(get_link(0), 0);
+    
+    // Node 2 is an end system, so only the path that does not go through it is left
+    for (int i = 0; i < TEST_NODES; i++) {
+        CHECK_EQUAL(add_node(categories[i], num_connections[i], connections[i]), i);
+    }
+    invalidate_topology_paths();
+    paths = get_k_shortest_paths(0, 4, 10, rank_latency);
+    CHECK(paths != NULL);
+    if (paths != NULL) {
+        CHECK_EQUAL(paths->num_paths, 1);
+        check_path(paths, 0, path_a, 2, 3044);
+    }
+    
+    srs_free_network();
+    srs_exit();
+    return check_result("TestTopology");
+}
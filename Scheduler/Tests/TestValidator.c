@@ -0,0 +1,185 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  TestValidator.c                                                                                                    *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Tests the validator with a hand-built schedule of a small network, two frames that share the last link of their    *
+ *  paths. The valid schedule has no violations, and moving a single transmission just over the limit of a constraint  *
+ *  gives a violation of that constraint, while leaving it exactly at the limit does not. The incremental validation   *
+ *  of a moved frame finds its collisions with the occupancy of the previous validations, and frees its old place.     *
+ *  Usage: TestValidator                                                                                               *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Network.h"
+#include "Validator.h"
+#include "Check.h"
+
+#define TEST_HYPERPERIOD 100000         // Hyperperiod of the network in ns
+#define TEST_HOP_DELAY 1000             // Hop delay of the network in ns
+#define TEST_THREADS 2                  // Threads of the validator
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Creates the network, frame 0 goes through links 0 and 1 twice per hyperperiod, and frame 1 through links 2 and 1 once.
+ Both take 1000 ns per link, at 1000 MB/s, and the network is initialized so the offsets can be set by hand
+
+ @return 0 if created correctly, -1 otherwise
+ */
+int create_network(void) {
+    
+    int path_0[2] = {0, 1}, path_1[2] = {2, 1};
+    int status = 0;
+    
+    status += srs_new_network(2, 3, TEST_HOP_DELAY, TEST_HYPERPERIOD, 0, 0, 0);
+    for (int i = 0; i < 3; i++) {
+        status += srs_add_link(i, 1000, wired);
+    }
+    status += srs_add_link_nodes(0, 0, 1);
+    status += srs_add_link_nodes(1, 1, 2);
+    status += srs_add_link_nodes(2, 3, 1);
+    status += srs_add_frame(0, 50000, 50000, 1000, 10000, 0, 1, 0);
+    status += srs_add_frame_path(0, 0, path_0, 2);
+    status += srs_add_frame(1, 100000, 100000, 1000, 20000, 0, 1, 0);
+    status += srs_add_frame_path(1, 0, path_1, 2);
+    if (status != 0) {
+        return -1;
+    }
+    initialize_network();
+    return 0;
+}
+
+/**
+ Sets the transmission of all the instances of a frame in a link, one period after the other
+
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @param transmission transmission time of the first instance in ns
+ */
+void set_transmission(int frame_id, int link_id, long long int transmission) {
+    
+    Frame *frame_pt = get_frame(frame_id);
+    Offset *offset_pt = get_frame_offset_by_link(frame_pt, link_id);
+    
+    for (int instance = 0; instance < get_number_instances(offset_pt); instance++) {
+        set_offset(offset_pt, instance, 0, transmission + get_period(frame_pt) * instance);
+    }
+}
+
+/**
+ Sets the valid schedule, frame 0 is relayed as soon as possible and frame 1 waits in the switch some time more
+ */
+void set_valid_schedule(void) {
+    
+    set_transmission(0, 0, 1000);
+    set_transmission(0, 1, 3000);
+    set_transmission(1, 2, 10000);
+    set_transmission(1, 1, 20000);
+}
+
+/**
+ Checks if the last validation found a violation of the given type for the given frame and link
+
+ @param type type of the violation
+ @param frame_id identifier of the frame
+ @param link_id identifier of the link
+ @return 1 if found, 0 otherwise
+ */
+int has_violation(ViolationType type, int frame_id, int link_id) {
+    
+    Violation *violation_pt;
+    
+    for (int i = 0; i < get_number_violations(); i++) {
+        violation_pt = get_violation(i);
+        if (violation_pt->type == type && violation_pt->frame == frame_id && violation_pt->link == link_id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, const char * argv[]) {
+    
+    int frame_0 = 0, frame_1 = 1;
+    
+    srs_init();
+    if (create_network() == -1) {
+        printf("The network of the test could not be created\n");
+        return 1;
+    }
+    
+    // The valid schedule, also with the shared link and the path at their limits
+    set_valid_schedule();
+    CHECK_EQUAL(validate_schedule(TEST_THREADS), 0);
+    set_transmission(1, 1, 12000);      // 10000 + 1000 of transmission + 1000 of hop delay
+    CHECK_EQUAL(validate_schedule(TEST_THREADS), 0);
+    set_transmission(0, 0, 9000);       // Frame 0 leaves the shared link right when frame 1 starts
+    set_transmission(0, 1, 11000);
+    CHECK_EQUAL(validate_schedule(TEST_THREADS), 0);
+    set_valid_schedule();
+    set_transmission(0, 1, 10000);      // 10000 + 1000 of transmission - 1000 is the end to end delay
+    CHECK_EQUAL(validate_schedule(TEST_THREADS), 0);
+    
+    // Collision in the shared link
+    set_valid_schedule();
+    set_transmission(1, 1, 3999);
+    CHECK(validate_schedule(TEST_THREADS) > 0);
+    CHECK(has_violation(collision, 1, 1));
+    
+    // Transmission before the starting time and after the deadline
+    set_valid_schedule();
+    set_transmission(0, 0, -1);
+    CHECK(validate_schedule(TEST_THREADS) > 0);
+    CHECK(has_violation(out_of_range, 0, 0));
+    set_valid_schedule();
+    set_transmission(1, 1, 99001);
+    CHECK(validate_schedule(TEST_THREADS) > 0);
+    CHECK(has_violation(out_of_range, 1, 1));
+    
+    // Second instance not one period after the first one
+    set_valid_schedule();
+    set_offset(get_frame_offset_by_link(get_frame(0), 0), 1, 0, 51001);
+    CHECK(validate_schedule(TEST_THREADS) > 0);
+    CHECK(has_violation(not_periodic, 0, 0));
+    
+    // Next link of the path 1 ns before the frame is relayed
+    set_valid_schedule();
+    set_transmission(1, 1, 11999);
+    CHECK(validate_schedule(TEST_THREADS) > 0);
+    CHECK(has_violation(path_dependency, 1, 1));
+    
+    // Path 1 ns longer than the end to end delay
+    set_valid_schedule();
+    set_transmission(0, 1, 10001);
+    CHECK(validate_schedule(TEST_THREADS) > 0);
+    CHECK(has_violation(end_to_end, 0, 1));
+    
+    // Incremental validations of a single frame against the occupancy of the links from the previous validations
+    set_valid_schedule();
+    CHECK_EQUAL(validate_schedule(TEST_THREADS), 0);
+    set_transmission(1, 1, 3999);
+    CHECK(validate_frames(&frame_1, 1, TEST_THREADS) > 0);
+    CHECK(has_violation(collision, 1, 1));
+    set_transmission(1, 1, 12000);
+    CHECK_EQUAL(validate_frames(&frame_1, 1, TEST_THREADS), 0);
+    set_transmission(0, 0, 10000);      // Frame 1 is now at 12000 in the shared link
+    set_transmission(0, 1, 12000);
+    CHECK(validate_frames(&frame_0, 1, TEST_THREADS) > 0);
+    CHECK(has_violation(collision, 0, 1));
+    set_transmission(0, 0, 18000);      // And the place of frame 1 at 20000 is free
+    set_transmission(0, 1, 20000);
+    CHECK_EQUAL(validate_frames(&frame_0, 1, TEST_THREADS), 0);
+    CHECK_EQUAL(validate_schedule(TEST_THREADS), 0);
+    
+    srs_free_network();
+    srs_exit();
+    return check_result("TestValidator");
+}
@@ -0,0 +1,631 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Benchmark.c                                                                                                        *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Measures how the phases of the scheduler scale with the size of the network.                                       *
+ *  For every point of a matrix of frames, links, hyperperiod / period ratios and link utilizations, a synthetic       *
+ *  network is generated (with a fixed seed, so every run of the benchmark measures the same networks), written to a   *
+ *  file and then loaded, scheduled, validated and written as many times as repetitions, or only until a given stage.  *
+ *  The generated networks are rings of links where every frame follows consecutive links, the periods divide the      *
+ *  hyperperiod by a divisor of the ratio and the size of the frames is set to reach the utilization.                  *
+ *  Every phase of every point is written as a row of a CSV file with the minimum, median, percentiles, maximum and    *
+ *  mean of its time, so the rows of a phase give its scaling curve.                                                   *
+ *  The CSV file of a previous run can be given as baseline, then the median of every phase is compared with it and   *
+ *  the phases that got slower than the threshold are reported as regressions (and the exit code is 2).                *
+ *  Usage: Benchmark [options], see --help                                                                             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "SelfRegeneratingScheduler.h"
+#include "Metrics.h"
+
+#define BENCHMARK_REPETITIONS 5         // Runs of every point by default
+#define BENCHMARK_THRESHOLD 0.1         // Slowdown of a median over the baseline reported as regression by default
+#define BENCHMARK_MIN_DIFFERENCE 0.1    // Smallest slowdown in ms reported as regression, below it is noise
+#define BENCHMARK_PERIOD 1000000        // Smallest period of the generated frames in ns when the ratio is 1
+#define BENCHMARK_SPEED 100             // Speed of the generated links in MB/s, a byte takes 10 ns
+#define BENCHMARK_HOP_DELAY 1000        // Hop delay of the generated networks in ns
+#define BENCHMARK_MAX_HOPS 4            // Maximum number of links of the path of a generated frame
+#define BENCHMARK_MAX_SIZE 1500         // Maximum size of a generated frame in bytes
+#define BENCHMARK_PHASE_SIZE 32         // Maximum length of the name of a phase in the CSV file
+#define BENCHMARK_COLUMNS (number_phases + 2)   // Phases measured: generate, the phases of the library and total
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Last stage of the scheduler run by the benchmark
+ */
+typedef enum BenchmarkStage {
+    stage_parse,                        // Load the network file
+    stage_constraints,                  // Add all the constraints, without solving them
+    stage_solve,                        // Solve the constraints and save the offsets
+    stage_validate,                     // Validate the schedule
+    stage_write                         // Write the schedule file (full pipeline)
+}BenchmarkStage;
+
+/**
+ Point of the matrix of network sizes
+ */
+typedef struct BenchmarkPoint {
+    int frames;                         // Number of frames
+    int links;                          // Number of links
+    int ratio;                          // Hyperperiod divided by the smallest period
+    double utilization;                 // Target utilization of the links, as a fraction
+}BenchmarkPoint;
+
+/**
+ Times of a phase in a point of the matrix, a row of the CSV file
+ */
+typedef struct BenchmarkRow {
+    BenchmarkPoint point;               // Point of the matrix
+    char phase[BENCHMARK_PHASE_SIZE];   // Name of the phase
+    double median;                      // Median of the time of the phase in ms
+}BenchmarkRow;
+
+                                                    /* VARIABLES */
+
+unsigned long long int benchmark_seed;  // State of the random generator of the networks
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the next pseudo random number of the generator of the networks (xorshift64*), so every platform generates the
+ same networks for the same seed
+
+ @param bound upper bound of the number (not included)
+ @return random number from 0 to bound - 1
+ */
+int next_random(int bound) {
+    
+    benchmark_seed ^= benchmark_seed >> 12;
+    benchmark_seed ^= benchmark_seed << 25;
+    benchmark_seed ^= benchmark_seed >> 27;
+    return (int) (((benchmark_seed * 2685821657736338717ULL) >> 33) % bound);
+}
+
+/**
+ Parses a list of numbers separated by commas
+
+ @param list string with the numbers
+ @param values pointer where the allocated array of numbers is saved
+ @return number of numbers
+ */
+int parse_value_list(const char *list, double **values) {
+    
+    char *end;
+    int num_values = 0;
+    
+    *values = malloc(sizeof(double) * (strlen(list) / 2 + 1));
+    while (*list != '\0') {
+        (*values)[num_values] = strtod(list, &end);
+        if (end == list) {          // Separator
+            list++;
+            continue;
+        }
+        num_values++;
+        list = end;
+    }
+    return num_values;
+}
+
+/**
+ Get the name of the column of the times of the benchmark
+
+ @param column column, 0 for the generation, then the phases of the library and the total at the end
+ @return name of the column
+ */
+const char * get_column_name(int column) {
+    
+    if (column == 0) {
+        return "generate";
+    }
+    if (column == BENCHMARK_COLUMNS - 1) {
+        return "total";
+    }
+    return get_phase_name((MetricPhase) (column - 1));
+}
+
+/**
+ Tells if a column is measured when the benchmark runs until the given stage
+
+ @param column column of the times
+ @param stage last stage run
+ @return 1 if it is measured, 0 otherwise
+ */
+int is_column_measured(int column, BenchmarkStage stage) {
+    
+    MetricPhase last_phase[] = {phase_parse, phase_end_to_end, phase_extract, phase_validate, phase_write};
+    
+    if (column == 0 || column == BENCHMARK_COLUMNS - 1) {
+        return 1;
+    }
+    return column - 1 <= (int) last_phase[stage];
+}
+
+/**
+ Generates the synthetic network of a point of the matrix and writes it in a network file. The links form a ring,
+ where the link i goes from the node i to the node i + 1, and every frame follows from 1 to BENCHMARK_MAX_HOPS
+ consecutive links from a random one. The period of every frame is the hyperperiod divided by a random divisor of the
+ ratio, and all frames have the same size, the one that brings the average utilization of the links closest to the
+ target (limited to BENCHMARK_MAX_SIZE)
+
+ @param point point of the matrix
+ @param namefile path and name of the network file, binary if it ends with .srsn
+ @param real_utilization pointer where the average utilization of the links reached is saved
+ @return 0 if generated correctly, -1 otherwise
+ */
+int generate_network(BenchmarkPoint *point, char *namefile, double *real_utilization) {
+    
+    long long int hyperperiod = (long long int) BENCHMARK_PERIOD * point->ratio;
+    long long int *periods;             // Period of every frame
+    int *first_links, *hops;            // First link and number of links of every frame
+    int path[BENCHMARK_MAX_HOPS];       // Path of the frame being added
+    int max_hops = point->links < BENCHMARK_MAX_HOPS ? point->links : BENCHMARK_MAX_HOPS;
+    int divisor, size, status;
+    double transmissions = 0;           // Bytes transmitted in all links every hyperperiod per byte of the frames
+    const char *extension = strrchr(namefile, '.');
+    
+    if (srs_new_network(point->frames, point->links, BENCHMARK_HOP_DELAY, hyperperiod, 0, 0, 0) == -1) {
+        return -1;
+    }
+    for (int i = 0; i < point->links; i++) {
+        srs_add_link(i, BENCHMARK_SPEED, wired);
+        srs_add_link_nodes(i, i, (i + 1) % point->links);
+    }
+    
+    periods = malloc(sizeof(long long int) * point->frames);
+    first_links = malloc(sizeof(int) * point->frames);
+    hops = malloc(sizeof(int) * point->frames);
+    for (int i = 0; i < point->frames; i++) {
+        do {
+            divisor = next_random(point->ratio) + 1;
+        } while (point->ratio % divisor != 0);
+        periods[i] = hyperperiod / divisor;
+        first_links[i] = next_random(point->links);
+        hops[i] = next_random(max_hops) + 1;
+        transmissions += (double) divisor * hops[i];
+    }
+    
+    // The size is the busy time of all links divided by the time that every byte of the frames keeps them busy
+    size = (int) (point->utilization * point->links * hyperperiod * BENCHMARK_SPEED / 1000 / transmissions);
+    size = size < 1 ? 1 : (size > BENCHMARK_MAX_SIZE ? BENCHMARK_MAX_SIZE : size);
+    *real_utilization = transmissions * size * 1000 / BENCHMARK_SPEED / ((double) point->links * hyperperiod);
+    for (int i = 0; i < point->frames; i++) {
+        srs_add_frame(i, periods[i], periods[i], size, periods[i], 0, 1, 0);
+        for (int j = 0; j < hops[i]; j++) {
+            path[j] = (first_links[i] + j) % point->links;
+        }
+        srs_add_frame_path(i, 0, path, hops[i]);
+    }
+    free(periods);
+    free(first_links);
+    free(hops);
+    
+    if (extension != NULL && strcmp(extension, ".srsn") == 0) {
+        status = srs_write_network_binary(namefile);
+    } else {
+        status = srs_write_network_xml(namefile);
+    }
+    srs_free_network();
+    return status;
+}
+
+/**
+ Runs the scheduler once for the network file until the given stage, and saves the time of every column
+
+ @param network_file path and name of the network file
+ @param schedule_file path and name of the schedule file
+ @param stage last stage run
+ @param options pointer to the options of the scheduler
+ @param times array where the time in ms of every column (except the generation) is saved
+ @return 0 if all the stages were run, -1 otherwise
+ */
+int run_scheduler(char *network_file, char *schedule_file, BenchmarkStage stage, SchedulerOptions *options,
+                  double *times) {
+    
+    struct timeval start, end;
+    int status = 0;
+    
+    gettimeofday(&start, NULL);
+    if (srs_load_network(network_file) == -1) {
+        return -1;
+    }
+    if (stage >= stage_constraints) {
+        options->constraints_only = stage == stage_constraints;
+        options->check_schedule = stage >= stage_validate;
+        status = srs_schedule(options);
+    }
+    if (status == 0 && stage == stage_write) {
+        status = srs_write_schedule(schedule_file);
+    }
+    gettimeofday(&end, NULL);
+    
+    for (int i = 0; i < number_phases; i++) {
+        times[i + 1] = get_phase_time((MetricPhase) i);
+    }
+    times[BENCHMARK_COLUMNS - 1] = time_diff(start, end);
+    srs_free_network();
+    return status;
+}
+
+/**
+ Compares two times to sort them
+
+ @param time1 pointer to the first time
+ @param time2 pointer to the second time
+ @return negative if the first is smaller, positive if greater, 0 if equal
+ */
+int compare_times(const void *time1, const void *time2) {
+    
+    double difference = *(const double*) time1 - *(const double*) time2;
+    
+    return difference < 0 ? -1 : (difference > 0 ? 1 : 0);
+}
+
+/**
+ Get a percentile of sorted times, interpolated between the two closest times
+
+ @param times sorted array of times
+ @param num_times number of times
+ @param percentile percentile as a fraction (0.5 for the median)
+ @return time of the percentile
+ */
+double get_percentile(double *times, int num_times, double percentile) {
+    
+    double position = percentile * (num_times - 1);
+    int index = (int) position;
+    
+    if (index + 1 >= num_times) {
+        return times[num_times - 1];
+    }
+    return times[index] + (times[index + 1] - times[index]) * (position - index);
+}
+
+/**
+ Reads the rows of a CSV file written by the benchmark, to compare the medians of the new run with them
+
+ @param namefile path and name of the CSV file
+ @param rows pointer where the allocated array of rows is saved
+ @return number of rows read, -1 if the file could not be read
+ */
+int read_baseline(char *namefile, BenchmarkRow **rows) {
+    
+    FILE *file;
+    char line[1024];
+    int num_rows = 0, max_rows = 64;
+    BenchmarkRow *row;
+    
+    if ((file = fopen(namefile, "r")) == NULL) {
+        printf("The baseline file %s could not be opened\n", namefile);
+        return -1;
+    }
+    *rows = malloc(sizeof(BenchmarkRow) * max_rows);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (num_rows == max_rows) {
+            max_rows *= 2;
+            *rows = realloc(*rows, sizeof(BenchmarkRow) * max_rows);
+        }
+        row = &(*rows)[num_rows];
+        // The header and the malformed lines are skipped
+        if (sscanf(line, "%d,%d,%d,%lf,%31[^,],%*d,%*d,%*d,%*d,%*d,%*f,%*f,%lf", &row->point.frames,
+                   &row->point.links, &row->point.ratio, &row->point.utilization, row->phase, &row->median) == 6) {
+            num_rows++;
+        }
+    }
+    fclose(file);
+    return num_rows;
+}
+
+/**
+ Searches the row of the same point and phase in the baseline
+
+ @param row pointer to the row of the new run
+ @param baseline array of rows of the baseline
+ @param num_baseline number of rows of the baseline
+ @return pointer to the row of the baseline, NULL if not found
+ */
+BenchmarkRow * find_baseline_row(BenchmarkRow *row, BenchmarkRow *baseline, int num_baseline) {
+    
+    for (int i = 0; i < num_baseline; i++) {
+        if (baseline[i].point.frames == row->point.frames && baseline[i].point.links == row->point.links &&
+            baseline[i].point.ratio == row->point.ratio &&
+            baseline[i].point.utilization - row->point.utilization < 1e-9 &&
+            row->point.utilization - baseline[i].point.utilization < 1e-9 &&
+            strcmp(baseline[i].phase, row->phase) == 0) {
+            return &baseline[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ Prints the comparison of the medians of the new run with the baseline
+
+ @param rows array of rows of the new run
+ @param num_rows number of rows of the new run
+ @param baseline array of rows of the baseline
+ @param num_baseline number of rows of the baseline
+ @param threshold slowdown of a median reported as regression, as a fraction
+ @return number of regressions found
+ */
+int compare_baseline(BenchmarkRow *rows, int num_rows, BenchmarkRow *baseline, int num_baseline, double threshold) {
+    
+    BenchmarkRow *base;
+    int num_regressions = 0, regression;
+    double change;
+    
+    printf("%8s %6s %6s %6s %-16s %12s %12s %8s\n", "frames", "links", "ratio", "util", "phase", "baseline_ms",
+           "median_ms", "change");
+    for (int i = 0; i < num_rows; i++) {
+        if ((base = find_baseline_row(&rows[i], baseline, num_baseline)) == NULL) {
+            continue;
+        }
+        change = base->median > 0 ? (rows[i].median - base->median) / base->median * 100 : 0;
+        regression = rows[i].median > base->median * (1 + threshold) &&
+                     rows[i].median - base->median > BENCHMARK_MIN_DIFFERENCE;
+        num_regressions += regression;
+        printf("%8d %6d %6d %6.2f %-16s %12.3f %12.3f %+7.1f%%%s\n", rows[i].point.frames, rows[i].point.links,
+               rows[i].point.ratio, rows[i].point.utilization, rows[i].phase, base->median, rows[i].median, change,
+               regression ? " REGRESSION" : "");
+    }
+    printf("Regressions => %d\n", num_regressions);
+    return num_regressions;
+}
+
+/**
+ Prints the usage of the benchmark
+
+ @param program name of the program
+ */
+void print_usage(const char *program) {
+    
+    printf("Usage: %s [options]\n", program);
+    printf("Options:\n");
+    printf("  --frames LIST          numbers of frames of the matrix separated by commas (10,20,40 by default)\n");
+    printf("  --links LIST           numbers of links of the matrix (8 by default)\n");
+    printf("  --ratios LIST          hyperperiod / smallest period ratios of the matrix (1 by default)\n");
+    printf("  --utilization LIST     utilizations of the links of the matrix in percent (10 by default)\n");
+    printf("  --repeat N             runs of every point of the matrix (%d by default)\n", BENCHMARK_REPETITIONS);
+    printf("  --until STAGE          last stage run: parse, constraints, solve, validate or write (by default)\n");
+    printf("  --binary               write the generated networks in the binary format instead of xml\n");
+    printf("  --seed N               seed of the generated networks (1 by default)\n");
+    printf("  --budget MS            maximum time to synthesize every schedule\n");
+    printf("  --threads N            threads used to validate the schedules (0 for all processors)\n");
+    printf("  --work DIR             directory of the generated networks and schedules (/tmp by default)\n");
+    printf("  --output FILE          CSV file with the times of every phase (benchmark.csv by default)\n");
+    printf("  --baseline FILE        CSV file of a previous run to compare the medians with\n");
+    printf("  --threshold PERCENT    slowdown of a median reported as regression (10 by default)\n");
+    printf("  --help                 show this help\n");
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, char * argv[]) {
+    
+    double *frames = NULL, *links = NULL, *ratios = NULL, *utilizations = NULL;
+    int num_frames, num_links, num_ratios, num_utilizations;
+    int repetitions = BENCHMARK_REPETITIONS, binary = 0, opt, completed, num_rows = 0, max_rows = 64;
+    int num_baseline = 0, num_points = 0, result = 0;
+    unsigned long long int seed = 1;    // Seed of the generated networks
+    BenchmarkStage stage = stage_write;
+    const char *stage_names[] = {"parse", "constraints", "solve", "validate", "write"};
+    char *work_dir = "/tmp", *output_file = "benchmark.csv", *baseline_file = NULL;
+    char network_file[1024], schedule_file[1024];
+    double threshold = BENCHMARK_THRESHOLD, real_utilization, generate_time, sum;
+    double *samples[BENCHMARK_COLUMNS];     // Times of the completed runs of the point in every column
+    double times[BENCHMARK_COLUMNS];
+    struct timeval start, end;
+    BenchmarkPoint point;
+    BenchmarkRow *rows, *baseline = NULL;
+    SchedulerOptions options;
+    FILE *output;
+    struct option long_options[] = {
+        {"frames", required_argument, NULL, 'f'},
+        {"links", required_argument, NULL, 'l'},
+        {"ratios", required_argument, NULL, 'r'},
+        {"utilization", required_argument, NULL, 'u'},
+        {"repeat", required_argument, NULL, 'n'},
+        {"until", required_argument, NULL, 's'},
+        {"binary", no_argument, NULL, 'B'},
+        {"seed", required_argument, NULL, 'S'},
+        {"budget", required_argument, NULL, 'b'},
+        {"threads", required_argument, NULL, 't'},
+        {"work", required_argument, NULL, 'w'},
+        {"output", required_argument, NULL, 'o'},
+        {"baseline", required_argument, NULL, 'c'},
+        {"threshold", required_argument, NULL, 'T'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    
+    init_scheduler_options(&options);
+    options.verbose = 0;
+    num_frames = parse_value_list("10,20,40", &frames);
+    num_links = parse_value_list("8", &links);
+    num_ratios = parse_value_list("1", &ratios);
+    num_utilizations = parse_value_list("10", &utilizations);
+    while ((opt = getopt_long(argc, argv, "f:l:r:u:n:s:BS:b:t:w:o:c:T:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'f':
+                free(frames);
+                num_frames = parse_value_list(optarg, &frames);
+                break;
+            case 'l':
+                free(links);
+                num_links = parse_value_list(optarg, &links);
+                break;
+            case 'r':
+                free(ratios);
+                num_ratios = parse_value_list(optarg, &ratios);
+                break;
+            case 'u':
+                free(utilizations);
+                num_utilizations = parse_value_list(optarg, &utilizations);
+                break;
+            case 'n':
+                repetitions = atoi(optarg);
+                break;
+            case 's':
+                for (stage = stage_parse; stage < stage_write && strcmp(optarg, stage_names[stage]) != 0; stage++);
+                if (strcmp(optarg, stage_names[stage]) != 0) {
+                    printf("Unknown stage %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'B':
+                binary = 1;
+                break;
+            case 'S':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'b':
+                options.time_budget = atoll(optarg);
+                break;
+            case 't':
+                options.num_threads = atoi(optarg);
+                break;
+            case 'w':
+                work_dir = optarg;
+                break;
+            case 'o':
+                output_file = optarg;
+                break;
+            case 'c':
+                baseline_file = optarg;
+                break;
+            case 'T':
+                threshold = atof(optarg) / 100;
+                break;
+            default:
+                print_usage(argv[0]);
+                free(frames);
+                free(links);
+                free(ratios);
+                free(utilizations);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (repetitions <= 0 || num_frames == 0 || num_links == 0 || num_ratios == 0 || num_utilizations == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (baseline_file != NULL && (num_baseline = read_baseline(baseline_file, &baseline)) == -1) {
+        return 1;
+    }
+    if ((output = fopen(output_file, "w")) == NULL) {
+        printf("The output file %s could not be created\n", output_file);
+        free(baseline);
+        return 1;
+    }
+    
+    snprintf(network_file, sizeof(network_file), "%s/srs_benchmark_network.%s", work_dir, binary ? "srsn" : "xml");
+    snprintf(schedule_file, sizeof(schedule_file), "%s/srs_benchmark_schedule.xml", work_dir);
+    for (int i = 0; i < BENCHMARK_COLUMNS; i++) {
+        samples[i] = malloc(sizeof(double) * repetitions);
+    }
+    rows = malloc(sizeof(BenchmarkRow) * max_rows);
+    fprintf(output, "frames,links,ratio,utilization,phase,runs,failed,variables,formulas,disjunctions,"
+            "real_utilization,min_ms,median_ms,p90_ms,p99_ms,max_ms,mean_ms\n");
+    
+    srs_init();
+    for (int f = 0; f < num_frames; f++) {
+        for (int l = 0; l < num_links; l++) {
+            for (int r = 0; r < num_ratios; r++) {
+                for (int u = 0; u < num_utilizations; u++) {
+                    point.frames = (int) frames[f];
+                    point.links = (int) links[l];
+                    point.ratio = (int) ratios[r];
+                    point.utilization = utilizations[u] / 100;
+                    if (point.frames <= 0 || point.links <= 0 || point.ratio <= 0) {
+                        continue;
+                    }
+                    
+                    // Every repetition generates the same network of the point again, to measure the generation
+                    completed = 0;
+                    num_points++;
+                    for (int i = 0; i < repetitions; i++) {
+                        benchmark_seed = (seed + num_points) * 0x9E3779B97F4A7C15ULL;
+                        benchmark_seed = benchmark_seed == 0 ? 1 : benchmark_seed;     // xorshift cannot start at 0
+                        gettimeofday(&start, NULL);
+                        if (generate_network(&point, network_file, &real_utilization) == -1) {
+                            printf("The network could not be generated in %s\n", network_file);
+                            result = 1;
+                            break;
+                        }
+                        gettimeofday(&end, NULL);
+                        generate_time = time_diff(start, end);
+                        if (run_scheduler(network_file, schedule_file, stage, &options, times) == 0) {
+                            times[0] = generate_time;
+                            for (int j = 0; j < BENCHMARK_COLUMNS; j++) {
+                                samples[j][completed] = times[j];
+                            }
+                            completed++;
+                        }
+                    }
+                    printf("Point %d frames, %d links, ratio %d, utilization %.2f => %d of %d runs completed\n",
+                           point.frames, point.links, point.ratio, point.utilization, completed, repetitions);
+                    
+                    // One row per phase, with the statistics of the completed runs
+                    for (int j = 0; j < BENCHMARK_COLUMNS; j++) {
+                        if (!is_column_measured(j, stage)) {
+                            continue;
+                        }
+                        qsort(samples[j], completed, sizeof(double), compare_times);
+                        if (num_rows == max_rows) {
+                            max_rows *= 2;
+                            rows = realloc(rows, sizeof(BenchmarkRow) * max_rows);
+                        }
+                        rows[num_rows].point = point;
+                        strncpy(rows[num_rows].phase, get_column_name(j), BENCHMARK_PHASE_SIZE - 1);
+                        rows[num_rows].phase[BENCHMARK_PHASE_SIZE - 1] = '\0';
+                        rows[num_rows].median = completed > 0 ? get_percentile(samples[j], completed, 0.5) : 0;
+                        fprintf(output, "%d,%d,%d,%g,%s,%d,%d,%d,%d,%d,%f", point.frames, point.links, point.ratio,
+                                point.utilization, rows[num_rows].phase, completed, repetitions - completed,
+                                get_number_variables(), get_number_formulas(), get_number_disjunctions(),
+                                real_utilization);
+                        if (completed > 0) {
+                            sum = 0;
+                            for (int i = 0; i < completed; i++) {
+                                sum += samples[j][i];
+                            }
+                            fprintf(output, ",%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", samples[j][0], rows[num_rows].median,
+                                    get_percentile(samples[j], completed, 0.9),
+                                    get_percentile(samples[j], completed, 0.99), samples[j][completed - 1],
+                                    sum / completed);
+                        } else {
+                            fprintf(output, ",,,,,,\n");
+                        }
+                        num_rows++;
+                    }
+                    fflush(output);
+                }
+            }
+        }
+    }
+    srs_exit();
+    fclose(output);
+    remove(network_file);
+    remove(schedule_file);
+    
+    if (baseline != NULL && compare_baseline(rows, num_rows, baseline, num_baseline, threshold) > 0 && result == 0) {
+        result = 2;
+    }
+    for (int i = 0; i < BENCHMARK_COLUMNS; i++) {
+        free(samples[i]);
+    }
+    free(rows);
+    free(baseline);
+    free(frames);
+    free(links);
+    free(ratios);
+    free(utilizations);
+    return result;
+}
@@ -0,0 +1,40 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  NetworkConverter.c                                                                                                 *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Converts network files between the xml format and the binary format of the scheduler library.                      *
+ *  The format of the input file is detected by its content, the output is written in the other format.                *
+ *  Usage: NetworkConverter input_network output_network                                                               *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include "SelfRegeneratingScheduler.h"
+#include "BinaryNetwork.h"
+
+int main(int argc, const char * argv[]) {
+    
+    int binary;                         // 1 if the input file is a binary network file
+    int result = 1;                     // Exit code of the program
+    
+    if (argc < 3) {
+        printf("Usage: %s input_network output_network\n", argv[0]);
+        return 1;
+    }
+    
+    srs_init();
+    binary = is_network_binary((char*) argv[1]);
+    if (srs_load_network((char*) argv[1]) != -1) {
+        if (binary && srs_write_network_xml((char*) argv[2]) != -1) {
+            result = 0;
+        } else if (!binary && srs_write_network_binary((char*) argv[2]) != -1) {
+            result = 0;
+        }
+    }
+    srs_exit();
+    return result;
+}
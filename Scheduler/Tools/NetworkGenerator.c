@@ -0,0 +1,213 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  NetworkGenerator.c                                                                                                 *
+ *  Self-Regenerating Scheduler                                                                                        *
+ *                                                                                                                     *
+ *  Created by Francisco Pozo on 18/10/26.                                                                             *
+ *  Copyright © 2026 Francisco Pozo. All rights reserved.                                                              *
+ *                                                                                                                     *
+ *  Generates a synthetic network with the generator of the scheduler library and writes it in a network file, binary *
+ *  if its name ends with .srsn and xml otherwise. The same seed and options always generate the same file.            *
+ *  Usage: NetworkGenerator [options] output_network, see --help                                                       *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <sys/time.h>
+#include "Generator.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Parses a list of integers separated by commas
+
+ @param list string with the numbers
+ @param values pointer where the allocated array of numbers is saved
+ @return number of numbers
+ */
+int parse_integer_list(const char *list, long long int **values) {
+    
+    char *end;
+    int num_values = 0;
+    
+    *values = malloc(sizeof(long long int) * (strlen(list) / 2 + 1));
+    while (*list != '\0') {
+        (*values)[num_values] = strtoll(list, &end, 10);
+        if (end == list) {          // Separator
+            list++;
+            continue;
+        }
+        num_values++;
+        list = end;
+    }
+    return num_values;
+}
+
+/**
+ Prints the options of the generator
+
+ @param name name of the program
+ */
+void print_usage(const char *name) {
+    
+    printf("Usage: %s [options] output_network (binary if it ends with .srsn, xml otherwise)\n", name);
+    printf("  --topology NAME          line, ring, star, tree or mesh of switches (ring by default)\n");
+    printf("  --switches N             number of switches (8 by default)\n");
+    printf("  --end-systems N          end systems connected to every switch (2 by default)\n");
+    printf("  --frames N               number of frames (100 by default)\n");
+    printf("  --speeds LIST            speeds of the links in MB/s, chosen at random (100 by default)\n");
+    printf("  --wireless PERCENT       connections of end systems that are wireless (0 by default)\n");
+    printf("  --periods LIST           periods of the frames in ns, chosen at random (1, 2, 5 and 10 ms by default)\n");
+    printf("  --sizes MIN,MAX          sizes of the frames in bytes (64,1500 by default)\n");
+    printf("  --utilization PERCENT    average utilization of the links used (random sizes by default)\n");
+    printf("  --multicast PERCENT      frames with more than one receiver (10 by default)\n");
+    printf("  --fanout N               maximum receivers of a multicast frame (4 by default)\n");
+    printf("  --hop-delay NS           minimum time a switch needs to relay a frame (1000 by default)\n");
+    printf("  --protocol PERIOD,TIME   period and time reserved for the protocol in ns (none by default)\n");
+    printf("  --time-between-frames NS minimum time between two transmissions in a link (0 by default)\n");
+    printf("  --seed N                 seed of the network (1 by default)\n");
+    printf("  --help                   show this help\n");
+}
+
+                                                    /* FUNCTIONS */
+
+int main(int argc, char * argv[]) {
+    
+    GeneratorOptions options;
+    GeneratorSummary summary;
+    long long int *periods = NULL, *values = NULL;
+    int *speeds = NULL;
+    int opt, num_values, result;
+    struct timeval start, end;
+    struct option long_options[] = {
+        {"topology", required_argument, NULL, 'T'},
+        {"switches", required_argument, NULL, 's'},
+        {"end-systems", required_argument, NULL, 'e'},
+        {"frames", required_argument, NULL, 'f'},
+        {"speeds", required_argument, NULL, 'v'},
+        {"wireless", required_argument, NULL, 'w'},
+        {"periods", required_argument, NULL, 'p'},
+        {"sizes", required_argument, NULL, 'z'},
+        {"utilization", required_argument, NULL, 'u'},
+        {"multicast", required_argument, NULL, 'm'},
+        {"fanout", required_argument, NULL, 'o'},
+        {"hop-delay", required_argument, NULL, 'd'},
+        {"protocol", required_argument, NULL, 'P'},
+        {"time-between-frames", required_argument, NULL, 'g'},
+        {"seed", required_argument, NULL, 'S'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    
+    init_generator_options(&options);
+    while ((opt = getopt_long(argc, argv, "T:s:e:f:v:w:p:z:u:m:o:d:P:g:S:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'T':
+                if ((int) (options.topology = get_topology_class(optarg)) == -1) {
+                    printf("Unknown topology %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 's':
+                options.num_switches = atoi(optarg);
+                break;
+            case 'e':
+                options.end_systems = atoi(optarg);
+                break;
+            case 'f':
+                options.num_frames = atoi(optarg);
+                break;
+            case 'v':
+                free(speeds);
+                options.num_speeds = parse_integer_list(optarg, &values);
+                speeds = malloc(sizeof(int) * (options.num_speeds + 1));
+                for (int i = 0; i < options.num_speeds; i++) {
+                    speeds[i] = (int) values[i];
+                }
+                free(values);
+                options.speeds = speeds;
+                break;
+            case 'w':
+                options.wireless = atof(optarg) / 100;
+                break;
+            case 'p':
+                free(periods);
+                options.num_periods = parse_integer_list(optarg, &periods);
+                options.periods = periods;
+                break;
+            case 'z':
+                num_values = parse_integer_list(optarg, &values);
+                if (num_values == 2) {
+                    options.min_size = (int) values[0];
+                    options.max_size = (int) values[1];
+                }
+                free(values);
+                if (num_values != 2) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'u':
+                options.utilization = atof(optarg) / 100;
+                break;
+            case 'm':
+                options.multicast = atof(optarg) / 100;
+                break;
+            case 'o':
+                options.max_fanout = atoi(optarg);
+                break;
+            case 'd':
+                options.hop_delay = atoi(optarg);
+                break;
+            case 'P':
+                num_values = parse_integer_list(optarg, &values);
+                if (num_values == 2) {
+                    options.protocol_period = values[0];
+                    options.protocol_time = values[1];
+                }
+                free(values);
+                if (num_values != 2) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'g':
+                options.time_between_frames = atoll(optarg);
+                break;
+            case 'S':
+                options.seed = strtoull(optarg, NULL, 10);
+                break;
+            default:
+                print_usage(argv[0]);
+                free(speeds);
+                free(periods);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1) {
+        print_usage(argv[0]);
+        free(speeds);
+        free(periods);
+        return 1;
+    }
+    
+    gettimeofday(&start, NULL);
+    result = generate_network_file(argv[optind], &options, &summary);
+    gettimeofday(&end, NULL);
+    if (result != -1) {
+        printf("Network %s generated in %.3f s\n", argv[optind],
+               (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0);
+        printf("  Nodes: %d, links: %d, frames: %d\n", summary.num_nodes, summary.num_links, options.num_frames);
+        printf("  Hyperperiod: %lld ns, instances: %lld, path links: %lld\n", summary.hyperperiod,
+               summary.instances, summary.path_links);
+        printf("  Utilization: %.4f (maximum %.4f), sizes scaled by %.4f\n", summary.utilization,
+               summary.max_utilization, summary.size_scale);
+        printf("  File size: %lld bytes\n", summary.file_size);
+    }
+    free(speeds);
+    free(periods);
+    return result == -1 ? 1 : 0;
+}